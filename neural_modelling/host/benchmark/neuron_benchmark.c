@@ -0,0 +1,719 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host microbenchmark of a neuron binary.
+ *
+ *  This takes the place of c_main.c in a host build of a neuron model (see
+ *  makefiles/neuron/host_build.mk).  It builds the data regions of a
+ *  synthetic core in memory (neuron parameters, a master population table
+ *  and a synaptic matrix with one block of rows per source population),
+ *  initialises the model code exactly as c_main.c does, and then replays a
+ *  spike stream through the real multicast packet, DMA and row processing
+ *  callbacks.  The stream is either generated (each source fires with a
+ *  fixed probability per timestep) or read from a file.
+ *
+ *  The cost of _process_fixed_synapses,
+ *  synapse_dynamics_process_plastic_synapses and the master population
+ *  table lookup is taken from the profiler tags around them; the neuron
+ *  update is timed around neuron_do_timestep_update.  A final "BENCHMARK" line gives the results in
+ *  a form that is easy to collect across models.
+ *
+ *  The neuron parameters are read from a file written by neuron_params.py,
+ *  which the host build runs to give the default parameters of the PyNN
+ *  model of the binary; this holds the number of neurons and of synapse
+ *  types, followed by the words that follow the recording parameters in the
+ *  neuron parameter region written by the tools.
+ */
+
+// The SpiNNaker headers must come before the system ones (see
+// common-typedefs.h)
+#include <common/neuron-typedefs.h>
+#include <neuron/neuron.h>
+#include <neuron/synapses.h>
+#include <neuron/synapse_row.h>
+#include <neuron/spike_processing.h>
+#include <neuron/population_table/population_table.h>
+#include <neuron/plasticity/synapse_dynamics.h>
+#include <neuron/profile_tags.h>
+#include <profiler.h>
+#include <host_api.h>
+#include <utils.h>
+#include <bit_field.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef HOST_APP_NAME
+#define HOST_APP_NAME "neuron"
+#endif
+
+//! The default neuron parameter file, as written by the host build
+#ifndef HOST_NEURON_PARAMS_FILE
+#define HOST_NEURON_PARAMS_FILE HOST_APP_NAME "_params.bin"
+#endif
+
+//! The words of the header of a neuron parameter file
+#define NEURON_PARAMS_HEADER_WORDS 2
+
+//! The memory made available to the model
+#define ARENA_BYTES (256 * 1024 * 1024)
+
+//! The number of sources in each source population (and so in each master
+//! population table entry)
+#define SOURCES_PER_POPULATION 256
+
+//! The mask of the keys of a source population
+#define SOURCE_POPULATION_MASK 0xFFFFFF00
+
+//! Words reserved for the plastic region header of each row; the largest
+//! pre-synaptic event history of the timing rules fits in this
+#define PLASTIC_HEADER_WORDS 4
+
+//! The largest row length that the master population table can describe
+#define MAX_ROW_LENGTH 0xFF
+
+//! The size of the synapse dynamics region; all rules read less than this
+#define SYNAPSE_DYNAMICS_REGION_BYTES (64 * 1024)
+
+//! The size of the incoming spike buffer given to the model
+#define INCOMING_SPIKE_BUFFER_SIZE 256
+
+//! The routing key of the core (only used when neurons spike)
+#define TRANSMISSION_KEY 0x10000000
+
+//! The number of (unrecorded) state variables given to the neuron
+//! implementation; it writes this many into the recording values each update,
+//! so it must be at least the largest used by any of the implementations
+#define N_RECORDED_VARIABLES 3
+
+//! The current timestep, as maintained by c_main.c on the machine
+uint32_t time;
+
+// The timer tick count of the host stand-in for the spin1 API
+extern uint ticks;
+
+//! The options of a run
+typedef struct benchmark_options {
+    uint32_t n_neurons;
+    uint32_t n_sources;
+    uint32_t row_length;
+    uint32_t n_ticks;
+    double rate_hz;
+    uint32_t plastic_percent;
+    uint32_t n_dma_buffers;
+    bool burst;
+    uint32_t empty_percent;
+    bool bit_fields;
+    synapse_row_format row_format;
+    uint32_t seed;
+    const char *spike_file;
+    const char *params_file;
+} benchmark_options;
+
+//! The neuron model parameters, as read from a parameter file
+typedef struct neuron_params {
+    uint32_t n_neurons;
+    uint32_t n_synapse_types;
+    uint32_t n_words;
+    uint32_t *words;
+} neuron_params;
+
+//! A spike to be delivered at a given timestep
+typedef struct timed_spike {
+    uint32_t tick;
+    uint32_t key;
+} timed_spike;
+
+static uint32_t rng_state;
+
+/* PRIVATE FUNCTIONS */
+
+static inline uint32_t _rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static inline uint32_t _log_n_bits(uint32_t n, bool min_one) {
+    if (n == 1) {
+        return min_one ? 1 : 0;
+    }
+    if (!is_power_of_2(n)) {
+        n = next_power_of_2(n);
+    }
+    return ilog_2(n);
+}
+
+static inline uint32_t _source_key(uint32_t source) {
+    uint32_t population = source / SOURCES_PER_POPULATION;
+    return ((population + 1) << 8) | (source % SOURCES_PER_POPULATION);
+}
+
+static void _usage(const char *program) {
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -s <sources>      source neurons (default 1024)\n"
+        "  -r <synapses>     synapses per row (default 32)\n"
+        "  -t <ticks>        timesteps to run (default 1000)\n"
+        "  -f <rate>         source firing rate in Hz at 1ms (default 10)\n"
+        "  -p <percent>      percentage of plastic source populations\n"
+        "                    (default 50 for STDP builds, else 0)\n"
+        "  -d <buffers>      synaptic row DMA buffers (default 4)\n"
+        "  -b <0|1>          deliver the spikes of each timestep together\n"
+        "                    rather than one at a time (default 0)\n"
+        "  -e <percent>      percentage of source rows with no synapses\n"
+        "                    (default 0)\n"
+        "  -F <0|1>          write connectivity bit fields (default 1)\n"
+        "  -c <format>       format of the static rows: 0 full, 1 shared\n"
+        "                    weight, 2 shared delay (default 0)\n"
+        "  -S <seed>         random seed (default 1)\n"
+        "  -i <file>         replay spikes from a file of \"<tick> <key>\"\n"
+        "                    lines, ordered by tick, where the key of\n"
+        "                    source s is ((s / 256 + 1) << 8) | (s %% 256)\n"
+        "  -P <file>         neuron parameter file written by neuron_params.py\n"
+        "                    (default " HOST_NEURON_PARAMS_FILE ")\n",
+        program);
+    exit(1);
+}
+
+static void _parse_options(
+        int argc, char **argv, benchmark_options *options) {
+    options->n_neurons = 0;
+    options->n_sources = 1024;
+    options->row_length = 32;
+    options->n_ticks = 1000;
+    options->rate_hz = 10.0;
+    options->plastic_percent = STDP_ENABLED ? 50 : 0;
+    options->n_dma_buffers = 4;
+    options->burst = false;
+    options->empty_percent = 0;
+    options->bit_fields = true;
+    options->row_format = SYNAPSE_ROW_FORMAT_FULL;
+    options->seed = 1;
+    options->spike_file = NULL;
+    options->params_file = HOST_NEURON_PARAMS_FILE;
+
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0'
+                || i + 1 >= argc) {
+            _usage(argv[0]);
+        }
+        const char *value = argv[++i];
+        switch (argv[i - 1][1]) {
+        case 's':
+            options->n_sources = strtoul(value, NULL, 0);
+            break;
+        case 'r':
+            options->row_length = strtoul(value, NULL, 0);
+            break;
+        case 't':
+            options->n_ticks = strtoul(value, NULL, 0);
+            break;
+        case 'f':
+            options->rate_hz = strtod(value, NULL);
+            break;
+        case 'p':
+            options->plastic_percent = strtoul(value, NULL, 0);
+            break;
+        case 'd':
+            options->n_dma_buffers = strtoul(value, NULL, 0);
+            break;
+        case 'b':
+            options->burst = strtoul(value, NULL, 0) != 0;
+            break;
+        case 'e':
+            options->empty_percent = strtoul(value, NULL, 0);
+            break;
+        case 'F':
+            options->bit_fields = strtoul(value, NULL, 0) != 0;
+            break;
+        case 'c':
+            options->row_format = strtoul(value, NULL, 0);
+            break;
+        case 'S':
+            options->seed = strtoul(value, NULL, 0);
+            break;
+        case 'i':
+            options->spike_file = value;
+            break;
+        case 'P':
+            options->params_file = value;
+            break;
+        default:
+            _usage(argv[0]);
+        }
+    }
+
+    if (options->n_sources == 0 || options->row_length == 0
+            || options->plastic_percent > 100
+            || options->empty_percent > 100
+            || options->row_format > SYNAPSE_ROW_FORMAT_SHARED_DELAY) {
+        _usage(argv[0]);
+    }
+#if !STDP_ENABLED
+    options->plastic_percent = 0;
+#endif
+}
+
+//! \brief Reads the whole of a file into newly allocated memory
+static void *_read_file(const char *filename, uint32_t *n_bytes) {
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Could not open %s\n", filename);
+        exit(1);
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    void *data = malloc(size > 0 ? size : 1);
+    if (data == NULL || fread(data, 1, size, file) != (size_t) size) {
+        fprintf(stderr, "Could not read %s\n", filename);
+        exit(1);
+    }
+    fclose(file);
+    *n_bytes = (uint32_t) size;
+    return data;
+}
+
+//! \brief Reads a neuron parameter file written by neuron_params.py
+static void _read_neuron_params(const char *filename, neuron_params *params) {
+    uint32_t n_bytes;
+    uint32_t *words = _read_file(filename, &n_bytes);
+    if (n_bytes < NEURON_PARAMS_HEADER_WORDS * sizeof(uint32_t)
+            || (n_bytes % sizeof(uint32_t)) != 0
+            || words[0] == 0 || words[0] > 256 || words[1] == 0) {
+        fprintf(stderr, "%s is not a neuron parameter file\n", filename);
+        exit(1);
+    }
+    params->n_neurons = words[0];
+    params->n_synapse_types = words[1];
+    params->n_words =
+        (n_bytes / sizeof(uint32_t)) - NEURON_PARAMS_HEADER_WORDS;
+    params->words = words;
+}
+
+//! \brief Writes the neuron parameter region
+static address_t _make_neuron_region(
+        const benchmark_options *options, const neuron_params *params) {
+    uint32_t n_neurons = options->n_neurons;
+    uint32_t n_words_for_n_neurons = (n_neurons + 3) >> 2;
+
+    uint32_t header_words =
+        8 + ((2 + n_words_for_n_neurons) * (1 + N_RECORDED_VARIABLES));
+    address_t region = host_sdram_alloc(
+        (header_words + params->n_words) * sizeof(uint32_t));
+    uint32_t next = 0;
+    region[next++] = 0;                           // timer start offset
+    region[next++] = 0;                           // time between spikes
+    region[next++] = 1;                           // has key
+    region[next++] = TRANSMISSION_KEY;
+    region[next++] = n_neurons;
+    region[next++] = params->n_synapse_types;
+    region[next++] = INCOMING_SPIKE_BUFFER_SIZE;
+    region[next++] = N_RECORDED_VARIABLES;
+
+    // Record the spikes of every neuron on every timestep
+    region[next++] = 1;
+    region[next++] = n_neurons;
+    uint8_t *indices = (uint8_t *) &region[next];
+    for (uint32_t i = 0; i < n_neurons; i++) {
+        indices[i] = i;
+    }
+    next += n_words_for_n_neurons;
+
+    // Don't record the other variables
+    for (uint32_t v = 0; v < N_RECORDED_VARIABLES; v++) {
+        region[next++] = 0;
+        region[next++] = 0;
+        memset(&region[next], 0, n_words_for_n_neurons * sizeof(uint32_t));
+        next += n_words_for_n_neurons;
+    }
+
+    memcpy(&region[next], &params->words[NEURON_PARAMS_HEADER_WORDS],
+        params->n_words * sizeof(uint32_t));
+    return region;
+}
+
+//! \brief Writes the master population table and synaptic matrix regions
+static void _make_synaptic_regions(
+        const benchmark_options *options, uint32_t n_synapse_types,
+        address_t *table_region, address_t *matrix_region,
+        uint32_t *n_plastic_populations) {
+    uint32_t n_neurons = options->n_neurons;
+    uint32_t row_length = options->row_length;
+    uint32_t n_populations =
+        (options->n_sources + SOURCES_PER_POPULATION - 1)
+        / SOURCES_PER_POPULATION;
+    *n_plastic_populations =
+        ((n_populations * options->plastic_percent) + 50) / 100;
+    if (options->plastic_percent > 0 && *n_plastic_populations == 0) {
+        *n_plastic_populations = 1;
+    }
+
+    uint32_t index_bits = _log_n_bits(n_neurons, true);
+    uint32_t type_bits = _log_n_bits(n_synapse_types, false);
+    uint32_t type_index_bits = index_bits + type_bits;
+    uint32_t n_control_words = (row_length + 1) >> 1;
+    uint32_t plastic_region_words = PLASTIC_HEADER_WORDS + row_length;
+
+    uint32_t fixed_row_words = row_length;
+    if (options->row_format != SYNAPSE_ROW_FORMAT_FULL) {
+        fixed_row_words = 1 + ((row_length + 1) >> 1);
+    }
+    uint32_t plastic_row_words = plastic_region_words + n_control_words;
+    if (fixed_row_words > MAX_ROW_LENGTH || (*n_plastic_populations > 0
+            && plastic_row_words > MAX_ROW_LENGTH)) {
+        fprintf(stderr, "Rows of %u synapses are too long\n", row_length);
+        exit(1);
+    }
+    if (*n_plastic_populations > 0
+            && type_index_bits + SYNAPSE_DELAY_BITS + 3 > 16) {
+        fprintf(stderr, "%u neurons do not fit in a plastic control word\n",
+            n_neurons);
+        exit(1);
+    }
+
+    // The master population table holds an entry, one address and a
+    // connectivity bit field per source population
+    uint32_t bit_field_words = get_bit_field_size(SOURCES_PER_POPULATION);
+    *table_region = host_sdram_alloc(
+        (2 + (n_populations * (3 + 1 + 1 + bit_field_words)))
+        * sizeof(uint32_t));
+    address_t table = *table_region;
+    table[0] = n_populations;
+    table[1] = n_populations;
+    address_t entries = &table[2];
+    address_t addresses = &table[2 + (n_populations * 3)];
+    address_t bit_fields = &addresses[n_populations];
+
+    // Work out the size of the matrix, keeping each block 16-byte aligned
+    uint32_t matrix_bytes = 0;
+    for (uint32_t p = 0; p < n_populations; p++) {
+        uint32_t words = (p < *n_plastic_populations) ?
+            plastic_row_words : fixed_row_words;
+        uint32_t block_bytes = SOURCES_PER_POPULATION
+            * (words + N_SYNAPSE_ROW_HEADER_WORDS) * sizeof(uint32_t);
+        matrix_bytes += (block_bytes + 15) & ~15u;
+    }
+    *matrix_region = host_sdram_alloc(matrix_bytes);
+
+    uint32_t offset = 0;
+    for (uint32_t p = 0; p < n_populations; p++) {
+        bool plastic = p < *n_plastic_populations;
+        uint32_t words = plastic ? plastic_row_words : fixed_row_words;
+
+        entries[p * 3] = (p + 1) << 8;
+        entries[(p * 3) + 1] = SOURCE_POPULATION_MASK;
+        entries[(p * 3) + 2] = (1 << 16) | p;  // count 1, start p
+        addresses[p] = (offset << 4) | words;
+
+        bit_field_t bit_field = &bit_fields[1];
+        bit_fields[0] = options->bit_fields ? bit_field_words : 0;
+        clear_bit_field(bit_field, bit_field_words);
+        bit_fields = &bit_fields[1 + bit_fields[0]];
+
+        address_t block = &(*matrix_region)[offset >> 2];
+        for (uint32_t s = 0; s < SOURCES_PER_POPULATION; s++) {
+            address_t row = &block[s * (words + N_SYNAPSE_ROW_HEADER_WORDS)];
+            if (options->empty_percent > 0
+                    && (_rng_next() % 100) < options->empty_percent) {
+                row[0] = plastic ? plastic_region_words : 0;
+                address_t fixed = &row[1 + row[0]];
+                fixed[0] = 0;
+                fixed[1] = 0;
+                continue;
+            }
+            if (options->bit_fields) {
+                bit_field_set(bit_field, s);
+            }
+            if (plastic) {
+                row[0] = plastic_region_words;
+                address_t fixed = &row[1 + plastic_region_words];
+                fixed[0] = 0;
+                fixed[1] = row_length;
+                control_t *controls = (control_t *) &fixed[2];
+                for (uint32_t i = 0; i < row_length; i++) {
+                    uint32_t delay = 1 + (_rng_next() % 7);
+                    controls[i] = (delay << type_index_bits)
+                        | (_rng_next() % n_neurons);
+                }
+            } else if (options->row_format != SYNAPSE_ROW_FORMAT_FULL) {
+                row[0] = 0;
+                address_t fixed = &row[1];
+                fixed[0] = row_length
+                    | (options->row_format << SYNAPSE_ROW_FORMAT_SHIFT);
+                fixed[1] = 0;
+                bool shared_weight =
+                    options->row_format == SYNAPSE_ROW_FORMAT_SHARED_WEIGHT;
+                uint32_t weight_mask = (1 << (16 - type_index_bits)) - 1;
+                fixed[2] = shared_weight ?
+                    (_rng_next() & 0xFF) : 1 + (_rng_next() % 15);
+                uint16_t *synapses = synapse_row_compact_synapses(fixed);
+                for (uint32_t i = 0; i < row_length; i++) {
+                    uint32_t type = _rng_next() % n_synapse_types;
+                    uint32_t first = shared_weight ?
+                        1 + (_rng_next() % 15) : _rng_next() & weight_mask;
+                    synapses[i] = (first << type_index_bits)
+                        | (type << index_bits)
+                        | (_rng_next() % n_neurons);
+                }
+            } else {
+                row[0] = 0;
+                address_t fixed = &row[1];
+                fixed[0] = row_length;
+                fixed[1] = 0;
+                for (uint32_t i = 0; i < row_length; i++) {
+                    uint32_t weight = _rng_next() & 0xFF;
+                    uint32_t delay = 1 + (_rng_next() % 15);
+                    uint32_t type = _rng_next() % n_synapse_types;
+                    fixed[2 + i] = (weight << 16)
+                        | (delay << type_index_bits)
+                        | (type << index_bits)
+                        | (_rng_next() % n_neurons);
+                }
+            }
+        }
+
+        uint32_t block_bytes = SOURCES_PER_POPULATION
+            * (words + N_SYNAPSE_ROW_HEADER_WORDS) * sizeof(uint32_t);
+        offset += (block_bytes + 15) & ~15u;
+    }
+}
+
+//! \brief Reads or generates the spikes to replay
+static timed_spike *_make_spikes(
+        const benchmark_options *options, uint32_t *n_spikes) {
+    uint32_t capacity = 1024;
+    uint32_t n = 0;
+    timed_spike *spikes = malloc(capacity * sizeof(timed_spike));
+
+    if (options->spike_file != NULL) {
+        FILE *file = fopen(options->spike_file, "r");
+        if (file == NULL) {
+            fprintf(stderr, "Could not open %s\n", options->spike_file);
+            exit(1);
+        }
+        char line[256];
+        while (fgets(line, sizeof(line), file) != NULL) {
+            char *end;
+            uint32_t tick = strtoul(line, &end, 0);
+            if (end == line) {
+                continue;
+            }
+            char *key_start = end;
+            uint32_t key = strtoul(key_start, &end, 0);
+            if (end == key_start) {
+                continue;
+            }
+            if (n == capacity) {
+                capacity *= 2;
+                spikes = realloc(spikes, capacity * sizeof(timed_spike));
+            }
+            spikes[n].tick = tick;
+            spikes[n].key = key;
+            n++;
+        }
+        fclose(file);
+    } else {
+        uint32_t threshold = (uint32_t) (
+            (options->rate_hz / 1000.0) * 4294967295.0);
+        for (uint32_t t = 0; t < options->n_ticks; t++) {
+            for (uint32_t s = 0; s < options->n_sources; s++) {
+                if (_rng_next() < threshold) {
+                    if (n == capacity) {
+                        capacity *= 2;
+                        spikes = realloc(
+                            spikes, capacity * sizeof(timed_spike));
+                    }
+                    spikes[n].tick = t;
+                    spikes[n].key = _source_key(s);
+                    n++;
+                }
+            }
+        }
+    }
+    *n_spikes = n;
+    return spikes;
+}
+
+static inline double _per(uint64_t total, uint64_t count) {
+    return (count == 0) ? 0.0 : (double) total / (double) count;
+}
+
+int main(int argc, char **argv) {
+    benchmark_options options;
+    _parse_options(argc, argv, &options);
+    rng_state = (options.seed == 0) ? 1 : options.seed;
+
+    neuron_params params;
+    _read_neuron_params(options.params_file, &params);
+    options.n_neurons = params.n_neurons;
+
+    host_initialise(ARENA_BYTES);
+
+    // Build the data regions of the core
+    uint32_t n_synapse_types = params.n_synapse_types;
+    address_t neuron_region = _make_neuron_region(&options, &params);
+    free(params.words);
+    address_t synapse_params_region = host_sdram_alloc(
+        (n_synapse_types + 1) * sizeof(uint32_t));
+    synapse_params_region[n_synapse_types] = options.n_dma_buffers;
+    address_t direct_matrix_region = host_sdram_alloc(sizeof(uint32_t));
+    address_t synapse_dynamics_region = host_sdram_alloc(
+        SYNAPSE_DYNAMICS_REGION_BYTES);
+    address_t table_region, matrix_region;
+    uint32_t n_plastic_populations;
+    _make_synaptic_regions(
+        &options, n_synapse_types, &table_region, &matrix_region,
+        &n_plastic_populations);
+
+    // Initialise the model in the same way as c_main.c
+    uint32_t n_neurons, n_types, incoming_spike_buffer_size, timer_offset;
+    if (!neuron_initialise(
+            neuron_region, &n_neurons, &n_types, &incoming_spike_buffer_size,
+            &timer_offset)) {
+        fprintf(stderr, "Neuron initialisation failed\n");
+        return 1;
+    }
+    uint32_t *ring_buffer_to_input_left_shifts;
+    address_t direct_synapses_address = NULL;
+    uint32_t n_dma_buffers;
+    if (!synapses_initialise(
+            synapse_params_region, direct_matrix_region, n_neurons, n_types,
+            &ring_buffer_to_input_left_shifts, &direct_synapses_address,
+            &n_dma_buffers)) {
+        fprintf(stderr, "Synapse initialisation failed\n");
+        return 1;
+    }
+    uint32_t row_max_n_words;
+    if (!population_table_initialise(
+            table_region, matrix_region, direct_synapses_address,
+            &row_max_n_words)) {
+        fprintf(stderr, "Population table initialisation failed\n");
+        return 1;
+    }
+    if (synapse_dynamics_initialise(
+            synapse_dynamics_region, n_neurons, n_types,
+            ring_buffer_to_input_left_shifts) == NULL) {
+        fprintf(stderr, "Synapse dynamics initialisation failed\n");
+        return 1;
+    }
+    // Structural plasticity is not initialised; rewiring is not measured
+    if (!spike_processing_initialise(
+            row_max_n_words, n_dma_buffers, -1, 0,
+            incoming_spike_buffer_size)) {
+        fprintf(stderr, "Spike processing initialisation failed\n");
+        return 1;
+    }
+    profiler_init(NULL);
+
+    uint32_t n_spikes;
+    timed_spike *spikes = _make_spikes(&options, &n_spikes);
+
+    // Run the timesteps
+    uint64_t ring_buffer_cycles = 0;
+    uint64_t neuron_cycles = 0;
+    uint64_t spike_cycles = 0;
+    uint32_t next_spike = 0;
+    for (uint32_t t = 0; t < options.n_ticks; t++) {
+        time = t;
+
+        uint64_t start = host_cycles();
+        synapses_do_timestep_update(time);
+        uint64_t middle = host_cycles();
+        neuron_do_timestep_update(time, ticks + 1, 1000);
+        uint64_t end = host_cycles();
+        ring_buffer_cycles += middle - start;
+        neuron_cycles += end - middle;
+
+        // Complete any recording
+        host_run_pending_events();
+
+        // Deliver the spikes, either each to completion or all together so
+        // that they queue up as they would with bursty input
+        start = host_cycles();
+        while (next_spike < n_spikes && spikes[next_spike].tick <= t) {
+            host_deliver_mc_packet(spikes[next_spike].key, 0, false);
+            if (!options.burst) {
+                host_run_pending_events();
+            }
+            next_spike++;
+        }
+        host_run_pending_events();
+        spike_cycles += host_cycles() - start;
+    }
+
+    uint32_t n_plastic_events =
+        synapse_dynamics_get_plastic_pre_synaptic_events();
+    uint32_t n_fixed_events =
+        synapses_get_pre_synaptic_events() - n_plastic_events;
+    uint64_t n_neuron_updates = (uint64_t) n_neurons * options.n_ticks;
+    double fixed_per_event = _per(
+        host_profiler_cycles(PROFILER_PROCESS_FIXED_SYNAPSES),
+        n_fixed_events);
+    double plastic_per_event = _per(
+        host_profiler_cycles(PROFILER_PROCESS_PLASTIC_SYNAPSES),
+        n_plastic_events);
+    double per_lookup = _per(
+        host_profiler_cycles(PROFILER_POP_TABLE_LOOKUP),
+        host_profiler_count(PROFILER_POP_TABLE_LOOKUP));
+    double per_spike = _per(spike_cycles, next_spike);
+    double ring_buffer_per_neuron = _per(ring_buffer_cycles, n_neuron_updates);
+    double neuron_per_update = _per(neuron_cycles, n_neuron_updates);
+    const char *units = host_cycle_units();
+
+    printf("%s: %u neurons, %u sources (%u of %u populations plastic), "
+        "%u synapses per row, %u timesteps\n",
+        HOST_APP_NAME, n_neurons, options.n_sources, n_plastic_populations,
+        (options.n_sources + SOURCES_PER_POPULATION - 1)
+            / SOURCES_PER_POPULATION,
+        options.row_length, options.n_ticks);
+    printf("    spikes replayed:              %u (%u DMAs, %u overflows, "
+        "%u dropped by bit field)\n",
+        next_spike, host_n_dmas(), spike_processing_get_buffer_overflows(),
+        population_table_get_filtered_packets());
+    printf("    synaptic events:              %u fixed, %u plastic\n",
+        n_fixed_events, n_plastic_events);
+    printf("    _process_fixed_synapses:      %.1f %s per synaptic event\n",
+        fixed_per_event, units);
+    printf("    process_plastic_synapses:     %.1f %s per synaptic event\n",
+        plastic_per_event, units);
+    printf("    population table lookup:      %.1f %s per lookup\n",
+        per_lookup, units);
+    printf("    spike processing:             %.1f %s per spike\n",
+        per_spike, units);
+    printf("    synapses_do_timestep_update:  %.1f %s per neuron\n",
+        ring_buffer_per_neuron, units);
+    printf("    neuron_do_timestep_update:    %.1f %s per neuron update\n",
+        neuron_per_update, units);
+#if EVENT_DRIVEN_NEURONS
+    printf("    neuron updates skipped:       %.4f of neuron timesteps\n",
+        _per(neuron_get_n_updates_skipped(), n_neuron_updates));
+#endif
+    printf("    output spikes:                %.4f per neuron per timestep\n",
+        _per(host_n_packets_sent(), n_neuron_updates));
+    printf("BENCHMARK,%s,%s,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n",
+        HOST_APP_NAME, units, fixed_per_event, plastic_per_event, per_spike,
+        ring_buffer_per_neuron, neuron_per_update, per_lookup);
+
+    free(spikes);
+    return 0;
+}
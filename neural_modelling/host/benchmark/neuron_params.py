@@ -0,0 +1,99 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+""" Writes the neuron model parameters of a neuron binary, with the default\
+    values of its PyNN model, in the form read by the -P option of the host\
+    neuron benchmark (see makefiles/neuron/host_build.mk): the number of\
+    neurons and of synapse types, followed by the words that the tools write\
+    after the recording parameters in the neuron parameter region.
+
+    usage: neuron_params.py <app> <n_neurons> <output> [<timestep_us>]
+
+    The model is the one in spynnaker.pyNN.models.neuron.builds whose binary\
+    name is the longest prefix of <app>, so the plastic builds of a model\
+    get the parameters of the model itself.  Models that cannot be created\
+    without arguments (such as those controlling external devices) are not\
+    supported.
+"""
+
+import inspect
+import sys
+import numpy
+from pacman.executor.injection_decorator import (
+    clear_injectables, provide_injectables)
+from pacman.model.graphs.common import Slice
+from spynnaker.pyNN.models.neuron import AbstractPyNNNeuronModel
+from spynnaker.pyNN.models.neuron import builds
+from spynnaker.pyNN.utilities.ranged import SpynnakerRangeDictionary
+
+
+def find_model(app):
+    """ Find the model of a binary, created with its default parameters
+
+    :param app: The name of the binary, without the extension
+    :rtype: AbstractNeuronImpl
+    """
+    best = None
+    best_length = 0
+    for _, cls in inspect.getmembers(builds, inspect.isclass):
+        if not issubclass(cls, AbstractPyNNNeuronModel):
+            continue
+        impl = cls()._model
+        name = impl.binary_name.split(".")[0]
+        if ((app == name or app.startswith(name + "_")) and
+                len(name) > best_length):
+            best = impl
+            best_length = len(name)
+    if best is None:
+        raise ValueError("No neuron model has a binary matching " + app)
+    return best
+
+
+def get_neuron_params(app, n_neurons, timestep_us=1000):
+    """ Get the contents of the neuron parameter file of a binary
+
+    :rtype: numpy array of uint32
+    """
+    impl = find_model(app)
+    parameters = SpynnakerRangeDictionary(n_neurons)
+    state_variables = SpynnakerRangeDictionary(n_neurons)
+    impl.add_parameters(parameters)
+    impl.add_state_variables(state_variables)
+    provide_injectables({"MachineTimeStep": timestep_us})
+    try:
+        data = impl.get_data(
+            parameters, state_variables, Slice(0, n_neurons - 1))
+    finally:
+        clear_injectables()
+    header = numpy.array(
+        [n_neurons, impl.get_n_synapse_types()], dtype="uint32")
+    return numpy.concatenate([header, data])
+
+
+def main(argv):
+    if len(argv) not in (4, 5):
+        sys.exit("usage: {} <app> <n_neurons> <output> [<timestep_us>]"
+                 .format(argv[0]))
+    timestep_us = int(argv[4]) if len(argv) == 5 else 1000
+    n_neurons = int(argv[2])
+    if not 0 < n_neurons <= 256:
+        sys.exit("The benchmark runs between 1 and 256 neurons")
+    data = get_neuron_params(argv[1], n_neurons, timestep_us)
+    with open(argv[3], "wb") as f:
+        f.write(data.astype("<u4").tobytes())
+
+
+if __name__ == "__main__":
+    main(sys.argv)
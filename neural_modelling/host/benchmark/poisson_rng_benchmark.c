@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host microbenchmark of the random variates of the Poisson source
+ *
+ *  The variates used by spike_source_poisson.c (exponential inter-spike
+ *  intervals of slow sources, Poisson counts of fast sources and Gaussian
+ *  counts of faster sources) are drawn both one at a time, as the source
+ *  did before, and from a random_buffer_t.  For the buffered variates, the
+ *  time taken to fill the buffers (which the source does once its spikes
+ *  have been sent) is reported apart from the time taken to use them (which
+ *  is what the sources see), as well as the total.
+ *
+ *  The stand-in exponential and Gaussian variates of the host random.h are
+ *  computed in double precision, so only the relative costs of the paths,
+ *  not the absolute costs, say anything of the SpiNNaker library versions.
+ *
+ *      poisson_rng_benchmark [-n variates] [-l lambda]
+ */
+
+// The SpiNNaker headers must come before the system ones (see
+// common-typedefs.h)
+#include <common/maths-util.h>
+#include <common/random_buffer.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+
+//! The scale of the inter-spike intervals, as in spike_source_poisson.c
+#define ISI_SCALE_FACTOR 1000
+
+//! The number of variates of each kind drawn by default
+#define DEFAULT_N_VARIATES 1000000
+
+//! The mean number of spikes per tick of a fast source by default
+#define DEFAULT_LAMBDA 0.5
+
+//! The generator of all the variates
+static mars_kiss64_seed_t seed = {12345, 67890, 13579, 24680};
+
+//! The buffers being benchmarked
+static random_buffer_t buffer;
+
+//! The sum of the variates, printed so they are not optimised away
+static uint32_t sink;
+
+//! The time taken by each path
+typedef struct path_time {
+    double fill_seconds;
+    double take_seconds;
+} path_time;
+
+/* PRIVATE FUNCTIONS */
+
+static inline double _seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + (now.tv_nsec * 1e-9);
+}
+
+static path_time _single_exponentials(uint32_t n_variates) {
+    double start = _seconds();
+    for (uint32_t i = 0; i < n_variates; i++) {
+        sink += (uint32_t) (exponential_dist_variate(mars_kiss64_seed, seed)
+            * ISI_SCALE_FACTOR);
+    }
+    return (path_time) {0.0, _seconds() - start};
+}
+
+static path_time _single_poissons(
+        uint32_t n_variates, UFRACT exp_minus_lambda) {
+    double start = _seconds();
+    for (uint32_t i = 0; i < n_variates; i++) {
+        sink += poisson_dist_variate_exp_minus_lambda(
+            mars_kiss64_seed, seed, exp_minus_lambda);
+    }
+    return (path_time) {0.0, _seconds() - start};
+}
+
+static path_time _single_gaussians(uint32_t n_variates) {
+    double start = _seconds();
+    for (uint32_t i = 0; i < n_variates; i++) {
+        sink += bitsk(
+            gaussian_dist_variate(mars_kiss64_seed, seed) * REAL_CONST(0.5));
+    }
+    return (path_time) {0.0, _seconds() - start};
+}
+
+//! \brief Time the buffered variates of one kind, filling the buffers
+//!        between batches as the source does between ticks
+#define BUFFERED_PATH(fill, take) ({ \
+    path_time time = {0.0, 0.0}; \
+    for (uint32_t done = 0; done < n_variates; done += RANDOM_BUFFER_SIZE) { \
+        double start = _seconds(); \
+        fill(&buffer); \
+        double middle = _seconds(); \
+        for (uint32_t i = 0; i < RANDOM_BUFFER_SIZE; i++) { \
+            sink += take; \
+        } \
+        time.fill_seconds += middle - start; \
+        time.take_seconds += _seconds() - middle; \
+    } \
+    time; \
+})
+
+static path_time _buffered_exponentials(uint32_t n_variates) {
+    return BUFFERED_PATH(random_buffer_fill_exponentials,
+        random_buffer_exponential(&buffer));
+}
+
+static path_time _buffered_poissons(
+        uint32_t n_variates, UFRACT exp_minus_lambda) {
+    // The uniforms used are refilled as needed within the batch
+    return BUFFERED_PATH(random_buffer_fill_uniforms,
+        random_buffer_poisson_exp_minus_lambda(&buffer, exp_minus_lambda));
+}
+
+static path_time _buffered_gaussians(uint32_t n_variates) {
+    return BUFFERED_PATH(random_buffer_fill_gaussians,
+        bitsk(random_buffer_gaussian(&buffer)));
+}
+
+static void _report(
+        const char *name, uint32_t n_variates, path_time single,
+        path_time buffered) {
+    double single_rate = n_variates / single.take_seconds;
+    double take_rate = n_variates / buffered.take_seconds;
+    double total_rate =
+        n_variates / (buffered.fill_seconds + buffered.take_seconds);
+    printf("    %-12s one at a time %12.0f/s, buffered %12.0f/s "
+        "(%12.0f/s with fills), %.2fx\n",
+        name, single_rate, take_rate, total_rate, take_rate / single_rate);
+    printf("BENCHMARK,poisson_rng,%s,%.0f,%.0f,%.0f\n",
+        name, single_rate, take_rate, total_rate);
+}
+
+static void _usage(const char *program) {
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -n <variates>     variates of each kind to draw (default %u)\n"
+        "  -l <lambda>       mean spikes per tick of fast sources "
+        "(default %.1f)\n",
+        program, DEFAULT_N_VARIATES, DEFAULT_LAMBDA);
+    exit(1);
+}
+
+/* MAIN */
+
+int main(int argc, char *argv[]) {
+    uint32_t n_variates = DEFAULT_N_VARIATES;
+    double lambda = DEFAULT_LAMBDA;
+    int option;
+    while ((option = getopt(argc, argv, "n:l:h")) != -1) {
+        switch (option) {
+        case 'n':
+            n_variates = strtoul(optarg, NULL, 0);
+            break;
+        case 'l':
+            lambda = strtod(optarg, NULL);
+            break;
+        default:
+            _usage(argv[0]);
+        }
+    }
+    if (n_variates == 0 || lambda <= 0.0) {
+        _usage(argv[0]);
+    }
+    UFRACT exp_minus_lambda = (UFRACT) EXP(-((REAL) lambda));
+
+    validate_mars_kiss64_seed(seed);
+    random_buffer_initialize(&buffer, seed, ISI_SCALE_FACTOR, REAL_CONST(0.5));
+
+    printf("poisson_rng: %u variates of each kind, lambda %.2f, "
+        "buffers of %u\n", n_variates, lambda, RANDOM_BUFFER_SIZE);
+    _report("exponential", n_variates, _single_exponentials(n_variates),
+        _buffered_exponentials(n_variates));
+    _report("poisson", n_variates,
+        _single_poissons(n_variates, exp_minus_lambda),
+        _buffered_poissons(n_variates, exp_minus_lambda));
+    _report("gaussian", n_variates, _single_gaussians(n_variates),
+        _buffered_gaussians(n_variates));
+    printf("    (checksum %u)\n", sink);
+    return 0;
+}
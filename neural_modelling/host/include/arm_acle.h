@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Portable C versions of the ARM DSP multiply intrinsics
+ *
+ *  The b/t suffixes select the bottom or top signed 16-bit half of each
+ *  operand, as for the ARMv5TE SMULxy and SMLAxy instructions.
+ */
+
+#ifndef __HOST_ARM_ACLE_H__
+#define __HOST_ARM_ACLE_H__
+
+#include <stdint.h>
+
+#define __host_bottom(x) ((int32_t) (int16_t) (x))
+#define __host_top(x)    ((int32_t) ((int32_t) (x) >> 16))
+
+static inline int32_t __smulbb(int32_t x, int32_t y) {
+    return __host_bottom(x) * __host_bottom(y);
+}
+
+static inline int32_t __smulbt(int32_t x, int32_t y) {
+    return __host_bottom(x) * __host_top(y);
+}
+
+static inline int32_t __smultb(int32_t x, int32_t y) {
+    return __host_top(x) * __host_bottom(y);
+}
+
+static inline int32_t __smultt(int32_t x, int32_t y) {
+    return __host_top(x) * __host_top(y);
+}
+
+static inline int32_t __smlabb(int32_t x, int32_t y, int32_t acc) {
+    return acc + __smulbb(x, y);
+}
+
+static inline int32_t __smlabt(int32_t x, int32_t y, int32_t acc) {
+    return acc + __smulbt(x, y);
+}
+
+static inline int32_t __smlatb(int32_t x, int32_t y, int32_t acc) {
+    return acc + __smultb(x, y);
+}
+
+static inline int32_t __smlatt(int32_t x, int32_t y, int32_t acc) {
+    return acc + __smultt(x, y);
+}
+
+#endif // __HOST_ARM_ACLE_H__
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the spinn_common bit_field.h
+ */
+
+#ifndef __HOST_BIT_FIELD_H__
+#define __HOST_BIT_FIELD_H__
+
+#include <common-typedefs.h>
+#include <sark.h>
+
+typedef uint32_t *bit_field_t;
+
+static inline bool bit_field_test(bit_field_t b, index_t n) {
+    return (b[n >> 5] & (1u << (n & 0x1F))) != 0;
+}
+
+static inline void bit_field_set(bit_field_t b, index_t n) {
+    b[n >> 5] |= (1u << (n & 0x1F));
+}
+
+static inline void bit_field_clear(bit_field_t b, index_t n) {
+    b[n >> 5] &= ~(1u << (n & 0x1F));
+}
+
+//! \brief The number of words needed to hold a bit field of s bits
+static inline size_t get_bit_field_size(size_t s) {
+    return (s + 31) >> 5;
+}
+
+static inline void clear_bit_field(bit_field_t b, size_t s) {
+    for (index_t i = 0; i < s; i++) {
+        b[i] = 0;
+    }
+}
+
+static inline bool empty_bit_field(bit_field_t b, size_t s) {
+    for (index_t i = 0; i < s; i++) {
+        if (b[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static inline bool nonempty_bit_field(bit_field_t b, size_t s) {
+    return !empty_bit_field(b, s);
+}
+
+static inline void print_bit_field(bit_field_t b, size_t s) {
+    for (index_t i = 0; i < s; i++) {
+        io_printf(IO_BUF, "%08x\n", b[i]);
+    }
+}
+
+#endif // __HOST_BIT_FIELD_H__
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the spinnaker_tools circular_buffer.h
+ *
+ *  The buffer holds a power of two number of slots, one of which is always
+ *  left empty to tell a full buffer from an empty one.
+ */
+
+#ifndef __HOST_CIRCULAR_BUFFER_H__
+#define __HOST_CIRCULAR_BUFFER_H__
+
+#include <common-typedefs.h>
+#include <sark.h>
+
+typedef struct _circular_buffer {
+    //! The mask to apply to an index (the number of slots - 1)
+    uint32_t buffer_size;
+    //! The index of the next item to be read
+    uint32_t output;
+    //! The index of the next slot to be written
+    uint32_t input;
+    //! The number of items that could not be added as the buffer was full
+    uint32_t overflows;
+    uint32_t buffer[];
+} _circular_buffer, *circular_buffer;
+
+static inline circular_buffer circular_buffer_initialize(uint32_t size) {
+    uint32_t real_size = size;
+    if ((real_size & (real_size - 1)) != 0) {
+        real_size |= real_size >> 1;
+        real_size |= real_size >> 2;
+        real_size |= real_size >> 4;
+        real_size |= real_size >> 8;
+        real_size |= real_size >> 16;
+        real_size += 1;
+    }
+    circular_buffer buffer = (circular_buffer) sark_alloc(
+        1, sizeof(_circular_buffer) + (real_size * sizeof(uint32_t)));
+    if (buffer == NULL) {
+        return NULL;
+    }
+    buffer->buffer_size = real_size - 1;
+    buffer->input = 0;
+    buffer->output = 0;
+    buffer->overflows = 0;
+    return buffer;
+}
+
+static inline uint32_t circular_buffer_real_size(circular_buffer buffer) {
+    return buffer->buffer_size;
+}
+
+static inline uint32_t circular_buffer_next(
+        circular_buffer buffer, uint32_t index) {
+    return (index + 1) & buffer->buffer_size;
+}
+
+static inline bool circular_buffer_not_empty(circular_buffer buffer) {
+    return buffer->input != buffer->output;
+}
+
+static inline bool circular_buffer_add(circular_buffer buffer, uint32_t item) {
+    uint32_t next = circular_buffer_next(buffer, buffer->input);
+    if (next == buffer->output) {
+        buffer->overflows++;
+        return false;
+    }
+    buffer->buffer[buffer->input] = item;
+    buffer->input = next;
+    return true;
+}
+
+static inline bool circular_buffer_get_next(
+        circular_buffer buffer, uint32_t *item) {
+    if (!circular_buffer_not_empty(buffer)) {
+        return false;
+    }
+    *item = buffer->buffer[buffer->output];
+    buffer->output = circular_buffer_next(buffer, buffer->output);
+    return true;
+}
+
+static inline bool circular_buffer_advance_if_next_equals(
+        circular_buffer buffer, uint32_t item) {
+    if (circular_buffer_not_empty(buffer)
+            && buffer->buffer[buffer->output] == item) {
+        buffer->output = circular_buffer_next(buffer, buffer->output);
+        return true;
+    }
+    return false;
+}
+
+static inline uint32_t circular_buffer_size(circular_buffer buffer) {
+    return (buffer->input - buffer->output) & buffer->buffer_size;
+}
+
+static inline uint32_t circular_buffer_get_n_buffer_overflows(
+        circular_buffer buffer) {
+    return buffer->overflows;
+}
+
+static inline void circular_buffer_clear(circular_buffer buffer) {
+    buffer->input = 0;
+    buffer->output = 0;
+    buffer->overflows = 0;
+}
+
+static inline uint32_t circular_buffer_input(circular_buffer buffer) {
+    return buffer->input;
+}
+
+static inline uint32_t circular_buffer_output(circular_buffer buffer) {
+    return buffer->output;
+}
+
+static inline uint32_t circular_buffer_value_at_index(
+        circular_buffer buffer, uint32_t index) {
+    return buffer->buffer[index & buffer->buffer_size];
+}
+
+static inline void circular_buffer_print_buffer(circular_buffer buffer) {
+    io_printf(IO_BUF, "Buffer: input = %u, output = %u elements = {",
+        buffer->input, buffer->output);
+    for (uint32_t i = buffer->output; i != buffer->input;
+            i = circular_buffer_next(buffer, i)) {
+        io_printf(IO_BUF, " %u", buffer->buffer[i]);
+    }
+    io_printf(IO_BUF, " }\n");
+}
+
+#endif // __HOST_CIRCULAR_BUFFER_H__
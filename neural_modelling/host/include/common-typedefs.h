@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the spinnaker_tools common-typedefs.h
+ *
+ *  Only the types used by the neural_modelling sources are provided.  This
+ *  header must be included before any system header so that the SpiNNaker
+ *  meanings of timer_t and key_t win over the POSIX ones.
+ */
+
+#ifndef __COMMON_TYPEDEFS_H__
+#define __COMMON_TYPEDEFS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Stop glibc from declaring its own (incompatible) versions of these
+#define __timer_t_defined 1
+#define __key_t_defined 1
+
+typedef unsigned int uint;
+typedef unsigned short ushort;
+typedef unsigned char uchar;
+
+typedef uint32_t *address_t;
+typedef uint32_t timer_t;
+typedef uint32_t counter_t;
+typedef uint32_t index_t;
+
+#define __int_t(n) __int_t_(n)
+#define __int_t_(n) int ## n ## _t
+#define __uint_t(n) __uint_t_(n)
+#define __uint_t_(n) uint ## n ## _t
+
+//! \brief Marks a variable as used to avoid compiler warnings
+#define use(x) do {} while ((x) != (x))
+
+#define UNUSED __attribute__((__unused__))
+
+#endif // __COMMON_TYPEDEFS_H__
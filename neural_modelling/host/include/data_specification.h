@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the front end common data_specification.h
+ *
+ *  Only the c_main files read their regions, so this is declared for the
+ *  tests that include one, which define it themselves (see simulation.h).
+ */
+
+#ifndef __HOST_DATA_SPECIFICATION_H__
+#define __HOST_DATA_SPECIFICATION_H__
+
+#include <common-typedefs.h>
+
+typedef struct data_specification_metadata_t data_specification_metadata_t;
+
+data_specification_metadata_t *data_specification_get_data_address(void);
+
+bool data_specification_read_header(data_specification_metadata_t *ds_regions);
+
+address_t data_specification_get_region(
+    uint32_t region, data_specification_metadata_t *ds_regions);
+
+#endif // __HOST_DATA_SPECIFICATION_H__
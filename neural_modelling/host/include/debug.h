@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the spinnaker_tools debug.h logging macros
+ *
+ *  Messages go to stderr.  Note that the host io_printf does not understand
+ *  the SpiNNaker "%k" (accum) conversion, so debug builds will print those
+ *  values incorrectly.
+ */
+
+#ifndef __DEBUG_H__
+#define __DEBUG_H__
+
+#include <spin1_api.h>
+
+#define LOG_ERROR   10
+#define LOG_WARNING 20
+#define LOG_INFO    30
+#define LOG_DEBUG   40
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_INFO
+#endif
+
+#define __log(level, name, message, ...) \
+    do { \
+        if (LOG_LEVEL >= (level)) { \
+            io_printf(IO_BUF, "[" name "] (%s: %d): " message "\n", \
+                __FILE__, __LINE__, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+#define log_error(message, ...) \
+    __log(LOG_ERROR, "ERROR", message, ##__VA_ARGS__)
+#define log_warning(message, ...) \
+    __log(LOG_WARNING, "WARNING", message, ##__VA_ARGS__)
+#define log_info(message, ...) \
+    __log(LOG_INFO, "INFO", message, ##__VA_ARGS__)
+#define log_debug(message, ...) \
+    __log(LOG_DEBUG, "DEBUG", message, ##__VA_ARGS__)
+
+#if defined(PRODUCTION_CODE) || defined(NDEBUG)
+#define assert(assertion) do {} while (0)
+#define assert_info(assertion, message, ...) do {} while (0)
+#else
+#define assert(assertion) \
+    do { \
+        if (!(assertion)) { \
+            io_printf(IO_BUF, "[ASSERT] (%s: %d): %s\n", \
+                __FILE__, __LINE__, #assertion); \
+            rt_error(RTE_SWERR); \
+        } \
+    } while (0)
+#define assert_info(assertion, message, ...) \
+    do { \
+        if (!(assertion)) { \
+            log_error(message, ##__VA_ARGS__); \
+            rt_error(RTE_SWERR); \
+        } \
+    } while (0)
+#endif
+
+#endif // __DEBUG_H__
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Control of the host stand-in for the SpiNNaker run-time, for use
+ *         by the benchmark runners.
+ *
+ *  The models store addresses in 32-bit words, so all memory handed to them
+ *  (by spin1_malloc, sark_alloc and host_sdram_alloc) comes from a single
+ *  arena mapped below 4GB.
+ */
+
+#ifndef __HOST_API_H__
+#define __HOST_API_H__
+
+#include <common-typedefs.h>
+#include <spin1_api.h>
+
+//! \brief Maps the memory arena and resets all host state.
+//! \param[in] arena_bytes The size of the arena to map
+void host_initialise(uint32_t arena_bytes);
+
+//! \brief Allocates zeroed memory to stand in for SDRAM
+//! \param[in] n_bytes The number of bytes to allocate
+//! \return The (16-byte aligned) memory; does not return on failure
+void *host_sdram_alloc(uint32_t n_bytes);
+
+//! \brief Delivers a multicast packet to the registered callback
+//! \param[in] key The key of the packet
+//! \param[in] payload The payload of the packet
+//! \param[in] has_payload True if the packet is to have a payload
+void host_deliver_mc_packet(uint key, uint payload, bool has_payload);
+
+//! \brief Runs queued events (DMA completions, user events, recording
+//!        completions) until no more are queued
+void host_run_pending_events(void);
+
+//! \brief Reads the host cycle counter
+//! \return The current count
+uint64_t host_cycles(void);
+
+//! \brief The units of host_cycles()
+//! \return A string naming the units ("cycles" or "ns")
+const char *host_cycle_units(void);
+
+//! \brief Resets the accumulated profiler totals
+void host_profiler_reset(void);
+
+//! \brief Gets the total host cycles spent between enter and exit of a tag
+//! \param[in] tag The profiler tag
+//! \return The total
+uint64_t host_profiler_cycles(uint32_t tag);
+
+//! \brief Gets the number of enter/exit pairs seen for a tag
+//! \param[in] tag The profiler tag
+//! \return The count
+uint32_t host_profiler_count(uint32_t tag);
+
+//! \brief Gets the number of multicast packets sent by the model
+//! \return The count
+uint32_t host_n_packets_sent(void);
+
+//! \brief Sets a function to be called with the key and payload of each
+//!        multicast packet sent by the model, until host_initialise is next
+//!        called
+//! \param[in] callback The function, or NULL for none
+void host_on_mc_packet_sent(callback_t callback);
+
+//! \brief Gets the number of DMA transfers started by the model
+//! \return The count
+uint32_t host_n_dmas(void);
+
+//! \brief Gets the number of bytes recorded on a channel
+//! \param[in] channel The recording channel
+//! \return The number of bytes
+uint32_t host_n_recorded_bytes(uint8_t channel);
+
+#endif // __HOST_API_H__
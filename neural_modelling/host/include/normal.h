@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the spinn_common normal.h, computed in double
+ *         precision by bisection.  Cycle counts of models that call
+ *         norminv_urt() are therefore not representative of the SpiNNaker
+ *         library version.
+ */
+
+#ifndef __HOST_NORMAL_H__
+#define __HOST_NORMAL_H__
+
+#include <stdint.h>
+#include <stdfix-full-iso.h>
+
+double erfc(double x);
+
+//! \brief The inverse of the standard normal distribution function at a
+//!        uniformly distributed 0.32 value
+static inline accum norminv_urt(uint32_t x) {
+    double p = ((double) x + 0.5) / 4294967296.0;
+    double low = -8.0, high = 8.0;
+    for (uint32_t i = 0; i < 48; i++) {
+        double mid = (low + high) / 2.0;
+        if (0.5 * erfc(-mid / 1.4142135623730951) < p) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return kbits((int_k_t) (((low + high) / 2.0) * 32768.0));
+}
+
+#endif // __HOST_NORMAL_H__
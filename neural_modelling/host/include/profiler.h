@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the front end common profiler.h
+ *
+ *  Rather than logging samples to SDRAM, each enter/exit pair of a tag adds
+ *  the elapsed host cycles to a per-tag total, which the benchmark runners
+ *  read with host_profiler_cycles() and host_profiler_count().
+ */
+
+#ifndef __HOST_PROFILER_H__
+#define __HOST_PROFILER_H__
+
+#include <common-typedefs.h>
+
+#define PROFILER_ENTER 0x80000000
+#define PROFILER_EXIT  0
+
+//! The number of distinct tags that can be profiled on the host
+#define PROFILER_N_TAGS 32
+
+void profiler_init(uint32_t *data_region);
+
+void profiler_finalise(void);
+
+#ifdef PROFILER_ENABLED
+
+void profiler_write_entry(uint32_t tag);
+
+#define profiler_write_entry_disable_irq_fiq(tag) profiler_write_entry(tag)
+#define profiler_write_entry_disable_fiq(tag) profiler_write_entry(tag)
+
+#else // PROFILER_ENABLED
+
+#define profiler_write_entry(tag)
+#define profiler_write_entry_disable_irq_fiq(tag)
+#define profiler_write_entry_disable_fiq(tag)
+
+#endif // PROFILER_ENABLED
+
+#endif // __HOST_PROFILER_H__
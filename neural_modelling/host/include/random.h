@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the Marsaglia KISS generators of the spinn_common
+ *         random.h
+ */
+
+#ifndef __HOST_RANDOM_H__
+#define __HOST_RANDOM_H__
+
+#include <stdint.h>
+#include <stdfix-full-iso.h>
+#include <normal.h>
+
+double log(double x);
+
+typedef uint32_t mars_kiss64_seed_t[4];
+
+//! A generator of uniformly distributed words from a seed
+typedef uint32_t (*uniform_rng)(uint32_t *seed);
+
+//! \brief KISS 64 generator with a caller-held seed
+uint32_t mars_kiss64_seed(mars_kiss64_seed_t seed);
+
+//! \brief Make sure a seed is usable by mars_kiss64_seed()
+void validate_mars_kiss64_seed(mars_kiss64_seed_t seed);
+
+//! \brief KISS 64 generator with a library-held seed
+uint32_t mars_kiss64_simp(void);
+
+//! \brief An exponentially distributed value of mean 1, computed in double
+//!        precision
+static inline accum exponential_dist_variate(
+        uniform_rng uni_rng, uint32_t *seed_arg) {
+    double uniform = ((double) uni_rng(seed_arg) + 1.0) / 4294967296.0;
+    return kbits((int_k_t) (-log(uniform) * 32768.0));
+}
+
+//! \brief A normally distributed value of mean 0 and standard deviation 1
+static inline accum gaussian_dist_variate(
+        uniform_rng uni_rng, uint32_t *seed_arg) {
+    return norminv_urt(uni_rng(seed_arg));
+}
+
+//! \brief A Poisson distributed value given exp(-lambda), where lambda is the
+//!        mean, by multiplying uniform values until the product falls to
+//!        exp(-lambda)
+static inline uint32_t poisson_dist_variate_exp_minus_lambda(
+        uniform_rng uni_rng, uint32_t *seed_arg,
+        unsigned long fract exp_minus_lambda) {
+    unsigned long fract p = ulrbits(UINT32_MAX);
+    uint32_t k = 0;
+    do {
+        k++;
+        p = p * ulrbits(uni_rng(seed_arg));
+    } while (p > exp_minus_lambda);
+    return k - 1;
+}
+
+#endif // __HOST_RANDOM_H__
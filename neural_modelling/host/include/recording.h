@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the front end common recording.h
+ *
+ *  Recorded data is discarded, but the number of bytes recorded on each
+ *  channel is counted (see host_api.h) and completion callbacks are queued
+ *  as if the recording DMA had finished.
+ */
+
+#ifndef __HOST_RECORDING_H__
+#define __HOST_RECORDING_H__
+
+#include <common-typedefs.h>
+#include <spin1_api.h>
+
+//! The number of recording channels counted on the host
+#define HOST_RECORDING_CHANNELS 16
+
+typedef void (*recording_complete_callback_t) (void);
+
+//! \brief Records some data, calling the callback when the copy completes
+//! \param[in] channel The channel to record to
+//! \param[in] data The data to record
+//! \param[in] size_bytes The number of bytes to record
+//! \param[in] callback The function to call on completion, or NULL
+//! \return True if the data was recorded
+bool recording_record_and_notify(
+    uint8_t channel, void *data, uint32_t size_bytes,
+    recording_complete_callback_t callback);
+
+//! \brief Records some data
+//! \param[in] channel The channel to record to
+//! \param[in] data The data to record
+//! \param[in] size_bytes The number of bytes to record
+//! \return True if the data was recorded
+bool recording_record(uint8_t channel, void *data, uint32_t size_bytes);
+
+/* DEFINED BY THE TESTS THAT INCLUDE A C_MAIN FILE (see simulation.h) */
+
+bool recording_initialize(
+    address_t recording_data_address, uint32_t *recording_flags);
+
+void recording_reset(void);
+
+void recording_finalise(void);
+
+void recording_do_timestep_update(uint32_t time);
+
+#endif // __HOST_RECORDING_H__
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the parts of sark.h used by neural_modelling
+ */
+
+#ifndef __SARK_H__
+#define __SARK_H__
+
+#include <common-typedefs.h>
+
+#define IO_STD ((char *) 0)
+#define IO_BUF ((char *) 1)
+
+//! Run-time error codes (only those used by the models)
+enum rte_codes {
+    RTE_NONE, RTE_RESET, RTE_UNDEF, RTE_SVC, RTE_PABT, RTE_DABT, RTE_IRQ,
+    RTE_FIQ, RTE_VIC, RTE_ABORT, RTE_MALLOC, RTE_DIV0, RTE_EVENT, RTE_SWERR,
+    RTE_IOBUF, RTE_ENABLE, RTE_NULL, RTE_PKT, RTE_TIMER, RTE_API, RTE_VER
+};
+
+//! \brief The parts of the system variables that the models read
+typedef struct sv_t {
+    uint cpu_clk;
+} sv_t;
+
+extern sv_t *sv;
+
+//! The size of the data of an SDP message
+#define SDP_BUF_SIZE 256
+
+//! \brief An SDP message, laid out as in SARK
+typedef struct sdp_msg {
+    struct sdp_msg *next;
+    ushort length;
+    ushort checksum;
+    uchar flags;
+    uchar tag;
+    uchar dest_port;
+    uchar srce_port;
+    ushort dest_addr;
+    ushort srce_addr;
+    ushort cmd_rc;
+    ushort seq;
+    uint arg1;
+    uint arg2;
+    uint arg3;
+    uchar data[SDP_BUF_SIZE];
+    uint _PAD;
+} sdp_msg_t;
+
+void io_printf(char *stream, char *format, ...);
+
+void rt_error(uint code, ...);
+
+void *sark_alloc(uint count, uint size);
+
+void sark_free(void *ptr);
+
+#endif // __SARK_H__
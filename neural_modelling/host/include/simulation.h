@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the front end common simulation.h
+ *
+ *  Only the DMA tag multiplexing used outside of the c_main files is
+ *  provided; the benchmark runners take the place of the c_main files.  The
+ *  rest of the interface is declared for the tests that include a c_main
+ *  file, which define it themselves as they drive the model directly.
+ */
+
+#ifndef __HOST_SIMULATION_H__
+#define __HOST_SIMULATION_H__
+
+#include <common-typedefs.h>
+#include <spin1_api.h>
+
+//! \brief Registers a callback for the completion of DMAs with the given tag
+//! \param[in] tag The DMA tag to register the callback against
+//! \param[in] callback The function to call with (transfer id, tag)
+//! \return True if the callback was registered
+bool simulation_dma_transfer_done_callback_on(uint tag, callback_t callback);
+
+//! \brief Removes the callback for the completion of DMAs with the given tag
+//! \param[in] tag The DMA tag to remove the callback from
+void simulation_dma_transfer_done_callback_off(uint tag);
+
+/* DEFINED BY THE TESTS THAT INCLUDE A C_MAIN FILE */
+
+typedef void (*resume_callback_t) (void);
+
+bool simulation_initialise(
+    address_t address, uint32_t expected_app_magic_number,
+    uint32_t *timer_period, uint32_t *simulation_ticks_pointer,
+    uint32_t *infinite_run_pointer, uint32_t *time_pointer,
+    int sdp_packet_callback_priority, int dma_transfer_complete_priority);
+
+void simulation_set_provenance_data_address(address_t provenance_data_address);
+
+typedef void (*prov_callback_t) (address_t);
+
+void simulation_set_provenance_function(
+    prov_callback_t provenance_function, address_t provenance_data_address);
+
+void simulation_handle_pause_resume(resume_callback_t callback);
+
+void simulation_ready_to_read(void);
+
+bool simulation_sdp_callback_on(uint sdp_port, callback_t sdp_callback);
+
+void simulation_run(void);
+
+#endif // __HOST_SIMULATION_H__
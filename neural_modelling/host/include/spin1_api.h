@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the spin1 API
+ *
+ *  Events are not asynchronous on the host: DMA transfers complete
+ *  immediately and their completion callbacks, user events and recording
+ *  completions are queued and dispatched in order by
+ *  host_run_pending_events() (see host_api.h).  Interrupt control functions
+ *  are no-ops.
+ */
+
+#ifndef __SPIN1_API_H__
+#define __SPIN1_API_H__
+
+#include <common-typedefs.h>
+#include <sark.h>
+#include <arm_acle.h>
+
+#define FALSE 0
+#define TRUE (0 == 0)
+
+// Events
+#define MC_PACKET_RECEIVED   0
+#define DMA_TRANSFER_DONE    1
+#define TIMER_TICK           2
+#define SDP_PACKET_RX        3
+#define USER_EVENT           4
+#define MCPL_PACKET_RECEIVED 5
+#define FR_PACKET_RECEIVED   6
+#define FRPL_PACKET_RECEIVED 7
+#define NUM_EVENTS           8
+
+// DMA directions
+#define DMA_READ  0
+#define DMA_WRITE 1
+
+// Packet payload flags
+#define NO_PAYLOAD   0
+#define WITH_PAYLOAD 1
+
+// Timer 1 registers (only the count is read by the models)
+#define T1_LOAD  0
+#define T1_COUNT 1
+
+typedef void (*callback_t) (uint, uint);
+
+extern volatile uint tc[];
+
+void spin1_callback_on(uint event_id, callback_t cback, int priority);
+
+void spin1_callback_off(uint event_id);
+
+uint spin1_dma_transfer(
+    uint tag, void *system_address, void *tcm_address, uint direction,
+    uint length);
+
+uint spin1_send_mc_packet(uint key, uint data, uint load);
+
+uint spin1_trigger_user_event(uint arg0, uint arg1);
+
+void *spin1_malloc(uint bytes);
+
+void spin1_memcpy(void *dst, void const *src, uint len);
+
+uint spin1_int_disable(void);
+
+uint spin1_irq_disable(void);
+
+uint spin1_fiq_disable(void);
+
+void spin1_mode_restore(uint sr);
+
+void spin1_delay_us(uint n);
+
+void spin1_wfi(void);
+
+void spin1_set_timer_tick(uint time);
+
+void spin1_set_timer_tick_and_phase(uint time, uint phase);
+
+void spin1_msg_free(sdp_msg_t *msg);
+
+#endif // __SPIN1_API_H__
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the spinn_common sqrt.h, computed in double
+ *         precision.
+ */
+
+#ifndef __HOST_SQRT_H__
+#define __HOST_SQRT_H__
+
+#include <stdfix-full-iso.h>
+
+double sqrt(double x);
+
+static inline s1615 sqrtk(s1615 x) {
+    int_k_t bits = bitsk(x);
+    if (bits <= 0) {
+        return kbits(0);
+    }
+    return kbits((int_k_t) (sqrt((double) bits / 32768.0) * 32768.0));
+}
+
+#endif // __HOST_SQRT_H__
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the spinn_common static-assert.h
+ *
+ *  The models assert on const locals, which are not constant expressions in
+ *  C, so this cannot be _Static_assert; instead it declares an array type
+ *  whose size is negative when the assertion fails.
+ */
+
+#ifndef __HOST_STATIC_ASSERT_H__
+#define __HOST_STATIC_ASSERT_H__
+
+#define static_assert(expression, message) \
+    do { \
+        typedef char __static_assertion[(expression) ? 1 : -1] UNUSED; \
+    } while (0)
+
+#ifndef UNUSED
+#define UNUSED __attribute__((__unused__))
+#endif
+
+#endif // __HOST_STATIC_ASSERT_H__
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the spinn_common stdfix-exp.h, computed in
+ *         double precision.  Cycle counts of models that call expk() are
+ *         therefore not representative of the SpiNNaker library version.
+ */
+
+#ifndef __HOST_STDFIX_EXP_H__
+#define __HOST_STDFIX_EXP_H__
+
+#include <stdfix-full-iso.h>
+
+double exp(double x);
+
+static inline s1615 expk(s1615 x) {
+    double result = exp((double) bitsk(x) / 32768.0) * 32768.0;
+    if (result >= (double) INT32_MAX) {
+        return kbits(INT32_MAX);
+    }
+    return kbits((int_k_t) result);
+}
+
+#endif // __HOST_STDFIX_EXP_H__
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the spinn_common stdfix-full-iso.h
+ *
+ *  Provides the short type names (s1615, u032, ...) and the bitsXX/XXbits
+ *  conversions between fixed-point values and their integer
+ *  representations.  The layouts assume the ARM GCC widths, which are also
+ *  the clang defaults: accum is s16.15 and long fract is s0.31.
+ */
+
+#ifndef __HOST_STDFIX_FULL_ISO_H__
+#define __HOST_STDFIX_FULL_ISO_H__
+
+#include <stdint.h>
+#include <stdfix.h>
+
+typedef int8_t   int_hr_t;
+typedef int16_t  int_r_t;
+typedef int32_t  int_lr_t;
+typedef int16_t  int_hk_t;
+typedef int32_t  int_k_t;
+typedef int64_t  int_lk_t;
+typedef uint8_t  uint_uhr_t;
+typedef uint16_t uint_ur_t;
+typedef uint32_t uint_ulr_t;
+typedef uint16_t uint_uhk_t;
+typedef uint32_t uint_uk_t;
+typedef uint64_t uint_ulk_t;
+
+typedef short fract              s07;
+typedef fract                    s015;
+typedef long fract               s031;
+typedef short accum              s87;
+typedef accum                    s1615;
+typedef long accum               s3231;
+typedef unsigned short fract     u08;
+typedef unsigned fract           u016;
+typedef unsigned long fract      u032;
+typedef unsigned short accum     u88;
+typedef unsigned accum           u1616;
+typedef unsigned long accum      u3232;
+
+//! \brief Defines the pair of conversions between a fixed-point type and
+//!        the integer type holding its bits
+#define __HOST_FX_BITS(bits_name, from_name, fx_type, int_type) \
+    static inline int_type bits_name(fx_type f) { \
+        union { fx_type f; int_type i; } u; \
+        u.f = f; \
+        return u.i; \
+    } \
+    static inline fx_type from_name(int_type i) { \
+        union { fx_type f; int_type i; } u; \
+        u.i = i; \
+        return u.f; \
+    }
+
+__HOST_FX_BITS(bitshr,  hrbits,  s07,   int_hr_t)
+__HOST_FX_BITS(bitsr,   rbits,   s015,  int_r_t)
+__HOST_FX_BITS(bitslr,  lrbits,  s031,  int_lr_t)
+__HOST_FX_BITS(bitshk,  hkbits,  s87,   int_hk_t)
+__HOST_FX_BITS(bitsk,   kbits,   s1615, int_k_t)
+__HOST_FX_BITS(bitslk,  lkbits,  s3231, int_lk_t)
+__HOST_FX_BITS(bitsuhr, uhrbits, u08,   uint_uhr_t)
+__HOST_FX_BITS(bitsur,  urbits,  u016,  uint_ur_t)
+__HOST_FX_BITS(bitsulr, ulrbits, u032,  uint_ulr_t)
+__HOST_FX_BITS(bitsuhk, uhkbits, u88,   uint_uhk_t)
+__HOST_FX_BITS(bitsuk,  ukbits,  u1616, uint_uk_t)
+__HOST_FX_BITS(bitsulk, ulkbits, u3232, uint_ulk_t)
+
+#undef __HOST_FX_BITS
+
+//! \brief Rounds an accum to a number of fractional bits
+static inline s1615 roundk(s1615 f, int n) {
+    if (n >= 15) {
+        return f;
+    }
+    int_k_t bits = bitsk(f) + (1 << (14 - n));
+    return kbits(bits & ~((1 << (15 - n)) - 1));
+}
+
+//! \brief Type-generic absolute value
+#define absfx(x) ({ \
+    __typeof__(x) __absfx_x = (x); \
+    (__absfx_x < 0) ? -__absfx_x : __absfx_x; \
+})
+
+#endif // __HOST_STDFIX_FULL_ISO_H__
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief ISO/IEC TR 18037 keyword macros for compilers (such as clang with
+ *         -ffixed-point) that provide the _Fract and _Accum types but no
+ *         stdfix.h
+ */
+
+#ifndef __HOST_STDFIX_H__
+#define __HOST_STDFIX_H__
+
+#define fract _Fract
+#define accum _Accum
+#define sat _Sat
+
+#endif // __HOST_STDFIX_H__
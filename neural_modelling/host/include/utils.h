@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Host stand-in for the integer helpers of the spinn_common utils.h
+ */
+
+#ifndef __HOST_UTILS_H__
+#define __HOST_UTILS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+static inline bool is_power_of_2(uint32_t v) {
+    return (v != 0) && ((v & (v - 1)) == 0);
+}
+
+static inline uint32_t next_power_of_2(uint32_t v) {
+    v--;
+    v |= v >> 1;
+    v |= v >> 2;
+    v |= v >> 4;
+    v |= v >> 8;
+    v |= v >> 16;
+    return v + 1;
+}
+
+//! \brief Integer logarithm (base 2), rounded down; 0 for 0
+static inline uint32_t ilog_2(uint32_t x) {
+    return (x == 0) ? 0 : (31 - __builtin_clz(x));
+}
+
+#endif // __HOST_UTILS_H__
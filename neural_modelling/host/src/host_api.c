@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Implementation of the host stand-in for the SpiNNaker run-time
+ *         (spin1 API, sark, simulation, recording, profiler and random).
+ */
+
+// The profiler is provided whether or not the code using it is built with it
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED
+#endif
+
+// The SpiNNaker headers must come before the system ones (see
+// common-typedefs.h)
+#include <common-typedefs.h>
+#include <spin1_api.h>
+#include <sark.h>
+#include <simulation.h>
+#include <recording.h>
+#include <profiler.h>
+#include <random.h>
+#include <host_api.h>
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+
+//! Where to ask for the arena to be mapped if MAP_32BIT is not available
+#define ARENA_HINT_ADDRESS ((void *) 0x10000000)
+
+//! The number of events that can be queued at once
+#define EVENT_QUEUE_SIZE 4096
+
+//! The number of DMA tags that can have their own callback
+#define N_DMA_TAGS 16
+
+typedef enum host_event_type {
+    HOST_EVENT_DMA_DONE, HOST_EVENT_USER, HOST_EVENT_RECORDING_DONE
+} host_event_type;
+
+typedef struct host_event {
+    host_event_type type;
+    uint arg0;
+    uint arg1;
+    recording_complete_callback_t recording_callback;
+} host_event;
+
+// The stand-in system variables and timer registers
+static sv_t host_sv = {.cpu_clk = 200};
+sv_t *sv = &host_sv;
+volatile uint tc[8];
+uint ticks;
+
+// The memory arena
+static uint8_t *arena = NULL;
+static uint32_t arena_size = 0;
+static uint32_t arena_used = 0;
+
+// The registered callbacks
+static callback_t callbacks[NUM_EVENTS];
+static callback_t dma_tag_callbacks[N_DMA_TAGS];
+
+// The queue of events waiting to be run
+static host_event event_queue[EVENT_QUEUE_SIZE];
+static uint32_t event_queue_input = 0;
+static uint32_t event_queue_output = 0;
+static bool user_event_pending = false;
+
+// Statistics
+static uint32_t next_dma_id = 1;
+static uint32_t n_dmas = 0;
+static uint32_t n_packets_sent = 0;
+static callback_t mc_packet_sent_callback = NULL;
+static uint32_t n_recorded_bytes[HOST_RECORDING_CHANNELS];
+static uint64_t profiler_start[PROFILER_N_TAGS];
+static uint64_t profiler_cycles[PROFILER_N_TAGS];
+static uint32_t profiler_count[PROFILER_N_TAGS];
+
+// The seed of mars_kiss64_simp
+static mars_kiss64_seed_t simp_seed = {123456789, 987654321, 43219876, 6543217};
+
+/* PRIVATE FUNCTIONS */
+
+static void _queue_event(
+        host_event_type type, uint arg0, uint arg1,
+        recording_complete_callback_t recording_callback) {
+    uint32_t next = (event_queue_input + 1) % EVENT_QUEUE_SIZE;
+    if (next == event_queue_output) {
+        io_printf(IO_BUF, "Host event queue full\n");
+        rt_error(RTE_EVENT);
+    }
+    host_event *event = &event_queue[event_queue_input];
+    event->type = type;
+    event->arg0 = arg0;
+    event->arg1 = arg1;
+    event->recording_callback = recording_callback;
+    event_queue_input = next;
+}
+
+/* HOST CONTROL FUNCTIONS */
+
+void host_initialise(uint32_t arena_bytes) {
+    if (arena == NULL) {
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE;
+#ifdef MAP_32BIT
+        flags |= MAP_32BIT;
+#endif
+        void *mapped = mmap(
+            ARENA_HINT_ADDRESS, arena_bytes, PROT_READ | PROT_WRITE, flags,
+            -1, 0);
+        if (mapped == MAP_FAILED) {
+            io_printf(IO_BUF, "Could not map %u bytes for the arena\n",
+                arena_bytes);
+            rt_error(RTE_MALLOC);
+        }
+        if (((uint64_t) (uintptr_t) mapped) + arena_bytes > UINT32_MAX) {
+            io_printf(IO_BUF,
+                "The arena could not be mapped below 4GB; "
+                "try building with HOST_CFLAGS += -m32\n");
+            rt_error(RTE_MALLOC);
+        }
+        arena = (uint8_t *) mapped;
+        arena_size = arena_bytes;
+    }
+    arena_used = 0;
+    memset(arena, 0, arena_size);
+
+    memset(callbacks, 0, sizeof(callbacks));
+    memset(dma_tag_callbacks, 0, sizeof(dma_tag_callbacks));
+    event_queue_input = 0;
+    event_queue_output = 0;
+    user_event_pending = false;
+    next_dma_id = 1;
+    n_dmas = 0;
+    n_packets_sent = 0;
+    mc_packet_sent_callback = NULL;
+    memset(n_recorded_bytes, 0, sizeof(n_recorded_bytes));
+    host_profiler_reset();
+    ticks = 0;
+    for (uint32_t i = 0; i < sizeof(tc) / sizeof(tc[0]); i++) {
+        tc[i] = 0;
+    }
+}
+
+void *host_sdram_alloc(uint32_t n_bytes) {
+    uint32_t aligned_bytes = (n_bytes + 15) & ~15u;
+    if (arena == NULL || aligned_bytes > arena_size - arena_used) {
+        io_printf(IO_BUF, "Out of arena memory allocating %u bytes\n",
+            n_bytes);
+        rt_error(RTE_MALLOC);
+    }
+    void *result = &arena[arena_used];
+    arena_used += aligned_bytes;
+    return result;
+}
+
+void host_deliver_mc_packet(uint key, uint payload, bool has_payload) {
+    uint event = has_payload ? MCPL_PACKET_RECEIVED : MC_PACKET_RECEIVED;
+    if (callbacks[event] != NULL) {
+        callbacks[event](key, payload);
+    }
+}
+
+void host_run_pending_events(void) {
+    while (event_queue_output != event_queue_input) {
+        host_event event = event_queue[event_queue_output];
+        event_queue_output = (event_queue_output + 1) % EVENT_QUEUE_SIZE;
+
+        switch (event.type) {
+        case HOST_EVENT_DMA_DONE:
+            if (event.arg1 < N_DMA_TAGS
+                    && dma_tag_callbacks[event.arg1] != NULL) {
+                dma_tag_callbacks[event.arg1](event.arg0, event.arg1);
+            } else if (callbacks[DMA_TRANSFER_DONE] != NULL) {
+                callbacks[DMA_TRANSFER_DONE](event.arg0, event.arg1);
+            }
+            break;
+        case HOST_EVENT_USER:
+            user_event_pending = false;
+            if (callbacks[USER_EVENT] != NULL) {
+                callbacks[USER_EVENT](event.arg0, event.arg1);
+            }
+            break;
+        case HOST_EVENT_RECORDING_DONE:
+            event.recording_callback();
+            break;
+        }
+    }
+}
+
+uint64_t host_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t) now.tv_sec * 1000000000ull) + now.tv_nsec;
+#endif
+}
+
+const char *host_cycle_units(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return "cycles";
+#else
+    return "ns";
+#endif
+}
+
+void host_profiler_reset(void) {
+    memset(profiler_start, 0, sizeof(profiler_start));
+    memset(profiler_cycles, 0, sizeof(profiler_cycles));
+    memset(profiler_count, 0, sizeof(profiler_count));
+}
+
+uint64_t host_profiler_cycles(uint32_t tag) {
+    return (tag < PROFILER_N_TAGS) ? profiler_cycles[tag] : 0;
+}
+
+uint32_t host_profiler_count(uint32_t tag) {
+    return (tag < PROFILER_N_TAGS) ? profiler_count[tag] : 0;
+}
+
+uint32_t host_n_packets_sent(void) {
+    return n_packets_sent;
+}
+
+void host_on_mc_packet_sent(callback_t callback) {
+    mc_packet_sent_callback = callback;
+}
+
+uint32_t host_n_dmas(void) {
+    return n_dmas;
+}
+
+uint32_t host_n_recorded_bytes(uint8_t channel) {
+    return (channel < HOST_RECORDING_CHANNELS) ? n_recorded_bytes[channel] : 0;
+}
+
+/* SARK */
+
+void io_printf(char *stream, char *format, ...) {
+    use(stream);
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+}
+
+void rt_error(uint code, ...) {
+    fprintf(stderr, "rt_error(%u)\n", code);
+    exit(code == 0 ? 1 : (int) code);
+}
+
+void *sark_alloc(uint count, uint size) {
+    return host_sdram_alloc(count * size);
+}
+
+void sark_free(void *ptr) {
+    use(ptr);
+}
+
+/* SPIN1 API */
+
+void spin1_callback_on(uint event_id, callback_t cback, int priority) {
+    use(priority);
+    if (event_id < NUM_EVENTS) {
+        callbacks[event_id] = cback;
+    }
+}
+
+void spin1_callback_off(uint event_id) {
+    if (event_id < NUM_EVENTS) {
+        callbacks[event_id] = NULL;
+    }
+}
+
+uint spin1_dma_transfer(
+        uint tag, void *system_address, void *tcm_address, uint direction,
+        uint length) {
+    if (direction == DMA_READ) {
+        memcpy(tcm_address, system_address, length);
+    } else {
+        memcpy(system_address, tcm_address, length);
+    }
+    uint id = next_dma_id++;
+    n_dmas++;
+    _queue_event(HOST_EVENT_DMA_DONE, id, tag, NULL);
+    return id;
+}
+
+uint spin1_send_mc_packet(uint key, uint data, uint load) {
+    use(load);
+    n_packets_sent++;
+    if (mc_packet_sent_callback != NULL) {
+        mc_packet_sent_callback(key, data);
+    }
+    return TRUE;
+}
+
+uint spin1_trigger_user_event(uint arg0, uint arg1) {
+    if (user_event_pending) {
+        return FALSE;
+    }
+    user_event_pending = true;
+    _queue_event(HOST_EVENT_USER, arg0, arg1, NULL);
+    return TRUE;
+}
+
+void *spin1_malloc(uint bytes) {
+    return host_sdram_alloc(bytes);
+}
+
+void spin1_memcpy(void *dst, void const *src, uint len) {
+    memcpy(dst, src, len);
+}
+
+uint spin1_int_disable(void) {
+    return 0;
+}
+
+uint spin1_irq_disable(void) {
+    return 0;
+}
+
+uint spin1_fiq_disable(void) {
+    return 0;
+}
+
+void spin1_mode_restore(uint sr) {
+    use(sr);
+}
+
+void spin1_delay_us(uint n) {
+    use(n);
+}
+
+void spin1_wfi(void) {
+    host_run_pending_events();
+}
+
+void spin1_set_timer_tick(uint time) {
+    use(time);
+}
+
+void spin1_set_timer_tick_and_phase(uint time, uint phase) {
+    use(time);
+    use(phase);
+}
+
+void spin1_msg_free(sdp_msg_t *msg) {
+    // The messages delivered on the host belong to whoever delivered them
+    use(msg);
+}
+
+/* SIMULATION */
+
+bool simulation_dma_transfer_done_callback_on(uint tag, callback_t callback) {
+    if (tag >= N_DMA_TAGS) {
+        return false;
+    }
+    dma_tag_callbacks[tag] = callback;
+    return true;
+}
+
+void simulation_dma_transfer_done_callback_off(uint tag) {
+    if (tag < N_DMA_TAGS) {
+        dma_tag_callbacks[tag] = NULL;
+    }
+}
+
+/* RECORDING */
+
+bool recording_record_and_notify(
+        uint8_t channel, void *data, uint32_t size_bytes,
+        recording_complete_callback_t callback) {
+    use(data);
+    if (channel < HOST_RECORDING_CHANNELS) {
+        n_recorded_bytes[channel] += size_bytes;
+    }
+    if (callback != NULL) {
+        _queue_event(HOST_EVENT_RECORDING_DONE, 0, 0, callback);
+    }
+    return true;
+}
+
+bool recording_record(uint8_t channel, void *data, uint32_t size_bytes) {
+    return recording_record_and_notify(channel, data, size_bytes, NULL);
+}
+
+/* PROFILER */
+
+void profiler_init(uint32_t *data_region) {
+    use(data_region);
+    host_profiler_reset();
+}
+
+void profiler_finalise(void) {
+}
+
+void profiler_write_entry(uint32_t tag) {
+    uint32_t index = tag & ~PROFILER_ENTER;
+    if (index >= PROFILER_N_TAGS) {
+        return;
+    }
+    if (tag & PROFILER_ENTER) {
+        profiler_start[index] = host_cycles();
+    } else {
+        profiler_cycles[index] += host_cycles() - profiler_start[index];
+        profiler_count[index]++;
+    }
+}
+
+/* RANDOM */
+
+uint32_t mars_kiss64_seed(mars_kiss64_seed_t seed) {
+    uint64_t t;
+
+    seed[0] = 314527869 * seed[0] + 1234567;
+    seed[1] ^= seed[1] << 5;
+    seed[1] ^= seed[1] >> 7;
+    seed[1] ^= seed[1] << 22;
+    t = 4294584393ULL * seed[2] + seed[3];
+    seed[3] = t >> 32;
+    seed[2] = t;
+
+    return seed[0] + seed[1] + seed[2];
+}
+
+void validate_mars_kiss64_seed(mars_kiss64_seed_t seed) {
+    if (seed[1] == 0) {
+        seed[1] = 13031301;
+    }
+    seed[3] = (seed[3] % 698769068) + 1;
+}
+
+uint32_t mars_kiss64_simp(void) {
+    return mars_kiss64_seed(simp_seed);
+}
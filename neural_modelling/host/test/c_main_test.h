@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Stand-ins for the simulation, recording and data specification
+ *         interfaces used by a c_main file
+ *
+ *  A test that includes a c_main file drives the model directly rather
+ *  than through c_main, so these do nothing; this is included once by such
+ *  a test, after the c_main file.
+ */
+
+#ifndef __C_MAIN_TEST_H__
+#define __C_MAIN_TEST_H__
+
+#include <host_api.h>
+
+bool simulation_initialise(
+        address_t address, uint32_t expected_app_magic_number,
+        uint32_t *timer_period, uint32_t *simulation_ticks_pointer,
+        uint32_t *infinite_run_pointer, uint32_t *time_pointer,
+        int sdp_packet_callback_priority, int dma_transfer_complete_priority) {
+    use(address);
+    use(expected_app_magic_number);
+    use(timer_period);
+    use(simulation_ticks_pointer);
+    use(infinite_run_pointer);
+    use(time_pointer);
+    use(sdp_packet_callback_priority);
+    use(dma_transfer_complete_priority);
+    return false;
+}
+
+void simulation_set_provenance_data_address(address_t provenance_data_address) {
+    use(provenance_data_address);
+}
+
+void simulation_set_provenance_function(
+        prov_callback_t provenance_function,
+        address_t provenance_data_address) {
+    use(provenance_function);
+    use(provenance_data_address);
+}
+
+void simulation_handle_pause_resume(resume_callback_t callback) {
+    use(callback);
+}
+
+void simulation_ready_to_read(void) {
+}
+
+bool simulation_sdp_callback_on(uint sdp_port, callback_t sdp_callback) {
+    use(sdp_port);
+    use(sdp_callback);
+    return true;
+}
+
+void simulation_run(void) {
+}
+
+bool recording_initialize(
+        address_t recording_data_address, uint32_t *recording_flags) {
+    use(recording_data_address);
+    use(recording_flags);
+    return false;
+}
+
+void recording_reset(void) {
+}
+
+void recording_finalise(void) {
+}
+
+void recording_do_timestep_update(uint32_t time) {
+    use(time);
+}
+
+data_specification_metadata_t *data_specification_get_data_address(void) {
+    return NULL;
+}
+
+bool data_specification_read_header(data_specification_metadata_t *ds_regions) {
+    use(ds_regions);
+    return false;
+}
+
+address_t data_specification_get_region(
+        uint32_t region, data_specification_metadata_t *ds_regions) {
+    use(region);
+    use(ds_regions);
+    return NULL;
+}
+
+#endif // __C_MAIN_TEST_H__
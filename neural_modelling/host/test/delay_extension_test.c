@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Test of the lists of the neurons with spikes in each delay slot of
+ *         the delay extension
+ *
+ *  delay_extension.c is included so that the test can look at the lists of
+ *  each slot.  Spikes are received and ticks run, and the test checks that
+ *  each neuron is listed once in the slot it spiked in, in order of its
+ *  first spike, that a slot with too many neurons to list is marked to be
+ *  scanned in full, and that a neuron with more spikes in a slot than its
+ *  counter holds is still listed once.  The keys sent each tick are checked
+ *  against the spikes received, so that both the listed and the scanned
+ *  slots are seen to send each spike after each delay stage of its neuron,
+ *  and slots are seen to be empty when they are used again.
+ *
+ *      delay_extension_test
+ */
+
+#define APPLICATION_NAME_HASH 0
+
+#include <delay_extension/delay_extension.c>
+#include "c_main_test.h"
+#include "test_assert.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//! The number of neurons
+#define N_NEURONS 100
+
+//! The number of delay stages
+#define N_STAGES 3
+
+//! The key and mask of the spikes received, and the key of those sent
+#define SPIKE_IN_KEY 0x20000
+#define SPIKE_IN_MASK 0xFFFFFF00
+#define SPIKE_OUT_KEY 0x10000
+
+//! The number of ticks run; more than twice the delay slots, so that each
+//! slot is used again
+#define N_TICKS 160
+
+//! The most spikes one neuron can have counted in a slot
+#define MAX_COUNT UINT8_MAX
+
+//! The size of the memory standing in for DTCM
+#define ARENA_BYTES (256 * 1024)
+
+//! The number of spikes received by each neuron before each tick
+static uint32_t n_received[N_TICKS][N_NEURONS];
+
+//! The number of spikes sent with each key in the current tick
+static uint32_t n_sent[N_STAGES * N_NEURONS];
+
+//! The number of spikes sent with keys that are not expected at all
+static uint32_t n_bad_keys;
+
+static void _count_sent(uint key, uint payload) {
+    use(payload);
+    uint32_t index = key - SPIKE_OUT_KEY;
+    if (key < SPIKE_OUT_KEY || index >= N_STAGES * N_NEURONS) {
+        n_bad_keys += 1;
+    } else {
+        n_sent[index] += 1;
+    }
+}
+
+//! \brief Whether a neuron emits spikes after a delay stage
+static inline bool _has_stage(uint32_t n, uint32_t d) {
+    return ((n + d) % 3) != 0;
+}
+
+//! \brief Sets up the delay extension as the data specification would
+static void _initialise(void) {
+    host_initialise(ARENA_BYTES);
+    host_on_mc_packet_sent(_count_sent);
+
+    uint32_t words = get_bit_field_size(N_NEURONS);
+    address_t params = spin1_malloc(
+        (DELAY_BLOCKS + N_STAGES * words) * sizeof(uint32_t));
+    params[KEY] = SPIKE_OUT_KEY;
+    params[INCOMING_KEY] = SPIKE_IN_KEY;
+    params[INCOMING_MASK] = SPIKE_IN_MASK;
+    params[N_ATOMS] = N_NEURONS;
+    params[N_DELAY_STAGES] = N_STAGES;
+    params[RANDOM_BACKOFF] = 0;
+    params[TIME_BETWEEN_SPIKES] = 0;
+    params[N_OUTGOING_EDGES] = 0;
+    for (uint32_t d = 0; d < N_STAGES; d++) {
+        bit_field_t stage = (bit_field_t) &params[DELAY_BLOCKS + d * words];
+        clear_bit_field(stage, words);
+        for (uint32_t n = 0; n < N_NEURONS; n++) {
+            if (_has_stage(n, d)) {
+                bit_field_set(stage, n);
+            }
+        }
+    }
+    if (!read_parameters(params)) {
+        test_fail("read_parameters");
+    }
+    if (!in_spikes_initialize_spike_buffer(1024)) {
+        test_fail("in_spikes_initialize_spike_buffer");
+    }
+    infinite_run = TRUE;
+    timer_period = 1000;
+    time = UINT32_MAX;
+}
+
+//! \brief Chooses the spikes received before each tick: a few neurons with
+//!        a few spikes each, a tick with more neurons than a slot lists, and
+//!        ticks with more spikes of a neuron than its counter holds
+static void _choose_spikes(void) {
+    for (uint32_t t = 0; t < N_TICKS - (N_STAGES * DELAY_STAGE_LENGTH);
+            t++) {
+        if (t == 20) {
+            for (uint32_t n = 0; n < 2 * MAX_SLOT_EVENTS; n++) {
+                n_received[t][(n * 3) % N_NEURONS] = 1 + (n % 2);
+            }
+        } else if (t == 30) {
+            n_received[t][7] = MAX_COUNT + 1;
+            n_received[t][8] = 1;
+        } else if (t == 31) {
+            n_received[t][9] = 300;
+            for (uint32_t n = 10; n < 10 + MAX_SLOT_EVENTS; n++) {
+                n_received[t][n] = 1;
+            }
+        } else if (t % 3 == 0) {
+            for (uint32_t i = 0; i < 5; i++) {
+                n_received[t][(t * 7 + i * 11) % N_NEURONS] = 1 + i;
+            }
+        }
+    }
+}
+
+//! \brief Receives the spikes of a tick, with the spikes of each neuron
+//!        interleaved with those of the others
+static void _receive_spikes(uint32_t t) {
+    uint32_t max_spikes = 0;
+    for (uint32_t n = 0; n < N_NEURONS; n++) {
+        if (n_received[t][n] > max_spikes) {
+            max_spikes = n_received[t][n];
+        }
+    }
+    for (uint32_t s = 0; s < max_spikes; s++) {
+        for (uint32_t n = 0; n < N_NEURONS; n++) {
+            if (s < n_received[t][n]) {
+                incoming_spike_callback(SPIKE_IN_KEY | n, 0);
+            }
+        }
+    }
+
+    // A spike of another source is not counted
+    incoming_spike_callback(SPIKE_IN_KEY + 0x100, 0);
+}
+
+//! \brief Checks the list and counters of the slot of the spikes received
+//!        before a tick, once they have been counted
+static void _check_slot(uint32_t t, uint32_t slot) {
+    uint32_t n_spiking = 0;
+    for (uint32_t n = 0; n < N_NEURONS; n++) {
+        uint32_t expected = n_received[t][n];
+        if (expected > MAX_COUNT) {
+            expected = MAX_COUNT;
+        }
+        if (spike_counters[slot][n] != expected) {
+            test_fail("slot: neuron %u counted %u spikes",
+                n, spike_counters[slot][n]);
+        }
+        if (n_received[t][n] > 0) {
+            n_spiking += 1;
+        }
+    }
+
+    slot_events_t *events = slot_events[slot];
+    if (n_spiking > MAX_SLOT_EVENTS) {
+        if (events->n_events != MAX_SLOT_EVENTS + 1) {
+            test_fail("slot: tick %u has %u events, not marked as overflowed",
+                t, events->n_events);
+        }
+        return;
+    }
+    if (events->n_events != n_spiking) {
+        test_fail("slot: tick %u has %u events", t, events->n_events);
+        return;
+    }
+
+    // The neurons are listed once each, in order of their first spike,
+    // which is in order of neuron ID as the spikes are interleaved
+    uint32_t e = 0;
+    for (uint32_t n = 0; n < N_NEURONS; n++) {
+        if (n_received[t][n] > 0) {
+            if (events->neurons[e] != n) {
+                test_fail("slot: event %u is neuron %u",
+                    e, events->neurons[e]);
+            }
+            e += 1;
+        }
+    }
+}
+
+//! \brief Checks the spikes sent in a tick, which are those received
+//!        before the tick a multiple of DELAY_STAGE_LENGTH ticks after the
+//!        tick they were counted in, once for each delay stage of their
+//!        neuron
+static void _check_sent(uint32_t t) {
+    for (uint32_t d = 0; d < N_STAGES; d++) {
+        uint32_t delay = (d + 1) * DELAY_STAGE_LENGTH;
+        for (uint32_t n = 0; n < N_NEURONS; n++) {
+            uint32_t expected = 0;
+            if (t + 1 >= delay && _has_stage(n, d)) {
+                expected = n_received[t + 1 - delay][n];
+                if (expected > MAX_COUNT) {
+                    expected = MAX_COUNT;
+                }
+            }
+            uint32_t sent = n_sent[d * N_NEURONS + n];
+            if (sent != expected) {
+                test_fail("sent: neuron %u sent %u spikes", n, sent);
+                printf("      at tick %u after delay stage %u\n", t, d);
+            }
+        }
+    }
+}
+
+int main(void) {
+    _initialise();
+    _choose_spikes();
+
+    uint32_t n_spikes = 0;
+    for (uint32_t t = 0; t < N_TICKS; t++) {
+        _receive_spikes(t);
+
+        // The spikes received before tick t are counted in the slot of the
+        // tick before, as the time only moves on once they are counted
+        memset(n_sent, 0, sizeof(n_sent));
+        timer_callback(0, 0);
+        if (time != t) {
+            test_fail("time: tick %u ran as %u", t, time);
+        }
+        _check_slot(t, (t - 1) & num_delay_slots_mask);
+        _check_sent(t);
+        for (uint32_t n = 0; n < N_NEURONS; n++) {
+            n_spikes += n_received[t][n];
+        }
+    }
+
+    if (n_bad_keys > 0) {
+        test_fail("sent: %u spikes sent with bad keys, of %u", n_bad_keys,
+            n_spikes_sent);
+    }
+
+    return test_finish("%u spikes, %u sent", n_spikes, n_spikes_sent);
+}
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Test of the event-driven neuron update of neuron.c
+ *
+ *  neuron.c is built with EVENT_DRIVEN_NEURONS=1 and the implementation in
+ *  neuron_impl_test.h.  The neurons receive occasional input, and after each
+ *  timestep the test checks that exactly the neurons that were active were
+ *  updated, and that each neuron woken from rest was first brought through
+ *  the timesteps it missed.  It then checks that the resting neurons are
+ *  brought up to date when the parameters are stored, and that all the
+ *  neurons are updated again after the parameters are reloaded.
+ *
+ *      neuron_event_driven_test
+ */
+
+// The SpiNNaker headers must come before the system ones (see
+// common-typedefs.h)
+#include <common/neuron-typedefs.h>
+#include <neuron/neuron.h>
+#include <neuron/plasticity/synapse_dynamics.h>
+#include <host_api.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "neuron_impl_test.h"
+#include "test_assert.h"
+
+//! The number of neurons; not a multiple of 32, to have a part word
+#define N_NEURONS 70
+
+//! The number of timesteps to run
+#define N_TICKS 400
+
+//! The words of the neuron region before the parameters of the neurons
+//! when nothing is recorded
+#define HEADER_WORDS (8 + 2 + ((N_NEURONS + 3) >> 2))
+
+//! The size of the memory standing in for SDRAM
+#define ARENA_BYTES (1024 * 1024)
+
+test_neuron *test_neurons;
+
+/* STAND-INS FOR THE PLASTICITY USED BY NEURON.C */
+
+void synapse_dynamics_process_post_synaptic_event(
+        uint32_t time, index_t neuron_index) {
+    use(time);
+    use(neuron_index);
+}
+
+input_t synapse_dynamics_get_intrinsic_bias(
+        uint32_t time, index_t neuron_index) {
+    use(time);
+    use(neuron_index);
+    return ZERO;
+}
+
+/* THE TEST */
+
+//! The expected state of a neuron
+typedef struct expected_neuron {
+    uint32_t input;
+    uint32_t level;
+    uint32_t n_updates;
+    bool active;
+} expected_neuron;
+
+static expected_neuron expected[N_NEURONS];
+
+//! \brief Writes a neuron region of N_NEURONS, with the given level for each
+static address_t _make_neuron_region(uint32_t level) {
+    address_t region = host_sdram_alloc(
+        (HEADER_WORDS + (2 * N_NEURONS)) * sizeof(uint32_t));
+    region[4] = N_NEURONS;
+    region[5] = 1;
+    region[6] = 16;
+    for (uint32_t i = 0; i < N_NEURONS; i++) {
+        region[HEADER_WORDS + i] = (level == UINT32_MAX) ? (i % 4) : level;
+        expected[i].input = 0;
+        expected[i].level = region[HEADER_WORDS + i];
+        expected[i].n_updates = 0;
+        expected[i].active = true;
+    }
+    return region;
+}
+
+static void _fail_neuron(const char *what, uint32_t time, index_t i) {
+    test_fail("%s of neuron %u at time %u", what, i, time);
+}
+
+//! \brief Gives the input for a timestep to the neurons
+static void _add_inputs(uint32_t time) {
+    input_t inputs[N_NEURONS];
+    uint32_t amounts[N_NEURONS];
+    memset(amounts, 0, sizeof(amounts));
+
+    // Single neurons now and then, and a whole word of neurons together
+    if (time % 10 == 0) {
+        amounts[(time * 7) % N_NEURONS] = 2;
+    }
+    if (time % 50 == 3) {
+        for (index_t i = 32; i < 64; i++) {
+            amounts[i] = 1;
+        }
+    }
+
+    // Zero input must not wake a neuron
+    for (index_t i = 0; i < N_NEURONS; i++) {
+        inputs[i] = (input_t) amounts[i];
+        if (amounts[i] > 0) {
+            expected[i].input += amounts[i];
+            expected[i].active = true;
+        }
+    }
+    neuron_add_input_array(0, inputs);
+}
+
+//! \brief Runs a timestep and checks the neurons that were updated
+//! \return The number of neurons woken from rest at this timestep
+static uint32_t _run_timestep(uint32_t time) {
+    bool was_active[N_NEURONS];
+    uint32_t n_steps_before[N_NEURONS];
+    for (index_t i = 0; i < N_NEURONS; i++) {
+        was_active[i] = expected[i].active;
+        n_steps_before[i] = test_neurons[i].n_steps;
+    }
+
+    neuron_do_timestep_update(time, time, 1000);
+
+    uint32_t n_woken = 0;
+    for (index_t i = 0; i < N_NEURONS; i++) {
+        expected_neuron *e = &expected[i];
+        if (!was_active[i]) {
+            if (test_neurons[i].n_updates != e->n_updates) {
+                _fail_neuron("update while at rest", time, i);
+            }
+            continue;
+        }
+        e->level += e->input;
+        e->input = 0;
+        if (e->level > 0) {
+            e->level -= 1;
+        }
+        e->n_updates += 1;
+        e->active = (e->level > 0);
+
+        if (test_neurons[i].n_updates != e->n_updates) {
+            _fail_neuron("no update while active", time, i);
+        } else if (test_neurons[i].n_steps != time + 1) {
+            _fail_neuron("timesteps missed or repeated", time, i);
+        } else if (test_neurons[i].level != e->level) {
+            _fail_neuron("level", time, i);
+        }
+        if (test_neurons[i].n_steps > n_steps_before[i] + 1) {
+            n_woken += 1;
+        }
+    }
+    return n_woken;
+}
+
+int main(void) {
+    host_initialise(ARENA_BYTES);
+
+    // Start with some of the neurons at rest and some not
+    address_t region = _make_neuron_region(UINT32_MAX);
+    uint32_t n_neurons, n_synapse_types, incoming_spike_buffer_size;
+    uint32_t timer_offset;
+    if (!neuron_initialise(
+            region, &n_neurons, &n_synapse_types,
+            &incoming_spike_buffer_size, &timer_offset)) {
+        test_fail("neuron_initialise");
+        return 1;
+    }
+
+    uint32_t n_woken = 0;
+    uint32_t n_updates = 0;
+    for (uint32_t time = 0; time < N_TICKS; time++) {
+        _add_inputs(time);
+        n_woken += _run_timestep(time);
+    }
+    for (index_t i = 0; i < N_NEURONS; i++) {
+        n_updates += expected[i].n_updates;
+    }
+    uint32_t n_skipped = neuron_get_n_updates_skipped();
+    if (n_skipped != (N_NEURONS * N_TICKS) - n_updates) {
+        test_fail("%u updates skipped, not %u",
+            n_skipped, (N_NEURONS * N_TICKS) - n_updates);
+    }
+    if (n_woken == 0 || n_skipped == 0) {
+        test_fail("no neuron came to rest and woke again");
+    }
+
+    // The stored state of every neuron is that at the last timestep
+    neuron_store_neuron_parameters(region);
+    for (index_t i = 0; i < N_NEURONS; i++) {
+        if (region[HEADER_WORDS + (2 * i)] != expected[i].level) {
+            _fail_neuron("stored level", N_TICKS, i);
+        }
+        if (region[HEADER_WORDS + (2 * i) + 1] != N_TICKS) {
+            _fail_neuron("stored timesteps", N_TICKS, i);
+        }
+    }
+
+    // New parameters might take any neuron from rest, so all are updated
+    region = _make_neuron_region(0);
+    if (!neuron_reload_neuron_parameters(region)) {
+        test_fail("neuron_reload_neuron_parameters");
+        return 1;
+    }
+    for (uint32_t time = 0; time < 2; time++) {
+        _run_timestep(time);
+    }
+    for (index_t i = 0; i < N_NEURONS; i++) {
+        if (test_neurons[i].n_updates != 1) {
+            _fail_neuron("updates after reloading", 1, i);
+        }
+    }
+
+    return test_finish("%u neuron updates, %u skipped, %u woken from rest",
+        n_updates, n_skipped, n_woken);
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief A neuron implementation for testing neuron.c
+ *
+ *  Each neuron has a level that is raised by its input and falls by one
+ *  each timestep until it is zero, when the neuron is at rest.  The neuron
+ *  counts the timesteps that it has been brought through, whether by an
+ *  update or by neuron_impl_decay_at_rest, so that a test can check that
+ *  no timestep is missed or counted twice.  The parameters are the starting
+ *  level of each neuron; the level and count are stored.
+ *
+ *  The functions are inline so that the test can include this for the
+ *  state of the neurons without the functions being unused.
+ */
+
+#ifndef _NEURON_IMPL_TEST_H_
+#define _NEURON_IMPL_TEST_H_
+
+#include <neuron/implementations/neuron_impl.h>
+#include <spin1_api.h>
+
+//! The state of a test neuron
+typedef struct test_neuron {
+    //! The input received since the last update
+    input_t input;
+    //! The level, falling to zero at rest
+    uint32_t level;
+    //! The timesteps the neuron has been brought through
+    uint32_t n_steps;
+    //! The number of times neuron_impl_do_timestep_update updated it
+    uint32_t n_updates;
+} test_neuron;
+
+//! The neurons, for the test to inspect
+extern test_neuron *test_neurons;
+
+static inline bool neuron_impl_initialise(uint32_t n_neurons) {
+    test_neurons = spin1_malloc(n_neurons * sizeof(test_neuron));
+    return test_neurons != NULL;
+}
+
+static inline void neuron_impl_add_input_array(
+        index_t synapse_type_index, const input_t *inputs,
+        uint32_t n_neurons) {
+    use(synapse_type_index);
+    for (index_t i = 0; i < n_neurons; i++) {
+        test_neurons[i].input += inputs[i];
+    }
+}
+
+static inline void neuron_impl_load_neuron_parameters(
+        address_t address, uint32_t next, uint32_t n_neurons) {
+    for (index_t i = 0; i < n_neurons; i++) {
+        test_neurons[i].input = ZERO;
+        test_neurons[i].level = address[next + i];
+        test_neurons[i].n_steps = 0;
+        test_neurons[i].n_updates = 0;
+    }
+}
+
+static inline bool neuron_impl_do_timestep_update(
+        index_t neuron_index, input_t external_bias,
+        state_t *recorded_variable_values) {
+    use(external_bias);
+    use(recorded_variable_values);
+    test_neuron *neuron = &test_neurons[neuron_index];
+    neuron->level += (uint32_t) neuron->input;
+    neuron->input = ZERO;
+    if (neuron->level > 0) {
+        neuron->level -= 1;
+    }
+    neuron->n_steps += 1;
+    neuron->n_updates += 1;
+    return false;
+}
+
+static inline void neuron_impl_store_neuron_parameters(
+        address_t address, uint32_t next, uint32_t n_neurons) {
+    for (index_t i = 0; i < n_neurons; i++) {
+        address[next + (2 * i)] = test_neurons[i].level;
+        address[next + (2 * i) + 1] = test_neurons[i].n_steps;
+    }
+}
+
+#if EVENT_DRIVEN_NEURONS
+static inline bool neuron_impl_is_quiescent(index_t neuron_index) {
+    return REAL_COMPARE(test_neurons[neuron_index].input, ==, ZERO)
+        && test_neurons[neuron_index].level == 0;
+}
+
+static inline void neuron_impl_decay_at_rest(
+        index_t neuron_index, uint32_t n_steps) {
+    test_neurons[neuron_index].n_steps += n_steps;
+}
+#endif // EVENT_DRIVEN_NEURONS
+
+#endif // _NEURON_IMPL_TEST_H_
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Test of a master population table implementation
+ *
+ *  This is built once with each implementation of population_table.h.  It
+ *  writes a table region in the form the tools write, with entries of two
+ *  mask sizes, entries of several rows, direct rows, empty rows and
+ *  connectivity bit fields, and then checks that the rows found for each of
+ *  a set of spikes (including spikes not in the table) are those found by
+ *  a linear search of the entries.
+ *
+ *      population_table_<impl>_test
+ */
+
+// The SpiNNaker headers must come before the system ones (see
+// common-typedefs.h)
+#include <common-typedefs.h>
+#include <neuron/population_table/population_table.h>
+#include <neuron/synapse_row.h>
+#include <bit_field.h>
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_assert.h"
+
+//! The most rows that a spike can read in the test tables
+#define MAX_ROWS 4
+
+//! Stand-in SDRAM addresses of the synaptic matrix and direct matrix; the
+//! table computes row addresses from these but never reads the rows
+#define SYNAPTIC_ROWS_BASE ((address_t) 0x60000000)
+#define DIRECT_ROWS_BASE ((address_t) 0x70000000)
+
+//! The bits of the key of an entry above the neuron index
+#define KEY_SHIFT 11
+
+//! An entry of the table, as written by the tools
+typedef struct test_entry {
+    uint32_t key;
+    uint32_t mask;
+    uint16_t start;
+    uint16_t count;
+} test_entry;
+
+//! A row to be read, as found for a spike
+typedef struct test_row {
+    address_t address;
+    size_t n_bytes;
+} test_row;
+
+static test_entry *entries;
+static uint32_t *addresses;
+static uint32_t *bit_fields[1024];
+static uint32_t n_entries;
+static uint32_t n_filtered;
+
+/* STAND-INS FOR THE FEW RUN-TIME FUNCTIONS THE TABLE USES */
+
+void *spin1_malloc(uint bytes) {
+    return malloc(bytes);
+}
+
+void spin1_memcpy(void *dst, void const *src, uint len) {
+    memcpy(dst, src, len);
+}
+
+void io_printf(char *stream, char *format, ...) {
+    use(stream);
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+void rt_error(uint code, ...) {
+    fprintf(stderr, "rt_error(%u)\n", code);
+    exit(2);
+}
+
+/* THE TEST */
+
+static uint32_t rng_state = 1;
+
+static inline uint32_t _rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+//! \brief Writes a table of n entries, sorted by key, as the tools do
+//! \return The table region
+static address_t _make_table(uint32_t n) {
+    n_entries = n;
+    entries = calloc(n + 1, sizeof(test_entry));
+    addresses = calloc((n * 3) + 1, sizeof(uint32_t));
+    uint32_t n_addresses = 0;
+    uint32_t next_offset = 0;
+    uint32_t next_direct_offset = 0;
+    for (uint32_t i = 0; i < n; i++) {
+
+        // Alternate between populations of 2048 and 256 neurons
+        entries[i].key = (i + 1) << KEY_SHIFT;
+        entries[i].mask = (i & 1) ? 0xFFFFFF00 : 0xFFFFF800;
+        entries[i].start = n_addresses;
+        entries[i].count = 1 + (i % 3);
+        uint32_t n_neurons = ~entries[i].mask + 1;
+
+        for (uint32_t j = 0; j < entries[i].count; j++) {
+            if (j == 1) {
+
+                // A direct row, with a word for each source neuron
+                addresses[n_addresses++] =
+                    0x80000000 | (next_direct_offset << 8);
+                next_direct_offset += n_neurons * sizeof(uint32_t);
+            } else {
+
+                // A block of rows, empty for some entries; the offset is in
+                // units of 16 bytes
+                uint32_t row_length = (i % 5 == 0) ? 0 : 1 + (i % 8);
+                addresses[n_addresses++] =
+                    ((next_offset >> 4) << 8) | row_length;
+                next_offset += n_neurons * sizeof(uint32_t)
+                    * (row_length + N_SYNAPSE_ROW_HEADER_WORDS);
+                next_offset = (next_offset + 15) & ~15;
+            }
+        }
+
+        // Filter some entries so that only every third neuron of the first
+        // 256 has synapses
+        bit_fields[i] = NULL;
+        if (i % 4 == 1) {
+            bit_fields[i] = calloc(9, sizeof(uint32_t));
+            bit_fields[i][0] = 8;
+            for (uint32_t k = 0; k < 256; k += 3) {
+                bit_field_set(&bit_fields[i][1], k);
+            }
+        }
+    }
+
+    uint32_t n_words = 2 + (n * sizeof(test_entry) / sizeof(uint32_t))
+        + n_addresses + (n * 9);
+    address_t region = calloc(n_words, sizeof(uint32_t));
+    region[0] = n;
+    region[1] = n_addresses;
+    memcpy(&region[2], entries, n * sizeof(test_entry));
+    uint32_t next = 2 + (n * sizeof(test_entry) / sizeof(uint32_t));
+    memcpy(&region[next], addresses, n_addresses * sizeof(uint32_t));
+    next += n_addresses;
+    for (uint32_t i = 0; i < n; i++) {
+        if (bit_fields[i] == NULL) {
+            region[next++] = 0;
+        } else {
+            memcpy(&region[next], bit_fields[i], 9 * sizeof(uint32_t));
+            next += 9;
+        }
+    }
+    return region;
+}
+
+//! \brief Finds the rows of a spike by a linear search of the entries
+//! \return The number of rows found
+static uint32_t _expected_rows(spike_t spike, test_row *rows) {
+    for (uint32_t i = 0; i < n_entries; i++) {
+        test_entry entry = entries[i];
+        if ((spike & entry.mask) != entry.key) {
+            continue;
+        }
+        uint32_t neuron_id = spike & ~entry.mask;
+        if (bit_fields[i] != NULL && (neuron_id >= (bit_fields[i][0] << 5)
+                || !bit_field_test(&bit_fields[i][1], neuron_id))) {
+            n_filtered += 1;
+            return 0;
+        }
+        uint32_t n_rows = 0;
+        for (uint32_t j = entry.start; j < entry.start + entry.count; j++) {
+            uint32_t item = addresses[j];
+            uintptr_t offset = (item & 0x7FFFFF00) >> 8;
+            if (item & 0x80000000) {
+                rows[n_rows].address = (address_t) ((uintptr_t)
+                    DIRECT_ROWS_BASE + offset + (neuron_id * 4));
+                rows[n_rows++].n_bytes = 0;
+            } else if ((item & 0xFF) > 0) {
+                uint32_t stride = (item & 0xFF) + N_SYNAPSE_ROW_HEADER_WORDS;
+                rows[n_rows].address = (address_t) ((uintptr_t)
+                    SYNAPTIC_ROWS_BASE + (offset << 4)
+                    + (neuron_id * stride * 4));
+                rows[n_rows++].n_bytes = stride * 4;
+            }
+        }
+        return n_rows;
+    }
+    return 0;
+}
+
+static void _check_spike(spike_t spike) {
+    test_row expected[MAX_ROWS];
+    uint32_t n_expected = _expected_rows(spike, expected);
+
+    address_t row_address;
+    size_t n_bytes;
+    uint32_t n_found = 0;
+    bool found = population_table_get_first_address(
+        spike, &row_address, &n_bytes);
+    while (found) {
+        if (n_found >= n_expected
+                || row_address != expected[n_found].address
+                || n_bytes != expected[n_found].n_bytes) {
+            test_fail("spike 0x%08x row %u is %p (%zu bytes)",
+                spike, n_found, (void *) row_address, n_bytes);
+            return;
+        }
+        n_found += 1;
+        found = population_table_get_next_address(&row_address, &n_bytes);
+    }
+    if (n_found != n_expected) {
+        test_fail("spike 0x%08x found %u rows, not %u",
+            spike, n_found, n_expected);
+    }
+}
+
+static bool _initialise(uint32_t n) {
+    address_t region = _make_table(n);
+    uint32_t row_max_n_words;
+    if (!population_table_initialise(
+            region, SYNAPTIC_ROWS_BASE, DIRECT_ROWS_BASE, &row_max_n_words)) {
+        test_fail("initialisation of %u entries", n);
+        return false;
+    }
+    return true;
+}
+
+int main(void) {
+    const uint32_t n = 200;
+    if (!_initialise(n)) {
+        return 1;
+    }
+
+    uint32_t n_spikes = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t n_neurons = ~entries[i].mask + 1;
+        uint32_t ids[] = {0, 1, 3, 255, 256, 768, n_neurons - 1};
+        for (uint32_t j = 0; j < sizeof(ids) / sizeof(ids[0]); j++) {
+
+            // Neuron ids beyond a small population are not in the table
+            _check_spike(entries[i].key | (ids[j] & 0x7FF));
+            n_spikes += 1;
+        }
+    }
+
+    // Keys below, between and above those of the entries, and random ones
+    _check_spike(0);
+    _check_spike(0x7FF);
+    _check_spike((n + 1) << KEY_SHIFT);
+    _check_spike(0xFFFFFFFF);
+    n_spikes += 4;
+    for (uint32_t i = 0; i < 100000; i++) {
+        _check_spike(_rng_next() % ((n + 2) << KEY_SHIFT));
+        n_spikes += 1;
+    }
+
+    // An empty table finds nothing
+    if (!_initialise(0)) {
+        return 1;
+    }
+    for (uint32_t i = 0; i < 1000; i++) {
+        _check_spike(_rng_next());
+        n_spikes += 1;
+    }
+
+    if (population_table_get_filtered_packets() != n_filtered) {
+        test_fail("%u packets filtered, not %u",
+            population_table_get_filtered_packets(), n_filtered);
+    }
+
+    return test_finish("%u spikes, %u filtered", n_spikes, n_filtered);
+}
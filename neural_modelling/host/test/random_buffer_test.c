@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Test that the variates of random_buffer.h are those drawn one at
+ *         a time
+ *
+ *  Each kind of variate is taken from a random_buffer_t and drawn one at a
+ *  time from a copy of the same seed, as spike_source_poisson.c did before
+ *  the variates were buffered, for several fills of the buffer.  A buffer
+ *  hands out the variates of each fill from the last drawn back, and a
+ *  buffer topped up part way through holds the next variates of the seed in
+ *  the places of those used.  The Poisson counts are checked against
+ *  poisson_dist_variate_exp_minus_lambda given the uniform variates in the
+ *  order the buffer hands them out.
+ *
+ *      random_buffer_test
+ */
+
+// The SpiNNaker headers must come before the system ones (see
+// common-typedefs.h)
+#include <common/maths-util.h>
+#include <common/random_buffer.h>
+
+#include <stdio.h>
+
+#include "test_assert.h"
+
+//! The scale of the exponential variates, as in spike_source_poisson.c
+#define ISI_SCALE_FACTOR 1000
+
+//! The standard deviation of the Gaussian variates, as in
+//! spike_source_poisson.c
+#define GAUSSIAN_SD REAL_CONST(0.5)
+
+//! The number of times each buffer is emptied
+#define N_FILLS 4
+
+//! The number of variates used before the buffer is topped up
+#define N_USED_BEFORE_TOP_UP 5
+
+//! The number of Poisson counts drawn
+#define N_POISSON 1000
+
+static const mars_kiss64_seed_t initial_seed = {12345, 67890, 13579, 24680};
+
+//! The seed of the buffers, and that of the variates drawn one at a time
+static mars_kiss64_seed_t buffer_seed;
+static mars_kiss64_seed_t single_seed;
+
+static random_buffer_t buffer;
+
+static void _reset(void) {
+    for (uint32_t i = 0; i < 4; i++) {
+        buffer_seed[i] = initial_seed[i];
+        single_seed[i] = initial_seed[i];
+    }
+    validate_mars_kiss64_seed(buffer_seed);
+    validate_mars_kiss64_seed(single_seed);
+    random_buffer_initialize(
+        &buffer, buffer_seed, ISI_SCALE_FACTOR, GAUSSIAN_SD);
+}
+
+/* THE VARIATES DRAWN ONE AT A TIME, AS SPIKE_SOURCE_POISSON.C DID */
+
+static uint32_t _single_uniform(void) {
+    return mars_kiss64_seed(single_seed);
+}
+
+static uint32_t _single_exponential(void) {
+    return (uint32_t) roundk(exponential_dist_variate(
+        mars_kiss64_seed, single_seed) * ISI_SCALE_FACTOR, 15);
+}
+
+static accum _single_gaussian(void) {
+    return gaussian_dist_variate(mars_kiss64_seed, single_seed) * GAUSSIAN_SD;
+}
+
+/* THE TEST */
+
+//! \brief Checks the variates of one kind taken from the buffer against
+//!        those drawn one at a time, for several fills of the buffer, and
+//!        for a buffer topped up after only some are used; bits gives the
+//!        bits of a variate to print
+#define CHECK_VARIATES(kind, type, bits) \
+    static void _check_##kind##s(void) { \
+        _reset(); \
+        for (uint32_t fill = 0; fill < N_FILLS; fill++) { \
+            type expected[RANDOM_BUFFER_SIZE]; \
+            for (uint32_t i = 0; i < RANDOM_BUFFER_SIZE; i++) { \
+                expected[i] = _single_##kind(); \
+            } \
+            for (uint32_t i = RANDOM_BUFFER_SIZE; i > 0; i--) { \
+                type value = random_buffer_##kind(&buffer); \
+                if (value != expected[i - 1]) { \
+                    test_fail(#kind " %u of fill %u is %d, not %d", \
+                        i - 1, fill, (int) bits(value), \
+                        (int) bits(expected[i - 1])); \
+                } \
+            } \
+        } \
+        for (uint32_t i = 0; i < RANDOM_BUFFER_SIZE; i++) { \
+            _single_##kind(); \
+        } \
+        for (uint32_t i = 0; i < N_USED_BEFORE_TOP_UP; i++) { \
+            random_buffer_##kind(&buffer); \
+        } \
+        random_buffer_fill_##kind##s(&buffer); \
+        for (uint32_t i = RANDOM_BUFFER_SIZE - N_USED_BEFORE_TOP_UP; \
+                i < RANDOM_BUFFER_SIZE; i++) { \
+            type expected = _single_##kind(); \
+            if (buffer.kind##s[i] != expected) { \
+                test_fail(#kind " %u topped up is %d, not %d", \
+                    i, (int) bits(buffer.kind##s[i]), (int) bits(expected)); \
+            } \
+        } \
+    }
+
+CHECK_VARIATES(uniform, uint32_t, )
+CHECK_VARIATES(exponential, uint32_t, )
+CHECK_VARIATES(gaussian, accum, bitsk)
+
+//! The uniform variates in the order the buffer hands them out, for
+//! poisson_dist_variate_exp_minus_lambda to draw from
+static uint32_t replay[RANDOM_BUFFER_SIZE];
+static uint32_t n_replay;
+
+static uint32_t _replay_uniform(uint32_t *seed) {
+    use(seed);
+    if (n_replay == 0) {
+        for (uint32_t i = 0; i < RANDOM_BUFFER_SIZE; i++) {
+            replay[i] = _single_uniform();
+        }
+        n_replay = RANDOM_BUFFER_SIZE;
+    }
+    return replay[--n_replay];
+}
+
+//! \brief Checks the Poisson counts made from the buffered uniform variates
+static void _check_poisson(void) {
+    _reset();
+    n_replay = 0;
+    unsigned long fract exp_minus_lambda = (UFRACT) EXP(-REAL_CONST(1.5));
+    for (uint32_t i = 0; i < N_POISSON; i++) {
+        uint32_t value = random_buffer_poisson_exp_minus_lambda(
+            &buffer, exp_minus_lambda);
+        uint32_t expected = poisson_dist_variate_exp_minus_lambda(
+            _replay_uniform, single_seed, exp_minus_lambda);
+        if (value != expected) {
+            test_fail("Poisson count %u is %u, not %u", i, value, expected);
+        }
+    }
+}
+
+int main(void) {
+    _check_uniforms();
+    _check_exponentials();
+    _check_gaussians();
+    _check_poisson();
+
+    return test_finish("%u fills of %u variates", N_FILLS, RANDOM_BUFFER_SIZE);
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Test of the handling of repeated spikes by spike_processing.c
+ *
+ *  spike_processing.c is built with the binary search master population
+ *  table and stand-ins for the synapses and for the procedural and
+ *  convolution synapses that count the spikes each sees.  Spikes are
+ *  received in runs of the same key before they are processed, so that a
+ *  row read for one spike of a run is processed again for the rest, and
+ *  the test checks that every spike is seen by the synapses of each kind
+ *  it is from, including those from sources with only procedural synapses.
+ *  Then the rows are written back as plastic rows are, and the test checks
+ *  that once the DMA is held for the rows in SDRAM to be changed, the rows
+ *  being processed have been, and no more are read until it is released.
+ *
+ *      spike_processing_test
+ */
+
+// The SpiNNaker headers must come before the system ones (see
+// common-typedefs.h)
+#include <common/neuron-typedefs.h>
+#include <neuron/spike_processing.h>
+#include <neuron/population_table/population_table.h>
+#include <neuron/synapses.h>
+#include <neuron/synapse_row.h>
+#include <host_api.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "test_assert.h"
+
+//! The neurons of each source population
+#define N_SOURCE_NEURONS 256
+
+//! The key of the source with a row in SDRAM for each neuron
+#define ROW_KEY 0x10000
+
+//! The key of the source with only procedural and convolution synapses,
+//! so not in the master population table
+#define PROCEDURAL_KEY 0x20000
+
+#define KEY_MASK 0xFFFFFF00
+
+//! The neurons of each source that spike
+#define N_SPIKING 16
+
+//! The words of a row: the header and one fixed synapse, which the test
+//! sets to the index of the source neuron so that it knows the row
+#define ROW_WORDS (N_SYNAPSE_ROW_HEADER_WORDS + 1)
+
+//! The DTCM buffers for rows being read
+#define N_DMA_BUFFERS 2
+
+//! The size of the memory standing in for SDRAM
+#define ARENA_BYTES (1024 * 1024)
+
+uint32_t time;
+
+//! The number of times each row was processed
+static uint32_t n_rows_processed[N_SOURCE_NEURONS];
+
+//! Whether the rows are written back once processed, as plastic rows are
+static bool write_back_rows = false;
+
+//! The number of spikes of each key seen by the procedural and convolution
+//! synapses
+static uint32_t n_procedural_spikes[2][N_SOURCE_NEURONS];
+static uint32_t n_convolution_spikes[2][N_SOURCE_NEURONS];
+
+static inline uint32_t _source_index(spike_t spike) {
+    return ((spike & KEY_MASK) == PROCEDURAL_KEY) ? 1 : 0;
+}
+
+/* STAND-INS FOR THE SYNAPSES USED BY SPIKE_PROCESSING.C */
+
+bool synapses_process_synaptic_row(
+        uint32_t time, synaptic_row_t row, address_t sdram_row_address,
+        bool write, uint32_t process_id) {
+    use(time);
+    use(sdram_row_address);
+    n_rows_processed[row[N_SYNAPSE_ROW_HEADER_WORDS]] += 1;
+    if (write && write_back_rows) {
+        spike_processing_finish_write(process_id, 1);
+    }
+    return true;
+}
+
+bool procedural_synapses_process_spike(uint32_t time, spike_t spike) {
+    use(time);
+    n_procedural_spikes[_source_index(spike)][spike & ~KEY_MASK] += 1;
+    return true;
+}
+
+bool convolution_synapses_process_spike(uint32_t time, spike_t spike) {
+    use(time);
+    n_convolution_spikes[_source_index(spike)][spike & ~KEY_MASK] += 1;
+    return true;
+}
+
+void synaptogenesis_dynamics_rewire(uint32_t time) {
+    use(time);
+}
+
+/* THE TEST */
+
+//! \brief Writes a master population table with an entry for the source
+//!        with rows, and the rows it points at
+static address_t _make_table(address_t *synaptic_matrix) {
+    *synaptic_matrix = host_sdram_alloc(
+        N_SOURCE_NEURONS * ROW_WORDS * sizeof(uint32_t));
+    for (uint32_t i = 0; i < N_SOURCE_NEURONS; i++) {
+        address_t row = &(*synaptic_matrix)[i * ROW_WORDS];
+        row[1] = 1;
+        row[N_SYNAPSE_ROW_HEADER_WORDS] = i;
+    }
+
+    // The entry (key, mask, start and count) and its address and row length,
+    // with no connectivity bit field
+    address_t region = host_sdram_alloc(7 * sizeof(uint32_t));
+    region[0] = 1;
+    region[1] = 1;
+    region[2] = ROW_KEY;
+    region[3] = KEY_MASK;
+    region[4] = 0 | (1 << 16);
+    region[5] = 1;
+    region[6] = 0;
+    return region;
+}
+
+int main(void) {
+    host_initialise(ARENA_BYTES);
+
+    address_t synaptic_matrix;
+    address_t table = _make_table(&synaptic_matrix);
+    uint32_t row_max_n_words;
+    if (!population_table_initialise(
+            table, synaptic_matrix, NULL, &row_max_n_words)) {
+        test_fail("population_table_initialise");
+        return 1;
+    }
+    if (!spike_processing_initialise(
+            row_max_n_words, N_DMA_BUFFERS, 0, 0, 256)) {
+        test_fail("spike_processing_initialise");
+        return 1;
+    }
+
+    // Receive runs of each key before processing any, with the procedural
+    // source between those of the source with rows
+    uint32_t n_sent[N_SOURCE_NEURONS];
+    uint32_t n_spikes = 0;
+    for (uint32_t i = 0; i < N_SPIKING; i++) {
+        n_sent[i] = 1 + (i % 4);
+        for (uint32_t j = 0; j < n_sent[i]; j++) {
+            host_deliver_mc_packet(ROW_KEY | i, 0, false);
+        }
+        for (uint32_t j = 0; j < n_sent[i]; j++) {
+            host_deliver_mc_packet(PROCEDURAL_KEY | i, 0, false);
+        }
+        n_spikes += 2 * n_sent[i];
+    }
+    host_run_pending_events();
+
+    uint32_t n_row_spikes = 0;
+    for (uint32_t i = 0; i < N_SPIKING; i++) {
+        n_row_spikes += n_sent[i];
+        if (n_rows_processed[i] != n_sent[i]) {
+            test_fail("row %u processed %u times, not %u",
+                i, n_rows_processed[i], n_sent[i]);
+        }
+        for (uint32_t s = 0; s < 2; s++) {
+            if (n_procedural_spikes[s][i] != n_sent[i]) {
+                test_fail("source %u neuron %u has %u procedural spikes, "
+                    "not %u", s, i, n_procedural_spikes[s][i], n_sent[i]);
+            }
+            if (n_convolution_spikes[s][i] != n_sent[i]) {
+                test_fail("source %u neuron %u has %u convolution spikes, "
+                    "not %u", s, i, n_convolution_spikes[s][i], n_sent[i]);
+            }
+        }
+    }
+
+    // Some spikes must have been processed with the row read for another
+    if (host_n_dmas() >= n_row_spikes) {
+        test_fail("%u rows read for %u spikes",
+            host_n_dmas(), n_row_spikes);
+    }
+
+    // Hold the DMA with rows to be read and written back; they must have
+    // been processed once the hold starts
+    write_back_rows = true;
+    uint32_t n_dmas = host_n_dmas();
+    for (uint32_t i = 0; i < N_SPIKING; i++) {
+        host_deliver_mc_packet(ROW_KEY | i, 0, false);
+    }
+    spike_processing_hold_dma();
+    for (uint32_t i = 0; i < N_SPIKING; i++) {
+        if (n_rows_processed[i] != n_sent[i] + 1) {
+            test_fail("row %u processed %u times before the hold",
+                i, n_rows_processed[i]);
+        }
+    }
+    if (host_n_dmas() != n_dmas + (2 * N_SPIKING)) {
+        test_fail("%u rows read and written back for %u spikes",
+            host_n_dmas() - n_dmas, N_SPIKING);
+    }
+
+    // No row is read while the DMA is held, and those of the spikes
+    // received are once it is released
+    host_deliver_mc_packet(ROW_KEY, 0, false);
+    host_run_pending_events();
+    if (n_rows_processed[0] != n_sent[0] + 1) {
+        test_fail("row read while the DMA is held");
+    }
+    spike_processing_release_dma();
+    host_run_pending_events();
+    if (n_rows_processed[0] != n_sent[0] + 2) {
+        test_fail("row not read once the DMA is released");
+    }
+    n_spikes += N_SPIKING + 1;
+
+    return test_finish("%u spikes, %u DMAs", n_spikes, host_n_dmas());
+}
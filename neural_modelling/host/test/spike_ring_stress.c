@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Stress test of the spike ring between two threads
+ *
+ *  A producer thread adds runs of equal keys as fast as it can, retrying
+ *  when the ring is full, while the consumer thread removes them with a mix
+ *  of single, batch and skip-equal operations.  Every key must come out
+ *  once, in order, however the two threads interleave.
+ *
+ *      spike_ring_stress [n_spikes] [ring_size]
+ */
+
+// The SpiNNaker headers must come before the system ones (see
+// common-typedefs.h)
+#include <common-typedefs.h>
+
+// The threads run on different host cores, so need a full memory barrier
+#define spike_ring_fence() __sync_synchronize()
+#include <common/spike_ring.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//! The number of spikes to pass through the ring by default
+#define DEFAULT_N_SPIKES 20000000
+
+//! The number of slots in the ring by default; small so it is often full
+#define DEFAULT_RING_SIZE 64
+
+//! The most spikes taken in one batch
+#define MAX_BATCH 48
+
+static spike_ring ring;
+static uint32_t n_spikes;
+
+/* STAND-INS FOR THE FEW RUN-TIME FUNCTIONS THE RING USES */
+
+void *spin1_malloc(uint bytes) {
+    return malloc(bytes);
+}
+
+void io_printf(char *stream, char *format, ...) {
+    use(stream);
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+/* THE TEST */
+
+//! \brief The key of a spike; keys repeat in runs of 4 so that skip-equal
+//!        has something to skip
+static inline uint32_t key_of(uint32_t i) {
+    return i >> 2;
+}
+
+static void *producer(void *arg) {
+    use(arg);
+    uint32_t i = 0;
+    while (i < n_spikes) {
+        if (spike_ring_add(ring, key_of(i))) {
+            i++;
+        } else {
+            // Let the consumer run if it shares a host core
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void fail(uint32_t expected, uint32_t got, const char *how) {
+    printf("FAIL: spike %u by %s was 0x%08x, expected 0x%08x\n",
+        expected, how, got, key_of(expected));
+    exit(1);
+}
+
+static void *consumer(void *arg) {
+    use(arg);
+    uint32_t batch[MAX_BATCH];
+    uint32_t next = 0;
+    uint32_t op = 0;
+    while (next < n_spikes) {
+        if (spike_ring_size(ring) == 0) {
+            sched_yield();
+        }
+        uint32_t spike;
+        switch (op++ % 3) {
+        case 0:
+            if (spike_ring_get_next(ring, &spike)) {
+                if (spike != key_of(next)) {
+                    fail(next, spike, "get_next");
+                }
+                next++;
+
+                // All the following copies must go, and no more
+                uint32_t n_skipped = spike_ring_skip_equal(ring, spike);
+                for (uint32_t i = 0; i < n_skipped; i++, next++) {
+                    if (key_of(next) != spike) {
+                        fail(next, spike, "skip_equal");
+                    }
+                }
+            }
+            break;
+        default: {
+            uint32_t n = spike_ring_get_batch(
+                ring, batch, 1 + (op % MAX_BATCH));
+            for (uint32_t i = 0; i < n; i++, next++) {
+                if (batch[i] != key_of(next)) {
+                    fail(next, batch[i], "get_batch");
+                }
+            }
+            break;
+        }
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    n_spikes = (argc > 1) ? strtoul(argv[1], NULL, 0) : DEFAULT_N_SPIKES;
+    uint32_t ring_size =
+        (argc > 2) ? strtoul(argv[2], NULL, 0) : DEFAULT_RING_SIZE;
+
+    ring = spike_ring_initialize(ring_size);
+    if (ring == NULL) {
+        printf("FAIL: could not allocate the ring\n");
+        return 1;
+    }
+
+    pthread_t producer_thread, consumer_thread;
+    pthread_create(&consumer_thread, NULL, consumer, NULL);
+    pthread_create(&producer_thread, NULL, producer, NULL);
+    pthread_join(producer_thread, NULL);
+    pthread_join(consumer_thread, NULL);
+
+    if (spike_ring_size(ring) != 0) {
+        printf("FAIL: %u spikes left in the ring\n", spike_ring_size(ring));
+        return 1;
+    }
+    printf("PASS: %u spikes through a ring of %u, %u times full\n",
+        n_spikes, spike_ring_index_mask(ring) + 1,
+        spike_ring_get_n_overflows(ring));
+    return 0;
+}
@@ -0,0 +1,327 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Test of the timing wheel that schedules the Poisson sources
+ *
+ *  spike_source_poisson.c is included so that the test can set up the
+ *  sources and look at the wheel directly, and the ticks are run by calling
+ *  its timer work for each tick in turn.  The test checks that sources are
+ *  put in the slots of the ticks they are due, that sources due on later
+ *  turns of the wheel spike on their own tick and not before, and that
+ *  taking the sources out of the schedule at a pause and scheduling them
+ *  again on resume puts each back where it was.
+ *
+ *      spike_source_poisson_schedule_test
+ */
+
+#define APPLICATION_NAME_HASH 0
+
+#include <spike_source/poisson/spike_source_poisson.c>
+#include "c_main_test.h"
+#include "test_assert.h"
+
+#include <stdio.h>
+
+//! The number of sources
+#define N_SOURCES 64
+
+//! The last tick at which the slow sources first spike; more than two
+//! turns of the wheel
+#define MAX_FIRST_SPIKE_TICK 600
+
+//! The tick at which the sources end
+#define END_TICK 2000
+
+//! The tick at which the delayed fast source starts
+#define FAST_START_TICK 10
+
+//! The source whose first spike is after it ends
+#define AFTER_END_SOURCE (N_SOURCES - 1)
+
+//! The source that is fast from the start, and the one that starts later
+#define FAST_SOURCE (N_SOURCES - 2)
+#define DELAYED_FAST_SOURCE (N_SOURCES - 3)
+
+//! The number of slow sources that spike
+#define N_SLOW_SOURCES (N_SOURCES - 3)
+
+//! The size of the memory standing in for DTCM and SDRAM
+#define ARENA_BYTES (1024 * 1024)
+
+/* THE TEST */
+
+//! \brief The tick at which each slow source first spikes
+static inline uint32_t _first_spike_tick(uint32_t s) {
+    return (s * 37) % MAX_FIRST_SPIKE_TICK;
+}
+
+//! \brief Sets up the sources: slow sources first spiking at ticks spread
+//!        over several turns of the wheel, a fast source active from the
+//!        start, one starting later, and a slow source that ends before it
+//!        spikes
+static void _make_sources(void) {
+    host_initialise(ARENA_BYTES);
+    global_parameters.n_spike_sources = N_SOURCES;
+    global_parameters.has_key = false;
+    poisson_parameters = spin1_malloc(N_SOURCES * sizeof(spike_source_t));
+    for (uint32_t s = 0; s < N_SOURCES; s++) {
+        spike_source_t *source = &poisson_parameters[s];
+        source->start_ticks = 0;
+        source->end_ticks = END_TICK;
+        source->is_fast_source = false;
+        source->exp_minus_lambda = UFRACT_CONST(0.0);
+        source->sqrt_lambda = REAL_CONST(0.0);
+        source->mean_isi_ticks = 100;
+        source->time_to_spike_ticks =
+            (_first_spike_tick(s) * ISI_SCALE_FACTOR) + (s % 7) * 100;
+    }
+    poisson_parameters[FAST_SOURCE].is_fast_source = true;
+    poisson_parameters[FAST_SOURCE].exp_minus_lambda = UFRACT_CONST(0.5);
+    poisson_parameters[DELAYED_FAST_SOURCE].is_fast_source = true;
+    poisson_parameters[DELAYED_FAST_SOURCE].exp_minus_lambda =
+        UFRACT_CONST(0.5);
+    poisson_parameters[DELAYED_FAST_SOURCE].start_ticks = FAST_START_TICK;
+    poisson_parameters[AFTER_END_SOURCE].end_ticks = 5;
+    poisson_parameters[AFTER_END_SOURCE].time_to_spike_ticks =
+        300 * ISI_SCALE_FACTOR;
+
+    for (uint32_t i = 0; i < 4; i++) {
+        global_parameters.spike_source_seed[i] = i + 1;
+    }
+    validate_mars_kiss64_seed(global_parameters.spike_source_seed);
+    random_buffer_initialize(
+        &random_buffer, global_parameters.spike_source_seed,
+        ISI_SCALE_FACTOR, REAL_CONST(0.5));
+    random_buffer_fill(&random_buffer);
+
+    // Record the spikes of each tick so that the test can see them
+    recording_flags = 1;
+    n_spike_buffer_words = get_bit_field_size(N_SOURCES);
+    spike_buffer_size = n_spike_buffer_words * sizeof(uint32_t);
+    spikes = NULL;
+    n_spike_buffers_allocated = 0;
+
+    if (!initialise_schedule()) {
+        test_fail("initialise_schedule");
+    }
+}
+
+//! \brief Checks that the lists of the wheel are linked both ways, that
+//!        every source in them is in the slot of its due tick, which is
+//!        not before the next tick, and that every source in the wheel is
+//!        in a list
+static void _check_wheel(const char *test, uint32_t next_tick) {
+    uint32_t n_in_lists = 0;
+    for (uint32_t slot = 0; slot < N_WHEEL_SLOTS; slot++) {
+        uint32_t prev = NO_SOURCE;
+        for (uint32_t s = wheel[slot]; s != NO_SOURCE; s = schedule[s].next) {
+            if (schedule[s].prev != prev) {
+                test_fail("%s: source %u has the wrong previous source %u",
+                    test, s, schedule[s].prev);
+            }
+            if (schedule[s].place != IN_WHEEL) {
+                test_fail("%s: source %u in slot %u is not marked in the wheel",
+                    test, s, slot);
+            }
+            if ((schedule[s].due_tick & WHEEL_SLOT_MASK) != slot) {
+                test_fail("%s: source %u due at %u is in the wrong slot",
+                    test, s, schedule[s].due_tick);
+            }
+            if (schedule[s].due_tick < next_tick) {
+                test_fail("%s: source %u was due at %u and was missed",
+                    test, s, schedule[s].due_tick);
+            }
+            prev = s;
+            n_in_lists += 1;
+        }
+    }
+    uint32_t n_in_wheel = 0;
+    for (uint32_t s = 0; s < N_SOURCES; s++) {
+        if (schedule[s].place == IN_WHEEL) {
+            n_in_wheel += 1;
+        }
+    }
+    if (n_in_lists != n_in_wheel) {
+        test_fail("%s: %u sources in the lists but %u in the wheel",
+            test, n_in_lists, n_in_wheel);
+    }
+}
+
+//! \brief Checks that each source is first put where it should be
+static void _test_insertion(void) {
+    _make_sources();
+    _schedule_sources(0);
+    _check_wheel("insertion", 0);
+
+    for (uint32_t s = 0; s < N_SLOW_SOURCES; s++) {
+        if (schedule[s].place != IN_WHEEL
+                || schedule[s].due_tick != _first_spike_tick(s)) {
+            test_fail("insertion: source %u is not due at tick %u",
+                s, _first_spike_tick(s));
+        }
+
+        // Only the part of the time to spike within the tick is kept
+        if (poisson_parameters[s].time_to_spike_ticks != (s % 7) * 100) {
+            test_fail("insertion: source %u has %u left to spike",
+                s, poisson_parameters[s].time_to_spike_ticks);
+        }
+    }
+    if (schedule[FAST_SOURCE].place != IN_FAST_SOURCES
+            || n_fast_sources != 1 || fast_sources[0] != FAST_SOURCE) {
+        test_fail("insertion: fast source %u is not in the %u fast sources",
+            FAST_SOURCE, n_fast_sources);
+    }
+    if (schedule[DELAYED_FAST_SOURCE].place != IN_WHEEL
+            || schedule[DELAYED_FAST_SOURCE].due_tick != FAST_START_TICK) {
+        test_fail("insertion: fast source %u is not waiting for tick %u",
+            DELAYED_FAST_SOURCE, FAST_START_TICK);
+    }
+    if (schedule[AFTER_END_SOURCE].place != AFTER_END) {
+        test_fail("insertion: source %u is scheduled %u after it ends",
+            AFTER_END_SOURCE, schedule[AFTER_END_SOURCE].place);
+    }
+}
+
+//! \brief Runs the wheel for a tick, as the timer callback does
+//! \param[in] tick: the tick to run
+//! \param[out] spiked: whether each source spiked, as a bit field
+static void _run_tick(uint32_t tick, uint32_t *spiked) {
+    time = tick;
+    _process_wheel(0);
+    clear_bit_field(spiked, n_spike_buffer_words);
+    if (spikes != NULL && spikes->n_buffers > 0) {
+        for (uint32_t w = 0; w < n_spike_buffer_words; w++) {
+            spiked[w] = _out_spikes(0)[w];
+        }
+        _reset_spikes();
+    }
+    random_buffer_fill(&random_buffer);
+}
+
+//! \brief Checks that each slow source first spikes on the tick it is due,
+//!        even when that is on a later turn of the wheel than its slot
+//!        first comes around, and that fast sources start on time
+static void _test_wrap_around(void) {
+    _make_sources();
+    _schedule_sources(0);
+
+    uint32_t first_spike[N_SOURCES];
+    for (uint32_t s = 0; s < N_SOURCES; s++) {
+        first_spike[s] = UINT32_MAX;
+    }
+    uint32_t spiked[get_bit_field_size(N_SOURCES)];
+    for (uint32_t tick = 0; tick <= MAX_FIRST_SPIKE_TICK; tick++) {
+        _run_tick(tick, spiked);
+        for (uint32_t s = 0; s < N_SOURCES; s++) {
+            if (bit_field_test(spiked, s) && first_spike[s] == UINT32_MAX) {
+                first_spike[s] = tick;
+            }
+        }
+        _check_wheel("wrap-around", tick + 1);
+        if (tick == FAST_START_TICK - 1
+                && schedule[DELAYED_FAST_SOURCE].place != IN_WHEEL) {
+            test_fail("wrap-around: fast source %u started before tick %u",
+                DELAYED_FAST_SOURCE, FAST_START_TICK);
+        }
+        if (tick == FAST_START_TICK
+                && schedule[DELAYED_FAST_SOURCE].place != IN_FAST_SOURCES) {
+            test_fail("wrap-around: fast source %u did not start at tick %u",
+                DELAYED_FAST_SOURCE, FAST_START_TICK);
+        }
+    }
+
+    for (uint32_t s = 0; s < N_SLOW_SOURCES; s++) {
+        if (first_spike[s] != _first_spike_tick(s)) {
+            test_fail("wrap-around: source %u first spiked at tick %u",
+                s, first_spike[s]);
+        }
+    }
+    if (first_spike[AFTER_END_SOURCE] != UINT32_MAX) {
+        test_fail("wrap-around: source %u spiked at tick %u after it ended",
+            AFTER_END_SOURCE, first_spike[AFTER_END_SOURCE]);
+    }
+}
+
+//! \brief Checks that pausing and resuming leaves every source where it was
+static void _test_pause_resume(void) {
+    _make_sources();
+    _schedule_sources(0);
+    uint32_t spiked[get_bit_field_size(N_SOURCES)];
+    for (uint32_t tick = 0; tick < 300; tick++) {
+        _run_tick(tick, spiked);
+    }
+
+    source_schedule_t before[N_SOURCES];
+    uint32_t time_to_spike_before[N_SOURCES];
+    for (uint32_t s = 0; s < N_SOURCES; s++) {
+        before[s] = schedule[s];
+        time_to_spike_before[s] = poisson_parameters[s].time_to_spike_ticks;
+    }
+
+    // Pausing puts the whole time to spike back in the parameters, as they
+    // are written to SDRAM then
+    uint32_t next_tick = 300;
+    _unschedule_sources(next_tick);
+    for (uint32_t s = 0; s < N_SLOW_SOURCES; s++) {
+        uint32_t expected = time_to_spike_before[s] +
+            (before[s].due_tick - next_tick) * ISI_SCALE_FACTOR;
+        if (poisson_parameters[s].time_to_spike_ticks != expected) {
+            test_fail("pause: source %u has %u left to spike",
+                s, poisson_parameters[s].time_to_spike_ticks);
+        }
+    }
+    for (uint32_t slot = 0; slot < N_WHEEL_SLOTS; slot++) {
+        if (wheel[slot] != NO_SOURCE) {
+            test_fail("pause: slot %u still has source %u", slot, wheel[slot]);
+        }
+    }
+
+    // Resuming puts each source back where it was; the source that has
+    // ended is not scheduled again
+    _schedule_sources(next_tick);
+    _check_wheel("resume", next_tick);
+    if (schedule[AFTER_END_SOURCE].place != NOT_SCHEDULED) {
+        test_fail("resume: source %u that has ended is in place %u",
+            AFTER_END_SOURCE, schedule[AFTER_END_SOURCE].place);
+    }
+    for (uint32_t s = 0; s < AFTER_END_SOURCE; s++) {
+        if (schedule[s].place != before[s].place
+                || ((before[s].place == IN_WHEEL)
+                    && (schedule[s].due_tick != before[s].due_tick))) {
+            test_fail("resume: source %u is now due at tick %u",
+                s, schedule[s].due_tick);
+        }
+        if (poisson_parameters[s].time_to_spike_ticks
+                != time_to_spike_before[s]) {
+            test_fail("resume: source %u has %u left to spike",
+                s, poisson_parameters[s].time_to_spike_ticks);
+        }
+    }
+    if (n_fast_sources != 2) {
+        test_fail("resume: %u fast sources, not %u", n_fast_sources, 2);
+    }
+}
+
+int main(void) {
+    _test_insertion();
+    _test_wrap_around();
+    _test_pause_resume();
+
+    return test_finish("%u sources", N_SOURCES);
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Test of the parsing of the SDP messages of many Poisson rates
+ *
+ *  spike_source_poisson.c is included so that the test can look at the
+ *  rates queued for the next tick.  Messages are laid out as
+ *  SpynnakerPoissonControlConnection sends them: an SDP header followed by
+ *  the words of a RATES_LIST or RATES_RANGE command, with the length of the
+ *  message counting the header.  The test checks that the rates of the
+ *  sources of the core are queued, once for each source with the last rate
+ *  given, that those of other cores are ignored, and that messages whose
+ *  counts do not fit their length are ignored altogether.
+ *
+ *      spike_source_poisson_sdp_test
+ */
+
+#define APPLICATION_NAME_HASH 0
+
+#include <spike_source/poisson/spike_source_poisson.c>
+#include "c_main_test.h"
+#include "test_assert.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//! The number of sources on the core
+#define N_SOURCES 100
+
+//! The ID of the first source on the core
+#define FIRST_SOURCE_ID 200
+
+//! The most rates in one RATES_RANGE message, as in
+//! SpynnakerPoissonControlConnection
+#define MAX_RATES_PER_RANGE 65
+
+//! The size of the memory standing in for DTCM
+#define ARENA_BYTES (64 * 1024)
+
+//! The message being delivered, which is in the arena so that its address
+//! fits in the mailbox given to the callback
+static sdp_msg_t *msg;
+
+//! \brief Sets up the core with no rates queued
+static void _make_sources(void) {
+    host_initialise(ARENA_BYTES);
+    global_parameters.n_spike_sources = N_SOURCES;
+    global_parameters.first_source_id = FIRST_SOURCE_ID;
+    if (!initialise_schedule()) {
+        test_fail("initialise_schedule");
+    }
+    msg = spin1_malloc(sizeof(sdp_msg_t));
+}
+
+//! \brief Delivers a message of the given words after the SDP header
+static void _deliver(const uint32_t *words, uint32_t n_words) {
+    memset(msg, 0, sizeof(sdp_msg_t));
+    msg->flags = 0x07;
+    msg->tag = 0xFF;
+    msg->dest_port = (POISSON_RATE_SDP_PORT << 5) | 1;
+    msg->length = SDP_HEADER_BYTES + (n_words * sizeof(uint32_t));
+    memcpy(&msg->cmd_rc, words, n_words * sizeof(uint32_t));
+    sdp_packet_callback((uint) (uintptr_t) msg, 0);
+}
+
+//! \brief The rate of a source in the messages of the test
+static inline REAL _rate(uint32_t id) {
+    return kbits((int_k_t) ((id * 3) << 12));
+}
+
+//! \brief Checks that exactly the sources in [first_id, first_id + n) of
+//!        this core are queued, in order, with their _rate()
+static void _check_queued(const char *test, uint32_t first_id, uint32_t n) {
+    uint32_t expected_n = 0;
+    for (uint32_t id = first_id; id < first_id + n; id++) {
+        if (id < FIRST_SOURCE_ID || id >= FIRST_SOURCE_ID + N_SOURCES) {
+            continue;
+        }
+        uint32_t sub_id = id - FIRST_SOURCE_ID;
+        if (expected_n < n_pending_rates
+                && pending_sources[expected_n] != sub_id) {
+            test_fail("%s: queued source %u is %u",
+                test, expected_n, pending_sources[expected_n]);
+        }
+        if (!bit_field_test(pending_rate_set, sub_id)) {
+            test_fail("%s: source %u of %u is not marked as queued",
+                test, sub_id, N_SOURCES);
+        }
+        if (pending_rates[sub_id] != _rate(id)) {
+            test_fail("%s: source %u has rate bits %u",
+                test, sub_id, bitsk(pending_rates[sub_id]));
+        }
+        expected_n += 1;
+    }
+    if (n_pending_rates != expected_n) {
+        test_fail("%s: %u rates queued, not %u",
+            test, n_pending_rates, expected_n);
+    }
+}
+
+//! \brief Checks the rates of a range of sources, which may start and end
+//!        on other cores
+static void _test_range(
+        const char *test, uint32_t first_id, uint32_t n_rates) {
+    _make_sources();
+    uint32_t words[3 + MAX_RATES_PER_RANGE];
+    words[0] = RATES_RANGE;
+    words[1] = first_id;
+    words[2] = n_rates;
+    for (uint32_t i = 0; i < n_rates; i++) {
+        words[3 + i] = bitsk(_rate(first_id + i));
+    }
+    _deliver(words, 3 + n_rates);
+    _check_queued(test, first_id, n_rates);
+}
+
+//! \brief Checks a list of rates with a source given twice and sources of
+//!        other cores
+static void _test_list(void) {
+    _make_sources();
+    uint32_t ids[] = {
+        FIRST_SOURCE_ID + 7, FIRST_SOURCE_ID - 1, FIRST_SOURCE_ID,
+        FIRST_SOURCE_ID + 7, FIRST_SOURCE_ID + N_SOURCES,
+        FIRST_SOURCE_ID + N_SOURCES - 1};
+    uint32_t n_ids = sizeof(ids) / sizeof(ids[0]);
+    uint32_t words[2 + 2 * 6];
+    words[0] = RATES_LIST;
+    words[1] = n_ids;
+    for (uint32_t i = 0; i < n_ids; i++) {
+        words[2 + 2 * i] = ids[i];
+        words[3 + 2 * i] = bitsk(_rate(ids[i]) + i);
+    }
+    _deliver(words, 2 + 2 * n_ids);
+
+    // The source given twice is queued once, with the second rate
+    uint32_t expected_sources[] = {7, 0, N_SOURCES - 1};
+    REAL expected_rates[] = {
+        _rate(FIRST_SOURCE_ID + 7) + 3, _rate(FIRST_SOURCE_ID) + 2,
+        _rate(FIRST_SOURCE_ID + N_SOURCES - 1) + 5};
+    if (n_pending_rates != 3) {
+        test_fail("list: %u rates queued, not %u", n_pending_rates, 3);
+        return;
+    }
+    for (uint32_t i = 0; i < 3; i++) {
+        uint32_t sub_id = pending_sources[i];
+        if (sub_id != expected_sources[i]) {
+            test_fail("list: queued source %u is %u", i, sub_id);
+        } else if (pending_rates[sub_id] != expected_rates[i]) {
+            test_fail("list: source %u has rate bits %u", sub_id,
+                bitsk(pending_rates[sub_id]));
+        }
+    }
+}
+
+//! \brief Checks that messages whose counts do not fit are ignored
+static void _test_malformed(void) {
+    _make_sources();
+
+    // A range of more rates than the message holds
+    uint32_t range[] = {RATES_RANGE, FIRST_SOURCE_ID, 3, 1, 2};
+    _deliver(range, 5);
+
+    // A list of more pairs than the message holds
+    uint32_t list[] = {RATES_LIST, 2, FIRST_SOURCE_ID, 1, FIRST_SOURCE_ID + 1};
+    _deliver(list, 5);
+
+    // Messages too short for their headers, and an unknown command
+    uint32_t short_range[] = {RATES_RANGE, FIRST_SOURCE_ID};
+    _deliver(short_range, 2);
+    uint32_t short_list[] = {RATES_LIST};
+    _deliver(short_list, 1);
+    uint32_t unknown[] = {RATES_RANGE + 1, FIRST_SOURCE_ID, 1, 1};
+    _deliver(unknown, 4);
+
+    if (n_pending_rates != 0) {
+        test_fail("malformed: %u rates queued from %u messages",
+            n_pending_rates, 5);
+    }
+}
+
+int main(void) {
+    _test_range("range", FIRST_SOURCE_ID + 10, 20);
+    _test_range("full range", FIRST_SOURCE_ID, MAX_RATES_PER_RANGE);
+    _test_range("range from before", FIRST_SOURCE_ID - 5, 10);
+    _test_range("range to after", FIRST_SOURCE_ID + N_SOURCES - 5, 10);
+    _test_range("empty range", FIRST_SOURCE_ID, 0);
+    _test_list();
+    _test_malformed();
+
+    return test_finish("%u sources", N_SOURCES);
+}
@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Test of the deferred updates of synapse_dynamics_stdp_mad_impl.c
+ *
+ *  This is built once with each of the pair and nearest pair rules, with
+ *  additive weight dependence.  Rows
+ *  of plastic synapses receive random pre-synaptic spikes while their
+ *  post-synaptic neurons spike now and then, and each row is copied out of
+ *  and back into a stand-in for SDRAM as spike_processing.c does, writing
+ *  back only the words that the synapse dynamics say have changed.  This is
+ *  run with the updates deferred and then with every spike applied at once,
+ *  and the rows must be the same once the deferred updates are applied at
+ *  the end of the run.  The weights delivered must be the same too, unless
+ *  deferred spikes are asked to deliver the weights stored, when they must
+ *  differ.  Finally a spike that changes nothing in a row must not have the
+ *  row written back.
+ *
+ *      synapse_dynamics_stdp_<timing>_test
+ */
+
+// The SpiNNaker headers must come before the system ones (see
+// common-typedefs.h)
+#include <common/neuron-typedefs.h>
+#include <neuron/plasticity/synapse_dynamics.h>
+#include <neuron/synapses.h>
+#include <host_api.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "test_assert.h"
+
+//! The post-synaptic neurons, and the bits of their index in a control word
+#define N_NEURONS 64
+#define INDEX_BITS 6
+
+//! The synapse types, and the bits of the type in a control word
+#define N_SYNAPSE_TYPES 2
+#define TYPE_BITS 1
+
+//! The post-synaptic events remembered per neuron
+#define HISTORY_SIZE 16
+
+//! The most spikes deferred in a row when updates are deferred
+#define MAX_DEFERRED 8
+
+#define N_ROWS 4
+#define N_SYNAPSES 12
+#define N_TICKS 2000
+
+//! The trace and time of the last spike applied to a row, at the start of
+//! the header of its plastic region
+typedef struct test_pre_event_history {
+    pre_trace_t prev_trace;
+    uint32_t prev_time;
+} test_pre_event_history;
+
+#define HISTORY_WORDS (sizeof(test_pre_event_history) / sizeof(uint32_t))
+
+//! The words of the plastic region before the synapses: the last spike
+//! applied, then when spikes are deferred the buckets of the post-synaptic
+//! neurons, the count and listed flag, and the time of each deferred spike
+#define HEADER_WORDS(max_deferred) \
+    (HISTORY_WORDS + (((max_deferred) > 0) ? (2 + (max_deferred)) : 0))
+
+//! The words of the plastic synapses of a row, with a half-word each
+#define SYNAPSE_WORDS ((N_SYNAPSES + 1) / 2)
+
+//! The words of the fixed region: no fixed synapses, the number of plastic
+//! synapses, and a control half-word for each
+#define FIXED_WORDS (2 + SYNAPSE_WORDS)
+
+//! The row that cannot defer updates, as it is given no SDRAM address
+#define DIRECT_ROW (N_ROWS - 1)
+
+//! The size of the memory standing in for SDRAM
+#define ARENA_BYTES (1024 * 1024)
+
+#define N_RING_BUFFERS (1 << (4 + INDEX_BITS + TYPE_BITS))
+
+static weight_t ring_buffers[N_RING_BUFFERS];
+
+/* STAND-INS FOR THE SYNAPSE TYPE FUNCTIONS USED IN DEBUGGING */
+
+const char *synapse_types_get_type_char(index_t synapse_type_index) {
+    use(synapse_type_index);
+    return "?";
+}
+
+/* THE TEST */
+
+static uint32_t rng_state;
+
+static inline uint32_t _rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+//! \brief Writes the synapse dynamics region, with exponential decay tables
+//!        shared between tau plus and tau minus
+static address_t _make_parameters(uint32_t max_deferred, bool approximate) {
+    const uint32_t lut_size = 256;
+    address_t region = host_sdram_alloc(
+        (5 + (lut_size / 2) + (4 * N_SYNAPSE_TYPES)) * sizeof(uint32_t));
+    uint32_t next = 0;
+    region[next++] = HISTORY_SIZE;
+    region[next++] = max_deferred;
+    region[next++] = approximate;
+    region[next++] = lut_size;
+    int16_t *lut = (int16_t *) &region[next];
+    int32_t value = 2048;
+    for (uint32_t i = 0; i < lut_size; i++) {
+        lut[i] = (int16_t) value;
+        value -= value >> 4;
+    }
+    next += lut_size / 2;
+    region[next++] = 1 << 25;
+    for (uint32_t s = 0; s < N_SYNAPSE_TYPES; s++) {
+        region[next++] = 0;
+        region[next++] = 0xFFFF;
+        region[next++] = 300;
+        region[next++] = 330;
+    }
+    return region;
+}
+
+//! \brief Writes a row in SDRAM, the same each run
+static address_t _make_row(
+        uint32_t r, uint32_t max_deferred, bool min_weights) {
+    uint32_t plastic_words = HEADER_WORDS(max_deferred) + SYNAPSE_WORDS;
+    address_t row = host_sdram_alloc(
+        (1 + plastic_words + FIXED_WORDS) * sizeof(uint32_t));
+    memset(row, 0, (1 + plastic_words + FIXED_WORDS) * sizeof(uint32_t));
+    row[0] = plastic_words;
+    address_t plastic = synapse_row_plastic_region(row);
+    address_t fixed = synapse_row_fixed_region(row);
+    weight_t *weights = (weight_t *) &plastic[HEADER_WORDS(max_deferred)];
+    fixed[1] = N_SYNAPSES;
+    control_t *controls = synapse_row_plastic_controls(fixed);
+    for (uint32_t i = 0; i < N_SYNAPSES; i++) {
+
+        // The rows have neurons in some of the same buckets, and row 1 has
+        // the neurons of row 0 but for their top bit
+        uint32_t index = ((r * 11) + i) % N_NEURONS;
+        if (r == 1) {
+            index = i + 32;
+        }
+        uint32_t type = (r + i) % N_SYNAPSE_TYPES;
+        uint32_t delay = 1 + (i % 3);
+        controls[i] = index | (type << INDEX_BITS)
+            | (delay << (INDEX_BITS + TYPE_BITS));
+        weights[i] = min_weights ? 0 : 20000 + (i * 500);
+    }
+    return row;
+}
+
+//! \brief Gets the number of spikes deferred in a row
+static inline uint32_t _n_deferred(address_t row) {
+    address_t plastic = synapse_row_plastic_region(row);
+    return ((uint16_t *) &plastic[HISTORY_WORDS + 1])[0];
+}
+
+//! \brief Processes a spike on a row as spike_processing.c does
+//! \return Whether the update of the row was deferred
+static bool _process_row(
+        address_t sdram_row, uint32_t time, uint32_t max_deferred,
+        weight_t *ring_buffers, bool give_address) {
+    uint32_t row[1 + HEADER_WORDS(MAX_DEFERRED) + SYNAPSE_WORDS + FIXED_WORDS];
+    uint32_t n_words = 1 + sdram_row[0] + FIXED_WORDS;
+    memcpy(row, sdram_row, n_words * sizeof(uint32_t));
+    size_t n_write_back_words;
+    if (!synapse_dynamics_process_plastic_synapses(
+            synapse_row_plastic_region(row), synapse_row_fixed_region(row),
+            ring_buffers, time, give_address ? sdram_row : NULL,
+            &n_write_back_words)) {
+        test_fail("processing a row at time %u", time);
+        return false;
+    }
+    if (n_write_back_words > sdram_row[0]) {
+        test_fail("%zu words written back at time %u",
+            n_write_back_words, time);
+        n_write_back_words = sdram_row[0];
+    }
+    memcpy(&sdram_row[1], &row[1], n_write_back_words * sizeof(uint32_t));
+    return max_deferred > 0 && _n_deferred(sdram_row) > 0;
+}
+
+//! \brief Adds the weights delivered to the ring buffers to a hash of those
+//!        delivered in the run, and empties the ring buffers
+static inline void _hash_delivered(uint64_t *hash) {
+    for (uint32_t i = 0; i < N_RING_BUFFERS; i++) {
+        *hash = (*hash * 31) + ring_buffers[i];
+    }
+    memset(ring_buffers, 0, sizeof(ring_buffers));
+}
+
+//! \brief Runs the network, with the same spikes each time
+//! \return The number of spikes whose updates were deferred
+static uint32_t _run(
+        address_t *rows, uint32_t max_deferred, bool approximate,
+        uint32_t *n_pending, uint64_t *delivered) {
+    uint32_t shifts[N_SYNAPSE_TYPES] = {0};
+    *delivered = 0;
+    memset(ring_buffers, 0, sizeof(ring_buffers));
+    if (synapse_dynamics_initialise(
+            _make_parameters(max_deferred, approximate),
+            N_NEURONS, N_SYNAPSE_TYPES, shifts) == NULL) {
+        test_fail("synapse_dynamics_initialise");
+        return 0;
+    }
+    for (uint32_t r = 0; r < N_ROWS; r++) {
+        rows[r] = _make_row(r, max_deferred, false);
+    }
+
+    rng_state = 12345;
+    uint32_t n_deferred = 0;
+    for (uint32_t time = 1; time < N_TICKS; time++) {
+        for (index_t n = 0; n < N_NEURONS; n++) {
+            if (_rng_next() % 400 == 0) {
+                synapse_dynamics_process_post_synaptic_event(time, n);
+            }
+        }
+        for (uint32_t r = 0; r < N_ROWS; r++) {
+            if (_rng_next() % 4 == 0) {
+                bool deferred = _process_row(rows[r], time, max_deferred,
+                    ring_buffers, r != DIRECT_ROW);
+                if (deferred && r == DIRECT_ROW) {
+                    test_fail("row without an address deferred");
+                }
+                n_deferred += deferred;
+                _hash_delivered(delivered);
+            }
+        }
+    }
+
+    // Count the spikes still deferred, then apply them
+    *n_pending = 0;
+    for (uint32_t r = 0; r < N_ROWS && max_deferred > 0; r++) {
+        *n_pending += _n_deferred(rows[r]);
+    }
+    synapse_dynamics_apply_deferred_updates();
+    for (uint32_t r = 0; r < N_ROWS && max_deferred > 0; r++) {
+        address_t plastic = synapse_row_plastic_region(rows[r]);
+        if (plastic[HISTORY_WORDS + 1] != 0) {
+            test_fail("row %u has spikes deferred after the run", r);
+        }
+    }
+    return n_deferred;
+}
+
+//! \brief Checks that a row is not written back after a spike that changes
+//!        nothing in it: one at the time of the last spike applied, long
+//!        after the last post-synaptic spike, with the weights already at
+//!        the minimum.  The pair rule still adds the spike to the trace in
+//!        the header.
+static void _check_unchanged_row(void) {
+    const uint32_t time = N_TICKS + 1000;
+    address_t row = _make_row(0, 0, true);
+    address_t plastic = synapse_row_plastic_region(row);
+    ((test_pre_event_history *) plastic)->prev_time = time;
+    size_t n_write_back_words;
+    synapse_dynamics_process_plastic_synapses(
+        plastic, synapse_row_fixed_region(row), ring_buffers, time, NULL,
+        &n_write_back_words);
+    size_t expected = (sizeof(pre_trace_t) > 0) ? HISTORY_WORDS : 0;
+    if (n_write_back_words != expected) {
+        test_fail("%zu words of an unchanged row written back, not %zu",
+            n_write_back_words, expected);
+    }
+}
+
+//! \brief Checks that the rows of two runs have the same last spike
+//!        applied and the same weights
+static void _check_same_rows(
+        address_t *rows, uint32_t max_deferred, address_t *expected_rows) {
+    for (uint32_t r = 0; r < N_ROWS; r++) {
+        address_t plastic = synapse_row_plastic_region(rows[r]);
+        address_t expected = synapse_row_plastic_region(expected_rows[r]);
+        if (memcmp(plastic, expected, HISTORY_WORDS * sizeof(uint32_t))) {
+            test_fail("row %u last spike %u, not %u", r,
+                ((test_pre_event_history *) plastic)->prev_time,
+                ((test_pre_event_history *) expected)->prev_time);
+        }
+        weight_t *weights = (weight_t *) &plastic[HEADER_WORDS(max_deferred)];
+        weight_t *expected_weights = (weight_t *) &expected[HEADER_WORDS(0)];
+        for (uint32_t i = 0; i < N_SYNAPSES; i++) {
+            if (weights[i] != expected_weights[i]) {
+                test_fail("row %u synapse %u weight %u, not %u",
+                    r, i, weights[i], expected_weights[i]);
+            }
+        }
+    }
+}
+
+int main(void) {
+    host_initialise(ARENA_BYTES);
+
+    address_t deferred_rows[N_ROWS];
+    address_t approximate_rows[N_ROWS];
+    address_t immediate_rows[N_ROWS];
+    uint32_t n_pending, n_approximate_pending, n_immediate_pending;
+    uint64_t deferred_delivered, approximate_delivered, immediate_delivered;
+    uint32_t n_deferred = _run(deferred_rows, MAX_DEFERRED, false,
+        &n_pending, &deferred_delivered);
+    _run(approximate_rows, MAX_DEFERRED, true, &n_approximate_pending,
+        &approximate_delivered);
+    _run(immediate_rows, 0, false, &n_immediate_pending,
+        &immediate_delivered);
+    if (n_deferred == 0 || n_pending == 0) {
+        test_fail("%u spikes deferred, %u at the end of the run",
+            n_deferred, n_pending);
+    }
+
+    // The last spike applied and the weights are the same either way, and
+    // so are the weights delivered unless they are approximated
+    _check_same_rows(deferred_rows, MAX_DEFERRED, immediate_rows);
+    _check_same_rows(approximate_rows, MAX_DEFERRED, immediate_rows);
+    if (deferred_delivered != immediate_delivered) {
+        test_fail("deferred spikes delivered different weights");
+    }
+    if (approximate_delivered == immediate_delivered) {
+        test_fail("approximated deferred spikes delivered the same "
+            "weights");
+    }
+
+    _check_unchanged_row();
+
+    return test_finish("%u spikes deferred, %u applied at the end",
+        n_deferred, n_pending);
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief The reporting of failed checks shared by the host tests
+ *
+ *  A test reports each check that fails with test_fail(), which goes on
+ *  with the test so that all the failures are seen, and ends with the exit
+ *  status returned by test_finish(), which is not zero if any check failed
+ *  so that make test fails too.
+ */
+
+#ifndef __TEST_ASSERT_H__
+#define __TEST_ASSERT_H__
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+
+//! The number of checks that have failed
+static uint32_t test_n_failures;
+
+//! \brief Reports a check that has failed
+//! \param[in] format: The printf format of what failed, without a newline
+static inline void test_fail(const char *format, ...)
+        __attribute__((format(printf, 1, 2)));
+
+static inline void test_fail(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    printf("FAIL: ");
+    vprintf(format, args);
+    printf("\n");
+    va_end(args);
+    test_n_failures += 1;
+}
+
+//! \brief Prints whether every check passed, with a summary of the test
+//! \param[in] format: The printf format of the summary, without a newline
+//! \return The exit status of the test: 0 if every check passed, or 1
+static inline int test_finish(const char *format, ...)
+        __attribute__((format(printf, 1, 2)));
+
+static inline int test_finish(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    printf("%s: ", test_n_failures == 0 ? "PASS" : "FAIL");
+    vprintf(format, args);
+    printf(", %u failures\n", test_n_failures);
+    va_end(args);
+    return test_n_failures == 0 ? 0 : 1;
+}
+
+#endif // __TEST_ASSERT_H__
@@ -0,0 +1,119 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+# Host build of a neuron binary, included by neural_build.mk when HOST_BUILD
+# is set.  The model sources are compiled unmodified (without the log string
+# replacement of local.mk) against the stand-in SpiNNaker headers in
+# neural_modelling/host/include, and c_main.c is replaced by the benchmark
+# runner in neural_modelling/host/benchmark.
+#
+# The compiler must support the ISO/IEC TR 18037 fixed point types (clang
+# with -ffixed-point does); the default widths of these match those of the
+# ARM GCC used for the machine build.  The neuron parameters of the benchmark
+# are written by host/benchmark/neuron_params.py from the defaults of the
+# PyNN model of the binary, so spynnaker must be importable by HOST_PYTHON.
+#
+#     make HOST_BUILD=1              builds $(HOST_BUILD_DIR)$(APP)_benchmark
+#                                    and the parameters of
+#                                    HOST_BENCHMARK_NEURONS neurons
+#     make HOST_BUILD=1 benchmark    builds and runs it with HOST_BENCHMARK_ARGS
+
+HOST_CC ?= clang
+HOST_OPT ?= -O2
+HOST_DIR := $(abspath $(NEURAL_MODELLING_DIRS)/host)
+HOST_BUILD_DIR := $(NEURAL_MODELLING_DIRS)/builds/host/$(APP)/
+HOST_BENCHMARK := $(HOST_BUILD_DIR)$(APP)_benchmark
+HOST_NEURON_PARAMS := $(abspath $(HOST_BUILD_DIR)$(APP)_params.bin)
+HOST_BENCHMARK_NEURONS ?= 256
+HOST_PYTHON ?= python
+
+# The stand-in headers must be found before any others
+HOST_CFLAGS = $(HOST_OPT) -g -std=gnu99 -ffixed-point -fcommon -Wall \
+              -I $(HOST_DIR)/include $(addprefix -I ,$(sort $(SOURCE_DIRS))) \
+              -DSTDP_ENABLED=$(STDP_ENABLED) -DSYNGEN_ENABLED=$(SYNGEN_ENABLED) \
+              -DPROFILER_ENABLED -DEVENT_DRIVEN_NEURONS=$(EVENT_DRIVEN_NEURONS) \
+              -DHOST_APP_NAME=\"$(APP)\" $(HOST_EXTRA_CFLAGS)
+HOST_LDFLAGS = -lm $(HOST_EXTRA_LDFLAGS)
+
+# The includes refer to modified_src; the host build uses the sources as-is
+define host_source_path#(file)
+$(subst $(MODIFIED_DIR),$(NEURON_DIR)/,$(1))
+endef
+HOST_NEURON_INCLUDES := $(call host_source_path,$(NEURON_INCLUDES))
+HOST_STDP_INCLUDES :=
+ifeq ($(STDP_ENABLED), 1)
+    HOST_STDP_INCLUDES := -include $(call host_source_path,$(WEIGHT_DEPENDENCE_H)) \
+                          -include $(call host_source_path,$(TIMING_DEPENDENCE_H))
+endif
+
+# Find a source (relative to one of SOURCE_DIRS) in the source directories
+define host_find_source#(file)
+$(firstword $(wildcard $(addsuffix /$(1),$(sort $(SOURCE_DIRS)))))
+endef
+
+HOST_MODEL_SOURCES := $(filter-out neuron/c_main.c,$(SOURCES))
+HOST_OBJECTS := $(HOST_MODEL_SOURCES:%.c=$(HOST_BUILD_DIR)%.o) \
+                $(HOST_BUILD_DIR)host/host_api.o \
+                $(HOST_BUILD_DIR)host/neuron_benchmark.o
+
+# The files compiled with the plasticity rules, as in neural_build.mk
+HOST_STDP_OBJECTS := $(HOST_BUILD_DIR)$(SYNAPSE_DYNAMICS:%.c=%.o) \
+                     $(HOST_BUILD_DIR)$(SYNAPTOGENESIS_DYNAMICS:%.c=%.o)
+
+all: $(HOST_BENCHMARK) $(HOST_NEURON_PARAMS)
+
+$(HOST_BENCHMARK): $(HOST_OBJECTS)
+	$(HOST_CC) -o $@ $^ $(HOST_LDFLAGS)
+
+$(HOST_NEURON_PARAMS): $(HOST_DIR)/benchmark/neuron_params.py
+	-@mkdir -p $(dir $@)
+	$(HOST_PYTHON) $< $(APP) $(HOST_BENCHMARK_NEURONS) $@
+
+benchmark: $(HOST_BENCHMARK) $(HOST_NEURON_PARAMS)
+	$(HOST_BENCHMARK) $(HOST_BENCHMARK_ARGS)
+
+$(HOST_BUILD_DIR)neuron/neuron.o: HOST_FILE_FLAGS = \
+        -DLOG_LEVEL=$(NEURON_DEBUG) $(HOST_NEURON_INCLUDES)
+$(HOST_STDP_OBJECTS): HOST_FILE_FLAGS = \
+        -DLOG_LEVEL=$(PLASTIC_DEBUG) $(HOST_STDP_INCLUDES)
+$(HOST_BUILD_DIR)$(TIMING_DEPENDENCE:%.c=%.o): HOST_FILE_FLAGS = \
+        -DLOG_LEVEL=$(PLASTIC_DEBUG) \
+        -include $(call host_source_path,$(WEIGHT_DEPENDENCE_H))
+$(HOST_BUILD_DIR)host/neuron_benchmark.o: HOST_FILE_FLAGS = \
+        -DLOG_LEVEL=$(SYNAPSE_DEBUG) \
+        -DHOST_NEURON_PARAMS_FILE=\"$(HOST_NEURON_PARAMS)\"
+HOST_FILE_FLAGS ?= -DLOG_LEVEL=$(SYNAPSE_DEBUG)
+ifdef WEIGHT_DEPENDENCE
+    $(HOST_BUILD_DIR)$(WEIGHT_DEPENDENCE:%.c=%.o): HOST_FILE_FLAGS = \
+            -DLOG_LEVEL=$(PLASTIC_DEBUG)
+endif
+
+$(HOST_BUILD_DIR)host/host_api.o: $(HOST_DIR)/src/host_api.c
+	-@mkdir -p $(dir $@)
+	$(HOST_CC) $(HOST_CFLAGS) $(HOST_FILE_FLAGS) -c -o $@ $<
+
+$(HOST_BUILD_DIR)host/neuron_benchmark.o: $(HOST_DIR)/benchmark/neuron_benchmark.c
+	-@mkdir -p $(dir $@)
+	$(HOST_CC) $(HOST_CFLAGS) $(HOST_FILE_FLAGS) -c -o $@ $<
+
+.SECONDEXPANSION:
+$(HOST_BUILD_DIR)%.o: $$(call host_find_source,$$*.c)
+	-@mkdir -p $(dir $@)
+	$(HOST_CC) $(HOST_CFLAGS) $(HOST_FILE_FLAGS) -c -o $@ $<
+
+clean:
+	rm -rf $(HOST_BUILD_DIR)
+
+.PHONY: all benchmark clean
@@ -15,9 +15,11 @@
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-# If SPINN_DIRS is not defined, this is an error!
-ifndef SPINN_DIRS
-    $(error SPINN_DIRS is not set.  Please define SPINN_DIRS (possibly by running "source setup" in the spinnaker package folder))
+# If SPINN_DIRS is not defined, this is an error (unless building for the host)!
+ifndef HOST_BUILD
+    ifndef SPINN_DIRS
+        $(error SPINN_DIRS is not set.  Please define SPINN_DIRS (possibly by running "source setup" in the spinnaker package folder))
+    endif
 endif
 
 # If NEURAL_MODELLING_DIRS is not defined, this is an error!
@@ -50,8 +52,15 @@ ifndef PLASTIC_DEBUG
     PLASTIC_DEBUG = LOG_INFO
 endif
 
-#POPULATION_TABLE_IMPL := fixed
-POPULATION_TABLE_IMPL := binary_search
+# The master population table lookup; one of binary_search (the default) or
+# hash_table (constant time lookup, at the cost of a little more DTCM), e.g.
+#     make POPULATION_TABLE_IMPL=hash_table
+POPULATION_TABLE_IMPL ?= binary_search
+
+# Set to 1 to update only the neurons that have input or have not yet decayed
+# to rest each timestep (see neuron/neuron.h), e.g.
+#     make EVENT_DRIVEN_NEURONS=1
+EVENT_DRIVEN_NEURONS ?= 0
 
 # Add source directory
 
@@ -201,10 +210,17 @@ SOURCES = common/out_spikes.c \
           neuron/synapses.c \
           neuron/neuron.c \
           neuron/spike_processing.c \
+          neuron/procedural_synapses.c \
+          neuron/convolution_synapses.c \
+          synapse_expander/rng.c \
           neuron/population_table/population_table_$(POPULATION_TABLE_IMPL)_impl.c \
           $(NEURON_MODEL) $(SYNAPSE_DYNAMICS) $(WEIGHT_DEPENDENCE) \
           $(TIMING_DEPENDENCE) $(SYNAPTOGENESIS_DYNAMICS) $(OTHER_SOURCES_CONVERTED)
 
+# A host build replaces the SpiNNaker build from here on (see host_build.mk)
+ifdef HOST_BUILD
+include $(dir $(MAKEFILE_PATH))host_build.mk
+else
 include $(SPINN_DIRS)/make/local.mk
 
 FEC_OPT = $(OTIME)
@@ -227,8 +243,8 @@ $(BUILD_DIR)neuron/spike_processing.o: $(MODIFIED_DIR)neuron/spike_processing.c
 	-@mkdir -p $(dir $@)
 	$(SYNAPSE_TYPE_COMPILE) -o $@ $<
 
-$(BUILD_DIR)neuron/population_table/population_table_binary_search_impl.o: $(MODIFIED_DIR)neuron/population_table/population_table_binary_search_impl.c
-	#population_table/population_table_binary_search_impl.c
+$(BUILD_DIR)neuron/population_table/population_table_$(POPULATION_TABLE_IMPL)_impl.o: $(MODIFIED_DIR)neuron/population_table/population_table_$(POPULATION_TABLE_IMPL)_impl.c
+	#population_table/population_table_$(POPULATION_TABLE_IMPL)_impl.c
 	-@mkdir -p $(dir $@)
 	$(SYNAPSE_TYPE_COMPILE) -o $@ $<
 
@@ -282,6 +298,8 @@ $(BUILD_DIR)neuron/neuron.o: $(MODIFIED_DIR)neuron/neuron.c $(NEURON_MODEL_H) \
                              $(SYNAPSE_TYPE_H)
 	# neuron.o
 	-@mkdir -p $(dir $@)
-	$(CC) -DLOG_LEVEL=$(NEURON_DEBUG) $(CFLAGS) $(NEURON_INCLUDES) -o $@ $<
+	$(CC) -DLOG_LEVEL=$(NEURON_DEBUG) $(CFLAGS) \
+	        -DEVENT_DRIVEN_NEURONS=$(EVENT_DRIVEN_NEURONS) $(NEURON_INCLUDES) -o $@ $<
 
 .PRECIOUS: $(MODIFIED_DIR)%.c $(MODIFIED_DIR)%.h $(LOG_DICT_FILE) $(EXTRA_PRECIOUS)
+endif
@@ -19,40 +19,58 @@
 #define _IN_SPIKES_H_
 
 #include "neuron-typedefs.h"
-#include <circular_buffer.h>
+#include "spike_ring.h"
 
-static circular_buffer buffer;
+static spike_ring buffer;
 
 // initialize_spike_buffer
 //
 // This function initializes the input spike buffer.
 // It configures:
 //    buffer:     the buffer to hold the spikes (initialized with size spaces)
-//    input:      index for next spike inserted into buffer
-//    output:     index for next spike extracted from buffer
+//    input:      count of the spikes inserted into buffer
+//    output:     count of the spikes extracted from buffer
 //    overflows:  a counter for the number of times the buffer overflows
-//    underflows: a counter for the number of times the buffer underflows
 //
-// If underflows is ever non-zero, then there is a problem with this code.
+// Spikes must only be added by one callback (normally packet reception),
+// and only be removed by callbacks that cannot interrupt each other; neither
+// then needs to disable interrupts.
 static inline bool in_spikes_initialize_spike_buffer(uint32_t size) {
-    buffer = circular_buffer_initialize(size);
+    buffer = spike_ring_initialize(size);
     return buffer != 0;
 }
 
 static inline bool in_spikes_add_spike(spike_t spike) {
-    return circular_buffer_add(buffer, spike);
+    return spike_ring_add(buffer, spike);
 }
 
 static inline bool in_spikes_get_next_spike(spike_t* spike) {
-    return circular_buffer_get_next(buffer, spike);
+    return spike_ring_get_next(buffer, spike);
 }
 
-static inline bool in_spikes_is_next_spike_equal(spike_t spike) {
-    return circular_buffer_advance_if_next_equals(buffer, spike);
+// Removes up to max_spikes of the spikes in the buffer into spikes, and
+// returns the number removed
+static inline uint32_t in_spikes_get_spikes(
+        spike_t *spikes, uint32_t max_spikes) {
+    return spike_ring_get_batch(buffer, spikes, max_spikes);
+}
+
+// Removes the spikes at the front of the buffer that are equal to spike, and
+// returns the number removed
+static inline uint32_t in_spikes_skip_equal_spikes(spike_t spike) {
+    return spike_ring_skip_equal(buffer, spike);
+}
+
+static inline bool in_spikes_is_empty() {
+    return spike_ring_size(buffer) == 0;
+}
+
+static inline uint32_t in_spikes_size() {
+    return spike_ring_size(buffer);
 }
 
 static inline counter_t in_spikes_get_n_buffer_overflows() {
-    return circular_buffer_get_n_buffer_overflows(buffer);
+    return spike_ring_get_n_overflows(buffer);
 }
 
 static inline counter_t in_spikes_get_n_buffer_underflows() {
@@ -60,26 +78,26 @@ static inline counter_t in_spikes_get_n_buffer_underflows() {
 }
 
 static inline void in_spikes_print_buffer() {
-    circular_buffer_print_buffer(buffer);
+    spike_ring_print(buffer);
 }
 
 //---------------------------------------
 // Synaptic rewiring functions
 //---------------------------------------
 static inline uint32_t in_spikes_input_index() {
-    return circular_buffer_input(buffer);
+    return spike_ring_input(buffer);
 }
 
 static inline uint32_t in_spikes_output_index() {
-    return circular_buffer_output(buffer);
+    return spike_ring_output(buffer);
 }
 
 static inline uint32_t in_spikes_real_size() {
-    return circular_buffer_real_size(buffer);
+    return spike_ring_index_mask(buffer);
 }
 
 static inline uint32_t in_spikes_value_at_index(uint32_t index){
-    return circular_buffer_value_at_index(buffer, index);
+    return spike_ring_value_at_index(buffer, index);
 }
 
 #endif // _IN_SPIKES_H_
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Buffers of random variates drawn ahead of time
+ *
+ *  Uniform, exponential and Gaussian variates are drawn from a
+ *  mars_kiss64_seed generator in tight loops into DTCM buffers, which are
+ *  then consumed one variate at a time.  random_buffer_fill tops up all the
+ *  buffers and is meant to be called when there is time to spare, such as
+ *  at the end of a timer tick once the spikes have been sent; a buffer that
+ *  runs out is refilled when the next variate is taken from it.
+ *
+ *  The variates are drawn with the spinn_common functions, so have the same
+ *  distributions as those drawn one at a time, but the exponential and
+ *  Gaussian variates are scaled as they are drawn to save doing so on each
+ *  use.
+ */
+
+#ifndef _RANDOM_BUFFER_H_
+#define _RANDOM_BUFFER_H_
+
+#include <common-typedefs.h>
+#include <random.h>
+#include <stdfix-full-iso.h>
+
+//! The number of variates of each kind held
+#ifndef RANDOM_BUFFER_SIZE
+#define RANDOM_BUFFER_SIZE 64
+#endif
+
+typedef struct random_buffer_t {
+    //! The seed of the generator the variates are drawn from
+    uint32_t *seed;
+    //! The scale of the exponential variates, which are held as integers
+    uint32_t exponential_scale;
+    //! The standard deviation of the Gaussian variates
+    accum gaussian_sd;
+    //! The number of variates in each buffer; these are taken from the end
+    uint32_t n_uniforms;
+    uint32_t n_exponentials;
+    uint32_t n_gaussians;
+    //! Uniformly distributed 32-bit words
+    uint32_t uniforms[RANDOM_BUFFER_SIZE];
+    //! Exponential variates of mean 1, times exponential_scale
+    uint32_t exponentials[RANDOM_BUFFER_SIZE];
+    //! Gaussian variates of mean 0, times gaussian_sd
+    accum gaussians[RANDOM_BUFFER_SIZE];
+} random_buffer_t;
+
+//! \brief Set up an empty set of buffers
+//! \param[out] buffer The buffers to set up
+//! \param[in] seed The seed of the generator to draw from; this must last as
+//!                 long as the buffers
+//! \param[in] exponential_scale The scale of the exponential variates
+//! \param[in] gaussian_sd The standard deviation of the Gaussian variates
+static inline void random_buffer_initialize(
+        random_buffer_t *buffer, uint32_t *seed, uint32_t exponential_scale,
+        accum gaussian_sd) {
+    buffer->seed = seed;
+    buffer->exponential_scale = exponential_scale;
+    buffer->gaussian_sd = gaussian_sd;
+    buffer->n_uniforms = 0;
+    buffer->n_exponentials = 0;
+    buffer->n_gaussians = 0;
+}
+
+//! \brief Top up the uniform variates
+static inline void random_buffer_fill_uniforms(random_buffer_t *buffer) {
+    uint32_t *seed = buffer->seed;
+    for (uint32_t i = buffer->n_uniforms; i < RANDOM_BUFFER_SIZE; i++) {
+        buffer->uniforms[i] = mars_kiss64_seed(seed);
+    }
+    buffer->n_uniforms = RANDOM_BUFFER_SIZE;
+}
+
+//! \brief Top up the exponential variates
+static inline void random_buffer_fill_exponentials(random_buffer_t *buffer) {
+    uint32_t *seed = buffer->seed;
+    uint32_t scale = buffer->exponential_scale;
+    for (uint32_t i = buffer->n_exponentials; i < RANDOM_BUFFER_SIZE; i++) {
+        // Rounding an accum to its 15 fractional bits changes nothing, so
+        // this is the same as the roundk and conversion done before
+        buffer->exponentials[i] = (uint32_t)
+            (exponential_dist_variate(mars_kiss64_seed, seed) * scale);
+    }
+    buffer->n_exponentials = RANDOM_BUFFER_SIZE;
+}
+
+//! \brief Top up the Gaussian variates
+static inline void random_buffer_fill_gaussians(random_buffer_t *buffer) {
+    uint32_t *seed = buffer->seed;
+    accum sd = buffer->gaussian_sd;
+    for (uint32_t i = buffer->n_gaussians; i < RANDOM_BUFFER_SIZE; i++) {
+        buffer->gaussians[i] =
+            gaussian_dist_variate(mars_kiss64_seed, seed) * sd;
+    }
+    buffer->n_gaussians = RANDOM_BUFFER_SIZE;
+}
+
+//! \brief Top up all the buffers
+static inline void random_buffer_fill(random_buffer_t *buffer) {
+    random_buffer_fill_uniforms(buffer);
+    random_buffer_fill_exponentials(buffer);
+    random_buffer_fill_gaussians(buffer);
+}
+
+//! \brief Take a uniformly distributed 32-bit word
+static inline uint32_t random_buffer_uniform(random_buffer_t *buffer) {
+    if (buffer->n_uniforms == 0) {
+        random_buffer_fill_uniforms(buffer);
+    }
+    return buffer->uniforms[--buffer->n_uniforms];
+}
+
+//! \brief Take an exponential variate of mean exponential_scale
+static inline uint32_t random_buffer_exponential(random_buffer_t *buffer) {
+    if (buffer->n_exponentials == 0) {
+        random_buffer_fill_exponentials(buffer);
+    }
+    return buffer->exponentials[--buffer->n_exponentials];
+}
+
+//! \brief Take a Gaussian variate of mean 0 and standard deviation
+//!        gaussian_sd
+static inline accum random_buffer_gaussian(random_buffer_t *buffer) {
+    if (buffer->n_gaussians == 0) {
+        random_buffer_fill_gaussians(buffer);
+    }
+    return buffer->gaussians[--buffer->n_gaussians];
+}
+
+//! \brief Draw a Poisson variate from the uniform variates, as
+//!        poisson_dist_variate_exp_minus_lambda does
+//! \param[in] exp_minus_lambda exp(-lambda), where lambda is the mean
+//! \return The number of events
+static inline uint32_t random_buffer_poisson_exp_minus_lambda(
+        random_buffer_t *buffer, unsigned long fract exp_minus_lambda) {
+    // The largest value below 1
+    unsigned long fract p = ulrbits(UINT32_MAX);
+    uint32_t k = 0;
+    do {
+        k++;
+        p = p * ulrbits(random_buffer_uniform(buffer));
+    } while (p > exp_minus_lambda);
+    return k - 1;
+}
+
+#endif // _RANDOM_BUFFER_H_
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief A single-producer, single-consumer ring of spike keys
+ *
+ *  Spikes are added by one context (the packet received callback) and
+ *  removed by one other (the callbacks processing them).  Only the producer
+ *  writes the input index and only the consumer writes the output index, so
+ *  neither needs to disable interrupts to use the ring.  The indices run
+ *  freely and are masked to index the slots, so every slot can be used.
+ *
+ *  The producer and consumer on a SpiNNaker core only run concurrently by
+ *  one interrupting the other, so spike_ring_fence only has to stop the
+ *  compiler reordering the accesses to the slots and indices; define it
+ *  before including this file to use the ring between threads.
+ */
+
+#ifndef _SPIKE_RING_H_
+#define _SPIKE_RING_H_
+
+#include <common-typedefs.h>
+#include <sark.h>
+#include <spin1_api.h>
+
+#ifndef spike_ring_fence
+#define spike_ring_fence() __asm__ volatile("" ::: "memory")
+#endif
+
+typedef struct _spike_ring {
+    //! The number of slots - 1; the number of slots is a power of two
+    uint32_t mask;
+    //! The count of spikes added; only written by the producer
+    volatile uint32_t input;
+    //! The count of spikes removed; only written by the consumer
+    volatile uint32_t output;
+    //! The number of spikes that could not be added as the ring was full
+    uint32_t overflows;
+    //! The slots
+    uint32_t spikes[];
+} _spike_ring, *spike_ring;
+
+//! \brief Create a ring
+//! \param[in] size The smallest number of spikes to be held; rounded up to a
+//!                 power of two
+//! \return The ring, or NULL if it could not be allocated
+static inline spike_ring spike_ring_initialize(uint32_t size) {
+    uint32_t real_size = 1;
+    while (real_size < size) {
+        real_size <<= 1;
+    }
+    spike_ring ring = (spike_ring) spin1_malloc(
+        sizeof(_spike_ring) + (real_size * sizeof(uint32_t)));
+    if (ring == NULL) {
+        return NULL;
+    }
+    ring->mask = real_size - 1;
+    ring->input = 0;
+    ring->output = 0;
+    ring->overflows = 0;
+    return ring;
+}
+
+//! \brief The number of spikes in the ring
+static inline uint32_t spike_ring_size(spike_ring ring) {
+    return ring->input - ring->output;
+}
+
+//! \brief Add a spike; only to be called by the producer
+//! \return True if there was space for the spike
+static inline bool spike_ring_add(spike_ring ring, uint32_t spike) {
+    uint32_t input = ring->input;
+    if (input - ring->output > ring->mask) {
+        ring->overflows++;
+        return false;
+    }
+    ring->spikes[input & ring->mask] = spike;
+
+    // The spike must be in the slot before the consumer can see it
+    spike_ring_fence();
+    ring->input = input + 1;
+    return true;
+}
+
+//! \brief Remove the oldest spike; only to be called by the consumer
+//! \param[out] spike The spike removed
+//! \return True if there was a spike to remove
+static inline bool spike_ring_get_next(spike_ring ring, uint32_t *spike) {
+    uint32_t output = ring->output;
+    if (ring->input == output) {
+        return false;
+    }
+    spike_ring_fence();
+    *spike = ring->spikes[output & ring->mask];
+
+    // The slot must be read before the producer can reuse it
+    spike_ring_fence();
+    ring->output = output + 1;
+    return true;
+}
+
+//! \brief Remove up to a number of the oldest spikes; only to be called by
+//!        the consumer
+//! \param[out] spikes The spikes removed, oldest first
+//! \param[in] max_spikes The most spikes to remove
+//! \return The number of spikes removed
+static inline uint32_t spike_ring_get_batch(
+        spike_ring ring, uint32_t *spikes, uint32_t max_spikes) {
+    uint32_t output = ring->output;
+    uint32_t n_spikes = ring->input - output;
+    if (n_spikes > max_spikes) {
+        n_spikes = max_spikes;
+    }
+    spike_ring_fence();
+    for (uint32_t i = 0; i < n_spikes; i++) {
+        spikes[i] = ring->spikes[(output + i) & ring->mask];
+    }
+    spike_ring_fence();
+    ring->output = output + n_spikes;
+    return n_spikes;
+}
+
+//! \brief Remove the oldest spikes for as long as they are equal to a given
+//!        spike; only to be called by the consumer
+//! \param[in] spike The spike to remove the copies of
+//! \return The number of spikes removed
+static inline uint32_t spike_ring_skip_equal(
+        spike_ring ring, uint32_t spike) {
+    uint32_t output = ring->output;
+    uint32_t input = ring->input;
+    spike_ring_fence();
+    uint32_t next = output;
+    while (next != input && ring->spikes[next & ring->mask] == spike) {
+        next++;
+    }
+    spike_ring_fence();
+    ring->output = next;
+    return next - output;
+}
+
+//! \brief The number of spikes that could not be added as the ring was full
+static inline uint32_t spike_ring_get_n_overflows(spike_ring ring) {
+    return ring->overflows;
+}
+
+//! \brief The mask to apply to an index into the ring
+static inline uint32_t spike_ring_index_mask(spike_ring ring) {
+    return ring->mask;
+}
+
+//! \brief The count of spikes added, which is the index of the next slot to
+//!        be filled before masking
+static inline uint32_t spike_ring_input(spike_ring ring) {
+    return ring->input;
+}
+
+//! \brief The count of spikes removed, which is the index of the next slot
+//!        to be emptied before masking
+static inline uint32_t spike_ring_output(spike_ring ring) {
+    return ring->output;
+}
+
+//! \brief The spike in a slot, which might have been removed already
+static inline uint32_t spike_ring_value_at_index(
+        spike_ring ring, uint32_t index) {
+    return ring->spikes[index & ring->mask];
+}
+
+static inline void spike_ring_print(spike_ring ring) {
+    io_printf(IO_BUF, "Spikes: input = %u, output = %u elements = {",
+        ring->input, ring->output);
+    for (uint32_t i = ring->output; i != ring->input; i++) {
+        io_printf(IO_BUF, " %u", ring->spikes[i & ring->mask]);
+    }
+    io_printf(IO_BUF, " }\n");
+}
+
+#endif // _SPIKE_RING_H_
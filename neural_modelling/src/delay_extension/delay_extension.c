@@ -39,6 +39,27 @@ typedef enum extra_provenance_data_region_entries{
     N_DELAYS = 5
 } extra_provenance_data_region_entries;
 
+//! The number of spikes taken from the input spikes at once
+#define SPIKE_BATCH_SIZE 16
+
+//! \brief The most neurons listed as having spikes in each delay slot; a slot
+//!        in which more neurons have spikes is scanned in full instead
+#ifndef MAX_SLOT_EVENTS
+#define MAX_SLOT_EVENTS 32
+#endif
+
+//! The most delay stages, as each neuron has a word of delay stage bits
+#define MAX_DELAY_STAGES 32
+
+//! The neurons which have spikes in a delay slot, in order of first spike
+typedef struct slot_events_t {
+    //! The number of neurons listed, or more than max_slot_events if the
+    //! list overflowed and the slot must be scanned in full
+    uint32_t n_events;
+    //! The neurons listed; a core has at most 256 neurons
+    uint8_t neurons[];
+} slot_events_t;
+
 // Globals
 static uint32_t key = 0;
 static uint32_t incoming_key = 0;
@@ -50,11 +71,22 @@ static uint32_t simulation_ticks = 0;
 static uint32_t infinite_run;
 
 static uint8_t **spike_counters = NULL;
-static bit_field_t *neuron_delay_stage_config = NULL;
 static uint32_t num_delay_stages = 0;
 static uint32_t num_delay_slots_mask = 0;
 static uint32_t neuron_bit_field_words = 0;
 
+//! For each neuron, a bit for each delay stage after which it emits spikes
+static uint32_t *neuron_delay_stages = NULL;
+
+//! A bit for each delay stage after which any neuron emits spikes
+static uint32_t active_delay_stages = 0;
+
+//! The neurons which have spikes in each delay slot
+static slot_events_t **slot_events = NULL;
+
+//! The number of neurons that each slot_events_t can list
+static uint32_t max_slot_events = 0;
+
 static uint32_t n_in_spikes = 0;
 static uint32_t n_processed_spikes = 0;
 static uint32_t n_spikes_sent = 0;
@@ -136,29 +168,44 @@ static bool read_parameters(address_t address) {
         "\t random back off = %u, time_between_spikes = %u",
         timer_offset, time_between_spikes);
 
-    // Create array containing a bitfield specifying whether each neuron should
-    // emit spikes after each delay stage
-    neuron_delay_stage_config = (bit_field_t*) spin1_malloc(
-        num_delay_stages * sizeof(bit_field_t));
+    if (num_delay_stages > MAX_DELAY_STAGES) {
+        log_error("Too many delay stages (%u)", num_delay_stages);
+        return false;
+    }
+    if (num_neurons > (UINT8_MAX + 1)) {
+        log_error("Too many neurons (%u)", num_neurons);
+        return false;
+    }
+
+    // Turn the bit-field of the neurons which emit spikes after each delay
+    // stage into a mask of the delay stages of each neuron
+    neuron_delay_stages = (uint32_t *) spin1_malloc(
+        num_neurons * sizeof(uint32_t));
+    if (neuron_delay_stages == NULL) {
+        log_error("Failed to allocate the delay stages of the neurons");
+        return false;
+    }
+    for (uint32_t n = 0; n < num_neurons; n++) {
+        neuron_delay_stages[n] = 0;
+    }
+    active_delay_stages = 0;
 
     // Loop through delay stages
     for (uint32_t d = 0; d < num_delay_stages; d++) {
         log_debug("\t delay stage %u", d);
 
-        // Allocate bit-field
-        neuron_delay_stage_config[d] = (bit_field_t) spin1_malloc(
-            neuron_bit_field_words * sizeof(uint32_t));
-
-        // Copy delay stage configuration bits into delay stage configuration bit-field
-        address_t neuron_delay_stage_config_data_address =
-            &address[DELAY_BLOCKS] + (d * neuron_bit_field_words);
-        spin1_memcpy(neuron_delay_stage_config[d],
-               neuron_delay_stage_config_data_address,
-               neuron_bit_field_words * sizeof(uint32_t));
-
+        bit_field_t delay_stage_config =
+            (bit_field_t) &address[DELAY_BLOCKS] + (d * neuron_bit_field_words);
         for (uint32_t w = 0; w < neuron_bit_field_words; w++) {
             log_debug("\t\t delay stage config word %u = %08x", w,
-                      neuron_delay_stage_config[d][w]);
+                      delay_stage_config[w]);
+        }
+
+        for (uint32_t n = 0; n < num_neurons; n++) {
+            if (bit_field_test(delay_stage_config, n)) {
+                neuron_delay_stages[n] |= 1 << d;
+                active_delay_stages |= 1 << d;
+            }
         }
     }
 
@@ -166,12 +213,32 @@ static bool read_parameters(address_t address) {
     spike_counters = (uint8_t**) spin1_malloc(
         num_delay_slots_pot * sizeof(uint8_t*));
 
+    // Allocate the list of the neurons with spikes in each delay slot; with
+    // few neurons, these can list all of them
+    max_slot_events = num_neurons;
+    if (max_slot_events > MAX_SLOT_EVENTS) {
+        max_slot_events = MAX_SLOT_EVENTS;
+    }
+    slot_events = (slot_events_t **) spin1_malloc(
+        num_delay_slots_pot * sizeof(slot_events_t *));
+    if (spike_counters == NULL || slot_events == NULL) {
+        log_error("Failed to allocate the delay slots");
+        return false;
+    }
+
     for (uint32_t s = 0; s < num_delay_slots_pot; s++) {
 
         // Allocate an array of counters for each neuron and zero
         spike_counters[s] = (uint8_t*) spin1_malloc(
             num_neurons * sizeof(uint8_t));
+        slot_events[s] = (slot_events_t *) spin1_malloc(
+            sizeof(slot_events_t) + (max_slot_events * sizeof(uint8_t)));
+        if (spike_counters[s] == NULL || slot_events[s] == NULL) {
+            log_error("Failed to allocate delay slot %u", s);
+            return false;
+        }
         zero_spike_counters(spike_counters[s], num_neurons);
+        slot_events[s]->n_events = 0;
     }
 
     log_debug("read_parameters: completed successfully");
@@ -241,45 +308,124 @@ static inline key_t _key_n(key_t k) {
     return k & incoming_neuron_mask;
 }
 
-static void spike_process() {
+// Counts a spike in the counters of the current time slot, listing the
+// neuron the first time it has a spike in the slot
+static inline void _process_spike(
+        spike_t s, uint8_t *current_time_slot_spike_counters,
+        slot_events_t *current_time_slot_events) {
+    n_processed_spikes += 1;
+
+    if ((s & incoming_mask) == incoming_key) {
+
+        // Mask out neuron ID
+        uint32_t neuron_id = _key_n(s);
+        if (neuron_id < num_neurons) {
+
+            // List the neuron if it is new to this slot; once the list is
+            // full, the count goes past max_slot_events to mark the overflow
+            if (current_time_slot_spike_counters[neuron_id] == 0) {
+                uint32_t n_events = current_time_slot_events->n_events;
+                if (n_events < max_slot_events) {
+                    current_time_slot_events->neurons[n_events] = neuron_id;
+                }
+                if (n_events <= max_slot_events) {
+                    current_time_slot_events->n_events = n_events + 1;
+                }
+            }
 
-    // turn off interrupts as this function is critical for
-    // keeping time in sync.
-    uint state = spin1_int_disable();
+            // Increment counter, which saturates rather than wrapping back
+            // to zero, as that would list the neuron again
+            if (current_time_slot_spike_counters[neuron_id] < UINT8_MAX) {
+                current_time_slot_spike_counters[neuron_id]++;
+                log_debug("Incrementing counter %u = %u\n", neuron_id,
+                          current_time_slot_spike_counters[neuron_id]);
+                n_spikes_added += 1;
+            } else {
+                log_debug("Counter %u is full", neuron_id);
+            }
+        } else {
+            log_debug("Invalid neuron ID %u", neuron_id);
+        }
+    } else {
+        log_debug("Invalid spike key 0x%08x", s);
+    }
+}
+
+static void spike_process() {
 
     // Get current time slot of incoming spike counters
     uint32_t current_time_slot = time & num_delay_slots_mask;
     uint8_t *current_time_slot_spike_counters =
         spike_counters[current_time_slot];
+    slot_events_t *current_time_slot_events = slot_events[current_time_slot];
 
     log_debug("Current time slot %u", current_time_slot);
 
-    // While there are any incoming spikes
-    spike_t s;
-    while (in_spikes_get_next_spike(&s)) {
-        n_processed_spikes += 1;
+    // Only the spikes received before now are for this time slot; those
+    // received while processing are left for the next.  Packet reception
+    // only adds to the input spikes, so interrupts can stay enabled.
+    uint32_t n_spikes_to_process = in_spikes_size();
+    spike_t spikes[SPIKE_BATCH_SIZE];
+    while (n_spikes_to_process > 0) {
+        uint32_t n_spikes = in_spikes_get_spikes(
+            spikes, (n_spikes_to_process < SPIKE_BATCH_SIZE) ?
+                n_spikes_to_process : SPIKE_BATCH_SIZE);
+        n_spikes_to_process -= n_spikes;
+        for (uint32_t i = 0; i < n_spikes; i++) {
+            _process_spike(
+                spikes[i], current_time_slot_spike_counters,
+                current_time_slot_events);
+        }
+    }
+}
 
-        if ((s & incoming_mask) == incoming_key) {
+// Sends the spikes counted for a neuron in a delay slot, if the neuron emits
+// spikes after the delay stage, waiting between neurons to spread the spikes
+// out over the timestep
+static inline void _send_delayed_spikes(
+        uint32_t n, uint32_t d, uint8_t *delay_stage_spike_counters,
+        uint timer_count) {
 
-            // Mask out neuron ID
-            uint32_t neuron_id = _key_n(s);
-            if (neuron_id < num_neurons) {
+    // If this neuron emits a spike after this stage
+    if (neuron_delay_stages[n] & (1 << d)) {
 
-                // Increment counter
-                current_time_slot_spike_counters[neuron_id]++;
-                log_debug("Incrementing counter %u = %u\n", neuron_id,
-                          current_time_slot_spike_counters[neuron_id]);
-                n_spikes_added += 1;
-            } else {
-                log_debug("Invalid neuron ID %u", neuron_id);
+        // Calculate key all spikes coming from this neuron will be
+        // sent with
+        uint32_t spike_key = ((d * num_neurons) + n) + key;
+
+        log_debug("Neuron %u sending %u spikes after delay stage %u with "
+                  "key %x", n, delay_stage_spike_counters[n], d, spike_key);
+
+        // Loop through counted spikes and send
+        for (uint32_t s = 0; s < delay_stage_spike_counters[n]; s++) {
+            while (!spin1_send_mc_packet(spike_key, 0, NO_PAYLOAD)) {
+                spin1_delay_us(1);
             }
-        } else {
-            log_debug("Invalid spike key 0x%08x", s);
+            n_spikes_sent += 1;
         }
+
+        // Wait until the expected time to send
+        while ((ticks == timer_count) && tc[T1_COUNT] > expected_time) {
+
+            // Do Nothing
+            n_delays += 1;
+        }
+        expected_time -= time_between_spikes;
     }
+}
 
-    // reactivate interrupts as critical section complete
-    spin1_mode_restore(state);
+// Zeros the counters of a delay slot, and empties its list of neurons
+static inline void _clear_slot(uint32_t slot) {
+    uint8_t *counters = spike_counters[slot];
+    slot_events_t *events = slot_events[slot];
+    if (events->n_events <= max_slot_events) {
+        for (uint32_t e = 0; e < events->n_events; e++) {
+            counters[events->neurons[e]] = 0;
+        }
+    } else {
+        zero_spike_counters(counters, num_neurons);
+    }
+    events->n_events = 0;
 }
 
 void timer_callback(uint timer_count, uint unused1) {
@@ -321,8 +467,7 @@ void timer_callback(uint timer_count, uint unused1) {
     for (uint32_t d = 0; d < num_delay_stages; d++) {
 
         // If any neurons emit spikes after this delay stage
-        bit_field_t delay_stage_config = neuron_delay_stage_config[d];
-        if (nonempty_bit_field(delay_stage_config, neuron_bit_field_words)) {
+        if (active_delay_stages & (1 << d)) {
 
             // Get key mask for this delay stage and it's time slot
             uint32_t delay_stage_delay = (d + 1) * DELAY_STAGE_LENGTH;
@@ -330,53 +475,34 @@ void timer_callback(uint timer_count, uint unused1) {
                 ((time - delay_stage_delay) & num_delay_slots_mask);
             uint8_t *delay_stage_spike_counters =
                 spike_counters[delay_stage_time_slot];
+            slot_events_t *delay_stage_events =
+                slot_events[delay_stage_time_slot];
 
             log_debug("%u: Checking time slot %u for delay stage %u",
                       time, delay_stage_time_slot, d);
 
-            // Loop through neurons
-            for (uint32_t n = 0; n < num_neurons; n++) {
-
-                // If this neuron emits a spike after this stage
-                if (bit_field_test(delay_stage_config, n)) {
-
-                    // Calculate key all spikes coming from this neuron will be
-                    // sent with
-                    uint32_t spike_key = ((d * num_neurons) + n) + key;
-
+            // Only the listed neurons have spikes, unless the list overflowed
+            uint32_t n_events = delay_stage_events->n_events;
+            if (n_events <= max_slot_events) {
+                for (uint32_t e = 0; e < n_events; e++) {
+                    _send_delayed_spikes(
+                        delay_stage_events->neurons[e], d,
+                        delay_stage_spike_counters, timer_count);
+                }
+            } else {
+                for (uint32_t n = 0; n < num_neurons; n++) {
                     if (delay_stage_spike_counters[n] > 0) {
-                        log_debug("Neuron %u sending %u spikes after delay"
-                                  "stage %u with key %x",
-                                  n, delay_stage_spike_counters[n], d,
-                                  spike_key);
-                    }
-
-                    // Loop through counted spikes and send
-                    for (uint32_t s = 0; s < delay_stage_spike_counters[n];
-                            s++) {
-                        while (!spin1_send_mc_packet(spike_key, 0,
-                                                     NO_PAYLOAD)) {
-                            spin1_delay_us(1);
-                        }
-                        n_spikes_sent += 1;
-
+                        _send_delayed_spikes(
+                            n, d, delay_stage_spike_counters, timer_count);
                     }
                 }
-
-                // Wait until the expected time to send
-                while ((ticks == timer_count) && tc[T1_COUNT] > expected_time) {
-
-                    // Do Nothing
-                    n_delays += 1;
-                }
-                expected_time -= time_between_spikes;
             }
         }
     }
 
     // Zero all counters in current time slot
     uint32_t current_time_slot = time & num_delay_slots_mask;
-    zero_spike_counters(spike_counters[current_time_slot], num_neurons);
+    _clear_slot(current_time_slot);
 }
 
 // Entry point
@@ -39,4 +39,12 @@ static input_t additional_input_get_input_value_as_current(
 static void additional_input_has_spiked(
     additional_input_pointer_t additional_input);
 
+//! \brief Determines if the additional input is at rest, i.e. it provides no
+//!     current and will not change until the neuron spikes
+//! \param[in] additional_input The additional input type pointer to the
+//!     parameters
+//! \return true if the additional input is at rest
+static bool additional_input_is_at_rest(
+    additional_input_pointer_t additional_input);
+
 #endif // _ADDITIONAL_INPUT_TYPE_H_
@@ -57,4 +57,10 @@ static void additional_input_has_spiked(
     additional_input->I_Ca2 += additional_input->I_alpha;
 }
 
+static inline bool additional_input_is_at_rest(
+        additional_input_pointer_t additional_input) {
+    // The trace decays to exactly zero in fixed point
+    return REAL_COMPARE(additional_input->I_Ca2, ==, ZERO);
+}
+
 #endif // _ADDITIONAL_INPUT_CA2_ADAPTIVE_H_
@@ -36,4 +36,10 @@ static void additional_input_has_spiked(
     use(additional_input);
 }
 
+static inline bool additional_input_is_at_rest(
+        additional_input_pointer_t additional_input) {
+    use(additional_input);
+    return true;
+}
+
 #endif // _ADDITIONAL_INPUT_TYPE_NONE_H_
@@ -37,6 +37,8 @@
 #include "neuron.h"
 #include "synapses.h"
 #include "spike_processing.h"
+#include "procedural_synapses.h"
+#include "convolution_synapses.h"
 #include "population_table/population_table.h"
 #include "plasticity/synapse_dynamics.h"
 #include "structural_plasticity/synaptogenesis_dynamics.h"
@@ -60,7 +62,12 @@ typedef enum extra_provenance_data_region_entries{
     SYNAPTIC_WEIGHT_SATURATION_COUNT = 1,
     INPUT_BUFFER_OVERFLOW_COUNT = 2,
     CURRENT_TIMER_TICK = 3,
-    PLASTIC_SYNAPTIC_WEIGHT_SATURATION_COUNT = 4
+    PLASTIC_SYNAPTIC_WEIGHT_SATURATION_COUNT = 4,
+    BIT_FIELD_FILTERED_COUNT = 5,
+    PLASTIC_WRITE_BACKS_SKIPPED_COUNT = 6,
+    PLASTIC_WRITE_BACKS_SHORTENED_COUNT = 7,
+    PROCEDURAL_ROWS_GENERATED_COUNT = 8,
+    CONVOLUTION_SPIKES_PROCESSED_COUNT = 9
 } extra_provenance_data_region_entries;
 
 //! values for the priority for each callback
@@ -71,8 +78,22 @@ typedef enum callback_priorities{
 //! The number of regions that are to be used for recording
 #define NUMBER_OF_REGIONS_TO_RECORD 4
 
+//! The timing and load of a timestep, recorded when enabled in the recording
+//! channel after those of the neurons
+typedef struct timestep_telemetry_t {
+    //! The timestep
+    uint32_t time;
+    //! The clock cycles from the timer tick to the end of the timer callback
+    uint32_t timer_callback_cycles;
+    //! The load on the spike processing since the previous timestep
+    spike_processing_load_t load;
+} timestep_telemetry_t;
+
 // Globals
 
+// Spin1 API ticks - to know when the timer callback overruns
+extern uint ticks;
+
 //! the current timer tick value
 //! the timer tick callback returning the same value.
 uint32_t time;
@@ -101,6 +122,15 @@ bool rewiring = false;
 // FOR DEBUGGING!
 uint32_t count_rewires = 0;
 
+//! The recording channel of the timestep telemetry
+static uint32_t telemetry_recording_channel;
+
+//! True if the timestep telemetry is being recorded
+static bool telemetry_recording = false;
+
+//! The telemetry of the current timestep
+static timestep_telemetry_t telemetry;
+
 
 //! \brief Initialises the recording parts of the model
 //! \param[in] recording_address: the address in SDRAM where to store
@@ -112,6 +142,23 @@ static bool initialise_recording(address_t recording_address){
     return success;
 }
 
+//! \brief Records the timing and load of this timestep
+//! \param[in] timer_count the number of times the timer callback has been
+//!            executed, to detect if it has overrun into the next tick
+static inline void record_telemetry(uint timer_count) {
+    telemetry.time = time;
+
+    // Timer 1 counts down from the load value each tick
+    telemetry.timer_callback_cycles = tc[T1_LOAD] - tc[T1_COUNT];
+    if (ticks != timer_count) {
+        telemetry.timer_callback_cycles += (ticks - timer_count) * tc[T1_LOAD];
+    }
+
+    spike_processing_get_and_reset_load(&telemetry.load);
+    recording_record(
+        telemetry_recording_channel, &telemetry, sizeof(telemetry));
+}
+
 void c_main_store_provenance_data(address_t provenance_region){
     log_debug("writing other provenance data");
 
@@ -125,6 +172,16 @@ void c_main_store_provenance_data(address_t provenance_region){
     provenance_region[CURRENT_TIMER_TICK] = time;
     provenance_region[PLASTIC_SYNAPTIC_WEIGHT_SATURATION_COUNT] =
             synapse_dynamics_get_plastic_saturation_count();
+    provenance_region[BIT_FIELD_FILTERED_COUNT] =
+        population_table_get_filtered_packets();
+    provenance_region[PLASTIC_WRITE_BACKS_SKIPPED_COUNT] =
+        spike_processing_get_n_plastic_write_backs_skipped();
+    provenance_region[PLASTIC_WRITE_BACKS_SHORTENED_COUNT] =
+        spike_processing_get_n_plastic_write_backs_shortened();
+    provenance_region[PROCEDURAL_ROWS_GENERATED_COUNT] =
+        procedural_synapses_get_n_rows_generated();
+    provenance_region[CONVOLUTION_SPIKES_PROCESSED_COUNT] =
+        convolution_synapses_get_n_spikes_processed();
     log_debug("finished other provenance data");
 }
 
@@ -173,17 +230,23 @@ static bool initialise() {
         return false;
     }
 
+    // The telemetry follows the recordings of the neurons
+    telemetry_recording_channel = neuron_get_n_recording_channels();
+    telemetry_recording =
+        (recording_flags & (1 << telemetry_recording_channel)) != 0;
+
     // Set up the synapses
     uint32_t *ring_buffer_to_input_buffer_left_shifts;
     address_t indirect_synapses_address =
             data_specification_get_region(SYNAPTIC_MATRIX_REGION, ds_regions);
     address_t direct_synapses_address;
+    uint32_t n_dma_buffers;
     if (!synapses_initialise(
             data_specification_get_region(SYNAPSE_PARAMS_REGION, ds_regions),
             data_specification_get_region(DIRECT_MATRIX_REGION, ds_regions),
             n_neurons, n_synapse_types,
             &ring_buffer_to_input_buffer_left_shifts,
-            &direct_synapses_address)) {
+            &direct_synapses_address, &n_dma_buffers)) {
         return false;
     }
 
@@ -195,6 +258,18 @@ static bool initialise() {
             &row_max_n_words)) {
         return false;
     }
+    // Set up the connectors whose rows are generated rather than stored
+    if (!procedural_synapses_initialise(data_specification_get_region(
+            PROCEDURAL_SYNAPSES_REGION, ds_regions))) {
+        return false;
+    }
+
+    // Set up the kernels whose weights are added without rows
+    if (!convolution_synapses_initialise(data_specification_get_region(
+            CONVOLUTION_SYNAPSES_REGION, ds_regions))) {
+        return false;
+    }
+
     // Set up the synapse dynamics
     address_t synapse_dynamics_region_address =
             data_specification_get_region(SYNAPSE_DYNAMICS_REGION, ds_regions);
@@ -216,7 +291,7 @@ static bool initialise() {
     rewiring = rewiring_period != -1;
 
     if (!spike_processing_initialise(
-            row_max_n_words, MC, USER,
+            row_max_n_words, n_dma_buffers, MC, USER,
             incoming_spike_buffer_size)) {
         return false;
     }
@@ -254,6 +329,9 @@ void timer_callback(uint timer_count, uint unused) {
 
     profiler_write_entry_disable_irq_fiq(PROFILER_ENTER | PROFILER_TIMER);
 
+    // The core is not idle waiting for rows while the timer callback runs
+    spike_processing_pause_dma_wait();
+
     time++;
     last_rewiring_time++;
 
@@ -272,6 +350,13 @@ void timer_callback(uint timer_count, uint unused) {
 
         log_debug("Completed a run");
 
+        // Bring the plastic synapses up to date for reading out if needed,
+        // once the rows being processed have been written back, and before
+        // any other row is read
+        spike_processing_hold_dma();
+        synapse_dynamics_apply_deferred_updates();
+        spike_processing_release_dma();
+
         // rewrite neuron params to SDRAM for reading out if needed
         data_specification_metadata_t *ds_regions =
                 data_specification_get_data_address();
@@ -332,11 +417,17 @@ void timer_callback(uint timer_count, uint unused) {
     synapses_do_timestep_update(time);
     neuron_do_timestep_update(time, timer_count, timer_period);
 
+    if (telemetry_recording) {
+        record_telemetry(timer_count);
+    }
+
     // trigger buffering_out_mechanism
     if (recording_flags > 0) {
         recording_do_timestep_update(time);
     }
 
+    spike_processing_resume_dma_wait();
+
     profiler_write_entry_disable_irq_fiq(PROFILER_EXIT | PROFILER_TIMER);
 }
 
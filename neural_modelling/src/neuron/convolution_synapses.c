@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "convolution_synapses.h"
+#include "synapses.h"
+#include <spin1_api.h>
+#include <debug.h>
+
+//! The parameters of a kernel as read from SDRAM
+typedef struct convolution_params_t {
+    uint32_t key;
+    uint32_t mask;
+    //! The index in the pre-synaptic population of neuron 0 of the key
+    uint32_t pre_slice_start;
+    uint32_t pre_width;
+    uint32_t post_width;
+    //! The row of the first post-synaptic neuron on the core, and the number
+    //! of rows that the neurons of the core are in
+    uint32_t first_post_row;
+    uint32_t n_post_rows;
+    uint32_t kernel_width;
+    uint32_t kernel_height;
+    uint32_t synapse_type;
+} convolution_params_t;
+
+//! \brief A kernel and the position of the post-synaptic neurons in the
+//!        coordinates of the pre-synaptic population
+//!
+//! A row or column that is outside of the common coordinates is a large
+//! negative value, so that it is never within the kernel.
+typedef struct convolution_t {
+    convolution_params_t params;
+    //! The pre-synaptic row of each post-synaptic row on the core
+    int16_t *post_row_as_pre;
+    //! The pre-synaptic column of each post-synaptic column
+    int16_t *post_col_as_pre;
+    //! The scaled weights of the kernel, by row then column
+    weight_t *weights;
+    //! The delays of the kernel in time steps, by row then column
+    uint16_t *delays;
+} convolution_t;
+
+static convolution_t *convolutions;
+static uint32_t n_convolutions = 0;
+
+static uint32_t post_slice_start;
+static uint32_t post_slice_count;
+
+static uint32_t n_spikes_processed = 0;
+
+/* PRIVATE FUNCTIONS */
+
+//! \brief Copy an array of 16-bit values, padded to a word, into DTCM
+static inline void *_read_half_words(address_t *address, uint32_t n_items) {
+    uint32_t n_words = (n_items + 1) >> 1;
+    void *values = spin1_malloc(n_words * sizeof(uint32_t));
+    if (values != NULL) {
+        spin1_memcpy(values, *address, n_words * sizeof(uint32_t));
+    }
+    *address += n_words;
+    return values;
+}
+
+//! \brief Add the weights of the kernel to the neurons that it covers when
+//!        centred on a pre-synaptic neuron
+static inline void _process_convolution(
+        const convolution_t *conv, uint32_t time, uint32_t pre_neuron_index) {
+    const convolution_params_t *params = &conv->params;
+    int32_t pre_r = pre_neuron_index / params->pre_width;
+    int32_t pre_c = pre_neuron_index - (pre_r * params->pre_width);
+    int32_t kernel_h = params->kernel_height;
+    int32_t kernel_w = params->kernel_width;
+
+    // The kernel row / column of a post-synaptic neuron is the half-kernel
+    // less its distance from the pre-synaptic neuron
+    int32_t row_offset = (kernel_h >> 1) + pre_r;
+    int32_t col_offset = (kernel_w >> 1) + pre_c;
+
+    int32_t post_w = params->post_width;
+    int32_t row_start = (params->first_post_row * post_w) - post_slice_start;
+    for (uint32_t i = 0; i < params->n_post_rows; i++, row_start += post_w) {
+        int32_t k_r = row_offset - conv->post_row_as_pre[i];
+        if (k_r < 0 || k_r >= kernel_h) {
+            continue;
+        }
+
+        // Only the columns of this row that are on the core
+        int32_t first_c = (row_start < 0) ? -row_start : 0;
+        int32_t end_c = (int32_t) post_slice_count - row_start;
+        if (end_c > post_w) {
+            end_c = post_w;
+        }
+        const weight_t *weights = &conv->weights[k_r * kernel_w];
+        const uint16_t *delays = &conv->delays[k_r * kernel_w];
+        for (int32_t c = first_c; c < end_c; c++) {
+            int32_t k_c = col_offset - conv->post_col_as_pre[c];
+            if (k_c < 0 || k_c >= kernel_w || weights[k_c] == 0) {
+                continue;
+            }
+            synapses_add_weight(time + delays[k_c], params->synapse_type,
+                row_start + c, weights[k_c]);
+        }
+    }
+}
+
+/* INTERFACE FUNCTIONS */
+
+bool convolution_synapses_initialise(address_t address) {
+    n_convolutions = 0;
+    if (address == NULL) {
+        return true;
+    }
+
+    post_slice_start = *address++;
+    post_slice_count = *address++;
+    uint32_t n_kernels = *address++;
+    if (n_kernels == 0) {
+        return true;
+    }
+
+    convolutions = (convolution_t *) spin1_malloc(
+        n_kernels * sizeof(convolution_t));
+    if (convolutions == NULL) {
+        log_error("Could not allocate %u convolution kernels", n_kernels);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < n_kernels; i++) {
+        convolution_t *conv = &convolutions[i];
+        convolution_params_t *params = &conv->params;
+        spin1_memcpy(params, address, sizeof(convolution_params_t));
+        address += sizeof(convolution_params_t) >> 2;
+
+        uint32_t kernel_size = params->kernel_width * params->kernel_height;
+        conv->post_row_as_pre = _read_half_words(&address, params->n_post_rows);
+        conv->post_col_as_pre = _read_half_words(&address, params->post_width);
+        conv->weights = _read_half_words(&address, kernel_size);
+        conv->delays = _read_half_words(&address, kernel_size);
+        if (conv->post_row_as_pre == NULL || conv->post_col_as_pre == NULL ||
+                conv->weights == NULL || conv->delays == NULL) {
+            log_error("Could not allocate convolution kernel %u of %u x %u",
+                i, params->kernel_height, params->kernel_width);
+            return false;
+        }
+        log_debug("Convolution %u: key 0x%08x mask 0x%08x, kernel %u x %u, "
+            "%u post rows from %u", i, params->key, params->mask,
+            params->kernel_height, params->kernel_width, params->n_post_rows,
+            params->first_post_row);
+    }
+
+    n_convolutions = n_kernels;
+    log_info("%u convolution kernels", n_convolutions);
+    return true;
+}
+
+bool convolution_synapses_process_spike(uint32_t time, spike_t spike) {
+    bool found = false;
+    for (uint32_t i = 0; i < n_convolutions; i++) {
+        const convolution_t *conv = &convolutions[i];
+        if ((spike & conv->params.mask) != conv->params.key) {
+            continue;
+        }
+        found = true;
+        n_spikes_processed++;
+
+        uint32_t neuron_id = spike & ~conv->params.mask;
+        _process_convolution(
+            conv, time, conv->params.pre_slice_start + neuron_id);
+    }
+    return found;
+}
+
+uint32_t convolution_synapses_get_n_spikes_processed(void) {
+    return n_spikes_processed;
+}
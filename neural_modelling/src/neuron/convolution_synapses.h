@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Synapses of a kernel connector, whose weights are added to the
+ *         ring buffers from a kernel held in DTCM when a spike arrives,
+ *         instead of being stored in synaptic rows
+ *
+ *  The pre- and post-synaptic populations are 2D arrays of neurons.  When a
+ *  spike arrives, the coordinates of the pre-synaptic neuron give the
+ *  window of the kernel over the post-synaptic neurons on the core, so
+ *  only the neurons that the kernel covers are visited.
+ */
+
+#ifndef _CONVOLUTION_SYNAPSES_H_
+#define _CONVOLUTION_SYNAPSES_H_
+
+#include <common/neuron-typedefs.h>
+
+//! \brief Read the convolution kernels
+//! \param[in] address The address of the convolution synapses region, or
+//!                    NULL if there are no kernels
+//! \return True if the kernels were read successfully
+bool convolution_synapses_initialise(address_t address);
+
+//! \brief Add the weights of the kernels that a spike is from to the ring
+//!        buffers
+//! \param[in] time The current time step
+//! \param[in] spike The spike received
+//! \return True if the spike was from at least one kernel
+bool convolution_synapses_process_spike(uint32_t time, spike_t spike);
+
+//! \brief Get the number of spikes processed through kernels
+//! \return The number of spikes processed
+uint32_t convolution_synapses_get_n_spikes_processed(void);
+
+#endif // _CONVOLUTION_SYNAPSES_H_
@@ -25,14 +25,12 @@
 //! \return bool
 static bool neuron_impl_initialise(uint32_t n_neurons);
 
-//! \brief Add inputs to the neuron
-//! \param[in] synapse_type_index the synapse type (e.g. exc. or inh.)
-//! \param[in] neuron_index the index of the neuron
-//! \param[in] weights_this_timestep weight inputs to be added
-//! \return None
-static void neuron_impl_add_inputs(
-        index_t synapse_type_index, index_t neuron_index,
-        input_t weights_this_timestep);
+//! \brief Add an input of one synapse type to every neuron
+//! \param[in] synapse_type_index the synapse type (exc. or inh.)
+//! \param[in] inputs the input for each neuron
+//! \param[in] n_neurons the number of neurons
+static void neuron_impl_add_input_array(
+    index_t synapse_type_index, const input_t *inputs, uint32_t n_neurons);
 
 //! \brief Load in the neuron parameters
 static void neuron_impl_load_neuron_parameters(
@@ -47,10 +45,37 @@ static bool neuron_impl_do_timestep_update(
     index_t neuron_index, input_t external_bias,
     state_t *recorded_variable_values);
 
+#ifdef NEURON_IMPL_BATCH_UPDATE
+//! \brief Update all the neurons at once at the start of the timestep.
+//!     An implementation that defines NEURON_IMPL_BATCH_UPDATE does its
+//!     work here, and neuron_impl_do_timestep_update then only reports the
+//!     results for each neuron.
+//! \param[in] time The time of the timestep
+//! \param[in] n_neurons The number of neurons to update
+static void neuron_impl_do_timestep_update_all(
+    uint32_t time, uint32_t n_neurons);
+#endif // NEURON_IMPL_BATCH_UPDATE
+
 //! \brief Store the neuron parameters to the given address
 static void neuron_impl_store_neuron_parameters(
         address_t address, uint32_t next, uint32_t n_neurons);
 
+#if EVENT_DRIVEN_NEURONS
+//! \brief Determine if a neuron can stop being updated, i.e. if it has no
+//!     input left to process and has decayed to rest, so that it will not
+//!     change other than by a decay that neuron_impl_decay_at_rest can
+//!     compute in one go.
+//! \param[in] neuron_index The index of the neuron
+//! \return true if the neuron doesn't need to be updated until it next
+//!     receives input
+static bool neuron_impl_is_quiescent(index_t neuron_index);
+
+//! \brief Bring a quiescent neuron up to date before it is next updated
+//! \param[in] neuron_index The index of the neuron
+//! \param[in] n_steps The number of timesteps for which it was not updated
+static void neuron_impl_decay_at_rest(index_t neuron_index, uint32_t n_steps);
+#endif // EVENT_DRIVEN_NEURONS
+
 #if LOG_LEVEL >= LOG_DEBUG
 void neuron_impl_print_inputs(uint32_t n_neurons);
 
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Leaky integrate and fire neurons with exponential current synapses
+ *      and a static threshold, stored as a structure of arrays.
+ *
+ *  This computes exactly what neuron_impl_standard.h does with the LIF
+ *  neuron model, current input, static threshold and exponential synapse
+ *  components, but keeps each state variable and parameter in its own
+ *  array rather than in an array of structs per component.  The neurons are
+ *  then all updated together, one short loop over contiguous arrays per
+ *  step of the update, which keeps the loads and stores sequential (and lets
+ *  a host build vectorise the loops).
+ *
+ *  The parameters are read in the same order as for the standard
+ *  implementation, but with each field of each component written for all
+ *  the neurons before the next field (NeuronImplStandard with
+ *  field_major=True), each field padded to a whole number of words.
+ */
+
+#ifndef _NEURON_IMPL_LIF_CURR_EXP_SOA_H_
+#define _NEURON_IMPL_LIF_CURR_EXP_SOA_H_
+
+#include "neuron_impl.h"
+
+#include <neuron/decay.h>
+#include <neuron/plasticity/synapse_dynamics.h>
+#include <common/out_spikes.h>
+#include <recording.h>
+#include <debug.h>
+
+#define SYNAPSE_TYPE_BITS 1
+#define SYNAPSE_TYPE_COUNT 2
+
+#define NUM_EXCITATORY_RECEPTORS 1
+#define NUM_INHIBITORY_RECEPTORS 1
+
+#define V_RECORDING_INDEX 0
+#define GSYN_EXCITATORY_RECORDING_INDEX 1
+#define GSYN_INHIBITORY_RECORDING_INDEX 2
+
+//! The neurons are updated together before the results are collected
+#define NEURON_IMPL_BATCH_UPDATE
+
+typedef enum input_buffer_regions {
+    EXCITATORY, INHIBITORY,
+} input_buffer_regions;
+
+// Neuron model state and parameters, as in neuron_model_lif_impl.h
+static REAL *V_membrane;
+static REAL *V_rest;
+static REAL *R_membrane;
+static REAL *exp_TC;
+static REAL *I_offset;
+static int32_t *refract_timer;
+static REAL *V_reset;
+static int32_t *T_refract;
+
+// Threshold, as in threshold_type_static.h
+static REAL *threshold_value;
+
+// Synapse shaping, as in synapse_types_exponential_impl.h
+static decay_t *exc_decay;
+static decay_t *exc_init;
+static input_t *exc_input;
+static decay_t *inh_decay;
+static decay_t *inh_init;
+static input_t *inh_input;
+
+//! An array of state, and the size of each of its elements
+typedef struct state_array_t {
+    void **array;
+    uint32_t element_size;
+} state_array_t;
+
+//! The arrays in the order in which they are stored in SDRAM
+static const state_array_t state_arrays[] = {
+    {(void **) &V_membrane, sizeof(REAL)},
+    {(void **) &V_rest, sizeof(REAL)},
+    {(void **) &R_membrane, sizeof(REAL)},
+    {(void **) &exp_TC, sizeof(REAL)},
+    {(void **) &I_offset, sizeof(REAL)},
+    {(void **) &refract_timer, sizeof(int32_t)},
+    {(void **) &V_reset, sizeof(REAL)},
+    {(void **) &T_refract, sizeof(int32_t)},
+    {(void **) &threshold_value, sizeof(REAL)},
+    {(void **) &exc_decay, sizeof(decay_t)},
+    {(void **) &exc_init, sizeof(decay_t)},
+    {(void **) &exc_input, sizeof(input_t)},
+    {(void **) &inh_decay, sizeof(decay_t)},
+    {(void **) &inh_init, sizeof(decay_t)},
+    {(void **) &inh_input, sizeof(input_t)},
+};
+
+#define N_STATE_ARRAYS (sizeof(state_arrays) / sizeof(state_arrays[0]))
+
+// Working space for the update, which is collected for each neuron by
+// neuron_impl_do_timestep_update
+static state_t *recorded_v;
+static input_t *recorded_exc;
+static input_t *recorded_inh;
+static input_t *input_this_timestep;
+static uint8_t *spiked;
+
+//! The number of words that an array takes up in SDRAM
+static inline uint32_t _n_words(uint32_t n_neurons, uint32_t element_size) {
+    return ((n_neurons * element_size) + 3) / 4;
+}
+
+static bool neuron_impl_initialise(uint32_t n_neurons) {
+    for (uint32_t i = 0; i < N_STATE_ARRAYS; i++) {
+        *state_arrays[i].array = spin1_malloc(
+            n_neurons * state_arrays[i].element_size);
+        if (*state_arrays[i].array == NULL) {
+            log_error("Unable to allocate neuron state array %u"
+                      " - Out of DTCM", i);
+            return false;
+        }
+    }
+
+    recorded_v = (state_t *) spin1_malloc(n_neurons * sizeof(state_t));
+    recorded_exc = (input_t *) spin1_malloc(n_neurons * sizeof(input_t));
+    recorded_inh = (input_t *) spin1_malloc(n_neurons * sizeof(input_t));
+    input_this_timestep = (input_t *) spin1_malloc(
+        n_neurons * sizeof(input_t));
+    spiked = (uint8_t *) spin1_malloc(n_neurons * sizeof(uint8_t));
+    if (recorded_v == NULL || recorded_exc == NULL || recorded_inh == NULL
+            || input_this_timestep == NULL || spiked == NULL) {
+        log_error("Unable to allocate neuron update space - Out of DTCM");
+        return false;
+    }
+    return true;
+}
+
+static void neuron_impl_add_input_array(
+        index_t synapse_type_index, const input_t *inputs,
+        uint32_t n_neurons) {
+    const input_t *restrict in = inputs;
+    if (synapse_type_index == EXCITATORY) {
+        const decay_t *restrict init = exc_init;
+        input_t *restrict exc = exc_input;
+        for (index_t i = 0; i < n_neurons; i++) {
+            exc[i] += decay_s1615(in[i], init[i]);
+        }
+    } else if (synapse_type_index == INHIBITORY) {
+        const decay_t *restrict init = inh_init;
+        input_t *restrict inh = inh_input;
+        for (index_t i = 0; i < n_neurons; i++) {
+            inh[i] += decay_s1615(in[i], init[i]);
+        }
+    }
+}
+
+static void neuron_impl_load_neuron_parameters(
+        address_t address, uint32_t next, uint32_t n_neurons) {
+    log_debug("reading parameters, next is %u, n_neurons is %u ",
+        next, n_neurons);
+
+    for (uint32_t i = 0; i < N_STATE_ARRAYS; i++) {
+        uint32_t element_size = state_arrays[i].element_size;
+        spin1_memcpy(*state_arrays[i].array, &address[next],
+            n_neurons * element_size);
+        next += _n_words(n_neurons, element_size);
+    }
+}
+
+//! \brief Update all the neurons for the timestep, one part of the update
+//!     at a time
+//! \param[in] time The time of the timestep
+//! \param[in] n_neurons The number of neurons to update
+static void neuron_impl_do_timestep_update_all(
+        uint32_t time, uint32_t n_neurons) {
+
+    // Record the state as it is at the start of the timestep
+    {
+        const REAL *restrict v = V_membrane;
+        const input_t *restrict exc = exc_input;
+        const input_t *restrict inh = inh_input;
+        state_t *restrict rec_v = recorded_v;
+        input_t *restrict rec_exc = recorded_exc;
+        input_t *restrict rec_inh = recorded_inh;
+        for (index_t i = 0; i < n_neurons; i++) {
+            rec_v[i] = v[i];
+            rec_exc[i] = exc[i];
+            rec_inh[i] = inh[i];
+        }
+    }
+
+    // Get any intrinsic bias; this is a call per neuron so is kept out of
+    // the loops below
+    for (index_t i = 0; i < n_neurons; i++) {
+        input_this_timestep[i] = synapse_dynamics_get_intrinsic_bias(time, i);
+    }
+
+    // Total the input current
+    {
+        const input_t *restrict exc = exc_input;
+        const input_t *restrict inh = inh_input;
+        const REAL *restrict offset = I_offset;
+        input_t *restrict input = input_this_timestep;
+        for (index_t i = 0; i < n_neurons; i++) {
+            input[i] += exc[i] - inh[i] + offset[i];
+        }
+    }
+
+    // Update the membrane voltage of the neurons outside of the refractory
+    // period (the closed form of neuron_model_lif_impl.c)
+    {
+        const input_t *restrict input = input_this_timestep;
+        const REAL *restrict r = R_membrane;
+        const REAL *restrict rest = V_rest;
+        const REAL *restrict tc = exp_TC;
+        int32_t *restrict refract = refract_timer;
+        REAL *restrict v = V_membrane;
+        for (index_t i = 0; i < n_neurons; i++) {
+            if (refract[i] <= 0) {
+                REAL alpha = (input[i] * r[i]) + rest[i];
+                v[i] = alpha - (tc[i] * (alpha - v[i]));
+            } else {
+                refract[i] -= 1;
+            }
+        }
+    }
+
+    // Check the threshold and reset the neurons that spike
+    {
+        const REAL *restrict threshold = threshold_value;
+        const REAL *restrict reset = V_reset;
+        const int32_t *restrict t_refract = T_refract;
+        int32_t *restrict refract = refract_timer;
+        REAL *restrict v = V_membrane;
+        uint8_t *restrict spike = spiked;
+        for (index_t i = 0; i < n_neurons; i++) {
+            spike[i] = REAL_COMPARE(v[i], >=, threshold[i]);
+            if (spike[i]) {
+                v[i] = reset[i];
+                refract[i] = t_refract[i];
+            }
+        }
+    }
+
+    // Shape the synaptic input
+    {
+        const decay_t *restrict decay = exc_decay;
+        input_t *restrict exc = exc_input;
+        for (index_t i = 0; i < n_neurons; i++) {
+            exc[i] = decay_s1615(exc[i], decay[i]);
+        }
+    }
+    {
+        const decay_t *restrict decay = inh_decay;
+        input_t *restrict inh = inh_input;
+        for (index_t i = 0; i < n_neurons; i++) {
+            inh[i] = decay_s1615(inh[i], decay[i]);
+        }
+    }
+}
+
+static bool neuron_impl_do_timestep_update(index_t neuron_index,
+        input_t external_bias, state_t *recorded_variable_values) {
+    use(external_bias);
+
+    // The neuron has already been updated, so just collect the results
+    recorded_variable_values[V_RECORDING_INDEX] = recorded_v[neuron_index];
+    recorded_variable_values[GSYN_EXCITATORY_RECORDING_INDEX] =
+        recorded_exc[neuron_index];
+    recorded_variable_values[GSYN_INHIBITORY_RECORDING_INDEX] =
+        recorded_inh[neuron_index];
+    return spiked[neuron_index];
+}
+
+#if EVENT_DRIVEN_NEURONS
+static bool neuron_impl_is_quiescent(index_t neuron_index) {
+    use(neuron_index);
+
+    // All the neurons are updated together anyway
+    return false;
+}
+
+static void neuron_impl_decay_at_rest(index_t neuron_index, uint32_t n_steps) {
+    use(neuron_index);
+    use(n_steps);
+}
+#endif // EVENT_DRIVEN_NEURONS
+
+//! \brief stores neuron parameter back into sdram
+//! \param[in] address: the address in sdram to start the store
+static void neuron_impl_store_neuron_parameters(
+        address_t address, uint32_t next, uint32_t n_neurons) {
+    log_debug("writing parameters");
+
+    for (uint32_t i = 0; i < N_STATE_ARRAYS; i++) {
+        uint32_t element_size = state_arrays[i].element_size;
+        spin1_memcpy(&address[next], *state_arrays[i].array,
+            n_neurons * element_size);
+        next += _n_words(n_neurons, element_size);
+    }
+}
+
+#if LOG_LEVEL >= LOG_DEBUG
+void neuron_impl_print_inputs(uint32_t n_neurons) {
+    log_debug("-------------------------------------\n");
+    for (index_t i = 0; i < n_neurons; i++) {
+        input_t input = exc_input[i] - inh_input[i];
+        if (bitsk(input) != 0) {
+            log_debug("%3u: %12.6k (= %12.6k - %12.6k)\n",
+                i, input, exc_input[i], inh_input[i]);
+        }
+    }
+    log_debug("-------------------------------------\n");
+}
+
+void neuron_impl_print_synapse_parameters(uint32_t n_neurons) {
+    log_debug("-------------------------------------\n");
+    for (index_t i = 0; i < n_neurons; i++) {
+        log_debug("exc_decay = %R\n", (unsigned fract) exc_decay[i]);
+        log_debug("exc_init  = %R\n", (unsigned fract) exc_init[i]);
+        log_debug("inh_decay = %R\n", (unsigned fract) inh_decay[i]);
+        log_debug("inh_init  = %R\n", (unsigned fract) inh_init[i]);
+    }
+    log_debug("-------------------------------------\n");
+}
+
+const char *neuron_impl_get_synapse_type_char(uint32_t synapse_type) {
+    if (synapse_type == EXCITATORY) {
+        return "X";
+    } else if (synapse_type == INHIBITORY) {
+        return "I";
+    }
+    return "?";
+}
+#endif // LOG_LEVEL >= LOG_DEBUG
+
+#endif // _NEURON_IMPL_LIF_CURR_EXP_SOA_H_
@@ -93,14 +93,14 @@ static bool neuron_impl_initialise(uint32_t n_neurons) {
     return true;
 }
 
-static void neuron_impl_add_inputs(
-        index_t synapse_type_index, index_t neuron_index,
-        input_t weights_this_timestep) {
-    // simple wrapper to synapse type input function
-    synapse_param_t *parameters =
-            &(neuron_synapse_shaping_params[neuron_index]);
-    synapse_types_add_neuron_input(synapse_type_index,
-            parameters, weights_this_timestep);
+static void neuron_impl_add_input_array(
+        index_t synapse_type_index, const input_t *inputs,
+        uint32_t n_neurons) {
+    for (index_t neuron_index = 0; neuron_index < n_neurons; neuron_index++) {
+        synapse_types_add_neuron_input(synapse_type_index,
+                &(neuron_synapse_shaping_params[neuron_index]),
+                inputs[neuron_index]);
+    }
 }
 
 static void neuron_impl_load_neuron_parameters(
@@ -206,6 +206,21 @@ static bool neuron_impl_do_timestep_update(index_t neuron_index,
     return spike;
 }
 
+#if EVENT_DRIVEN_NEURONS
+static bool neuron_impl_is_quiescent(index_t neuron_index) {
+    use(neuron_index);
+
+    // The input of this model depends on the history of both receptors, so
+    // it is always updated
+    return false;
+}
+
+static void neuron_impl_decay_at_rest(index_t neuron_index, uint32_t n_steps) {
+    use(neuron_index);
+    use(n_steps);
+}
+#endif // EVENT_DRIVEN_NEURONS
+
 //! \brief stores neuron parameter back into sdram
 //! \param[in] address: the address in sdram to start the store
 static void neuron_impl_store_neuron_parameters(
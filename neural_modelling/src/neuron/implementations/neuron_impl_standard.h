@@ -133,14 +133,14 @@ static bool neuron_impl_initialise(uint32_t n_neurons) {
     return true;
 }
 
-static void neuron_impl_add_inputs(
-        index_t synapse_type_index, index_t neuron_index,
-        input_t weights_this_timestep) {
-    // simple wrapper to synapse type input function
-    synapse_param_pointer_t parameters =
-            &(neuron_synapse_shaping_params[neuron_index]);
-    synapse_types_add_neuron_input(synapse_type_index,
-            parameters, weights_this_timestep);
+static void neuron_impl_add_input_array(
+        index_t synapse_type_index, const input_t *inputs,
+        uint32_t n_neurons) {
+    for (index_t neuron_index = 0; neuron_index < n_neurons; neuron_index++) {
+        synapse_types_add_neuron_input(synapse_type_index,
+                &(neuron_synapse_shaping_params[neuron_index]),
+                inputs[neuron_index]);
+    }
 }
 
 static void neuron_impl_load_neuron_parameters(
@@ -282,6 +282,37 @@ static bool neuron_impl_do_timestep_update(index_t neuron_index,
     return spike;
 }
 
+#if EVENT_DRIVEN_NEURONS
+static bool neuron_impl_is_quiescent(index_t neuron_index) {
+    synapse_param_pointer_t synapse_type =
+        &neuron_synapse_shaping_params[neuron_index];
+
+    // Any input still to be applied to the neuron will change it
+    input_t* exc_value = synapse_types_get_excitatory_input(synapse_type);
+    input_t* inh_value = synapse_types_get_inhibitory_input(synapse_type);
+    for (int i = 0; i < NUM_EXCITATORY_RECEPTORS; i++) {
+        if (REAL_COMPARE(exc_value[i], !=, ZERO)) {
+            return false;
+        }
+    }
+    for (int i = 0; i < NUM_INHIBITORY_RECEPTORS; i++) {
+        if (REAL_COMPARE(inh_value[i], !=, ZERO)) {
+            return false;
+        }
+    }
+
+    return threshold_type_can_skip_at_rest(&threshold_type_array[neuron_index])
+        && additional_input_is_at_rest(&additional_input_array[neuron_index])
+        && neuron_model_is_at_rest(&neuron_array[neuron_index]);
+}
+
+static void neuron_impl_decay_at_rest(index_t neuron_index, uint32_t n_steps) {
+
+    // Only the neuron model has any state to change at rest
+    neuron_model_decay(&neuron_array[neuron_index], n_steps);
+}
+#endif // EVENT_DRIVEN_NEURONS
+
 //! \brief stores neuron parameter back into sdram
 //! \param[in] address: the address in sdram to start the store
 static void neuron_impl_store_neuron_parameters(
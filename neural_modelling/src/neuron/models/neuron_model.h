@@ -25,6 +25,12 @@
 
 #include <common/neuron-typedefs.h>
 
+//! The distance of the membrane voltage from its resting value [mV] within
+//! which a neuron with no input is considered to be at rest
+#ifndef NEURON_REST_EPSILON
+#define NEURON_REST_EPSILON REAL_CONST(0.001)
+#endif
+
 //! Forward declaration of neuron type (creates a definition for a pointer to a
 //   Neuron parameter struct
 typedef struct neuron_t* neuron_pointer_t;
@@ -69,6 +75,20 @@ void neuron_model_has_spiked(neuron_pointer_t neuron);
 //!     parameters specified in neuron
 state_t neuron_model_get_membrane_voltage(restrict neuron_pointer_t neuron);
 
+//! \brief Determine if the neuron is at rest, i.e. that with no input its
+//!     state only decays towards a fixed point (see neuron_model_decay)
+//! \param[in] neuron a pointer to a neuron parameter struct which contains
+//!     all the parameters for a specific neuron
+//! \return true if the neuron is at rest
+bool neuron_model_is_at_rest(restrict neuron_pointer_t neuron);
+
+//! \brief Advance a neuron that is at rest by a number of timesteps with no
+//!     input in one go
+//! \param[in] neuron a pointer to a neuron parameter struct which contains
+//!     all the parameters for a specific neuron
+//! \param[in] n_steps the number of timesteps to advance by
+void neuron_model_decay(neuron_pointer_t neuron, uint32_t n_steps);
+
 //! \brief printout of state variables i.e. those values that might change
 //! \param[in] neuron a pointer to a neuron parameter struct which contains all
 //!     the parameters for a specific neuron
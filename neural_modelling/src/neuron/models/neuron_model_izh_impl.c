@@ -121,6 +121,18 @@ void neuron_model_has_spiked(neuron_pointer_t neuron) {
     neuron->this_h = global_params->machine_timestep_ms * SIMPLE_TQ_OFFSET;
 }
 
+bool neuron_model_is_at_rest(restrict neuron_pointer_t neuron) {
+    use(neuron);
+
+    // There is no closed form of the decay, so the neuron is always updated
+    return false;
+}
+
+void neuron_model_decay(neuron_pointer_t neuron, uint32_t n_steps) {
+    use(neuron);
+    use(n_steps);
+}
+
 state_t neuron_model_get_membrane_voltage(neuron_pointer_t neuron) {
     return neuron->V;
 }
@@ -79,6 +79,38 @@ void neuron_model_has_spiked(neuron_pointer_t neuron) {
     neuron->refract_timer  = neuron->T_refract;
 }
 
+//! The voltage that the membrane decays to with no synaptic input
+static inline REAL _lif_resting_voltage(neuron_pointer_t neuron) {
+    return neuron->V_rest + (neuron->I_offset * neuron->R_membrane);
+}
+
+bool neuron_model_is_at_rest(restrict neuron_pointer_t neuron) {
+    if (neuron->refract_timer > 0) {
+        return false;
+    }
+    REAL distance = neuron->V_membrane - _lif_resting_voltage(neuron);
+    return (distance <= NEURON_REST_EPSILON)
+        && (distance >= -NEURON_REST_EPSILON);
+}
+
+void neuron_model_decay(neuron_pointer_t neuron, uint32_t n_steps) {
+
+    // exp_TC ^ n_steps by squaring; this soon reaches zero for long rests
+    REAL decay = ONE;
+    REAL exp_TC = neuron->exp_TC;
+    while (n_steps > 0 && REAL_COMPARE(decay, >, ZERO)) {
+        if (n_steps & 1) {
+            decay *= exp_TC;
+        }
+        exp_TC *= exp_TC;
+        n_steps >>= 1;
+    }
+
+    // The closed form solution over the whole interval
+    REAL alpha = _lif_resting_voltage(neuron);
+    neuron->V_membrane = alpha - (decay * (alpha - neuron->V_membrane));
+}
+
 state_t neuron_model_get_membrane_voltage(neuron_pointer_t neuron) {
     return neuron->V_membrane;
 }
@@ -92,6 +92,27 @@ static uint32_t expected_time;
 //! The number of recordings outstanding
 static uint32_t n_recordings_outstanding = 0;
 
+#if EVENT_DRIVEN_NEURONS
+//! Neurons to be updated in the next timestep; the others are at rest and
+//! are only brought up to date when they next receive input
+static bit_field_t active_neurons;
+
+//! Neurons that have not been updated since they came to rest
+static bit_field_t resting_neurons;
+
+//! The timestep at which each resting neuron was last updated
+static uint32_t *rest_time;
+
+//! The number of words in active_neurons and resting_neurons
+static uint32_t n_neuron_words;
+
+//! The last timestep that was updated
+static uint32_t last_update_time;
+
+//! The number of neuron updates skipped as the neuron was at rest
+static uint32_t n_updates_skipped = 0;
+#endif // EVENT_DRIVEN_NEURONS
+
 //! parameters that reside in the neuron_parameter_data_region in human
 //! readable form
 typedef enum parameters_in_neuron_parameter_data_region {
@@ -100,6 +121,29 @@ typedef enum parameters_in_neuron_parameter_data_region {
     N_RECORDED_VARIABLES, START_OF_GLOBAL_PARAMETERS,
 } parameters_in_neuron_parameter_data_region;
 
+#if EVENT_DRIVEN_NEURONS
+//! \brief Mark every neuron as active, e.g. after the parameters have been
+//!     (re)loaded
+static void _activate_all_neurons(void) {
+    clear_bit_field(resting_neurons, n_neuron_words);
+    clear_bit_field(active_neurons, n_neuron_words);
+    for (index_t i = 0; i < n_neurons; i++) {
+        bit_field_set(active_neurons, i);
+    }
+}
+
+//! \brief Bring the resting neurons up to date with the last timestep, e.g.
+//!     so that their state can be written back to SDRAM
+static void _decay_resting_neurons(void) {
+    for (index_t i = 0; i < n_neurons; i++) {
+        if (bit_field_test(resting_neurons, i)) {
+            neuron_impl_decay_at_rest(i, last_update_time - rest_time[i]);
+            rest_time[i] = last_update_time;
+        }
+    }
+}
+#endif // EVENT_DRIVEN_NEURONS
+
 static void _reset_record_counter() {
     if (spike_recording_rate == 0){
         // Setting increment to zero means spike_index will never equal
@@ -162,6 +206,11 @@ static bool _neuron_load_neuron_parameters(address_t address) {
 
     // call the neuron implementation functions to do the work
     neuron_impl_load_neuron_parameters(address, next, n_neurons);
+
+#if EVENT_DRIVEN_NEURONS
+    // The new parameters might take any neuron away from rest
+    _activate_all_neurons();
+#endif
     return true;
 }
 
@@ -282,6 +331,20 @@ bool neuron_initialise(address_t address, uint32_t *n_neurons_value,
         }
     }
 
+#if EVENT_DRIVEN_NEURONS
+    n_neuron_words = get_bit_field_size(n_neurons);
+    active_neurons = (bit_field_t) spin1_malloc(
+        n_neuron_words * sizeof(uint32_t));
+    resting_neurons = (bit_field_t) spin1_malloc(
+        n_neuron_words * sizeof(uint32_t));
+    rest_time = (uint32_t *) spin1_malloc(n_neurons * sizeof(uint32_t));
+    if (active_neurons == NULL || resting_neurons == NULL
+            || rest_time == NULL) {
+        log_error("Could not allocate space for the active neuron tracking");
+        return false;
+    }
+#endif // EVENT_DRIVEN_NEURONS
+
     // load the data into the allocated DTCM spaces.
     if (!_neuron_load_neuron_parameters(address)){
         return false;
@@ -301,6 +364,11 @@ void neuron_store_neuron_parameters(address_t address){
     uint32_t n_words_for_n_neurons = (n_neurons + 3) >> 2;
     next += (n_words_for_n_neurons + 2) * (n_recorded_vars + 1);
 
+#if EVENT_DRIVEN_NEURONS
+    // The resting neurons must be stored as they are now
+    _decay_resting_neurons();
+#endif
+
     // call neuron implementation function to do the work
     neuron_impl_store_neuron_parameters(address, next, n_neurons);
 }
@@ -309,6 +377,64 @@ void recording_done_callback() {
     n_recordings_outstanding -= 1;
 }
 
+//! \brief Update a single neuron, recording its state and sending a spike
+//!     if it fires
+//! \param[in] time the timer tick value currently being executed
+//! \param[in] timer_count the count of timer ticks, to stop sending spikes if
+//!     the next tick arrives
+//! \param[in] neuron_index the neuron to update
+//! \param[out] recorded_variable_values space for the variables to record
+static inline void _update_neuron(
+        timer_t time, uint timer_count, index_t neuron_index,
+        state_t *recorded_variable_values) {
+
+    // Get external bias from any source of intrinsic plasticity
+    input_t external_bias =
+        synapse_dynamics_get_intrinsic_bias(time, neuron_index);
+
+    // call the implementation function (boolean for spike)
+    bool spike = neuron_impl_do_timestep_update(
+        neuron_index, external_bias, recorded_variable_values);
+
+    // Write the recorded variable values
+    for (uint32_t i = 0; i < n_recorded_vars; i++) {
+        uint32_t index = var_recording_indexes[i][neuron_index];
+        var_recording_values[i]->states[index] =
+            recorded_variable_values[i];
+    }
+
+    // If the neuron has spiked
+    if (spike) {
+        log_debug("neuron %u spiked at time %u", neuron_index, time);
+
+        // Record the spike
+        out_spikes_set_spike(spike_recording_indexes[neuron_index]);
+
+        // Do any required synapse processing
+        synapse_dynamics_process_post_synaptic_event(time, neuron_index);
+
+        if (use_key) {
+
+            // Wait until the expected time to send
+            while ((ticks == timer_count) &&
+                    (tc[T1_COUNT] > expected_time)) {
+
+                // Do Nothing
+            }
+            expected_time -= time_between_spikes;
+
+            // Send the spike
+            while (!spin1_send_mc_packet(
+                    key | neuron_index, 0, NO_PAYLOAD)) {
+                spin1_delay_us(1);
+            }
+        }
+    } else {
+        log_debug("the neuron %d has been determined to not spike",
+                  neuron_index);
+     }
+}
+
 //! \executes all the updates to neural parameters when a given timer period
 //! has occurred.
 //! \param[in] time the timer tick  value currently being executed
@@ -332,55 +458,57 @@ void neuron_do_timestep_update(
     // Set up an array for storing the recorded variable values
     state_t recorded_variable_values[n_recorded_vars];
 
-    // update each neuron individually
-    for (index_t neuron_index = 0; neuron_index < n_neurons; neuron_index++) {
-
-        // Get external bias from any source of intrinsic plasticity
-        input_t external_bias =
-            synapse_dynamics_get_intrinsic_bias(time, neuron_index);
-
-        // call the implementation function (boolean for spike)
-        bool spike = neuron_impl_do_timestep_update(
-            neuron_index, external_bias, recorded_variable_values);
-
-        // Write the recorded variable values
-        for (uint32_t i = 0; i < n_recorded_vars; i++) {
-            uint32_t index = var_recording_indexes[i][neuron_index];
-            var_recording_values[i]->states[index] =
-                recorded_variable_values[i];
+#ifdef NEURON_IMPL_BATCH_UPDATE
+    // update the state of all the neurons together
+    neuron_impl_do_timestep_update_all(time, n_neurons);
+#endif // NEURON_IMPL_BATCH_UPDATE
+
+#if EVENT_DRIVEN_NEURONS
+    // update each active neuron, skipping words of resting neurons at once
+    uint32_t n_updated = 0;
+    for (uint32_t w = 0; w < n_neuron_words; w++) {
+        if (active_neurons[w] == 0) {
+            continue;
         }
+        index_t last_index = (w + 1) << 5;
+        if (last_index > n_neurons) {
+            last_index = n_neurons;
+        }
+        for (index_t neuron_index = w << 5; neuron_index < last_index;
+                neuron_index++) {
+            if (!bit_field_test(active_neurons, neuron_index)) {
+                continue;
+            }
 
-        // If the neuron has spiked
-        if (spike) {
-            log_debug("neuron %u spiked at time %u", neuron_index, time);
-
-            // Record the spike
-            out_spikes_set_spike(spike_recording_indexes[neuron_index]);
-
-            // Do any required synapse processing
-            synapse_dynamics_process_post_synaptic_event(time, neuron_index);
-
-            if (use_key) {
-
-                // Wait until the expected time to send
-                while ((ticks == timer_count) &&
-                        (tc[T1_COUNT] > expected_time)) {
+            // Catch up with the timesteps missed while at rest
+            if (bit_field_test(resting_neurons, neuron_index)) {
+                neuron_impl_decay_at_rest(
+                    neuron_index, time - rest_time[neuron_index] - 1);
+                bit_field_clear(resting_neurons, neuron_index);
+            }
 
-                    // Do Nothing
-                }
-                expected_time -= time_between_spikes;
+            _update_neuron(
+                time, timer_count, neuron_index, recorded_variable_values);
+            n_updated++;
 
-                // Send the spike
-                while (!spin1_send_mc_packet(
-                        key | neuron_index, 0, NO_PAYLOAD)) {
-                    spin1_delay_us(1);
-                }
+            // Stop updating the neuron until it next receives input; the
+            // values last recorded for it stay in the recording buffers
+            if (neuron_impl_is_quiescent(neuron_index)) {
+                bit_field_clear(active_neurons, neuron_index);
+                bit_field_set(resting_neurons, neuron_index);
+                rest_time[neuron_index] = time;
             }
-        } else {
-            log_debug("the neuron %d has been determined to not spike",
-                      neuron_index);
-         }
+        }
+    }
+    n_updates_skipped += n_neurons - n_updated;
+    last_update_time = time;
+#else
+    // update each neuron individually
+    for (index_t neuron_index = 0; neuron_index < n_neurons; neuron_index++) {
+        _update_neuron(
+            time, timer_count, neuron_index, recorded_variable_values);
     }
+#endif // EVENT_DRIVEN_NEURONS
 
     // Disable interrupts to avoid possible concurrent access
     uint cpsr = 0;
@@ -419,12 +547,28 @@ void neuron_do_timestep_update(
     spin1_mode_restore(cpsr);
 }
 
-void neuron_add_inputs(
-        index_t synapse_type_index, index_t neuron_index,
-        input_t weights_this_timestep) {
-    neuron_impl_add_inputs(
-        synapse_type_index, neuron_index, weights_this_timestep);
+void neuron_add_input_array(
+        index_t synapse_type_index, const input_t *inputs) {
+#if EVENT_DRIVEN_NEURONS
+    // Wake up the neurons that have some input
+    for (index_t neuron_index = 0; neuron_index < n_neurons; neuron_index++) {
+        if (REAL_COMPARE(inputs[neuron_index], !=, ZERO)) {
+            bit_field_set(active_neurons, neuron_index);
+        }
+    }
+#endif
+    neuron_impl_add_input_array(synapse_type_index, inputs, n_neurons);
+}
+
+uint32_t neuron_get_n_recording_channels(void) {
+    return n_recorded_vars + 1;
+}
+
+#if EVENT_DRIVEN_NEURONS
+uint32_t neuron_get_n_updates_skipped(void) {
+    return n_updates_skipped;
 }
+#endif
 
 #if LOG_LEVEL >= LOG_DEBUG
 void neuron_print_inputs() {
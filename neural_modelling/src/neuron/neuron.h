@@ -28,6 +28,13 @@
  *    - neuron_do_timestep_update(time):
  *         executes all the updates to neural parameters when a given timer
  *         period has occurred.
+ *
+ *  When built with EVENT_DRIVEN_NEURONS=1, only the neurons that have input
+ *  to process or have not yet decayed to rest are updated each timestep; a
+ *  resting neuron is brought up to date in one step when it next receives
+ *  input.  This needs the neuron implementation to provide
+ *  neuron_impl_is_quiescent and neuron_impl_decay_at_rest, and assumes that
+ *  any intrinsic bias (see synapse_dynamics_get_intrinsic_bias) is zero.
  */
 
 #ifndef _NEURON_H_
@@ -72,14 +79,23 @@ bool neuron_reload_neuron_parameters(address_t address);
 //!            NEURON_PARAMS data region in SDRAM
 void neuron_store_neuron_parameters(address_t address);
 
-//! \brief Add inputs to the neuron
+//! \brief Add an input of one synapse type to every neuron
 //! \param[in] synapse_type_index the synapse type (e.g. exc. or inh.)
-//! \param[in] neuron_index the index of the neuron
-//! \param[in] weights_this_timestep weight inputs to be added
-//! \return None
-void neuron_add_inputs(
-        index_t synapse_type_index, index_t neuron_index,
-        input_t weights_this_timestep);
+//! \param[in] inputs the input for each neuron
+void neuron_add_input_array(
+        index_t synapse_type_index, const input_t *inputs);
+
+//! \brief Get the number of recording channels used by the neurons, for
+//!        spikes and each recorded variable
+//! \return the number of recording channels
+uint32_t neuron_get_n_recording_channels(void);
+
+#if EVENT_DRIVEN_NEURONS
+//! \brief Get the number of neuron updates that have been skipped because
+//!     the neuron was at rest
+//! \return the number of skipped updates
+uint32_t neuron_get_n_updates_skipped(void);
+#endif
 
 #if LOG_LEVEL >= LOG_DEBUG
 void neuron_print_inputs();
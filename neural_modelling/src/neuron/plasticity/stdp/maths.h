@@ -72,6 +72,80 @@ static inline int32_t maths_lut_exponential_decay(
     return (lut_index < lut_size) ? lut[lut_index] : 0;
 }
 
+//---------------------------------------
+// Exponential decay lookup tables whose size and resolution are read from
+// SDRAM.  Each table starts with a word holding:
+//
+// |  Shared  | Interpolate |  Time shift  |     Size      |
+// |  bit 25  |   bit 24    |  bits 16-23  |  bits 0-15    |
+//
+// followed, unless it is shared, by the int16 entries padded to a word.  A
+// shared table uses the entries of the table read before it.
+#define DECAY_LUT_SIZE_MASK 0xFFFF
+#define DECAY_LUT_SHIFT_SHIFT 16
+#define DECAY_LUT_SHIFT_MASK 0xFF
+#define DECAY_LUT_INTERPOLATE_BIT 24
+#define DECAY_LUT_SHARED_BIT 25
+
+typedef struct {
+    // The number of entries
+    uint32_t size;
+
+    // The time is shifted right by this to give the index of an entry
+    uint32_t shift;
+
+    // Whether to interpolate linearly between the entries either side
+    bool interpolate;
+
+    // The entries, which can be shared with another table
+    const int16_t *values;
+} decay_lut_t;
+
+//---------------------------------------
+// Read a table, returning the address after it, or NULL if there is not
+// enough DTCM for it
+static inline address_t maths_read_decay_lut(
+        address_t start_address, decay_lut_t *lut,
+        const decay_lut_t *previous_lut) {
+    const uint32_t header = start_address[0];
+    if ((header & (1 << DECAY_LUT_SHARED_BIT)) && previous_lut != NULL) {
+        *lut = *previous_lut;
+        return &start_address[1];
+    }
+
+    lut->size = header & DECAY_LUT_SIZE_MASK;
+    lut->shift = (header >> DECAY_LUT_SHIFT_SHIFT) & DECAY_LUT_SHIFT_MASK;
+    lut->interpolate = (header & (1 << DECAY_LUT_INTERPOLATE_BIT)) != 0;
+    int16_t *values = (int16_t *) spin1_malloc(lut->size * sizeof(int16_t));
+    if (values == NULL) {
+        return NULL;
+    }
+    lut->values = values;
+    return maths_copy_int16_lut(&start_address[1], lut->size, values);
+}
+
+//---------------------------------------
+static inline int32_t maths_decay_lut_lookup(
+        uint32_t time, const decay_lut_t *lut) {
+
+    // Calculate lut index
+    const uint32_t lut_index = time >> lut->shift;
+    if (lut_index >= lut->size) {
+        return 0;
+    }
+    int32_t value = lut->values[lut_index];
+
+    // Move towards the next entry (0 after the last) by how far the time is
+    // between the times of the entries
+    if (lut->interpolate) {
+        const uint32_t fraction = time & ((1 << lut->shift) - 1);
+        const int32_t next_value = (lut_index + 1 < lut->size) ?
+            lut->values[lut_index + 1] : 0;
+        value += ((next_value - value) * (int32_t) fraction) >> lut->shift;
+    }
+    return value;
+}
+
 //---------------------------------------
 static inline int32_t maths_fixed_mul16(
         int32_t a, int32_t b, const int32_t fixed_point_position) {
@@ -25,91 +25,139 @@
 // Include debug header for log_info etc
 #include <debug.h>
 
-//---------------------------------------
-// Macros
-//---------------------------------------
-#define MAX_POST_SYNAPTIC_EVENTS 16
-
 //---------------------------------------
 // Structures
 //---------------------------------------
+// A circular history of the post-synaptic events of one neuron.  The
+// history always holds at least one event (initially a placeholder at time
+// 0); when it is full, adding an event overwrites the oldest.  The times and
+// traces of all the neurons are in two shared arrays, each neuron having
+// post_event_history_capacity consecutive entries of them.
 typedef struct {
-    uint32_t count_minus_one;
+    uint32_t *times;
+    post_trace_t *traces;
+
+    // The index of the oldest event
+    uint16_t first;
 
-    uint32_t times[MAX_POST_SYNAPTIC_EVENTS];
-    post_trace_t traces[MAX_POST_SYNAPTIC_EVENTS];
+    // The number of events held
+    uint16_t count;
 } post_event_history_t;
 
 typedef struct {
     post_trace_t prev_trace;
     uint32_t prev_time;
-    const post_trace_t *next_trace;
-    const uint32_t *next_time;
+    const post_event_history_t *events;
+    uint32_t next_index;
     uint32_t num_events;
 } post_event_window_t;
 
+//---------------------------------------
+// Globals
+//---------------------------------------
+// The number of events held per neuron, set from the synapse dynamics region
+static uint32_t post_event_history_capacity;
+
 //---------------------------------------
 // Inline functions
 //---------------------------------------
 static inline post_event_history_t *post_events_init_buffers(
-        uint32_t n_neurons) {
+        uint32_t n_neurons, uint32_t capacity) {
+
+    // There must be space for a new event as well as the one before it
+    if (capacity < 2 || capacity > UINT16_MAX) {
+        log_error("Post-synaptic event history capacity %u is invalid",
+                  capacity);
+        return NULL;
+    }
+    post_event_history_capacity = capacity;
+
     post_event_history_t *post_event_history =
         (post_event_history_t*) spin1_malloc(
             n_neurons * sizeof(post_event_history_t));
+    uint32_t *times = (uint32_t*) spin1_malloc(
+        n_neurons * capacity * sizeof(uint32_t));
+    post_trace_t *traces = (post_trace_t*) spin1_malloc(
+        n_neurons * capacity * sizeof(post_trace_t));
 
     // Check allocations succeeded
-    if (post_event_history == NULL) {
+    if (post_event_history == NULL || times == NULL || traces == NULL) {
         log_error(
             "Unable to allocate global STDP structures - Out of DTCM: Try "
-            "reducing the number of neurons per core to fix this problem ");
+            "reducing the number of neurons per core or the post-synaptic "
+            "event history size to fix this problem ");
         return NULL;
     }
 
     // Loop through neurons
     for (uint32_t n = 0; n < n_neurons; n++) {
+        post_event_history_t *history = &post_event_history[n];
+        history->times = &times[n * capacity];
+        history->traces = &traces[n * capacity];
 
         // Add initial placeholder entry to buffer
-        post_event_history[n].times[0] = 0;
-        post_event_history[n].traces[0] = timing_get_initial_post_trace();
-        post_event_history[n].count_minus_one = 0;
+        history->times[0] = 0;
+        history->traces[0] = timing_get_initial_post_trace();
+        history->first = 0;
+        history->count = 1;
     }
 
     return post_event_history;
 }
 
-static inline post_event_window_t post_events_get_window(
-        const post_event_history_t *events, uint32_t begin_time) {
-
-    // Start at end event - beyond end of post-event history
-    const uint32_t count = events->count_minus_one + 1;
-    const uint32_t *end_event_time = events->times + count;
-    const post_trace_t *end_event_trace = events->traces + count;
-    const uint32_t *event_time = end_event_time;
-    post_event_window_t window;
-    do {
-
-        // Cache pointer to this event as potential
-        // Next event and go back one event
-        // **NOTE** next_time can be invalid
-        window.next_time = event_time--;
+//---------------------------------------
+// Convert the position of an event in age order (0 being the oldest) into
+// its index in the times and traces
+static inline uint32_t _post_events_index(
+        const post_event_history_t *events, uint32_t position) {
+    uint32_t index = events->first + position;
+    if (index >= post_event_history_capacity) {
+        index -= post_event_history_capacity;
     }
+    return index;
+}
 
-    // Keep looping while event occurred after start
-    // Of window and we haven't hit beginning of array
-    while (*event_time > begin_time && event_time != events->times);
+//---------------------------------------
+// Find the position in age order of the newest event at or before a time,
+// or of the oldest event if all are after it.  The times are in order, so
+// this is a binary search.
+static inline uint32_t _post_events_find(
+        const post_event_history_t *events, uint32_t time) {
+    uint32_t low = 0;
+    uint32_t high = events->count;
+    while (high - low > 1) {
+        const uint32_t mid = (low + high) >> 1;
+        if (events->times[_post_events_index(events, mid)] > time) {
+            high = mid;
+        } else {
+            low = mid;
+        }
+    }
+    return low;
+}
 
-    // Deference event to use as previous
-    window.prev_time = *event_time;
+//---------------------------------------
+static inline post_event_window_t _post_events_window(
+        const post_event_history_t *events, uint32_t prev_position,
+        uint32_t end_position) {
+    const uint32_t prev_index = _post_events_index(events, prev_position);
 
-    // Calculate number of events
-    window.num_events = (end_event_time - window.next_time);
+    post_event_window_t window;
+    window.events = events;
+    window.prev_time = events->times[prev_index];
+    window.prev_trace = events->traces[prev_index];
+    window.next_index = _post_events_index(events, prev_position + 1);
+    window.num_events = end_position - prev_position;
+    return window;
+}
 
-    // Using num_events, find next and previous traces
-    window.next_trace = (end_event_trace - window.num_events);
-    window.prev_trace = *(window.next_trace - 1);
+//---------------------------------------
+static inline post_event_window_t post_events_get_window(
+        const post_event_history_t *events, uint32_t begin_time) {
 
-    // Return window
-    return window;
+    // The window runs from the event before the start to the newest event
+    return _post_events_window(
+        events, _post_events_find(events, begin_time), events->count - 1);
 }
 
 //---------------------------------------
@@ -117,49 +165,35 @@ static inline post_event_window_t post_events_get_window_delayed(
         const post_event_history_t *events, uint32_t begin_time,
         uint32_t end_time) {
 
-    // Start at end event - beyond end of post-event history
-    const uint32_t count = events->count_minus_one + 1;
-    const uint32_t *end_event_time = events->times + count;
-    const uint32_t *event_time = end_event_time;
-
-    post_event_window_t window;
-    do {
-        // Cache pointer to this event as potential
-        // Next event and go back one event
-        // **NOTE** next_time can be invalid
-        window.next_time = event_time--;
-
-        // If this event is still in the future, set it as the end
-        if (*event_time > end_time) {
-            end_event_time = event_time;
-        }
+    // The window runs from the event before the start to the newest event
+    // that is not in the future
+    const uint32_t prev_position = _post_events_find(events, begin_time);
+    uint32_t end_position = _post_events_find(events, end_time);
+    if (end_position < prev_position) {
+        end_position = prev_position;
     }
+    return _post_events_window(events, prev_position, end_position);
+}
 
-    // Keep looping while event occurred after start
-    // Of window and we haven't hit beginning of array
-    while (*event_time > begin_time && event_time != events->times);
-
-    // Deference event to use as previous
-    window.prev_time = *event_time;
-
-    // Calculate number of events
-    window.num_events = (end_event_time - window.next_time);
-
-    // Using num_events, find next and previous traces
-    const post_trace_t *end_event_trace = events->traces + count;
-    window.next_trace = (end_event_trace - window.num_events);
-    window.prev_trace = *(window.next_trace - 1);
+//---------------------------------------
+static inline uint32_t post_events_next_time(post_event_window_t window) {
+    return window.events->times[window.next_index];
+}
 
-    // Return window
-    return window;
+//---------------------------------------
+static inline post_trace_t post_events_next_trace(post_event_window_t window) {
+    return window.events->traces[window.next_index];
 }
 
 //---------------------------------------
 static inline post_event_window_t post_events_next(post_event_window_t window) {
 
-    // Update previous time and increment next time
-    window.prev_time = *window.next_time++;
-    window.prev_trace = *window.next_trace++;
+    // Update previous time and go onto the next event
+    window.prev_time = post_events_next_time(window);
+    window.prev_trace = post_events_next_trace(window);
+    if (++window.next_index == post_event_history_capacity) {
+        window.next_index = 0;
+    }
 
     // Decrement remaining events
     window.num_events--;
@@ -170,52 +204,62 @@ static inline post_event_window_t post_events_next(post_event_window_t window) {
 static inline post_event_window_t post_events_next_delayed(
         post_event_window_t window, uint32_t delayed_time) {
 
-    // Update previous time and increment next time
+    // Update previous time and go onto the next event
     window.prev_time = delayed_time;
-    window.prev_trace = *window.next_trace++;
-
-    // Go onto next event
-    window.next_time++;
+    window.prev_trace = post_events_next_trace(window);
+    if (++window.next_index == post_event_history_capacity) {
+        window.next_index = 0;
+    }
 
     // Decrement remaining events
     window.num_events--;
     return window;
 }
 
+//---------------------------------------
+static inline uint32_t post_events_last_time(
+        const post_event_history_t *events) {
+    return events->times[_post_events_index(events, events->count - 1)];
+}
+
+//---------------------------------------
+static inline post_trace_t post_events_last_trace(
+        const post_event_history_t *events) {
+    return events->traces[_post_events_index(events, events->count - 1)];
+}
+
 //---------------------------------------
 static inline void post_events_add(uint32_t time, post_event_history_t *events,
                                    post_trace_t trace) {
 
-    if (events->count_minus_one < (MAX_POST_SYNAPTIC_EVENTS - 1)) {
+    if (events->count < post_event_history_capacity) {
 
         // If there's still space, store time at current end
-        // and increment count minus 1
-        const uint32_t new_index = ++events->count_minus_one;
+        // and increment count
+        const uint32_t new_index = _post_events_index(events, events->count);
+        events->count++;
         events->times[new_index] = time;
         events->traces[new_index] = trace;
     } else {
 
-        // Otherwise Shuffle down elements
-        // **NOTE** 1st element is always an entry at time 0
-        for (uint32_t e = 2; e < MAX_POST_SYNAPTIC_EVENTS; e++) {
-            events->times[e - 1] = events->times[e];
-            events->traces[e - 1] = events->traces[e];
-        }
-
-        // Stick new time at end
-        events->times[MAX_POST_SYNAPTIC_EVENTS - 1] = time;
-        events->traces[MAX_POST_SYNAPTIC_EVENTS - 1] = trace;
+        // Otherwise overwrite the oldest event, making the next oldest
+        // the first
+        const uint32_t new_index = events->first;
+        events->first = _post_events_index(events, 1);
+        events->times[new_index] = time;
+        events->traces[new_index] = trace;
     }
 }
 
 
 static inline void print_event_history(post_event_history_t *events){
 	log_debug("		##  printing entire post event history  ##");
-	for (uint i = 0; i <= events->count_minus_one; i++){
+	for (uint i = 0; i < events->count; i++){
+		const uint32_t index = _post_events_index(events, i);
 		log_debug("post event: %u, time: %u, trace: %u",
 				i,
-				events->times[i],
-				events->traces[i]
+				events->times[index],
+				events->traces[index]
 				);
 	}
 }
@@ -227,11 +271,11 @@ static inline void print_delayed_window_events(post_event_history_t *post_event_
             post_event_history, begin_time, end_time);
 
     while (post_window.num_events > 0) {
-    	const uint32_t delayed_post_time = *post_window.next_time
+    	const uint32_t delayed_post_time = post_events_next_time(post_window)
     	                                           + delay_dendritic;
     	log_debug("post spike: %u, time: %u, trace: %u",
     			post_window.num_events, delayed_post_time,
-				*post_window.next_trace);
+				post_events_next_trace(post_window));
 
     	post_window = post_events_next_delayed(post_window, delayed_post_time);
     }
@@ -41,6 +41,22 @@ static uint32_t synapse_type_mask;
 uint32_t num_plastic_pre_synaptic_events = 0;
 uint32_t plastic_saturation_count = 0;
 
+// The most pre-synaptic spikes whose updates can be deferred in each row; 0
+// if every spike updates the row
+static uint32_t max_deferred_pre_spikes;
+
+// Whether a deferred spike delivers the weights stored in the row, rather
+// than those that the updates of it and the spikes deferred before it give;
+// this changes the dynamics of the network, so is only done if asked for
+static bool approximate_deferred_weights;
+
+// The size of the header at the start of the plastic region of each row
+static uint32_t plastic_header_words;
+
+// The times and traces of the pre-synaptic spikes being applied to a row
+static uint32_t *pre_spike_times;
+static pre_trace_t *pre_spike_traces;
+
 //---------------------------------------
 // Macros
 //---------------------------------------
@@ -77,12 +93,48 @@ typedef struct {
     uint32_t prev_time;
 } pre_event_history_t;
 
+// The spikes not yet applied to the synapses of a row, which follows the
+// pre_event_history_t in the header when updates are deferred; the time and
+// trace of the history are those of the last spike that was applied.  The
+// post-synaptic neurons of the row are noted as a bit for each bucket of
+// neurons that they are in, so that whether any has spiked can be found
+// without reading the row.  A row is listed in rows_with_deferred_spikes
+// the first time that a spike is deferred, and stays listed until the end of
+// the run.
+typedef struct {
+    uint32_t post_buckets;
+    uint16_t n_spikes;
+    uint16_t is_listed;
+    uint32_t times[];
+} deferred_pre_spikes_t;
+
+// The most rows that can have spikes deferred in a run; once this many are
+// listed, the spikes of other rows are applied at once.  This must match
+// MAX_ROWS_WITH_DEFERRED_SPIKES in synapse_dynamics_stdp.py
+#define MAX_ROWS_WITH_DEFERRED_SPIKES 1024
+
+// The addresses in SDRAM of the rows that might have deferred spikes, to be
+// applied at the end of the run
+static address_t *rows_with_deferred_spikes;
+static uint32_t n_rows_with_deferred_spikes = 0;
+
+// The number of buckets that the post-synaptic neurons are divided between,
+// one for each bit of deferred_pre_spikes_t.post_buckets
+#define N_POST_BUCKETS 32
+
+// The time of the last post-synaptic spike of any neuron in each bucket
+static uint32_t bucket_last_post_time[N_POST_BUCKETS];
+
+static inline uint32_t _post_bucket(index_t neuron_index) {
+    return neuron_index & (N_POST_BUCKETS - 1);
+}
+
 post_event_history_t *post_event_history;
 
 //---------------------------------------
 // Synapse update loop
 //---------------------------------------
-static inline final_state_t _plasticity_update_synapse(
+static inline update_state_t _plasticity_update_synapse(
         uint32_t time,
         const uint32_t last_pre_time, const pre_trace_t last_pre_trace,
         const pre_trace_t new_pre_trace, const uint32_t delay_dendritic,
@@ -110,14 +162,15 @@ static inline final_state_t _plasticity_update_synapse(
 
     // Process events in post-synaptic window
     while (post_window.num_events > 0) {
-        const uint32_t delayed_post_time = *post_window.next_time
+        const uint32_t delayed_post_time = post_events_next_time(post_window)
                                            + delay_dendritic;
         log_debug("\t\tApplying post-synaptic event at delayed time:%u\n",
               delayed_post_time);
 
         // Apply spike to state
         current_state = timing_apply_post_spike(
-            delayed_post_time, *post_window.next_trace, delayed_last_pre_time,
+            delayed_post_time, post_events_next_trace(post_window),
+            delayed_last_pre_time,
             last_pre_trace, post_window.prev_time, post_window.prev_trace,
             current_state);
 
@@ -131,28 +184,26 @@ static inline final_state_t _plasticity_update_synapse(
 
     // Apply spike to state
     // **NOTE** dendritic delay is subtracted
-    current_state = timing_apply_pre_spike(
+    return timing_apply_pre_spike(
         delayed_pre_time, new_pre_trace, delayed_last_pre_time, last_pre_trace,
         post_window.prev_time, post_window.prev_trace, current_state);
-
-    // Return final synaptic word and weight
-    return synapse_structure_get_final_state(current_state);
 }
 
 //---------------------------------------
 // Synaptic row plastic-region implementation
 //---------------------------------------
+#define PRE_EVENT_HISTORY_SIZE_WORDS \
+    (sizeof(pre_event_history_t) / sizeof(uint32_t))
+
 static inline plastic_synapse_t* _plastic_synapses(
         address_t plastic_region_address) {
-    const uint32_t pre_event_history_size_words =
-        sizeof(pre_event_history_t) / sizeof(uint32_t);
-    static_assert(pre_event_history_size_words * sizeof(uint32_t)
+    static_assert(PRE_EVENT_HISTORY_SIZE_WORDS * sizeof(uint32_t)
                   == sizeof(pre_event_history_t),
                   "Size of pre_event_history_t structure should be a multiple"
                   " of 32-bit words");
 
     return (plastic_synapse_t*)
-        (&plastic_region_address[pre_event_history_size_words]);
+        (&plastic_region_address[plastic_header_words]);
 }
 
 //---------------------------------------
@@ -161,6 +212,13 @@ static inline pre_event_history_t *_plastic_event_history(
     return (pre_event_history_t*) (&plastic_region_address[0]);
 }
 
+//---------------------------------------
+static inline deferred_pre_spikes_t *_plastic_deferred_pre_spikes(
+        address_t plastic_region_address) {
+    return (deferred_pre_spikes_t*)
+        (&plastic_region_address[PRE_EVENT_HISTORY_SIZE_WORDS]);
+}
+
 void synapse_dynamics_print_plastic_synapses(
         address_t plastic_region_address, address_t fixed_region_address,
         uint32_t *ring_buffer_to_input_buffer_left_shifts) {
@@ -203,21 +261,27 @@ void synapse_dynamics_print_plastic_synapses(
 #endif // LOG_LEVEL >= LOG_DEBUG
 }
 
-//---------------------------------------
-static inline index_t _sparse_axonal_delay(uint32_t x) {
-    return ((x >> synapse_delay_index_type_bits) & SYNAPSE_AXONAL_DELAY_MASK);
-}
-
 address_t synapse_dynamics_initialise(
         address_t address, uint32_t n_neurons, uint32_t n_synapse_types,
         uint32_t *ring_buffer_to_input_buffer_left_shifts) {
 
-    // Load timing dependence data
-    address_t weight_region_address = timing_initialise(address);
     if (address == NULL) {
         return NULL;
     }
 
+    // Read the number of post-synaptic events to remember per neuron, the
+    // number of pre-synaptic spikes that can be deferred in each row, and
+    // how the weights of deferred spikes are delivered
+    uint32_t post_event_history_size = address[0];
+    max_deferred_pre_spikes = address[1];
+    approximate_deferred_weights = (address[2] != 0);
+
+    // Load timing dependence data
+    address_t weight_region_address = timing_initialise(&address[3]);
+    if (weight_region_address == NULL) {
+        return NULL;
+    }
+
     // Load weight dependence data
     address_t weight_result = weight_initialise(
         weight_region_address, n_synapse_types,
@@ -226,11 +290,37 @@ address_t synapse_dynamics_initialise(
         return NULL;
     }
 
-    post_event_history = post_events_init_buffers(n_neurons);
+    post_event_history = post_events_init_buffers(
+        n_neurons, post_event_history_size);
     if (post_event_history == NULL) {
         return NULL;
     }
 
+    // The deferred spikes, if any, follow the pre-synaptic event history in
+    // the row header; every spike deferred and the current one can be
+    // applied at once
+    plastic_header_words = PRE_EVENT_HISTORY_SIZE_WORDS;
+    if (max_deferred_pre_spikes > 0) {
+        plastic_header_words += (sizeof(deferred_pre_spikes_t) >> 2)
+            + max_deferred_pre_spikes;
+    }
+    pre_spike_times = (uint32_t*) spin1_malloc(
+        (max_deferred_pre_spikes + 1) * sizeof(uint32_t));
+    pre_spike_traces = (pre_trace_t*) spin1_malloc(
+        (max_deferred_pre_spikes + 1) * sizeof(pre_trace_t));
+    if (pre_spike_times == NULL || pre_spike_traces == NULL) {
+        log_error("Unable to allocate pre-synaptic spike buffers");
+        return NULL;
+    }
+    if (max_deferred_pre_spikes > 0) {
+        rows_with_deferred_spikes = (address_t*) spin1_malloc(
+            MAX_ROWS_WITH_DEFERRED_SPIKES * sizeof(address_t));
+        if (rows_with_deferred_spikes == NULL) {
+            log_error("Unable to allocate the list of deferred rows");
+            return NULL;
+        }
+    }
+
     uint32_t n_neurons_power_2 = n_neurons;
     uint32_t log_n_neurons = 1;
     if (n_neurons != 1) {
@@ -257,36 +347,142 @@ address_t synapse_dynamics_initialise(
     return weight_result;
 }
 
-bool synapse_dynamics_process_plastic_synapses(
-        address_t plastic_region_address, address_t fixed_region_address,
-        weight_t *ring_buffers, uint32_t time) {
+//---------------------------------------
+static inline void _add_to_ring_buffer(
+        weight_t *ring_buffers, uint32_t ring_buffer_index, weight_t weight) {
 
-    // Extract separate arrays of plastic synapses (from plastic region),
-    // Control words (from fixed region) and number of plastic synapses
+    // Add weight to ring-buffer entry
+    // **NOTE** Dave suspects that this could be a
+    // potential location for overflow
+
+    uint32_t accumulation = ring_buffers[ring_buffer_index] + weight;
+
+    uint32_t sat_test = accumulation & 0x10000;
+    if (sat_test){
+        accumulation = sat_test - 1;
+        plastic_saturation_count += 1;
+    }
+
+    ring_buffers[ring_buffer_index] = accumulation;
+}
+
+//---------------------------------------
+// Whether the deferred updates of a row must be applied now, because there
+// is no space to defer another spike, because the row can't be listed to be
+// brought up to date at the end of the run, or because a post-synaptic
+// neuron in one of the buckets of the row has spiked since the updates were
+// last applied (which is always the case before the buckets are first noted)
+static inline bool _is_update_due(
+        const pre_event_history_t *event_history,
+        const deferred_pre_spikes_t *deferred, address_t sdram_row_address) {
+    if (deferred->n_spikes >= max_deferred_pre_spikes) {
+        return true;
+    }
+    if (!deferred->is_listed && (sdram_row_address == NULL ||
+            n_rows_with_deferred_spikes >= MAX_ROWS_WITH_DEFERRED_SPIKES)) {
+        return true;
+    }
+    uint32_t buckets = deferred->post_buckets;
+    if (buckets == 0) {
+        return true;
+    }
+    while (buckets != 0) {
+        uint32_t bucket = 31 - __builtin_clz(buckets);
+        if (bucket_last_post_time[bucket] > event_history->prev_time) {
+            return true;
+        }
+        buckets &= ~(1u << bucket);
+    }
+    return false;
+}
+
+//---------------------------------------
+// Add the weights stored in a row to the ring buffers, without updating them
+// with the spike or those deferred before it
+static inline void _process_without_update(
+        const plastic_synapse_t *plastic_words, const control_t *control_words,
+        size_t n_plastic_synapses, weight_t *ring_buffers, uint32_t time) {
+    for (; n_plastic_synapses > 0; n_plastic_synapses--) {
+        uint32_t control_word = *control_words++;
+        uint32_t delay_dendritic = synapse_row_sparse_delay(
+            control_word, synapse_type_index_bits);
+        uint32_t type = synapse_row_sparse_type(
+            control_word, synapse_index_bits, synapse_type_mask);
+        uint32_t type_index = synapse_row_sparse_type_index(
+            control_word, synapse_type_index_mask);
+
+        final_state_t final_state = synapse_structure_get_final_state(
+            synapse_structure_get_update_state(*plastic_words++, type));
+        uint32_t ring_buffer_index = synapses_get_ring_buffer_index_combined(
+                delay_dendritic + time, type_index, synapse_type_index_bits);
+        _add_to_ring_buffer(ring_buffers, ring_buffer_index,
+            synapse_structure_get_final_weight(final_state));
+    }
+}
+
+//---------------------------------------
+// Whether a value in the plastic region differs from a new one; the values
+// can be structures, so are compared byte by byte
+static inline bool _is_plastic_value_changed(
+        const void *new_value, const void *old_value, size_t n_bytes) {
+    const uint8_t *new_bytes = (const uint8_t *) new_value;
+    const uint8_t *old_bytes = (const uint8_t *) old_value;
+    for (uint32_t i = 0; i < n_bytes; i++) {
+        if (new_bytes[i] != old_bytes[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------------------------------------
+// Update the synapses of a row with the n_spikes pre-synaptic spikes in
+// pre_spike_times, in order.  If ring_buffers is not NULL, the weights are
+// added to them at the time of the last spike.  If update_row is false, the
+// row is left as it was, so only the weights are delivered.  Returns the
+// number of words at the start of the plastic region that changed, which is
+// 0 if none did.
+static inline size_t _apply_pre_spikes(
+        address_t plastic_region_address, address_t fixed_region_address,
+        uint32_t n_spikes, weight_t *ring_buffers, bool update_row) {
     plastic_synapse_t *plastic_words = _plastic_synapses(
         plastic_region_address);
     const control_t *control_words = synapse_row_plastic_controls(
         fixed_region_address);
     size_t plastic_synapse = synapse_row_num_plastic_controls(
         fixed_region_address);
-
-    num_plastic_pre_synaptic_events += plastic_synapse;
-
-    // Get event history from synaptic row
     pre_event_history_t *event_history = _plastic_event_history(
         plastic_region_address);
+    const uint32_t time = pre_spike_times[n_spikes - 1];
 
     // Get last pre-synaptic event from event history
     const uint32_t last_pre_time = event_history->prev_time;
     const pre_trace_t last_pre_trace = event_history->prev_trace;
 
-    // Update pre-synaptic trace
-    log_debug("Adding pre-synaptic event to trace at time:%u", time);
-    event_history->prev_time = time;
-    event_history->prev_trace = timing_add_pre_spike(time, last_pre_time,
-                                                     last_pre_trace);
+    // Update pre-synaptic trace for each spike to be applied
+    uint32_t prev_time = last_pre_time;
+    pre_trace_t prev_trace = last_pre_trace;
+    for (uint32_t i = 0; i < n_spikes; i++) {
+        log_debug("Adding pre-synaptic event to trace at time:%u",
+            pre_spike_times[i]);
+        prev_trace = timing_add_pre_spike(
+            pre_spike_times[i], prev_time, prev_trace);
+        prev_time = pre_spike_times[i];
+        pre_spike_traces[i] = prev_trace;
+    }
+    bool header_changed = event_history->prev_time != time
+        || _is_plastic_value_changed(
+            &prev_trace, &event_history->prev_trace, sizeof(pre_trace_t));
+    if (update_row) {
+        event_history->prev_time = time;
+        event_history->prev_trace = prev_trace;
+    }
 
-    // Loop through plastic synapses
+    // Loop through plastic synapses, noting the last that changes and the
+    // buckets of the post-synaptic neurons
+    const plastic_synapse_t *first_plastic_word = plastic_words;
+    const plastic_synapse_t *end_changed_words = plastic_words;
+    uint32_t post_buckets = 0;
     for (; plastic_synapse > 0; plastic_synapse--) {
 
         // Get next control word (auto incrementing)
@@ -295,7 +491,7 @@ bool synapse_dynamics_process_plastic_synapses(
         // Extract control-word components
         // **NOTE** cunningly, control word is just the same as lower
         // 16-bits of 32-bit fixed synapse so same functions can be used
-        uint32_t delay_axonal = 0;    //_sparse_axonal_delay(control_word);
+        uint32_t delay_axonal = 0;    // Axonal delays are not supported
         uint32_t delay_dendritic = synapse_row_sparse_delay(
             control_word, synapse_type_index_bits);
         uint32_t type = synapse_row_sparse_type(
@@ -304,53 +500,170 @@ bool synapse_dynamics_process_plastic_synapses(
             control_word, synapse_index_mask);
         uint32_t type_index = synapse_row_sparse_type_index(
             control_word, synapse_type_index_mask);
+        post_buckets |= 1u << _post_bucket(index);
 
         // Create update state from the plastic synaptic word
         update_state_t current_state = synapse_structure_get_update_state(
             *plastic_words, type);
 
-        // Update the synapse state
-        final_state_t final_state = _plasticity_update_synapse(
-            time, last_pre_time, last_pre_trace, event_history->prev_trace,
-            delay_dendritic, delay_axonal, current_state,
-            &post_event_history[index]);
+        // Update the synapse state with each spike in turn, going through
+        // the synaptic word between them as when each is applied at once,
+        // so that the result is the same and the state can't overflow
+        uint32_t spike_last_pre_time = last_pre_time;
+        pre_trace_t spike_last_pre_trace = last_pre_trace;
+        for (uint32_t i = 0; i < n_spikes; i++) {
+            if (i > 0) {
+                current_state = synapse_structure_get_update_state(
+                    synapse_structure_get_final_synaptic_word(
+                        synapse_structure_get_final_state(current_state)),
+                    type);
+            }
+            current_state = _plasticity_update_synapse(
+                pre_spike_times[i], spike_last_pre_time, spike_last_pre_trace,
+                pre_spike_traces[i], delay_dendritic, delay_axonal,
+                current_state, &post_event_history[index]);
+            spike_last_pre_time = pre_spike_times[i];
+            spike_last_pre_trace = pre_spike_traces[i];
+        }
+        final_state_t final_state = synapse_structure_get_final_state(
+            current_state);
 
-        // Convert into ring buffer offset
-        uint32_t ring_buffer_index = synapses_get_ring_buffer_index_combined(
-                delay_axonal + delay_dendritic + time, type_index,
-                synapse_type_index_bits);
+        if (ring_buffers != NULL) {
 
-        // Add weight to ring-buffer entry
-        // **NOTE** Dave suspects that this could be a
-        // potential location for overflow
+            // Convert into ring buffer offset
+            uint32_t ring_buffer_index =
+                synapses_get_ring_buffer_index_combined(
+                    delay_axonal + delay_dendritic + time, type_index,
+                    synapse_type_index_bits);
 
-        uint32_t accumulation = ring_buffers[ring_buffer_index] +
-                synapse_structure_get_final_weight(final_state);
+            // Add weight to ring-buffer entry
+            _add_to_ring_buffer(ring_buffers, ring_buffer_index,
+                synapse_structure_get_final_weight(final_state));
+        }
 
-        uint32_t sat_test = accumulation & 0x10000;
-        if (sat_test){
-            accumulation = sat_test - 1;
-            plastic_saturation_count += 1;
+        // Write back updated synaptic word to plastic region
+        plastic_synapse_t new_word =
+            synapse_structure_get_final_synaptic_word(final_state);
+        if (update_row && _is_plastic_value_changed(
+                &new_word, plastic_words, sizeof(plastic_synapse_t))) {
+            *plastic_words = new_word;
+            end_changed_words = plastic_words + 1;
         }
+        plastic_words++;
+    }
 
-        ring_buffers[ring_buffer_index] = accumulation;
+    if (!update_row) {
+        return 0;
+    }
+    if (max_deferred_pre_spikes > 0) {
+        deferred_pre_spikes_t *deferred = _plastic_deferred_pre_spikes(
+            plastic_region_address);
+        header_changed = header_changed || deferred->n_spikes > 0
+            || deferred->post_buckets != post_buckets;
+        deferred->n_spikes = 0;
+        deferred->post_buckets = post_buckets;
+    }
 
-        // Write back updated synaptic word to plastic region
-        *plastic_words++ = synapse_structure_get_final_synaptic_word(
-            final_state);
+    // Nothing is written back if nothing changed; otherwise the header is,
+    // with the span of synapses up to the last that changed
+    if (!header_changed && end_changed_words == first_plastic_word) {
+        return 0;
+    }
+    uint32_t n_changed_bytes =
+        (end_changed_words - first_plastic_word) * sizeof(plastic_synapse_t);
+    return plastic_header_words + ((n_changed_bytes + 3) >> 2);
+}
+
+bool synapse_dynamics_process_plastic_synapses(
+        address_t plastic_region_address, address_t fixed_region_address,
+        weight_t *ring_buffers, uint32_t time, address_t sdram_row_address,
+        size_t *n_write_back_words) {
+    num_plastic_pre_synaptic_events +=
+        synapse_row_num_plastic_controls(fixed_region_address);
+
+    // If the update can wait, note the spike in the row header, which is
+    // then all that needs writing back; the weights delivered are those that
+    // the updates of the spikes deferred so far give, unless asked to be the
+    // weights stored
+    uint32_t n_deferred = 0;
+    if (max_deferred_pre_spikes > 0) {
+        deferred_pre_spikes_t *deferred = _plastic_deferred_pre_spikes(
+            plastic_region_address);
+        if (!_is_update_due(_plastic_event_history(plastic_region_address),
+                deferred, sdram_row_address)) {
+            log_debug("Deferring pre-synaptic event at time:%u", time);
+            if (!deferred->is_listed) {
+                rows_with_deferred_spikes[n_rows_with_deferred_spikes++] =
+                    sdram_row_address;
+                deferred->is_listed = 1;
+            }
+            deferred->times[deferred->n_spikes++] = time;
+            if (approximate_deferred_weights) {
+                _process_without_update(
+                    _plastic_synapses(plastic_region_address),
+                    synapse_row_plastic_controls(fixed_region_address),
+                    synapse_row_num_plastic_controls(fixed_region_address),
+                    ring_buffers, time);
+            } else {
+                for (uint32_t i = 0; i < deferred->n_spikes; i++) {
+                    pre_spike_times[i] = deferred->times[i];
+                }
+                _apply_pre_spikes(
+                    plastic_region_address, fixed_region_address,
+                    deferred->n_spikes, ring_buffers, false);
+            }
+            *n_write_back_words = plastic_header_words;
+            return true;
+        }
+
+        // Otherwise apply the deferred spikes before this one
+        n_deferred = deferred->n_spikes;
+        for (uint32_t i = 0; i < n_deferred; i++) {
+            pre_spike_times[i] = deferred->times[i];
+        }
     }
+    pre_spike_times[n_deferred] = time;
+
+    *n_write_back_words = _apply_pre_spikes(
+        plastic_region_address, fixed_region_address, n_deferred + 1,
+        ring_buffers, true);
     return true;
 }
 
+void synapse_dynamics_apply_deferred_updates(void) {
+
+    // The rows are updated where they are in SDRAM
+    for (uint32_t r = 0; r < n_rows_with_deferred_spikes; r++) {
+        address_t row = rows_with_deferred_spikes[r];
+        address_t plastic_region_address = synapse_row_plastic_region(row);
+        deferred_pre_spikes_t *deferred = _plastic_deferred_pre_spikes(
+            plastic_region_address);
+        uint32_t n_deferred = deferred->n_spikes;
+        if (n_deferred > 0) {
+            log_debug("Applying %u deferred pre-synaptic events to row 0x%08x",
+                n_deferred, row);
+            for (uint32_t i = 0; i < n_deferred; i++) {
+                pre_spike_times[i] = deferred->times[i];
+            }
+            _apply_pre_spikes(plastic_region_address,
+                synapse_row_fixed_region(row), n_deferred, NULL, true);
+        }
+        deferred->is_listed = 0;
+    }
+    n_rows_with_deferred_spikes = 0;
+}
+
 void synapse_dynamics_process_post_synaptic_event(
         uint32_t time, index_t neuron_index) {
     log_debug("Adding post-synaptic event to trace at time:%u", time);
 
+    // Note the spike for the rows with deferred updates
+    bucket_last_post_time[_post_bucket(neuron_index)] = time;
+
     // Add post-event
     post_event_history_t *history = &post_event_history[neuron_index];
-    const uint32_t last_post_time = history->times[history->count_minus_one];
-    const post_trace_t last_post_trace =
-        history->traces[history->count_minus_one];
+    const uint32_t last_post_time = post_events_last_time(history);
+    const post_trace_t last_post_trace = post_events_last_trace(history);
     post_events_add(time, history, timing_add_post_spike(time, last_post_time,
                                                          last_post_trace));
 }
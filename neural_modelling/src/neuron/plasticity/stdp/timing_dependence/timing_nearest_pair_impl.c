@@ -21,8 +21,8 @@
 // Globals
 //---------------------------------------
 // Exponential lookup-tables
-int16_t tau_plus_lookup[TAU_PLUS_SIZE];
-int16_t tau_minus_lookup[TAU_MINUS_SIZE];
+decay_lut_t tau_plus_lookup;
+decay_lut_t tau_minus_lookup;
 
 //---------------------------------------
 // Functions
@@ -33,11 +33,20 @@ address_t timing_initialise(address_t address) {
     log_info("\tSTDP nearest-pair rule");
     // **TODO** assert number of neurons is less than max
 
-    // Copy LUTs from following memory
-    address_t lut_address = maths_copy_int16_lut(&address[0], TAU_PLUS_SIZE,
-                                                 &tau_plus_lookup[0]);
-    lut_address = maths_copy_int16_lut(lut_address, TAU_MINUS_SIZE,
-                                       &tau_minus_lookup[0]);
+    // Copy LUTs from following memory; the tau minus LUT can share the
+    // entries of the tau plus LUT
+    address_t lut_address = maths_read_decay_lut(
+        &address[0], &tau_plus_lookup, NULL);
+    if (lut_address == NULL) {
+        log_error("Unable to allocate STDP lookup tables");
+        return NULL;
+    }
+    lut_address = maths_read_decay_lut(
+        lut_address, &tau_minus_lookup, &tau_plus_lookup);
+    if (lut_address == NULL) {
+        log_error("Unable to allocate STDP lookup tables");
+        return NULL;
+    }
 
     log_info("timing_initialise: completed successfully");
 
@@ -40,26 +40,18 @@ typedef struct pre_trace_t {
 //---------------------------------------
 // Macros
 //---------------------------------------
-// Exponential decay lookup parameters
-#define TAU_PLUS_TIME_SHIFT 0
-#define TAU_PLUS_SIZE 256
-
-#define TAU_MINUS_TIME_SHIFT 0
-#define TAU_MINUS_SIZE 256
-
-// Helper macros for looking up decays
+// Helper macros for looking up decays, from tables whose size and time
+// shift are set by the host
 #define DECAY_LOOKUP_TAU_PLUS(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_PLUS_TIME_SHIFT, TAU_PLUS_SIZE, tau_plus_lookup)
+    maths_decay_lut_lookup(time, &tau_plus_lookup)
 #define DECAY_LOOKUP_TAU_MINUS(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_MINUS_TIME_SHIFT, TAU_MINUS_SIZE, tau_minus_lookup)
+    maths_decay_lut_lookup(time, &tau_minus_lookup)
 
 //---------------------------------------
 // Externals
 //---------------------------------------
-extern int16_t tau_plus_lookup[TAU_PLUS_SIZE];
-extern int16_t tau_minus_lookup[TAU_MINUS_SIZE];
+extern decay_lut_t tau_plus_lookup;
+extern decay_lut_t tau_minus_lookup;
 
 //---------------------------------------
 // Timing dependence inline functions
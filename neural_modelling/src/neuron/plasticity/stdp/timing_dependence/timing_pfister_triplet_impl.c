@@ -21,10 +21,10 @@
 // Globals
 //---------------------------------------
 // Exponential lookup-tables
-int16_t tau_plus_lookup[TAU_PLUS_SIZE];
-int16_t tau_minus_lookup[TAU_MINUS_SIZE];
-int16_t tau_x_lookup[TAU_X_SIZE];
-int16_t tau_y_lookup[TAU_Y_SIZE];
+decay_lut_t tau_plus_lookup;
+decay_lut_t tau_minus_lookup;
+decay_lut_t tau_x_lookup;
+decay_lut_t tau_y_lookup;
 
 //---------------------------------------
 // Functions
@@ -35,15 +35,25 @@ address_t timing_initialise(address_t address) {
     log_info("\tSTDP triplet rule");
     // **TODO** assert number of neurons is less than max
 
-    // Copy LUTs from following memory
-    address_t lut_address = maths_copy_int16_lut(&address[0], TAU_PLUS_SIZE,
-                                                 &tau_plus_lookup[0]);
-    lut_address = maths_copy_int16_lut(lut_address, TAU_MINUS_SIZE,
-                                       &tau_minus_lookup[0]);
-    lut_address = maths_copy_int16_lut(lut_address, TAU_X_SIZE,
-                                       &tau_x_lookup[0]);
-    lut_address = maths_copy_int16_lut(lut_address, TAU_Y_SIZE,
-                                       &tau_y_lookup[0]);
+    // Copy LUTs from following memory; the tau minus and tau y LUTs can
+    // share the entries of the tau plus and tau x LUTs respectively
+    address_t lut_address = maths_read_decay_lut(
+        &address[0], &tau_plus_lookup, NULL);
+    if (lut_address != NULL) {
+        lut_address = maths_read_decay_lut(
+            lut_address, &tau_minus_lookup, &tau_plus_lookup);
+    }
+    if (lut_address != NULL) {
+        lut_address = maths_read_decay_lut(lut_address, &tau_x_lookup, NULL);
+    }
+    if (lut_address != NULL) {
+        lut_address = maths_read_decay_lut(
+            lut_address, &tau_y_lookup, &tau_x_lookup);
+    }
+    if (lut_address == NULL) {
+        log_error("Unable to allocate STDP lookup tables");
+        return NULL;
+    }
 
     log_info("timing_initialise: completed successfully");
 
@@ -45,41 +45,24 @@ typedef struct pre_trace_t {
 //---------------------------------------
 // Macros
 //---------------------------------------
-// Exponential decay lookup parameters
-#define TAU_PLUS_TIME_SHIFT 0
-#define TAU_PLUS_SIZE 256
-
-#define TAU_MINUS_TIME_SHIFT 0
-#define TAU_MINUS_SIZE 256
-
-#define TAU_X_TIME_SHIFT 2
-#define TAU_X_SIZE 256
-
-#define TAU_Y_TIME_SHIFT 2
-#define TAU_Y_SIZE 256
-
-// Helper macros for looking up decays
+// Helper macros for looking up decays, from tables whose size and time
+// shift are set by the host
 #define DECAY_LOOKUP_TAU_PLUS(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_PLUS_TIME_SHIFT, TAU_PLUS_SIZE, tau_plus_lookup)
+    maths_decay_lut_lookup(time, &tau_plus_lookup)
 #define DECAY_LOOKUP_TAU_MINUS(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_MINUS_TIME_SHIFT, TAU_MINUS_SIZE, tau_minus_lookup)
-
+    maths_decay_lut_lookup(time, &tau_minus_lookup)
 #define DECAY_LOOKUP_TAU_X(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_X_TIME_SHIFT, TAU_X_SIZE, tau_x_lookup)
+    maths_decay_lut_lookup(time, &tau_x_lookup)
 #define DECAY_LOOKUP_TAU_Y(time) \
-    maths_lut_exponential_decay( \
-        time, TAU_Y_TIME_SHIFT, TAU_Y_SIZE, tau_y_lookup)
+    maths_decay_lut_lookup(time, &tau_y_lookup)
 
 //---------------------------------------
 // Externals
 //---------------------------------------
-extern int16_t tau_plus_lookup[TAU_PLUS_SIZE];
-extern int16_t tau_minus_lookup[TAU_MINUS_SIZE];
-extern int16_t tau_x_lookup[TAU_X_SIZE];
-extern int16_t tau_y_lookup[TAU_Y_SIZE];
+extern decay_lut_t tau_plus_lookup;
+extern decay_lut_t tau_minus_lookup;
+extern decay_lut_t tau_x_lookup;
+extern decay_lut_t tau_y_lookup;
 
 //---------------------------------------
 // Timing dependence inline functions
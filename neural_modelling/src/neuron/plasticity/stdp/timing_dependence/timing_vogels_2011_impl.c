@@ -21,7 +21,7 @@
 // Globals
 //---------------------------------------
 // Exponential lookup-tables
-int16_t tau_lookup[TAU_SIZE];
+decay_lut_t tau_lookup;
 
 // Global plasticity parameter data
 plasticity_trace_region_data_t plasticity_trace_region_data;
@@ -38,7 +38,12 @@ uint32_t *timing_initialise(uint32_t* address)
     plasticity_trace_region_data.alpha = (int32_t)address[0];
 
     // Copy LUTs from following memory
-    address_t lut_address = maths_copy_int16_lut(&address[1], TAU_SIZE, &tau_lookup[0]);
+    address_t lut_address = maths_read_decay_lut(
+        &address[1], &tau_lookup, NULL);
+    if (lut_address == NULL) {
+        log_error("Unable to allocate STDP lookup tables");
+        return NULL;
+    }
 
     log_info("timing_initialise: completed successfully");
 
@@ -38,13 +38,10 @@ typedef int16_t pre_trace_t;
 //---------------------------------------
 // Macros
 //---------------------------------------
-// Exponential decay lookup parameters
-#define TAU_TIME_SHIFT 0
-#define TAU_SIZE 256
-
-// Helper macros for looking up decays
+// Helper macros for looking up decays, from tables whose size and time
+// shift are set by the host
 #define DECAY_LOOKUP_TAU(time) \
-    maths_lut_exponential_decay(time, TAU_TIME_SHIFT, TAU_SIZE, tau_lookup)
+    maths_decay_lut_lookup(time, &tau_lookup)
 
 //---------------------------------------
 // Structures
@@ -56,7 +53,7 @@ typedef struct {
 //---------------------------------------
 // Externals
 //---------------------------------------
-extern int16_t tau_lookup[TAU_SIZE];
+extern decay_lut_t tau_lookup;
 extern plasticity_trace_region_data_t plasticity_trace_region_data;
 
 //---------------------------------------
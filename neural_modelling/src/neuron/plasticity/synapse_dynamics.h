@@ -26,9 +26,21 @@ address_t synapse_dynamics_initialise(
     address_t address, uint32_t n_neurons, uint32_t n_synapse_types,
     uint32_t *ring_buffer_to_input_buffer_left_shifts);
 
+//! \brief Process the plastic synapses of a row for a pre-synaptic spike
+//! \param[in] sdram_row_address The address of the row in SDRAM, or NULL if
+//!                              the row is not read from SDRAM
+//! \param[out] n_write_back_words The number of words at the start of the
+//!                                plastic region that have changed, and so
+//!                                must be written back to SDRAM
+//! \return True if the synapses were processed
 bool synapse_dynamics_process_plastic_synapses(
     address_t plastic_region_address, address_t fixed_region_address,
-    weight_t *ring_buffers, uint32_t time);
+    weight_t *ring_buffers, uint32_t time, address_t sdram_row_address,
+    size_t *n_write_back_words);
+
+//! \brief Apply the updates of the rows in SDRAM that have been put off, so
+//!        that the synapses are up to date at the end of a run
+void synapse_dynamics_apply_deferred_updates(void);
 
 void synapse_dynamics_process_post_synaptic_event(
     uint32_t time, index_t neuron_index);
@@ -47,16 +47,23 @@ void synapse_dynamics_process_post_synaptic_event(
 
 //---------------------------------------
 bool synapse_dynamics_process_plastic_synapses(address_t plastic_region_address,
-        address_t fixed_region_address, weight_t *ring_buffer, uint32_t time) {
+        address_t fixed_region_address, weight_t *ring_buffer, uint32_t time,
+        address_t sdram_row_address, size_t *n_write_back_words) {
     use(plastic_region_address);
     use(fixed_region_address);
     use(ring_buffer);
     use(time);
+    use(sdram_row_address);
+    use(n_write_back_words);
 
     log_error("There should be no plastic synapses!");
     return false;
 }
 
+//---------------------------------------
+void synapse_dynamics_apply_deferred_updates(void) {
+}
+
 //---------------------------------------
 input_t synapse_dynamics_get_intrinsic_bias(uint32_t time,
                                             index_t neuron_index) {
@@ -49,4 +49,9 @@ bool population_table_get_first_address(
 bool population_table_get_next_address(
     address_t* row_address, size_t* n_bytes_to_transfer);
 
+//! \brief Get the number of spikes dropped because the connectivity bit field
+//!        showed that the source neuron has no synapses on this core
+//! \return The number of spikes dropped
+uint32_t population_table_get_filtered_packets(void);
+
 #endif // _POPULATION_TABLE_H_
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//! \file
+//! \brief The master population table data shared by the implementations
+//!        of population_table.h.
+//!
+//! The table region holds the number of entries and the number of addresses,
+//! followed by the entries (sorted by key), the addresses, and then a
+//! connectivity bit field for each entry in the same order.  Each bit field
+//! is a word count followed by that many words, with a bit set for each
+//! source neuron that has a synapse on this core; a count of 0 means that
+//! the entry is not filtered.  An
+//! implementation differs only in how it finds the entry for a spike; it
+//! then calls _population_table_start_entry() and the rows are read with
+//! _population_table_next_address().  This must only be included by the
+//! population table implementation.
+
+#ifndef _POPULATION_TABLE_COMMON_H_
+#define _POPULATION_TABLE_COMMON_H_
+
+#include "population_table.h"
+#include <neuron/synapse_row.h>
+#include <debug.h>
+#include <bit_field.h>
+
+typedef struct master_population_table_entry {
+    uint32_t key;
+    uint32_t mask;
+    uint16_t start;
+    uint16_t count;
+} master_population_table_entry;
+
+typedef uint32_t address_and_row_length;
+
+static master_population_table_entry *master_population_table;
+static uint32_t master_population_table_length;
+static address_and_row_length *address_list;
+static address_t synaptic_rows_base_address;
+static address_t direct_rows_base_address;
+
+//! The connectivity bit field of each entry, as copied from the table (the
+//! word count followed by the bits), or NULL if the entry is not filtered
+static bit_field_t *connectivity_bit_field;
+
+//! The number of spikes dropped by the connectivity bit fields
+static uint32_t bit_field_filtered_packets = 0;
+
+static uint32_t last_neuron_id = 0;
+static uint16_t next_item = 0;
+static uint16_t items_to_go = 0;
+
+static inline uint32_t _get_direct_address(address_and_row_length entry) {
+
+    // Direct row address is just the direct address bit
+    return (entry & 0x7FFFFF00) >> 8;
+}
+
+static inline uint32_t _get_address(address_and_row_length entry) {
+
+    // The address is in words and is the top 23-bits but 1, so this down
+    // shifts by 8 and then multiplies by 16 (= up shifts by 4) = down shift by 4
+    // with the given mask 0x7FFFFF00 to fully remove the row length
+    // NOTE: The mask can be removed given the machine spec says it
+    // hard-codes the bottom 2 bits to zero anyhow. BUT BAD CODE PRACTICE
+    return (entry & 0x7FFFFF00) >> 4;
+}
+
+static inline uint32_t _get_row_length(address_and_row_length entry) {
+    return entry & 0xFF;
+}
+
+static inline uint32_t _is_single(address_and_row_length entry) {
+    return entry & 0x80000000;
+}
+
+static inline uint32_t _get_neuron_id(
+        master_population_table_entry entry, spike_t spike) {
+    return spike & ~entry.mask;
+}
+
+//! \brief Determine if a source neuron has any synapses in an entry
+//! \param[in] bit_field The connectivity bit field of the entry
+//! \param[in] neuron_id The index of the source neuron in the entry
+//! \return True if there are synapses (or the bit field doesn't say)
+static inline bool _has_synapses(bit_field_t bit_field, uint32_t neuron_id) {
+    if (bit_field == NULL) {
+        return true;
+    }
+    return (neuron_id < (bit_field[0] << 5))
+        && bit_field_test(&bit_field[1], neuron_id);
+}
+
+//! \brief Copies the connectivity bit fields of the entries to DTCM
+//! \param[in] bit_field_address The address of the first bit field
+//! \return True if the bit fields were read successfully, False otherwise
+static inline bool _copy_connectivity_bit_fields(address_t bit_field_address) {
+    if (master_population_table_length == 0) {
+        return true;
+    }
+    connectivity_bit_field = (bit_field_t *) spin1_malloc(
+        master_population_table_length * sizeof(bit_field_t));
+    if (connectivity_bit_field == NULL) {
+        log_error("Could not allocate connectivity bit fields");
+        return false;
+    }
+
+    uint32_t n_filtered = 0;
+    for (uint32_t i = 0; i < master_population_table_length; i++) {
+        uint32_t n_words = bit_field_address[0];
+        connectivity_bit_field[i] = NULL;
+        if (n_words > 0) {
+
+            // Without the DTCM for a bit field, every spike is looked up
+            uint32_t n_bytes = (n_words + 1) * sizeof(uint32_t);
+            bit_field_t bit_field = (bit_field_t) spin1_malloc(n_bytes);
+            if (bit_field == NULL) {
+                log_warning(
+                    "Not enough DTCM for the bit field of entry %u", i);
+            } else {
+                spin1_memcpy(bit_field, bit_field_address, n_bytes);
+                connectivity_bit_field[i] = bit_field;
+                n_filtered += 1;
+            }
+        }
+        bit_field_address = &(bit_field_address[n_words + 1]);
+    }
+    log_info(
+        "%u of %u master population table entries are filtered",
+        n_filtered, master_population_table_length);
+    return true;
+}
+
+static inline void _print_master_population_table() {
+    log_info("master_population\n");
+    log_info("------------------------------------------\n");
+    for (uint32_t i = 0; i < master_population_table_length; i++) {
+        master_population_table_entry entry = master_population_table[i];
+        for (uint16_t j = entry.start; j < (entry.start + entry.count); j++) {
+            if (!_is_single(address_list[j])) {
+                log_info(
+                    "index (%d, %d), key: 0x%.8x, mask: 0x%.8x,"
+                    " offset: 0x%.8x, address: 0x%.8x, row_length: %u\n",
+                    i, j, entry.key, entry.mask,
+                    _get_address(address_list[j]),
+                    _get_address(address_list[j]) +
+                        (uint32_t) (uintptr_t) synaptic_rows_base_address,
+                    _get_row_length(address_list[j]));
+            } else {
+                log_info(
+                    "index (%d, %d), key: 0x%.8x, mask: 0x%.8x,"
+                    " offset: 0x%.8x, address: 0x%.8x, single",
+                    i, j, entry.key, entry.mask,
+                    _get_direct_address(address_list[j]),
+                    _get_direct_address(address_list[j]) +
+                        (uint32_t) (uintptr_t) direct_rows_base_address);
+            }
+        }
+    }
+    log_info("------------------------------------------\n");
+}
+
+//! \brief Copies the table from SDRAM to DTCM and stores the base addresses
+//! \param[in] table_address The address of the start of the table data
+//! \param[in] synapse_rows_address The address of the start of the synapse
+//!                                 data
+//! \param[in] direct_rows_address The address of the start of the direct
+//!                                synapse data
+//! \param[out] row_max_n_words Updated with the maximum length of any row in
+//!                             the table in words
+//! \return True if the table was copied successfully, False otherwise
+static inline bool _population_table_copy(
+        address_t table_address, address_t synapse_rows_address,
+        address_t direct_rows_address, uint32_t *row_max_n_words) {
+    master_population_table_length = table_address[0];
+    log_debug("master pop table length is %d\n", master_population_table_length);
+    log_debug(
+        "master pop table entry size is %d\n",
+        sizeof(master_population_table_entry));
+    uint32_t n_master_pop_bytes =
+        master_population_table_length * sizeof(master_population_table_entry);
+    uint32_t n_master_pop_words = n_master_pop_bytes >> 2;
+    log_debug("pop table size is %d\n", n_master_pop_bytes);
+
+    // only try to malloc if there's stuff to malloc.
+    if (n_master_pop_bytes != 0){
+        master_population_table = (master_population_table_entry *)
+            spin1_malloc(n_master_pop_bytes);
+        if (master_population_table == NULL) {
+            log_error("Could not allocate master population table");
+            return false;
+        }
+    }
+
+    uint32_t address_list_length = table_address[1];
+    uint32_t n_address_list_bytes =
+        address_list_length * sizeof(address_and_row_length);
+
+    // only try to malloc if there's stuff to malloc.
+    if (n_address_list_bytes != 0){
+        address_list = (address_and_row_length *)
+            spin1_malloc(n_address_list_bytes);
+        if (address_list == NULL) {
+            log_error("Could not allocate master population address list");
+            return false;
+        }
+    }
+
+    log_debug(
+        "pop table size: %u (%u bytes)", master_population_table_length,
+        n_master_pop_bytes);
+    log_debug(
+        "address list size: %u (%u bytes)", address_list_length,
+        n_address_list_bytes);
+
+    // Copy the master population table
+    spin1_memcpy(master_population_table, &(table_address[2]),
+            n_master_pop_bytes);
+    spin1_memcpy(
+        address_list, &(table_address[2 + n_master_pop_words]),
+        n_address_list_bytes);
+    if (!_copy_connectivity_bit_fields(
+            &(table_address[2 + n_master_pop_words + address_list_length]))) {
+        return false;
+    }
+
+    // Store the base address
+    log_info(
+        "the stored synaptic matrix base address is located at: 0x%08x",
+        synapse_rows_address);
+    log_info(
+        "the direct synaptic matrix base address is located at: 0x%08x",
+        direct_rows_address);
+    synaptic_rows_base_address = synapse_rows_address;
+    direct_rows_base_address = direct_rows_address;
+
+    *row_max_n_words = 0xFF + N_SYNAPSE_ROW_HEADER_WORDS;
+
+    _print_master_population_table();
+    return true;
+}
+
+//! \brief Gets the next row data for the entry last started
+//! \param[out] row_address Updated with the address of the row
+//! \param[out] n_bytes_to_transfer Updated with the number of bytes to read
+//! \return True if there is a row to read, False if not
+static inline bool _population_table_next_address(
+        address_t* row_address, size_t* n_bytes_to_transfer) {
+
+    // If there are no more items in the list, return false
+    if (items_to_go <= 0) {
+        return false;
+    }
+
+    bool is_valid = false;
+    do {
+        address_and_row_length item = address_list[next_item];
+
+        // If the row is a direct row, indicate this by specifying the
+        // n_bytes_to_transfer is 0
+        if (_is_single(item)) {
+            *row_address = (address_t) (
+                _get_direct_address(item) +
+                (uintptr_t) direct_rows_base_address +
+                (last_neuron_id * sizeof(uint32_t)));
+            *n_bytes_to_transfer = 0;
+            is_valid = true;
+        } else {
+
+            uint32_t row_length = _get_row_length(item);
+            if (row_length > 0) {
+
+                uintptr_t block_address =
+                    _get_address(item) + (uintptr_t) synaptic_rows_base_address;
+                uint32_t stride = (row_length + N_SYNAPSE_ROW_HEADER_WORDS);
+                uint32_t neuron_offset =
+                    last_neuron_id * stride * sizeof(uint32_t);
+
+                *row_address = (address_t) (block_address + neuron_offset);
+                *n_bytes_to_transfer = stride * sizeof(uint32_t);
+                log_debug(
+                    "neuron_id = %u, block_address = 0x%.8x,"
+                    "row_length = %u, row_address = 0x%.8x, n_bytes = %u",
+                    last_neuron_id, block_address, row_length, *row_address,
+                    *n_bytes_to_transfer);
+                is_valid = true;
+            }
+        }
+
+        next_item += 1;
+        items_to_go -= 1;
+    } while (!is_valid && (items_to_go > 0));
+
+    return is_valid;
+}
+
+//! \brief Starts reading the rows of an entry for a spike
+//! \param[in] entry_index The index of the entry that matches the spike
+//! \param[in] spike The spike received
+//! \param[out] row_address Updated with the address of the first row
+//! \param[out] n_bytes_to_transfer Updated with the number of bytes to read
+//! \return True if there is a row to read, False if not
+static inline bool _population_table_start_entry(
+        uint32_t entry_index, spike_t spike, address_t* row_address,
+        size_t* n_bytes_to_transfer) {
+    master_population_table_entry entry =
+        master_population_table[entry_index];
+    if (entry.count == 0) {
+        log_debug(
+            "spike %u (= %x): population found in master population"
+            "table but count is 0");
+    }
+
+    last_neuron_id = _get_neuron_id(entry, spike);
+
+    // Drop the spike before any DMA if the neuron has no synapses here
+    if (!_has_synapses(connectivity_bit_field[entry_index], last_neuron_id)) {
+        bit_field_filtered_packets += 1;
+        items_to_go = 0;
+        return false;
+    }
+    next_item = entry.start;
+    items_to_go = entry.count;
+
+    log_debug(
+        "spike = %08x, entry_index = %u, start = %u, count = %u",
+        spike, entry_index, next_item, items_to_go);
+
+    return _population_table_next_address(row_address, n_bytes_to_transfer);
+}
+
+#endif // _POPULATION_TABLE_COMMON_H_
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//! \file
+//! \brief Master population table looked up through a hash of the key.
+//!
+//! This reads the same table as the binary search implementation, but
+//! additionally builds an open addressed hash table of entry indices in
+//! DTCM at initialisation.  A spike is hashed on the bits that are in the
+//! mask of every entry, so that all spikes from one entry hash to the same
+//! slot, and the lookup then probes linearly from there.  With the table
+//! at most half full, a lookup costs a hash and usually a single compare,
+//! independent of the number of entries.
+
+#include "population_table_common.h"
+
+//! The value of an unused slot in the hash table
+#define EMPTY_SLOT 0xFFFF
+
+//! The minimum number of bits of hash to use
+#define MIN_HASH_BITS 2
+
+//! Multiplier for Fibonacci hashing (2^32 / golden ratio)
+#define HASH_MULTIPLIER 0x9E3779B1
+
+//! The hash table; each slot is an index into master_population_table
+static uint16_t *hash_table;
+
+//! The number of bits in the hash; the table has 1 << hash_bits slots
+static uint32_t hash_bits;
+
+//! hash_table size - 1, used to wrap the probe
+static uint32_t hash_slot_mask;
+
+//! The bits of the key which every entry matches on
+static uint32_t common_mask;
+
+static inline uint32_t _hash(uint32_t key) {
+    return ((key & common_mask) * HASH_MULTIPLIER) >> (32 - hash_bits);
+}
+
+static inline bool _build_hash_table(void) {
+
+    // Only the bits in the mask of every entry can be used to hash, as a
+    // spike doesn't say which entry it is for until it has been found
+    common_mask = 0xFFFFFFFF;
+    for (uint32_t i = 0; i < master_population_table_length; i++) {
+        common_mask &= master_population_table[i].mask;
+    }
+
+    // Keep the table at most half full so that probes stay short
+    hash_bits = MIN_HASH_BITS;
+    while ((1u << hash_bits) < (master_population_table_length << 1)) {
+        hash_bits += 1;
+    }
+    uint32_t n_slots = 1 << hash_bits;
+    hash_slot_mask = n_slots - 1;
+
+    hash_table = (uint16_t *) spin1_malloc(n_slots * sizeof(uint16_t));
+    if (hash_table == NULL) {
+        log_error("Could not allocate master population hash table");
+        return false;
+    }
+    for (uint32_t i = 0; i < n_slots; i++) {
+        hash_table[i] = EMPTY_SLOT;
+    }
+
+    uint32_t max_probe = 0;
+    for (uint32_t i = 0; i < master_population_table_length; i++) {
+        uint32_t slot = _hash(master_population_table[i].key);
+        uint32_t probe = 0;
+        while (hash_table[slot] != EMPTY_SLOT) {
+            slot = (slot + 1) & hash_slot_mask;
+            probe += 1;
+        }
+        hash_table[slot] = i;
+        if (probe > max_probe) {
+            max_probe = probe;
+        }
+    }
+
+    log_info(
+        "master population hash table: %u entries in %u slots,"
+        " common mask 0x%08x, longest probe %u",
+        master_population_table_length, n_slots, common_mask, max_probe);
+    return true;
+}
+
+bool population_table_initialise(
+        address_t table_address, address_t synapse_rows_address,
+        address_t direct_rows_address, uint32_t *row_max_n_words) {
+    log_debug("population_table_initialise: starting");
+
+    if (!_population_table_copy(
+            table_address, synapse_rows_address, direct_rows_address,
+            row_max_n_words)) {
+        return false;
+    }
+
+    // The entries are indexed by 16-bit values, with one reserved as empty
+    if (master_population_table_length >= EMPTY_SLOT) {
+        log_error(
+            "Too many master population table entries (%u) to hash",
+            master_population_table_length);
+        return false;
+    }
+    return _build_hash_table();
+}
+
+bool population_table_get_first_address(
+        spike_t spike, address_t* row_address, size_t* n_bytes_to_transfer) {
+    uint32_t slot = _hash(spike);
+    uint32_t index = hash_table[slot];
+    while (index != EMPTY_SLOT) {
+        master_population_table_entry entry = master_population_table[index];
+        if ((spike & entry.mask) == entry.key) {
+            return _population_table_start_entry(
+                index, spike, row_address, n_bytes_to_transfer);
+        }
+        slot = (slot + 1) & hash_slot_mask;
+        index = hash_table[slot];
+    }
+    log_debug(
+        "spike %u (= %x): population not found in master population table",
+        spike, spike);
+    return false;
+}
+
+bool population_table_get_next_address(
+        address_t* row_address, size_t* n_bytes_to_transfer) {
+    return _population_table_next_address(row_address, n_bytes_to_transfer);
+}
+
+uint32_t population_table_get_filtered_packets(void) {
+    return bit_field_filtered_packets;
+}
@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "procedural_synapses.h"
+#include "synapses.h"
+#include "synapse_row.h"
+#include <spin1_api.h>
+#include <debug.h>
+
+#include <synapse_expander/connection_generators/connection_generator_all_to_all.h>
+#include <synapse_expander/connection_generators/connection_generator_fixed_prob.h>
+#include <synapse_expander/param_generators/param_generator_constant.h>
+#include <synapse_expander/param_generators/param_generator_uniform.h>
+#include <synapse_expander/param_generators/param_generator_normal.h>
+#include <synapse_expander/param_generators/param_generator_normal_clipped.h>
+#include <synapse_expander/param_generators/param_generator_normal_clipped_to_boundary.h>
+#include <synapse_expander/param_generators/param_generator_exponential.h>
+
+//! The largest delay that can be given to a generated synapse
+#define MAX_PROCEDURAL_DELAY (1 << SYNAPSE_DELAY_BITS)
+
+//! A connection generator that can be used procedurally; the hash is the
+//! one agreed with Python for the synapse expander
+typedef struct connection_type_t {
+    uint32_t hash;
+    void *(*initialise)(address_t *region);
+    //! Restarts any random numbers; NULL if there are none
+    void (*restart)(void *data, uint32_t pre_neuron_index);
+    uint32_t (*generate)(
+        void *data, uint32_t pre_slice_start, uint32_t pre_slice_count,
+        uint32_t pre_neuron_index, uint32_t post_slice_start,
+        uint32_t post_slice_count, uint32_t max_row_length, uint16_t *indices);
+} connection_type_t;
+
+//! A parameter generator that can be used procedurally; the hash is the one
+//! agreed with Python for the synapse expander
+typedef struct param_type_t {
+    uint32_t hash;
+    void *(*initialise)(address_t *region);
+    //! Restarts any random numbers; NULL if there are none
+    void (*restart)(void *data, uint32_t pre_neuron_index);
+    void (*generate)(
+        void *data, uint32_t n_synapses, uint32_t pre_neuron_index,
+        uint16_t *indices, accum *values);
+} param_type_t;
+
+static const connection_type_t connection_types[] = {
+    {1, connection_generator_all_to_all_initialise, NULL,
+        connection_generator_all_to_all_generate},
+    {2, connection_generator_fixed_prob_initialise,
+        connection_generator_fixed_prob_restart,
+        connection_generator_fixed_prob_generate}
+};
+
+static const param_type_t param_types[] = {
+    {0, param_generator_constant_initialize, NULL,
+        param_generator_constant_generate},
+    {1, param_generator_uniform_initialize, param_generator_uniform_restart,
+        param_generator_uniform_generate},
+    {2, param_generator_normal_initialize, param_generator_normal_restart,
+        param_generator_normal_generate},
+    {3, param_generator_normal_clipped_initialize,
+        param_generator_normal_clipped_restart,
+        param_generator_normal_clipped_generate},
+    {4, param_generator_normal_clipped_boundary_initialize,
+        param_generator_normal_clipped_boundary_restart,
+        param_generator_normal_clipped_boundary_generate},
+    {5, param_generator_exponential_initialize,
+        param_generator_exponential_restart,
+        param_generator_exponential_generate}
+};
+
+#define N_CONNECTION_TYPES \
+    (sizeof(connection_types) / sizeof(connection_type_t))
+#define N_PARAM_TYPES (sizeof(param_types) / sizeof(param_type_t))
+
+//! The parameters of a procedural connector as read from SDRAM
+typedef struct procedural_connector_params_t {
+    uint32_t key;
+    uint32_t mask;
+    uint32_t pre_slice_start;
+    uint32_t pre_slice_count;
+    uint32_t max_row_n_synapses;
+    uint32_t synapse_type;
+    uint32_t weight_scale;
+    accum timestep_per_delay;
+    uint32_t connection_type_hash;
+    uint32_t weight_type_hash;
+    uint32_t delay_type_hash;
+} procedural_connector_params_t;
+
+//! A procedural connector and its generators
+typedef struct procedural_connector_t {
+    procedural_connector_params_t params;
+    const connection_type_t *connection_type;
+    void *connection_data;
+    const param_type_t *weight_type;
+    void *weight_data;
+    const param_type_t *delay_type;
+    void *delay_data;
+} procedural_connector_t;
+
+static procedural_connector_t *connectors;
+static uint32_t n_connectors = 0;
+
+static uint32_t post_slice_start;
+static uint32_t post_slice_count;
+static uint32_t synapse_index_bits;
+static uint32_t synapse_type_bits;
+
+// The row being generated, in the format of a row read from SDRAM, and the
+// post-synaptic indices and parameter values of its synapses
+static uint32_t *row;
+static uint16_t *indices;
+static accum *values;
+
+static uint32_t n_rows_generated = 0;
+
+/* PRIVATE FUNCTIONS */
+
+static const connection_type_t *_find_connection_type(uint32_t hash) {
+    for (uint32_t i = 0; i < N_CONNECTION_TYPES; i++) {
+        if (connection_types[i].hash == hash) {
+            return &connection_types[i];
+        }
+    }
+    log_error("Connection generator %u cannot be used procedurally", hash);
+    return NULL;
+}
+
+static const param_type_t *_find_param_type(uint32_t hash) {
+    for (uint32_t i = 0; i < N_PARAM_TYPES; i++) {
+        if (param_types[i].hash == hash) {
+            return &param_types[i];
+        }
+    }
+    log_error("Parameter generator %u cannot be used procedurally", hash);
+    return NULL;
+}
+
+static inline void _restart(
+        void (*restart)(void *data, uint32_t pre_neuron_index), void *data,
+        uint32_t pre_neuron_index) {
+    if (restart != NULL) {
+        restart(data, pre_neuron_index);
+    }
+}
+
+//! \brief Generate the row of a neuron in the row buffer
+static inline void _generate_row(
+        procedural_connector_t *connector, uint32_t pre_neuron_index) {
+    procedural_connector_params_t *params = &connector->params;
+    _restart(connector->connection_type->restart,
+        connector->connection_data, pre_neuron_index);
+    _restart(connector->delay_type->restart,
+        connector->delay_data, pre_neuron_index);
+    _restart(connector->weight_type->restart,
+        connector->weight_data, pre_neuron_index);
+
+    uint32_t n_synapses = connector->connection_type->generate(
+        connector->connection_data, params->pre_slice_start,
+        params->pre_slice_count, pre_neuron_index, post_slice_start,
+        post_slice_count, params->max_row_n_synapses, indices);
+
+    // The index and type of each synapse, then the delay
+    uint32_t *words = &row[N_SYNAPSE_ROW_HEADER_WORDS];
+    uint32_t type = params->synapse_type << synapse_index_bits;
+    uint32_t delay_shift = synapse_index_bits + synapse_type_bits;
+    connector->delay_type->generate(
+        connector->delay_data, n_synapses, pre_neuron_index, indices, values);
+    for (uint32_t i = 0; i < n_synapses; i++) {
+        accum delay = values[i] * params->timestep_per_delay;
+        uint32_t delay_steps = (delay < 1) ? 1 : (uint32_t) delay;
+        if (delay_steps > MAX_PROCEDURAL_DELAY) {
+            delay_steps = MAX_PROCEDURAL_DELAY;
+        }
+        words[i] = indices[i] | type |
+            ((delay_steps & SYNAPSE_DELAY_MASK) << delay_shift);
+    }
+
+    // The weight, in the top bits
+    connector->weight_type->generate(
+        connector->weight_data, n_synapses, pre_neuron_index, indices,
+        values);
+    for (uint32_t i = 0; i < n_synapses; i++) {
+        accum weight = values[i];
+        if (weight < 0) {
+            weight = -weight;
+        }
+        weight_t scaled = (weight_t) (weight * params->weight_scale);
+        words[i] |= ((uint32_t) scaled) << (32 - SYNAPSE_WEIGHT_BITS);
+    }
+
+    row[1] = n_synapses;
+}
+
+/* INTERFACE FUNCTIONS */
+
+bool procedural_synapses_initialise(address_t address) {
+    n_connectors = 0;
+    if (address == NULL) {
+        return true;
+    }
+
+    post_slice_start = *address++;
+    post_slice_count = *address++;
+    synapse_type_bits = *address++;
+    synapse_index_bits = *address++;
+    uint32_t n_procedural_connectors = *address++;
+    if (n_procedural_connectors == 0) {
+        return true;
+    }
+
+    connectors = (procedural_connector_t *) spin1_malloc(
+        n_procedural_connectors * sizeof(procedural_connector_t));
+    if (connectors == NULL) {
+        log_error("Could not allocate %u procedural connectors",
+            n_procedural_connectors);
+        return false;
+    }
+
+    uint32_t max_row_n_synapses = 0;
+    for (uint32_t i = 0; i < n_procedural_connectors; i++) {
+        procedural_connector_t *connector = &connectors[i];
+        procedural_connector_params_t *params = &connector->params;
+        spin1_memcpy(params, address, sizeof(procedural_connector_params_t));
+        address += sizeof(procedural_connector_params_t) >> 2;
+
+        connector->connection_type =
+            _find_connection_type(params->connection_type_hash);
+        connector->weight_type = _find_param_type(params->weight_type_hash);
+        connector->delay_type = _find_param_type(params->delay_type_hash);
+        if (connector->connection_type == NULL ||
+                connector->weight_type == NULL ||
+                connector->delay_type == NULL) {
+            return false;
+        }
+
+        // The parameters of each generator follow, in the same order
+        connector->connection_data =
+            connector->connection_type->initialise(&address);
+        connector->weight_data = connector->weight_type->initialise(&address);
+        connector->delay_data = connector->delay_type->initialise(&address);
+
+        if (params->max_row_n_synapses > max_row_n_synapses) {
+            max_row_n_synapses = params->max_row_n_synapses;
+        }
+        log_debug("Procedural connector %u: key 0x%08x mask 0x%08x, "
+            "%u pre-neurons from %u, up to %u synapses per row", i,
+            params->key, params->mask, params->pre_slice_count,
+            params->pre_slice_start, params->max_row_n_synapses);
+    }
+
+    // Only the fixed synapses of the row are ever generated
+    row = (uint32_t *) spin1_malloc(
+        (N_SYNAPSE_ROW_HEADER_WORDS + max_row_n_synapses) * sizeof(uint32_t));
+    indices = (uint16_t *) spin1_malloc(
+        max_row_n_synapses * sizeof(uint16_t));
+    values = (accum *) spin1_malloc(max_row_n_synapses * sizeof(accum));
+    if (row == NULL || indices == NULL || values == NULL) {
+        log_error("Could not allocate procedural rows of %u synapses",
+            max_row_n_synapses);
+        return false;
+    }
+    row[0] = 0;
+    row[1] = 0;
+    row[2] = 0;
+
+    n_connectors = n_procedural_connectors;
+    log_info("%u procedural connectors, rows of up to %u synapses",
+        n_connectors, max_row_n_synapses);
+    return true;
+}
+
+bool procedural_synapses_process_spike(uint32_t time, spike_t spike) {
+    bool found = false;
+    for (uint32_t i = 0; i < n_connectors; i++) {
+        procedural_connector_t *connector = &connectors[i];
+        if ((spike & connector->params.mask) != connector->params.key) {
+            continue;
+        }
+        found = true;
+
+        uint32_t neuron_id = spike & ~connector->params.mask;
+        _generate_row(connector, connector->params.pre_slice_start + neuron_id);
+        n_rows_generated++;
+
+        // There is no plastic region, so nothing is ever written back
+        synapses_process_synaptic_row(time, row, NULL, false, 0);
+    }
+    return found;
+}
+
+uint32_t procedural_synapses_get_n_rows_generated(void) {
+    return n_rows_generated;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Synapses whose rows are generated when a spike arrives, instead of
+ *         being stored in SDRAM and read by DMA
+ *
+ *  A procedural connector is described by the parameters of the connection,
+ *  weight and delay generators of the synapse expander.  The random number
+ *  generators of these are restarted at a stream given by the index of the
+ *  pre-synaptic neuron before each row is generated, so a neuron always
+ *  gets the same row.
+ */
+
+#ifndef _PROCEDURAL_SYNAPSES_H_
+#define _PROCEDURAL_SYNAPSES_H_
+
+#include <common/neuron-typedefs.h>
+
+//! \brief Read the procedural connectors
+//! \param[in] address The address of the procedural synapses region, or NULL
+//!                    if there are no procedural connectors
+//! \return True if the connectors were read successfully
+bool procedural_synapses_initialise(address_t address);
+
+//! \brief Generate and process the rows of any procedural connectors that
+//!        a spike is from
+//! \param[in] time The current time step
+//! \param[in] spike The spike received
+//! \return True if the spike was from at least one procedural connector
+bool procedural_synapses_process_spike(uint32_t time, spike_t spike);
+
+//! \brief Get the number of rows generated for spikes
+//! \return The number of rows generated
+uint32_t procedural_synapses_get_n_rows_generated(void);
+
+#endif // _PROCEDURAL_SYNAPSES_H_
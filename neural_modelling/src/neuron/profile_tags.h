@@ -21,3 +21,4 @@
 #define PROFILER_INCOMING_SPIKE           2
 #define PROFILER_PROCESS_FIXED_SYNAPSES   3
 #define PROFILER_PROCESS_PLASTIC_SYNAPSES 4
+#define PROFILER_POP_TABLE_LOOKUP         5
@@ -28,5 +28,7 @@ typedef enum regions_e {
     PROVENANCE_DATA_REGION,   // 7
     PROFILER_REGION,          // 8
     CONNECTOR_BUILDER_REGION, // 9
-    DIRECT_MATRIX_REGION      // 10
+    DIRECT_MATRIX_REGION,     // 10
+    PROCEDURAL_SYNAPSES_REGION, // 11
+    CONVOLUTION_SYNAPSES_REGION // 12
 } regions_e;
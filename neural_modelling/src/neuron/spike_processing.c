@@ -19,12 +19,30 @@
 #include "population_table/population_table.h"
 #include "synapse_row.h"
 #include "synapses.h"
+#include "procedural_synapses.h"
+#include "convolution_synapses.h"
 #include "structural_plasticity/synaptogenesis_dynamics.h"
 #include <simulation.h>
 #include <debug.h>
+#include <profiler.h>
 
-// The number of DMA Buffers to use
-#define N_DMA_BUFFERS 2
+// declare spin1_wfi
+void spin1_wfi();
+
+//! if using profiler import profiler tags
+#ifdef PROFILER_ENABLED
+    #include "profile_tags.h"
+#endif
+
+// The smallest number of DMA buffers that allows a plastic region to be
+// written back while the next row is read
+#define MIN_DMA_BUFFERS 2
+
+// The largest number of DMA buffers; each can have a read and a write back
+// queued, and this leaves space in the spin1 DMA queue (of 16 transfers) for
+// those of rewiring and recording.  This must match _MAX_DMA_BUFFERS in
+// synaptic_manager.py
+#define MAX_DMA_BUFFERS 6
 
 // DMA tags
 #define DMA_TAG_READ_SYNAPTIC_ROW 0
@@ -36,13 +54,28 @@ extern uint32_t time;
 static bool dma_busy;
 
 // The DTCM buffers for the synapse rows
-static dma_buffer dma_buffers[N_DMA_BUFFERS];
+static dma_buffer *dma_buffers;
+
+// The number of DTCM buffers, and so the number of synaptic rows that can be
+// being read or waiting to be processed at once
+static uint32_t n_dma_buffers;
 
 // The index of the next buffer to be filled by a DMA
 static uint32_t next_buffer_to_fill;
 
-// The index of the buffer currently being filled by a DMA read
-static uint32_t buffer_being_read;
+// The index of the next buffer to be processed; reads complete in the order
+// they were started, so this is the oldest buffer in use
+static uint32_t next_buffer_to_process;
+
+// The number of buffers being filled by a DMA read or waiting to be processed
+static uint32_t n_buffers_in_use;
+
+// A row read that is held back until an earlier read of the same row has
+// been processed (and so any plastic region of the row written back)
+static bool read_pending = false;
+static address_t pending_row_address;
+static size_t pending_n_bytes_to_transfer;
+static spike_t pending_spike;
 
 static uint32_t max_n_words;
 
@@ -50,80 +83,169 @@ static spike_t spike=-1;
 
 static uint32_t single_fixed_synapse[4];
 
+// The load since it was last read
+static spike_processing_load_t load;
+
+// The number of plastic region write-backs started and not yet complete
+static uint32_t n_write_backs_in_progress = 0;
+
+// The number of plastic region write-backs skipped as nothing changed, and
+// shortened as only the start of the region changed
+static uint32_t n_plastic_write_backs_skipped = 0;
+static uint32_t n_plastic_write_backs_shortened = 0;
+
+// True if the core is idle waiting for a row being read
+static bool dma_waiting = false;
+
+// The timer 1 count and tick when the wait for a DMA started
+static uint32_t dma_wait_start;
+static uint32_t dma_wait_start_ticks;
+
+// Spin1 API ticks, to count the timer reloads during a wait
+extern uint ticks;
+
 uint32_t number_of_rewires=0;
 bool any_spike = false;
 
 /* PRIVATE FUNCTIONS - static for inlining */
 
-static inline void _do_dma_read(
-        address_t row_address, size_t n_bytes_to_transfer) {
+static inline uint32_t _next_buffer_index(uint32_t index) {
+    index += 1;
+    if (index == n_dma_buffers) {
+        index = 0;
+    }
+    return index;
+}
+
+// Check if a row is in one of the buffers in use
+static inline bool _is_row_in_use(address_t row_address) {
+    uint32_t index = next_buffer_to_process;
+    for (uint32_t i = 0; i < n_buffers_in_use; i++) {
+        if (dma_buffers[index].sdram_writeback_address == row_address) {
+            return true;
+        }
+        index = _next_buffer_index(index);
+    }
+    return false;
+}
+
+// Start timing a wait for a DMA to complete, unless already waiting; this
+// is called as the spike processing finishes with rows still being read
+static inline void _start_dma_wait() {
+    if (!dma_waiting) {
+        dma_waiting = true;
+        dma_wait_start = tc[T1_COUNT];
+        dma_wait_start_ticks = ticks;
+    }
+}
+
+// Add the time waited for a DMA to the load; timer 1 counts down, and is
+// reloaded at each timer tick during the wait
+static inline void _end_dma_wait() {
+    if (dma_waiting) {
+        dma_waiting = false;
+        load.dma_wait_cycles += dma_wait_start - tc[T1_COUNT]
+            + ((ticks - dma_wait_start_ticks) * tc[T1_LOAD]);
+    }
+}
+
+// Hold back a row read until _setup_synaptic_dma_read is next called
+static inline void _hold_dma_read(
+        address_t row_address, size_t n_bytes_to_transfer,
+        spike_t originating_spike) {
+    read_pending = true;
+    pending_row_address = row_address;
+    pending_n_bytes_to_transfer = n_bytes_to_transfer;
+    pending_spike = originating_spike;
+}
+
+// Start reading a row; returns false if the DMA queue is full, in which case
+// the read is held back to be tried again
+static inline bool _do_dma_read(
+        address_t row_address, size_t n_bytes_to_transfer,
+        spike_t originating_spike) {
+
+    // Start a DMA transfer to fetch this synaptic row into current
+    // buffer; any write back from the buffer's last row is queued ahead of
+    // this, so will complete before the buffer is overwritten
+    dma_buffer *next_buffer = &dma_buffers[next_buffer_to_fill];
+    if (!spin1_dma_transfer(
+            DMA_TAG_READ_SYNAPTIC_ROW, row_address, next_buffer->row,
+            DMA_READ, n_bytes_to_transfer)) {
+        log_debug("DMA queue full; holding read of 0x%.8x", row_address);
+        _hold_dma_read(row_address, n_bytes_to_transfer, originating_spike);
+
+        // With no reads to complete, nothing else would try again
+        if (n_buffers_in_use == 0) {
+            spin1_trigger_user_event(0, 0);
+        }
+        return false;
+    }
 
     // Write the SDRAM address of the plastic region and the
     // Key of the originating spike to the beginning of DMA buffer
-    dma_buffer *next_buffer = &dma_buffers[next_buffer_to_fill];
     next_buffer->sdram_writeback_address = row_address;
-    next_buffer->originating_spike = spike;
+    next_buffer->originating_spike = originating_spike;
     next_buffer->n_bytes_transferred = n_bytes_to_transfer;
-
-    // Start a DMA transfer to fetch this synaptic row into current
-    // buffer
-    buffer_being_read = next_buffer_to_fill;
-    spin1_dma_transfer(
-        DMA_TAG_READ_SYNAPTIC_ROW, row_address, next_buffer->row, DMA_READ,
-        n_bytes_to_transfer);
-    next_buffer_to_fill = (next_buffer_to_fill + 1) % N_DMA_BUFFERS;
+    n_buffers_in_use++;
+    load.n_rows_fetched++;
+    next_buffer_to_fill = _next_buffer_index(next_buffer_to_fill);
+    return true;
 }
 
 
 static inline void _do_direct_row(address_t row_address) {
     single_fixed_synapse[3] = (uint32_t) row_address[0];
-    synapses_process_synaptic_row(time, single_fixed_synapse, false, 0);
+    synapses_process_synaptic_row(time, single_fixed_synapse, NULL, false, 0);
 }
 
 // Check if there is anything to do - if not, DMA is not busy
 static inline bool _is_something_to_do(
         address_t *row_address, size_t *n_bytes_to_transfer) {
 
-    // Disable interrupts here as check and dma_busy modification is a
-    // critical section
-    uint cpsr = spin1_int_disable();
-    bool something_to_do = false;
-
     // Synaptic rewiring needs to be done?
     if (number_of_rewires) {
-        something_to_do = true;
+        return true;
+    }
 
     // Is there another address in the population table?
-    // Note, this is fairly quick to check, so leave interrupts disabled
-    } else if (population_table_get_next_address(
-            row_address, n_bytes_to_transfer)) {
-        something_to_do = true;
-    } else {
-
-        // Are there any more spikes to process?
-        while (!something_to_do && in_spikes_get_next_spike(&spike)) {
+    if (population_table_get_next_address(row_address, n_bytes_to_transfer)) {
+        return true;
+    }
 
-            // Enable interrupts while looking up in the master pop table,
-            // as this can be slow
-            spin1_mode_restore(cpsr);
-            if (population_table_get_first_address(
-                    spike, row_address, n_bytes_to_transfer)) {
-                something_to_do = true;
+    // Are there any more spikes to process?  Packet reception only adds to
+    // the input spikes, so they can be removed with interrupts enabled
+    while (true) {
+        while (in_spikes_get_next_spike(&spike)) {
+
+            // The rows of procedural connectors are generated here rather
+            // than read, and kernels need no rows at all, so only any other
+            // rows of the spike are looked up
+            procedural_synapses_process_spike(time, spike);
+            convolution_synapses_process_spike(time, spike);
+
+            profiler_write_entry_disable_fiq(
+                PROFILER_ENTER | PROFILER_POP_TABLE_LOOKUP);
+            bool found = population_table_get_first_address(
+                spike, row_address, n_bytes_to_transfer);
+            profiler_write_entry_disable_fiq(
+                PROFILER_EXIT | PROFILER_POP_TABLE_LOOKUP);
+            if (found) {
+                return true;
             }
-
-            // Disable interrupts before checking if there is another spike
-            cpsr = spin1_int_disable();
         }
-    }
 
-    // If nothing to do, the DMA is not busy
-    if (!something_to_do) {
-        dma_busy = false;
+        // Nothing to do, so the DMA is not busy; this is a critical section
+        // as a spike received after the check would otherwise not restart
+        // the processing
+        uint cpsr = spin1_int_disable();
+        if (in_spikes_is_empty()) {
+            dma_busy = false;
+            spin1_mode_restore(cpsr);
+            return false;
+        }
+        spin1_mode_restore(cpsr);
     }
-
-    // Restore interrupts
-    spin1_mode_restore(cpsr);
-    return something_to_do;
 }
 
 void _setup_synaptic_dma_read() {
@@ -132,40 +254,96 @@ void _setup_synaptic_dma_read() {
     address_t row_address;
     size_t n_bytes_to_transfer;
 
-    bool setup_done = false;
-    while (!setup_done && _is_something_to_do(
+    // Start any read that was held back, unless the row is still in use
+    if (read_pending) {
+        if (_is_row_in_use(pending_row_address)) {
+            return;
+        }
+        read_pending = false;
+        if (!_do_dma_read(pending_row_address, pending_n_bytes_to_transfer,
+                pending_spike)) {
+            return;
+        }
+    }
+
+    // Keep reading rows until all the buffers are in use
+    while (n_buffers_in_use < n_dma_buffers && _is_something_to_do(
             &row_address, &n_bytes_to_transfer)) {
         if (number_of_rewires) {
+
+            // Rewiring changes rows in SDRAM, so wait until all the rows
+            // read have been processed; the last DMA to complete will
+            // call this again
+            if (n_buffers_in_use > 0) {
+                return;
+            }
             number_of_rewires--;
             synaptogenesis_dynamics_rewire(time);
-            setup_done = true;
+            return;
         } else if (n_bytes_to_transfer == 0) {
             _do_direct_row(row_address);
-        } else {
-            _do_dma_read(row_address, n_bytes_to_transfer);
-            setup_done = true;
+        } else if (_is_row_in_use(row_address)) {
+
+            // The row has been read already and not yet written back, so
+            // hold this read until it has been
+            _hold_dma_read(row_address, n_bytes_to_transfer, spike);
+            return;
+        } else if (!_do_dma_read(row_address, n_bytes_to_transfer, spike)) {
+            return;
         }
     }
 }
 
-static inline void _setup_synaptic_dma_write(uint32_t dma_buffer_index) {
+static inline void _setup_synaptic_dma_write(
+        uint32_t dma_buffer_index, size_t n_plastic_words) {
 
     // Get pointer to current buffer
     dma_buffer *buffer = &dma_buffers[dma_buffer_index];
 
-    // Get the number of plastic bytes and the write back address from the
-    // synaptic row
-    size_t n_plastic_region_bytes =
-        synapse_row_plastic_size(buffer->row) * sizeof(uint32_t);
+    // Nothing to write if nothing changed
+    if (n_plastic_words == 0) {
+        n_plastic_write_backs_skipped++;
+        return;
+    }
+
+    // Get the number of plastic bytes to write, which can be less than the
+    // whole plastic region if only the start of it has changed
+    if (n_plastic_words < synapse_row_plastic_size(buffer->row)) {
+        n_plastic_write_backs_shortened++;
+    }
+    size_t n_plastic_region_bytes = n_plastic_words * sizeof(uint32_t);
 
     log_debug("Writing back %u bytes of plastic region to %08x",
               n_plastic_region_bytes, buffer->sdram_writeback_address + 1);
 
-    // Start transfer
-    spin1_dma_transfer(
-        DMA_TAG_WRITE_PLASTIC_REGION, buffer->sdram_writeback_address + 1,
-        synapse_row_plastic_region(buffer->row),
-        DMA_WRITE, n_plastic_region_bytes);
+    // Start transfer; this must be queued before the buffer is read into
+    // again, and there is always space for it with at most MAX_DMA_BUFFERS,
+    // so a full queue is an error rather than something to wait for (the
+    // DMA that would free space cannot complete while this waits)
+    if (!spin1_dma_transfer(
+            DMA_TAG_WRITE_PLASTIC_REGION, buffer->sdram_writeback_address + 1,
+            synapse_row_plastic_region(buffer->row),
+            DMA_WRITE, n_plastic_region_bytes)) {
+        log_error("DMA queue full writing back 0x%.8x",
+            buffer->sdram_writeback_address);
+        rt_error(RTE_SWERR);
+    }
+    n_write_backs_in_progress++;
+}
+
+
+// Remove the spikes at the front of the input equal to spike, so that the
+// row read for it is processed for each; the spikes skipped still have the
+// rows of any procedural connectors they are from generated and any kernels
+// they are from added, as these are not in the row read.  Returns the number
+// of spikes removed.
+static inline uint32_t _skip_equal_spikes(spike_t spike) {
+    uint32_t n_spikes = in_spikes_skip_equal_spikes(spike);
+    for (uint32_t i = 0; i < n_spikes; i++) {
+        procedural_synapses_process_spike(time, spike);
+        convolution_synapses_process_spike(time, spike);
+    }
+    return n_spikes;
 }
 
 
@@ -175,10 +353,15 @@ static inline void _setup_synaptic_dma_write(uint32_t dma_buffer_index) {
 void _multicast_packet_received_callback(uint key, uint payload) {
     use(payload);
     any_spike = true;
+    load.n_spikes_received++;
     log_debug("Received spike %x at %d, DMA Busy = %d", key, time, dma_busy);
 
     // If there was space to add spike to incoming spike queue
     if (in_spikes_add_spike(key)) {
+        uint32_t queue_depth = in_spikes_size();
+        if (queue_depth > load.max_input_queue_depth) {
+            load.max_input_queue_depth = queue_depth;
+        }
 
         // If we're not already processing synaptic DMAs,
         // flag pipeline as busy and trigger a feed event
@@ -201,6 +384,11 @@ void _user_event_callback(uint unused0, uint unused1) {
     use(unused0);
     use(unused1);
     _setup_synaptic_dma_read();
+
+    // The rows being read are now being waited for
+    if (n_buffers_in_use > 0) {
+        _start_dma_wait();
+    }
 }
 
 // Called when a DMA completes
@@ -208,24 +396,30 @@ void _dma_complete_callback(uint unused, uint tag) {
     use(unused);
 
     log_debug("DMA transfer complete at time %u with tag %u", time, tag);
+    _end_dma_wait();
 
-    // Get pointer to current buffer
-    uint32_t current_buffer_index = buffer_being_read;
+    // Get pointer to current buffer; reads complete in order, so this is
+    // the oldest buffer in use
+    uint32_t current_buffer_index = next_buffer_to_process;
     dma_buffer *current_buffer = &dma_buffers[current_buffer_index];
 
-    // Process synaptic row repeatedly
-    bool subsequent_spikes;
-    do {
+    // Process synaptic row once for the spike that read it, and once for
+    // each following spike from the same pre-synaptic neuron
+    uint32_t n_spikes = 1 + _skip_equal_spikes(
+        current_buffer->originating_spike);
+    while (n_spikes > 0) {
+        n_spikes--;
 
-        // Are there any more incoming spikes from the same pre-synaptic
-        // neuron?
-        subsequent_spikes = in_spikes_is_next_spike_equal(
-            current_buffer->originating_spike);
+        // Check for more spikes from the neuron received while processing
+        if (n_spikes == 0) {
+            n_spikes = _skip_equal_spikes(current_buffer->originating_spike);
+        }
 
         // Process synaptic row, writing it back if it's the last time
         // it's going to be processed
         if (!synapses_process_synaptic_row(time, current_buffer->row,
-            !subsequent_spikes, current_buffer_index)) {
+            current_buffer->sdram_writeback_address, n_spikes == 0,
+            current_buffer_index)) {
             log_error(
                 "Error processing spike 0x%.8x for address 0x%.8x"
                 "(local=0x%.8x)",
@@ -241,21 +435,58 @@ void _dma_complete_callback(uint unused, uint tag) {
 
             rt_error(RTE_SWERR);
         }
-    } while (subsequent_spikes);
+    }
+
+    // Free the buffer; any write back has been queued, so it will complete
+    // before another read into the buffer
+    next_buffer_to_process = _next_buffer_index(next_buffer_to_process);
+    n_buffers_in_use--;
 
-    // Start the next DMA transfer, so it is complete when we are finished
+    // Start the next DMA transfers, so they are complete when we are finished
     _setup_synaptic_dma_read();
+
+    // Any rows still being read are now being waited for
+    if (n_buffers_in_use > 0) {
+        _start_dma_wait();
+    }
+}
+
+
+// Called when a DMA writing back a plastic region completes
+void _dma_write_back_complete_callback(uint unused, uint tag) {
+    use(unused);
+    use(tag);
+    n_write_backs_in_progress--;
 }
 
 
 /* INTERFACE FUNCTIONS - cannot be static */
 
 bool spike_processing_initialise(
-        size_t row_max_n_words, uint mc_packet_callback_priority,
-        uint user_event_priority, uint incoming_spike_buffer_size) {
+        size_t row_max_n_words, uint32_t n_dma_buffers_value,
+        uint mc_packet_callback_priority, uint user_event_priority,
+        uint incoming_spike_buffer_size) {
 
     // Allocate the DMA buffers
-    for (uint32_t i = 0; i < N_DMA_BUFFERS; i++) {
+    n_dma_buffers = n_dma_buffers_value;
+    if (n_dma_buffers < MIN_DMA_BUFFERS) {
+        log_warning(
+            "%u DMA buffers requested; using %u", n_dma_buffers,
+            MIN_DMA_BUFFERS);
+        n_dma_buffers = MIN_DMA_BUFFERS;
+    } else if (n_dma_buffers > MAX_DMA_BUFFERS) {
+        log_warning(
+            "%u DMA buffers requested; using %u", n_dma_buffers,
+            MAX_DMA_BUFFERS);
+        n_dma_buffers = MAX_DMA_BUFFERS;
+    }
+    dma_buffers = (dma_buffer *) spin1_malloc(
+        n_dma_buffers * sizeof(dma_buffer));
+    if (dma_buffers == NULL) {
+        log_error("Could not initialise DMA buffers");
+        return false;
+    }
+    for (uint32_t i = 0; i < n_dma_buffers; i++) {
         dma_buffers[i].row = (uint32_t*) spin1_malloc(
                 row_max_n_words * sizeof(uint32_t));
         if (dma_buffers[i].row == NULL) {
@@ -267,7 +498,10 @@ bool spike_processing_initialise(
     }
     dma_busy = false;
     next_buffer_to_fill = 0;
-    buffer_being_read = N_DMA_BUFFERS;
+    next_buffer_to_process = 0;
+    n_buffers_in_use = 0;
+    read_pending = false;
+    n_write_backs_in_progress = 0;
     max_n_words = row_max_n_words;
 
     // Allocate incoming spike buffer
@@ -285,13 +519,16 @@ bool spike_processing_initialise(
             _multicast_packet_received_callback, mc_packet_callback_priority);
     simulation_dma_transfer_done_callback_on(
         DMA_TAG_READ_SYNAPTIC_ROW, _dma_complete_callback);
+    simulation_dma_transfer_done_callback_on(
+        DMA_TAG_WRITE_PLASTIC_REGION, _dma_write_back_complete_callback);
     spin1_callback_on(USER_EVENT, _user_event_callback, user_event_priority);
 
     return true;
 }
 
-void spike_processing_finish_write(uint32_t process_id) {
-    _setup_synaptic_dma_write(process_id);
+void spike_processing_finish_write(
+        uint32_t process_id, size_t n_plastic_words) {
+    _setup_synaptic_dma_write(process_id, n_plastic_words);
 }
 
 //! \brief returns the number of times the input buffer has overflowed
@@ -302,10 +539,68 @@ uint32_t spike_processing_get_buffer_overflows() {
     return in_spikes_get_n_buffer_overflows();
 }
 
-//! \brief get the address of the circular buffer used for buffering received
-//! spikes before processing them
-//! \return address of circular buffer
-circular_buffer get_circular_buffer(){
+uint32_t spike_processing_get_n_plastic_write_backs_skipped(void) {
+    return n_plastic_write_backs_skipped;
+}
+
+uint32_t spike_processing_get_n_plastic_write_backs_shortened(void) {
+    return n_plastic_write_backs_shortened;
+}
+
+void spike_processing_pause_dma_wait(void) {
+    _end_dma_wait();
+}
+
+void spike_processing_resume_dma_wait(void) {
+    if (n_buffers_in_use > 0) {
+        _start_dma_wait();
+    }
+}
+
+void spike_processing_hold_dma(void) {
+
+    // The DMA and user event callbacks can interrupt the timer callback that
+    // this is called from, so the rows being read and written back finish
+    // while this waits; once nothing is in progress, marking the DMA as busy
+    // stops a spike received from starting another read
+    while (true) {
+        uint cpsr = spin1_int_disable();
+        if (!dma_busy && n_buffers_in_use == 0 && !read_pending
+                && n_write_backs_in_progress == 0) {
+            dma_busy = true;
+            spin1_mode_restore(cpsr);
+            return;
+        }
+        spin1_mode_restore(cpsr);
+        spin1_wfi();
+    }
+}
+
+void spike_processing_release_dma(void) {
+
+    // Start on any spikes received while the DMA was held
+    uint cpsr = spin1_int_disable();
+    dma_busy = false;
+    if (!in_spikes_is_empty() && spin1_trigger_user_event(0, 0)) {
+        dma_busy = true;
+    }
+    spin1_mode_restore(cpsr);
+}
+
+void spike_processing_get_and_reset_load(spike_processing_load_t *load_out) {
+    uint cpsr = spin1_int_disable();
+    *load_out = load;
+    load.n_spikes_received = 0;
+    load.n_rows_fetched = 0;
+    load.dma_wait_cycles = 0;
+    load.max_input_queue_depth = in_spikes_size();
+    spin1_mode_restore(cpsr);
+}
+
+//! \brief get the address of the ring used for buffering received spikes
+//! before processing them
+//! \return address of the spike ring
+spike_ring get_spike_ring(){
     return buffer;
 }
 
@@ -22,16 +22,76 @@
 #include <common/in_spikes.h>
 #include <spin1_api.h>
 
+//! \brief Initialises the spike processing
+//! \param[in] row_max_n_words The size of the largest synaptic row, in words
+//! \param[in] n_dma_buffers The number of synaptic rows that can be read by
+//!                          DMA or waiting to be processed at once
+//! \param[in] mc_packet_callback_priority The priority of packet reception
+//! \param[in] user_event_priority The priority of the user event
+//! \param[in] incoming_spike_buffer_size The size of the input spike buffer
+//! \return True if the initialisation succeeded
 bool spike_processing_initialise(
-    size_t row_max_n_bytes, uint mc_packet_callback_priority,
-    uint user_event_priority, uint incoming_spike_buffer_size);
+    size_t row_max_n_words, uint32_t n_dma_buffers,
+    uint mc_packet_callback_priority, uint user_event_priority,
+    uint incoming_spike_buffer_size);
 
-void spike_processing_finish_write(uint32_t process_id);
+//! \brief Write back the plastic region of a row once it has been processed
+//! \param[in] process_id The index of the DMA buffer holding the row
+//! \param[in] n_plastic_words The number of words at the start of the plastic
+//!                            region to write back
+void spike_processing_finish_write(
+    uint32_t process_id, size_t n_plastic_words);
 
 //! \brief returns the number of times the input buffer has overflowed
 //! \return the number of times the input buffer has overflowed
 uint32_t spike_processing_get_buffer_overflows();
 
+//! \brief returns the number of plastic region write-backs skipped because
+//!        nothing in the region changed
+//! \return the number of write-backs skipped
+uint32_t spike_processing_get_n_plastic_write_backs_skipped(void);
+
+//! \brief returns the number of plastic region write-backs shortened to
+//!        the start of the region that changed
+//! \return the number of write-backs shortened
+uint32_t spike_processing_get_n_plastic_write_backs_shortened(void);
+
+//! The load on the spike processing since it was last read
+typedef struct spike_processing_load_t {
+    //! The number of spikes received
+    uint32_t n_spikes_received;
+    //! The number of synaptic rows fetched by DMA
+    uint32_t n_rows_fetched;
+    //! The clock cycles spent idle with no row to process while waiting for
+    //! a DMA, not counting the timer callback
+    uint32_t dma_wait_cycles;
+    //! The largest number of spikes waiting in the input buffer
+    uint32_t max_input_queue_depth;
+} spike_processing_load_t;
+
+//! \brief Stop timing any wait for a DMA, as the timer callback is about to
+//!        keep the core busy
+void spike_processing_pause_dma_wait(void);
+
+//! \brief Start timing the wait for any rows still being read, as the timer
+//!        callback has finished
+void spike_processing_resume_dma_wait(void);
+
+//! \brief Wait until the synaptic rows being read and written back are
+//!        finished with, and hold off reading any more until
+//!        spike_processing_release_dma() is called, so that the rows in SDRAM
+//!        can be changed by the caller
+void spike_processing_hold_dma(void);
+
+//! \brief Let the spikes received be processed again after
+//!        spike_processing_hold_dma()
+void spike_processing_release_dma(void);
+
+//! \brief Get the load on the spike processing since the last call, and
+//!        start counting again
+//! \param[out] load The load since the last call
+void spike_processing_get_and_reset_load(spike_processing_load_t *load);
+
 
 //! DMA buffer structure combines the row read from SDRAM with
 typedef struct dma_buffer {
@@ -50,10 +110,10 @@ typedef struct dma_buffer {
 
 } dma_buffer;
 
-//! \brief get the address of the circular buffer used for buffering received
-//! spikes before processing them
-//! \return address of circular buffer
-circular_buffer get_circular_buffer();
+//! \brief get the address of the ring used for buffering received spikes
+//! before processing them
+//! \return address of the spike ring
+spike_ring get_spike_ring();
 
 //! \brief set the DMA status
 //! \param[in] busy: bool
@@ -43,7 +43,7 @@
 #include <simulation.h>
 
 // For last spike selection
-#include <circular_buffer.h>
+#include <common/spike_ring.h>
 
 //-----------------------------------------------------------------------------
 // External functions                                                         |
@@ -130,8 +130,8 @@ typedef struct {
     uint32_t offset_in_table, pop_index, subpop_index, neuron_index;
     // circular buffer indices
     uint32_t my_cb_input, my_cb_output, no_spike_in_interval, cb_total_size;
-    // a local reference to the circular buffer
-    circular_buffer cb;
+    // a local reference to the ring of received spikes
+    spike_ring cb;
 } current_state_t;
 
 // instantiation of the previous struct
@@ -284,7 +284,7 @@ address_t synaptogenesis_dynamics_initialise(address_t sdram_sp_address)
         rewiring_data.lat_probabilities[index] = *half_word++;
     }
 
-    assert(((int) half_word) % 4 == 4);
+    assert(((uintptr_t) half_word) % 4 == 0);
 
     sp_word = (int32_t *) half_word;
 
@@ -330,12 +330,12 @@ void update_goal_posts(uint32_t time) {
     if (!received_any_spike()) {
         return;
     }
-    current_state.cb = get_circular_buffer();
-    current_state.cb_total_size = circular_buffer_real_size(current_state.cb);
+    current_state.cb = get_spike_ring();
+    current_state.cb_total_size = spike_ring_index_mask(current_state.cb);
 
     current_state.my_cb_output = current_state.my_cb_input;
     current_state.my_cb_input = (
-        circular_buffer_input(current_state.cb)
+        spike_ring_input(current_state.cb)
         & current_state.cb_total_size);
 
     current_state.no_spike_in_interval = (
@@ -352,7 +352,7 @@ static inline spike_t select_last_spike(void) {
     }
     uint32_t offset = ulrbits(mars_kiss64_seed(rewiring_data.local_seed)) *
         current_state.no_spike_in_interval;
-    return circular_buffer_value_at_index(
+    return spike_ring_value_at_index(
         current_state.cb,
         (current_state.my_cb_output + offset) & current_state.cb_total_size);
 }
@@ -74,7 +74,7 @@ bool synaptogenesis_dynamics_elimination_rule();
 //! \param[in] dma_id: the ID of the DMA
 //! \param[in] dma_tag: the DMA tag, i.e. the tag used for reading row for rew.
 //! \return nothing
-void synaptic_row_restructure();
+void synaptic_row_restructure(uint dma_id, uint dma_tag);
 
 //! retrieve the period of rewiring
 //! based on is_fast(), this can either mean how many times rewiring happens
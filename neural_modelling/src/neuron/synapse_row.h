@@ -68,6 +68,22 @@ typedef uint16_t control_t;
 
 #define N_SYNAPSE_ROW_HEADER_WORDS 3
 
+//! The position of the format of the fixed synapses in the count word
+#define SYNAPSE_ROW_FORMAT_SHIFT 30
+
+//! The mask of the number of fixed synapses in the count word
+#define SYNAPSE_ROW_COUNT_MASK ((1 << SYNAPSE_ROW_FORMAT_SHIFT) - 1)
+
+//! The encodings of the fixed synapses of a row
+typedef enum synapse_row_format {
+    //! A word per synapse of weight, delay, type and index
+    SYNAPSE_ROW_FORMAT_FULL = 0,
+    //! A weight word, then a half-word per synapse of delay, type and index
+    SYNAPSE_ROW_FORMAT_SHARED_WEIGHT = 1,
+    //! A delay word, then a half-word per synapse of weight, type and index
+    SYNAPSE_ROW_FORMAT_SHARED_DELAY = 2
+} synapse_row_format;
+
 
 // The data structure layout supported by this API is designed for
 // mixed plastic and fixed synapse rows.
@@ -105,7 +121,8 @@ static inline address_t synapse_row_fixed_region(address_t row) {
 }
 
 // Within the fixed-region extracted using the above API, fixed[0]
-// Contains the number of 32-bit fixed synaptic words, fixed[1]
+// Contains the number of fixed synapses (with the format of these in the
+// top bits, see below), fixed[1]
 // Contains the number of 16-bit plastic synapse control words
 // (The weights for the plastic synapses are assumed to be stored
 // In some learning-rule-specific format in the plastic region)
@@ -117,8 +134,33 @@ static inline address_t synapse_row_fixed_region(address_t row) {
 // F+2:           [ 1st plastic synapse control word|2nd plastic control word ]
 //   ...
 // F+1+ceil(P/2): [ Last word of fixed region                                 ]
+//
+// The fixed synapses of a row without plastic synapses can instead be in one
+// of the compact formats, in which the synapses share a weight or a delay:
+//   0:           [ F = Num fixed synapses | format << 30                     ]
+//   1:           [ P = 0                                                     ]
+//   2:           [ The shared weight or delay                                ]
+//   3:           [ 1st synapse half-word | 2nd synapse half-word             ]
+//   ...
+// 2+ceil(F/2):   [ Last word of fixed region                                 ]
+// A shared weight half-word is the bottom half of the full synaptic word;
+// a shared delay half-word has the weight in place of the delay.
 static inline size_t synapse_row_num_fixed_synapses(address_t fixed) {
-    return ((size_t) (fixed[0]));
+    return ((size_t) (fixed[0] & SYNAPSE_ROW_COUNT_MASK));
+}
+
+static inline synapse_row_format synapse_row_fixed_format(address_t fixed) {
+    return (synapse_row_format) (fixed[0] >> SYNAPSE_ROW_FORMAT_SHIFT);
+}
+
+//! Returns the weight or delay shared by the synapses of a compact row
+static inline uint32_t synapse_row_compact_shared_value(address_t fixed) {
+    return fixed[2];
+}
+
+//! Returns the synapse half-words of a compact row
+static inline uint16_t *synapse_row_compact_synapses(address_t fixed) {
+    return (uint16_t *) (&fixed[3]);
 }
 
 static inline size_t synapse_row_num_plastic_controls(address_t fixed) {
@@ -158,4 +200,10 @@ static inline weight_t synapse_row_sparse_weight(uint32_t x) {
     return (x >> (32 - SYNAPSE_WEIGHT_BITS));
 }
 
+// The weight of a half-word of a shared delay row
+static inline weight_t synapse_row_compact_weight(
+        uint32_t x, uint32_t synapse_type_index_bits) {
+    return (x >> synapse_type_index_bits);
+}
+
 #endif  // SYNAPSE_ROW_H
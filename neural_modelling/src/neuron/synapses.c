@@ -44,9 +44,23 @@ static weight_t *ring_buffers;
 // Amount to left shift the ring buffer by to make it an input
 static uint32_t *ring_buffer_to_input_left_shifts;
 
+// The ring buffer slot of the current timestep, taken out of the ring
+// buffers so that it can be transferred to the neurons with interrupts on
+static weight_t *current_slot;
+
+// The number of words in a ring buffer slot
+static uint32_t n_slot_words;
+
+// The input of one synapse type for each neuron in the current timestep
+static input_t *current_inputs;
+
 // Count of the number of times the ring buffers have saturated
 static uint32_t saturation_count = 0;
 
+// The number of words at the start of the plastic region of the current row
+// changed by the times it has been processed since it was last written back
+static size_t n_plastic_words_changed = 0;
+
 static uint32_t synapse_type_index_bits;
 static uint32_t synapse_type_index_mask;
 static uint32_t synapse_index_bits;
@@ -82,6 +96,14 @@ static inline void _print_synaptic_row(synaptic_row_t synaptic_row) {
               n_fixed_synapses,
               synapse_row_num_plastic_controls(fixed_region_address));
 
+    // The synapses of compact rows aren't printed individually
+    synapse_row_format format = synapse_row_fixed_format(fixed_region_address);
+    if (format != SYNAPSE_ROW_FORMAT_FULL) {
+        log_debug("Compact format %u, shared value %u\n", format,
+                  synapse_row_compact_shared_value(fixed_region_address));
+        n_fixed_synapses = 0;
+    }
+
     for (uint32_t i = 0; i < n_fixed_synapses; i++) {
         uint32_t synapse = fixed_synapses[i];
         uint32_t synapse_type = synapse_row_sparse_type(
@@ -156,18 +178,95 @@ static inline void _print_inputs() {
 }
 
 
+//! \brief Adds a weight to a ring buffer entry, saturating if needed
+static inline void _add_to_ring_buffer(
+        uint32_t ring_buffer_index, uint32_t weight) {
+
+    // Add weight to current ring buffer value
+    uint32_t accumulation = ring_buffers[ring_buffer_index] + weight;
+
+    // If 17th bit is set, saturate accumulator at UINT16_MAX (0xFFFF)
+    // **NOTE** 0x10000 can be expressed as an ARM literal,
+    //          but 0xFFFF cannot.  Therefore, we use (0x10000 - 1)
+    //          to obtain this value
+    uint32_t sat_test = accumulation & 0x10000;
+    if (sat_test) {
+        accumulation = sat_test - 1;
+        saturation_count += 1;
+    }
+
+    // Store saturated value back in ring-buffer
+    ring_buffers[ring_buffer_index] = accumulation;
+}
+
+//! \brief Processes a compact row in which all synapses have one weight
+static inline void _process_shared_weight_synapses(
+        address_t fixed_region_address, uint32_t fixed_synapse,
+        uint32_t time) {
+    register uint16_t *synapses = synapse_row_compact_synapses(
+        fixed_region_address);
+    uint32_t weight = synapse_row_compact_shared_value(fixed_region_address);
+
+    for (; fixed_synapse > 0; fixed_synapse--) {
+        uint32_t synapse = *synapses++;
+        uint32_t delay = synapse_row_sparse_delay(synapse,
+            synapse_type_index_bits);
+        uint32_t combined_synapse_neuron_index = synapse_row_sparse_type_index(
+                synapse, synapse_type_index_mask);
+        uint32_t ring_buffer_index = synapses_get_ring_buffer_index_combined(
+            delay + time, combined_synapse_neuron_index,
+            synapse_type_index_bits);
+        _add_to_ring_buffer(ring_buffer_index, weight);
+    }
+}
+
+//! \brief Processes a compact row in which all synapses have one delay
+static inline void _process_shared_delay_synapses(
+        address_t fixed_region_address, uint32_t fixed_synapse,
+        uint32_t time) {
+    register uint16_t *synapses = synapse_row_compact_synapses(
+        fixed_region_address);
+    uint32_t delayed_time =
+        synapse_row_compact_shared_value(fixed_region_address) + time;
+
+    for (; fixed_synapse > 0; fixed_synapse--) {
+        uint32_t synapse = *synapses++;
+        uint32_t combined_synapse_neuron_index = synapse_row_sparse_type_index(
+                synapse, synapse_type_index_mask);
+        uint32_t weight = synapse_row_compact_weight(
+            synapse, synapse_type_index_bits);
+        uint32_t ring_buffer_index = synapses_get_ring_buffer_index_combined(
+            delayed_time, combined_synapse_neuron_index,
+            synapse_type_index_bits);
+        _add_to_ring_buffer(ring_buffer_index, weight);
+    }
+}
+
 // This is the "inner loop" of the neural simulation.
 // Every spike event could cause up to 256 different weights to
 // be put into the ring buffer.
 static inline void _process_fixed_synapses(
         address_t fixed_region_address, uint32_t time) {
-    register uint32_t *synaptic_words = synapse_row_fixed_weight_controls(
-        fixed_region_address);
     register uint32_t fixed_synapse = synapse_row_num_fixed_synapses(
         fixed_region_address);
 
     num_fixed_pre_synaptic_events += fixed_synapse;
 
+    // Rows with a shared weight or delay have their own loops
+    synapse_row_format format = synapse_row_fixed_format(fixed_region_address);
+    if (format == SYNAPSE_ROW_FORMAT_SHARED_WEIGHT) {
+        _process_shared_weight_synapses(
+            fixed_region_address, fixed_synapse, time);
+        return;
+    } else if (format == SYNAPSE_ROW_FORMAT_SHARED_DELAY) {
+        _process_shared_delay_synapses(
+            fixed_region_address, fixed_synapse, time);
+        return;
+    }
+
+    register uint32_t *synaptic_words = synapse_row_fixed_weight_controls(
+        fixed_region_address);
+
     for (; fixed_synapse > 0; fixed_synapse--) {
 
         // Get the next 32 bit word from the synaptic_row
@@ -186,21 +285,7 @@ static inline void _process_fixed_synapses(
             delay + time, combined_synapse_neuron_index,
             synapse_type_index_bits);
 
-        // Add weight to current ring buffer value
-        uint32_t accumulation = ring_buffers[ring_buffer_index] + weight;
-
-        // If 17th bit is set, saturate accumulator at UINT16_MAX (0xFFFF)
-        // **NOTE** 0x10000 can be expressed as an ARM literal,
-        //          but 0xFFFF cannot.  Therefore, we use (0x10000 - 1)
-        //          to obtain this value
-        uint32_t sat_test = accumulation & 0x10000;
-        if (sat_test) {
-            accumulation = sat_test - 1;
-            saturation_count += 1;
-        }
-
-        // Store saturated value back in ring-buffer
-        ring_buffers[ring_buffer_index] = accumulation;
+        _add_to_ring_buffer(ring_buffer_index, weight);
     }
 }
 
@@ -220,7 +305,7 @@ bool synapses_initialise(
         address_t synapse_params_address, address_t direct_matrix_address,
         uint32_t n_neurons_value, uint32_t n_synapse_types_value,
         uint32_t **ring_buffer_to_input_buffer_left_shifts,
-        address_t *direct_synapses_address) {
+        address_t *direct_synapses_address, uint32_t *n_dma_buffers) {
 
     log_debug("synapses_initialise: starting");
     n_neurons = n_neurons_value;
@@ -235,6 +320,9 @@ bool synapses_initialise(
     *ring_buffer_to_input_buffer_left_shifts =
         ring_buffer_to_input_left_shifts;
 
+    // The number of synaptic row DMA buffers follows the shifts
+    *n_dma_buffers = synapse_params_address[n_synapse_types];
+
     // Work out the positions of the direct and indirect synaptic matrices
     // and copy the direct matrix to DTCM
     uint32_t direct_matrix_size = direct_matrix_address[0];
@@ -288,6 +376,16 @@ bool synapses_initialise(
         ring_buffers[i] = 0;
     }
 
+    // Each slot holds at least two weights, so is a whole number of words
+    uint32_t slot_size = 1 << (log_n_neurons + log_n_synapse_types);
+    n_slot_words = (slot_size * sizeof(weight_t)) / sizeof(uint32_t);
+    current_slot = (weight_t *) spin1_malloc(n_slot_words * sizeof(uint32_t));
+    current_inputs = (input_t *) spin1_malloc(n_neurons * sizeof(input_t));
+    if (current_slot == NULL || current_inputs == NULL) {
+        log_error("Could not allocate space for the synaptic input transfer");
+        return false;
+    }
+
     synapse_type_index_bits = log_n_neurons + log_n_synapse_types;
     synapse_type_index_mask = (1 << synapse_type_index_bits) - 1;
     synapse_index_bits = log_n_neurons;
@@ -301,44 +399,43 @@ void synapses_do_timestep_update(timer_t time) {
 
     _print_ring_buffers(time);
 
-    // Disable interrupts to stop DMAs interfering with the ring buffers
+    // Take the slot of this timestep out of the ring buffers, leaving it
+    // clear.  Interrupts are disabled only while this is done, as input with
+    // the maximum delay is added to the slot of the current timestep.
+    uint32_t *restrict ring_slot = (uint32_t *) &ring_buffers[
+        synapses_get_ring_buffer_index(
+            time, 0, 0, synapse_type_index_bits, synapse_index_bits)];
+    uint32_t *restrict slot = (uint32_t *) current_slot;
     uint32_t state = spin1_irq_disable();
+    for (uint32_t i = 0; i < n_slot_words; i++) {
+        slot[i] = ring_slot[i];
+        ring_slot[i] = 0;
+    }
+    spin1_mode_restore(state);
 
-    // Transfer the input from the ring buffers into the input buffers
-    for (uint32_t neuron_index = 0; neuron_index < n_neurons;
-            neuron_index++) {
-
-        // Loop through all synapse types
-        for (uint32_t synapse_type_index = 0;
-                synapse_type_index < n_synapse_types; synapse_type_index++) {
-
-            // Get index in the ring buffers for the current time slot for
-            // this synapse type and neuron
-            uint32_t ring_buffer_index = synapses_get_ring_buffer_index(
-                time, synapse_type_index, neuron_index, synapse_type_index_bits,
-                synapse_index_bits);
-
-            // Convert ring-buffer entry to input and add on to correct
-            // input for this synapse type and neuron
-            neuron_add_inputs(
-                synapse_type_index, neuron_index,
-                synapses_convert_weight_to_input(
-                    ring_buffers[ring_buffer_index],
-                    ring_buffer_to_input_left_shifts[synapse_type_index]));
-
-            // Clear ring buffer
-            ring_buffers[ring_buffer_index] = 0;
+    // Convert the weights of each synapse type to input in one pass and
+    // transfer them to the neurons together
+    for (uint32_t synapse_type_index = 0;
+            synapse_type_index < n_synapse_types; synapse_type_index++) {
+        const weight_t *restrict weights =
+            &current_slot[synapse_type_index << synapse_index_bits];
+        input_t *restrict inputs = current_inputs;
+        uint32_t left_shift =
+            ring_buffer_to_input_left_shifts[synapse_type_index];
+        for (uint32_t neuron_index = 0; neuron_index < n_neurons;
+                neuron_index++) {
+            inputs[neuron_index] = synapses_convert_weight_to_input(
+                weights[neuron_index], left_shift);
         }
+        neuron_add_input_array(synapse_type_index, current_inputs);
     }
 
     _print_inputs();
-
-    // Re-enable the interrupts
-    spin1_mode_restore(state);
 }
 
 bool synapses_process_synaptic_row(uint32_t time, synaptic_row_t row,
-                                   bool write, uint32_t process_id) {
+                                   address_t sdram_row_address, bool write,
+                                   uint32_t process_id) {
 
     _print_synaptic_row(row);
 
@@ -357,17 +454,22 @@ bool synapses_process_synaptic_row(uint32_t time, synaptic_row_t row,
         // Process any plastic synapses
         profiler_write_entry_disable_fiq(
             PROFILER_ENTER | PROFILER_PROCESS_PLASTIC_SYNAPSES);
+        size_t n_words_changed;
         if (!synapse_dynamics_process_plastic_synapses(plastic_region_address,
-                fixed_region_address, ring_buffers, time)) {
+                fixed_region_address, ring_buffers, time, sdram_row_address,
+                &n_words_changed)) {
             return false;
         }
         profiler_write_entry_disable_fiq(
             PROFILER_EXIT | PROFILER_PROCESS_PLASTIC_SYNAPSES);
+        if (n_words_changed > n_plastic_words_changed) {
+            n_plastic_words_changed = n_words_changed;
+        }
 
-
-        // Perform DMA write back
+        // Perform DMA write back of what has changed
         if (write) {
-            spike_processing_finish_write(process_id);
+            spike_processing_finish_write(process_id, n_plastic_words_changed);
+            n_plastic_words_changed = 0;
         }
     }
 
@@ -375,11 +477,25 @@ bool synapses_process_synaptic_row(uint32_t time, synaptic_row_t row,
     // **NOTE** this is done after initiating DMA in an attempt
     // to hide cost of DMA behind this loop to improve the chance
     // that the DMA controller is ready to read next synaptic row afterwards
+    profiler_write_entry_disable_fiq(
+        PROFILER_ENTER | PROFILER_PROCESS_FIXED_SYNAPSES);
     _process_fixed_synapses(fixed_region_address, time);
+    profiler_write_entry_disable_fiq(
+        PROFILER_EXIT | PROFILER_PROCESS_FIXED_SYNAPSES);
     //}
     return true;
 }
 
+void synapses_add_weight(
+        uint32_t time, uint32_t synapse_type, uint32_t neuron_index,
+        weight_t weight) {
+    num_fixed_pre_synaptic_events++;
+    uint32_t ring_buffer_index = synapses_get_ring_buffer_index(
+        time, synapse_type, neuron_index, synapse_type_index_bits,
+        synapse_index_bits);
+    _add_to_ring_buffer(ring_buffer_index, weight);
+}
+
 //! \brief returns the number of times the synapses have saturated their
 //!        weights.
 //! \return the number of times the synapses have saturated.
@@ -73,18 +73,32 @@ bool synapses_initialise(
     address_t synapse_params_address, address_t direct_matrix_address,
     uint32_t n_neurons, uint32_t n_synapse_types,
     uint32_t **ring_buffer_to_input_buffer_left_shifts,
-    address_t *direct_synapses_address);
+    address_t *direct_synapses_address, uint32_t *n_dma_buffers);
 
 void synapses_do_timestep_update(timer_t time);
 
 //! \brief process a synaptic row
 //! \param[in] time: the simulated time
 //! \param[in] row: the synaptic row in question
+//! \param[in] sdram_row_address: the address of the row in SDRAM, or NULL
+//!                               if it is not read from SDRAM
 //! \param[in] write: bool saying if to write this back to SDRAM
 //! \param[in] process_id: ??????????????????
 //! \return bool if successful or not
 bool synapses_process_synaptic_row(
-    uint32_t time, synaptic_row_t row, bool write, uint32_t process_id);
+    uint32_t time, synaptic_row_t row, address_t sdram_row_address,
+    bool write, uint32_t process_id);
+
+//! \brief add the weight of a synapse that is not stored in a row, such as
+//!        one computed from a convolution kernel
+//! \param[in] time: the simulated time at which the weight arrives,
+//!                  including the delay of the synapse
+//! \param[in] synapse_type: the type of the synapse
+//! \param[in] neuron_index: the index of the neuron on this core
+//! \param[in] weight: the weight to add to the ring buffer
+void synapses_add_weight(
+    uint32_t time, uint32_t synapse_type, uint32_t neuron_index,
+    weight_t weight);
 
 //! \brief returns the number of times the synapses have saturated their
 //!        weights.
@@ -29,4 +29,11 @@ typedef struct threshold_type_t* threshold_type_pointer_t;
 static bool threshold_type_is_above_threshold(
     state_t value, threshold_type_pointer_t threshold_type);
 
+//! \brief Determines if the threshold can be skipped while the neuron is at
+//!     rest, i.e. it will not spike and has no state of its own to update
+//! \param[in] threshold_type The parameters of the threshold
+//! \return true if the threshold doesn't need to be checked at rest
+static bool threshold_type_can_skip_at_rest(
+    threshold_type_pointer_t threshold_type);
+
 #endif // _THRESHOLD_TYPE_H_
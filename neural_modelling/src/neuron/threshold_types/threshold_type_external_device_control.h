@@ -145,4 +145,12 @@ static bool threshold_type_is_above_threshold(
     return false;
 }
 
+static inline bool threshold_type_can_skip_at_rest(
+        threshold_type_pointer_t threshold_type) {
+    use(threshold_type);
+
+    // The value is sent periodically whatever the state of the neuron
+    return false;
+}
+
 #endif // _THRESHOLD_TYPE_PUSH_BOT_CONTROL_MODULE_H_
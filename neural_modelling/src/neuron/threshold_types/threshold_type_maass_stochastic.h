@@ -66,4 +66,12 @@ static inline bool threshold_type_is_above_threshold(state_t value,
     return REAL_COMPARE(result, >=, random_number);
 }
 
+static inline bool threshold_type_can_skip_at_rest(
+        threshold_type_pointer_t threshold_type) {
+    use(threshold_type);
+
+    // A neuron at rest still has a chance of spiking
+    return false;
+}
+
 #endif // _THRESHOLD_TYPE_STOCHASTIC_H_
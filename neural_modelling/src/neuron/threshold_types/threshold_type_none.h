@@ -30,4 +30,10 @@ static inline bool threshold_type_is_above_threshold(state_t value,
     return 0;
 }
 
+static inline bool threshold_type_can_skip_at_rest(
+        threshold_type_pointer_t threshold_type) {
+    use(threshold_type);
+    return true;
+}
+
 #endif // _THRESHOLD_TYPE_NONE_H_
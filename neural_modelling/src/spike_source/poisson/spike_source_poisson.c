@@ -23,6 +23,7 @@
  */
 
 #include <common/maths-util.h>
+#include <common/random_buffer.h>
 
 #include <data_specification.h>
 #include <recording.h>
@@ -67,7 +68,8 @@ typedef enum region {
     SYSTEM, POISSON_PARAMS,
     SPIKE_HISTORY_REGION,
     PROVENANCE_REGION,
-    PROFILER_REGION
+    PROFILER_REGION,
+    RATE_SCHEDULE_REGION
 } region;
 
 #define NUMBER_OF_REGIONS_TO_RECORD 1
@@ -75,10 +77,107 @@ typedef enum region {
 //! A scale factor to allow the use of integers for "inter-spike intervals"
 #define ISI_SCALE_FACTOR 1000
 
+//! The number of slots in the timing wheel of scheduled sources; this must be
+//! a power of 2
+#define N_WHEEL_SLOTS 256
+#define WHEEL_SLOT_MASK (N_WHEEL_SLOTS - 1)
+
+//! Marks the end of a list of sources in the timing wheel
+#define NO_SOURCE 0xFFFF
+
+//! Where a source currently is in the schedule
+typedef enum schedule_place {
+    //! The source will not spike again in this run
+    NOT_SCHEDULED,
+    //! In the timing wheel, waiting for due_tick to come around; this is the
+    //! next spike of a slow source, or the start of a fast source
+    IN_WHEEL,
+    //! In the dense array of fast sources, which are visited every tick
+    IN_FAST_SOURCES,
+    //! A slow source whose next spike (at due_tick) is after its end_ticks
+    AFTER_END
+} schedule_place;
+
+//! \brief scheduling state of a source, kept in DTCM alongside (but separate
+//!        from) the parameters so that the parameter layout is unchanged.
+//!
+//! While a slow source is scheduled, its time_to_spike_ticks only holds the
+//! part of the time to spike within due_tick, which is always less than
+//! ISI_SCALE_FACTOR; the whole ticks are held in due_tick instead.
+typedef struct source_schedule_t {
+    //! The tick at which the source next needs attention
+    uint32_t due_tick;
+    //! The next source in the same wheel slot, or NO_SOURCE
+    uint16_t next;
+    //! The previous source in the same wheel slot, or NO_SOURCE
+    uint16_t prev;
+    //! The position of the source in fast_sources when IN_FAST_SOURCES
+    uint16_t fast_position;
+    //! The schedule_place of the source
+    uint8_t place;
+} source_schedule_t;
+
 typedef enum callback_priorities{
     MULTICAST = -1, SDP = 0, TIMER = 2, DMA = 1
 } callback_priorities;
 
+//! The SDP port on which rates are received; this must match
+//! POISSON_RATE_SDP_PORT in the tools
+#define POISSON_RATE_SDP_PORT 6
+
+//! The size of the SDP header, which is included in the length of a message
+#define SDP_HEADER_BYTES 8
+
+//! The commands of the rate messages received by SDP; the words of each
+//! message start at cmd_rc
+typedef enum rate_command {
+    //! [RATES_LIST, n, (id, rate) * n]: the rates of a list of sources
+    RATES_LIST,
+    //! [RATES_RANGE, first id, n, rate * n]: the rates of n sources with
+    //! consecutive IDs
+    RATES_RANGE
+} rate_command;
+
+//! How the value of a scheduled rate change is to be taken
+typedef enum rate_change_kind {
+    //! The value is the mean inter-spike interval in ticks of a slow source
+    SLOW_RATE,
+    //! The value is exp(-lambda) of a fast source, as an unsigned long fract
+    FAST_RATE,
+    //! The value is sqrt(lambda) of a faster source, as a REAL
+    FASTER_RATE
+} rate_change_kind;
+
+//! \brief A change of the rate of a source at a given tick, as written by the
+//!        host, which has already worked out the parameters for the rate
+typedef struct rate_change_t {
+    //! The tick at which the rate changes
+    uint32_t tick;
+    //! The index of the source on this core
+    uint16_t source;
+    //! The rate_change_kind of the value
+    uint16_t kind;
+    //! The parameter of the source for the new rate
+    uint32_t value;
+} rate_change_t;
+
+//! The rate schedule region; the changes are sorted by tick
+typedef struct rate_schedule_t {
+    uint32_t n_changes;
+    rate_change_t changes[];
+} rate_schedule_t;
+
+//! The number of rate changes copied into DTCM at a time; this must be a
+//! power of 2
+#define RATE_CHANGES_PER_BLOCK 32
+#define RATE_CHANGE_BLOCK_MASK (RATE_CHANGES_PER_BLOCK - 1)
+
+//! Marks a block buffer whose block has not (yet) been read
+#define NO_BLOCK 0xFFFFFFFF
+
+//! The DMA tag used to read the rate schedule
+#define DMA_TAG_READ_RATE_SCHEDULE 0
+
 //! Parameters of the SpikeSourcePoisson
 struct global_parameters {
 
@@ -159,6 +258,59 @@ static bool recording_in_progress = false;
 //! The timer period
 static uint32_t timer_period;
 
+//! The random variates drawn ahead of time for the sources
+static random_buffer_t random_buffer;
+
+//! The scheduling state of each source
+static source_schedule_t *schedule = NULL;
+
+//! \brief The timing wheel; the head of the list of sources in each slot.
+//!        A source due at tick t is in slot (t & WHEEL_SLOT_MASK), so a slot
+//!        may also hold sources due on later turns of the wheel.
+static uint16_t wheel[N_WHEEL_SLOTS];
+
+//! The fast sources which are currently active, in no particular order
+static uint16_t *fast_sources = NULL;
+
+//! The number of entries in fast_sources
+static uint32_t n_fast_sources = 0;
+
+//! \brief The rates received since the last tick; these are applied at the
+//!        start of the next tick so that the schedule is only ever changed
+//!        from the timer callback
+static REAL *pending_rates = NULL;
+
+//! The sources which have a rate in pending_rates, in order of arrival
+static uint16_t *pending_sources = NULL;
+
+//! The sources whose rates are being applied; swapped with pending_sources
+//! at the start of each tick so that more rates can arrive meanwhile
+static uint16_t *applying_sources = NULL;
+
+//! The number of entries in pending_sources
+static uint32_t n_pending_rates = 0;
+
+//! Which sources have a rate in pending_rates
+static bit_field_t pending_rate_set = NULL;
+
+//! The rate schedule in SDRAM
+static rate_schedule_t *rate_schedule = NULL;
+
+//! The index of the next change in the rate schedule to be applied
+static uint32_t next_rate_change = 0;
+
+//! \brief Two blocks of the rate schedule in DTCM; while the changes of one
+//!        block are applied, the next block is read into the other by DMA
+static rate_change_t rate_change_blocks[2][RATE_CHANGES_PER_BLOCK];
+
+//! The block of the rate schedule held in each of rate_change_blocks, or
+//! NO_BLOCK if it is still being read
+static volatile uint32_t rate_change_block_held[2] = {NO_BLOCK, NO_BLOCK};
+
+//! The block of the rate schedule which is read by the next DMA to complete;
+//! DMAs complete in the order in which they are started
+static uint32_t rate_change_block_arriving = 0;
+
 //! \brief Set specific spikes for recording
 //! \param[in] n is the spike array index
 //! \return bit field at the location n
@@ -183,10 +335,8 @@ static inline void _reset_spikes() {
 //!         until the next spike occurs
 static inline uint32_t slow_spike_source_get_time_to_spike(
         uint32_t mean_inter_spike_interval_in_ticks) {
-    // Round (dist variate * ISI_SCALE_FACTOR), convert to uint32
-    int nbits = 15;
-    uint32_t value = (uint32_t) roundk(exponential_dist_variate(
-            mars_kiss64_seed, global_parameters.spike_source_seed) * ISI_SCALE_FACTOR, nbits);
+    // The buffered variates are already (dist variate * ISI_SCALE_FACTOR)
+    uint32_t value = random_buffer_exponential(&random_buffer);
     // Now multiply by the mean ISI
     uint32_t exp_variate = value * mean_inter_spike_interval_in_ticks;
     // Note that this will be compared to ISI_SCALE_FACTOR in the main loop!
@@ -206,9 +356,8 @@ static inline uint32_t fast_spike_source_get_num_spikes(
         return 0;
     }
     else {
-        return poisson_dist_variate_exp_minus_lambda(
-            mars_kiss64_seed,
-            global_parameters.spike_source_seed, exp_minus_lambda);
+        return random_buffer_poisson_exp_minus_lambda(
+            &random_buffer, exp_minus_lambda);
     }
 }
 
@@ -220,10 +369,9 @@ static inline uint32_t fast_spike_source_get_num_spikes(
 //!         this timer tick
 static inline uint32_t faster_spike_source_get_num_spikes(
         REAL sqrt_lambda) {
-    // First we do x = (invgausscdf(U(0,1)) * 0.5) + sqrt(lambda)
-    REAL x = (gaussian_dist_variate(
-            mars_kiss64_seed,
-            global_parameters.spike_source_seed) * REAL_CONST(0.5)) + sqrt_lambda;
+    // First we do x = (invgausscdf(U(0,1)) * 0.5) + sqrt(lambda); the
+    // buffered variates are already scaled by 0.5
+    REAL x = random_buffer_gaussian(&random_buffer) + sqrt_lambda;
     // Then we return int(roundk(x^2))
     int nbits = 15;
     return (uint32_t) roundk(x * x, nbits);
@@ -245,6 +393,156 @@ void print_spike_sources(){
     }
 }
 
+//! \brief puts a source in the timing wheel
+//! \param[in] s: the index of the source
+//! \param[in] due_tick: the tick at which the source needs attention
+static inline void _wheel_insert(uint32_t s, uint32_t due_tick) {
+    source_schedule_t *entry = &schedule[s];
+    uint32_t slot = due_tick & WHEEL_SLOT_MASK;
+    entry->due_tick = due_tick;
+    entry->place = IN_WHEEL;
+    entry->prev = NO_SOURCE;
+    entry->next = wheel[slot];
+    if (wheel[slot] != NO_SOURCE) {
+        schedule[wheel[slot]].prev = s;
+    }
+    wheel[slot] = s;
+}
+
+//! \brief takes a source out of the timing wheel
+//! \param[in] s: the index of the source
+static inline void _wheel_remove(uint32_t s) {
+    source_schedule_t *entry = &schedule[s];
+    if (entry->prev == NO_SOURCE) {
+        wheel[entry->due_tick & WHEEL_SLOT_MASK] = entry->next;
+    } else {
+        schedule[entry->prev].next = entry->next;
+    }
+    if (entry->next != NO_SOURCE) {
+        schedule[entry->next].prev = entry->prev;
+    }
+    entry->place = NOT_SCHEDULED;
+}
+
+//! \brief adds a source to the fast sources visited every tick
+//! \param[in] s: the index of the source
+static inline void _fast_source_add(uint32_t s) {
+    schedule[s].place = IN_FAST_SOURCES;
+    schedule[s].fast_position = n_fast_sources;
+    fast_sources[n_fast_sources++] = s;
+}
+
+//! \brief removes a source from the fast sources, by moving the last fast
+//!        source into its place
+//! \param[in] s: the index of the source
+static inline void _fast_source_remove(uint32_t s) {
+    uint32_t position = schedule[s].fast_position;
+    uint32_t last = fast_sources[--n_fast_sources];
+    fast_sources[position] = last;
+    schedule[last].fast_position = position;
+    schedule[s].place = NOT_SCHEDULED;
+}
+
+//! \brief schedules the next spike of a slow source
+//! \param[in] s: the index of the source
+//! \param[in] from_tick: the first tick in which the time to spike of the
+//!            source counts down
+static inline void _schedule_slow_source(uint32_t s, uint32_t from_tick) {
+    spike_source_t *spike_source = &poisson_parameters[s];
+    uint32_t ticks_to_spike =
+        spike_source->time_to_spike_ticks / ISI_SCALE_FACTOR;
+    uint32_t due_tick = from_tick + ticks_to_spike;
+    spike_source->time_to_spike_ticks -= ticks_to_spike * ISI_SCALE_FACTOR;
+
+    // If the spike is after the end (or the tick count would wrap), the
+    // source is done, but remember where it was for storing back
+    if ((due_tick < spike_source->end_ticks) && (due_tick >= from_tick)) {
+        _wheel_insert(s, due_tick);
+    } else {
+        schedule[s].due_tick = due_tick;
+        schedule[s].place = AFTER_END;
+    }
+}
+
+//! \brief puts a source where it needs to be in the schedule
+//! \param[in] s: the index of the source
+//! \param[in] next_tick: the next tick to be processed
+static void _schedule_source(uint32_t s, uint32_t next_tick) {
+    spike_source_t *spike_source = &poisson_parameters[s];
+    schedule[s].place = NOT_SCHEDULED;
+    if (next_tick >= spike_source->end_ticks) {
+        return;
+    }
+    if (spike_source->is_fast_source) {
+        // Fast sources are parked in the wheel until they start
+        if (next_tick >= spike_source->start_ticks) {
+            _fast_source_add(s);
+        } else {
+            _wheel_insert(s, spike_source->start_ticks);
+        }
+    } else if (spike_source->mean_isi_ticks != 0) {
+        // Slow sources don't count down until they start
+        if (next_tick >= spike_source->start_ticks) {
+            _schedule_slow_source(s, next_tick);
+        } else {
+            _schedule_slow_source(s, spike_source->start_ticks);
+        }
+    }
+}
+
+//! \brief takes a source out of the schedule without updating its time to
+//!        spike, e.g. because its rate is about to change
+//! \param[in] s: the index of the source
+static inline void _unschedule_source(uint32_t s) {
+    if (schedule[s].place == IN_WHEEL) {
+        _wheel_remove(s);
+    } else if (schedule[s].place == IN_FAST_SOURCES) {
+        _fast_source_remove(s);
+    }
+    schedule[s].place = NOT_SCHEDULED;
+}
+
+//! \brief builds the schedule of all the sources from their parameters
+//! \param[in] next_tick: the next tick to be processed
+static void _schedule_sources(uint32_t next_tick) {
+    for (uint32_t slot = 0; slot < N_WHEEL_SLOTS; slot++) {
+        wheel[slot] = NO_SOURCE;
+    }
+    n_fast_sources = 0;
+    for (index_t s = 0; s < global_parameters.n_spike_sources; s++) {
+        _schedule_source(s, next_tick);
+    }
+}
+
+//! \brief takes all the sources out of the schedule, putting the whole time
+//!        to spike of each slow source back into its parameters
+//! \param[in] next_tick: the next tick to be processed
+static void _unschedule_sources(uint32_t next_tick) {
+    for (index_t s = 0; s < global_parameters.n_spike_sources; s++) {
+        spike_source_t *spike_source = &poisson_parameters[s];
+        uint8_t place = schedule[s].place;
+        if (!spike_source->is_fast_source &&
+                (place == IN_WHEEL || place == AFTER_END)) {
+
+            // The time to spike only counts down within the active window
+            uint32_t from_tick = next_tick;
+            if (from_tick < spike_source->start_ticks) {
+                from_tick = spike_source->start_ticks;
+            }
+            if (from_tick > spike_source->end_ticks) {
+                from_tick = spike_source->end_ticks;
+            }
+            spike_source->time_to_spike_ticks +=
+                (schedule[s].due_tick - from_tick) * ISI_SCALE_FACTOR;
+        }
+        schedule[s].place = NOT_SCHEDULED;
+    }
+    for (uint32_t slot = 0; slot < N_WHEEL_SLOTS; slot++) {
+        wheel[slot] = NO_SOURCE;
+    }
+    n_fast_sources = 0;
+}
+
 //! \brief entry method for reading the global parameters stored in Poisson
 //!        parameter region
 //! \param[in] address the absolute SDRAm memory address to which the
@@ -268,6 +566,9 @@ bool read_global_parameters(address_t address) {
         global_parameters.spike_source_seed[3]);
 
     validate_mars_kiss64_seed(global_parameters.spike_source_seed);
+    random_buffer_initialize(
+        &random_buffer, global_parameters.spike_source_seed,
+        ISI_SCALE_FACTOR, REAL_CONST(0.5));
 
     log_info(
         "\t spike sources = %u, starting at %u",
@@ -321,6 +622,94 @@ static bool read_poisson_parameters(address_t address) {
     return true;
 }
 
+//! \brief allocates the structures used to schedule the sources
+//! \return a boolean which is True if the structures were allocated
+//!         successfully or False otherwise
+static bool initialise_schedule() {
+    uint32_t n_sources = global_parameters.n_spike_sources;
+    if (n_sources >= NO_SOURCE) {
+        log_error("Too many sources (%u) to schedule", n_sources);
+        return false;
+    }
+    if (n_sources > 0) {
+        schedule = (source_schedule_t *) spin1_malloc(
+            n_sources * sizeof(source_schedule_t));
+        fast_sources = (uint16_t *) spin1_malloc(
+            n_sources * sizeof(uint16_t));
+        pending_rates = (REAL *) spin1_malloc(n_sources * sizeof(REAL));
+        pending_sources = (uint16_t *) spin1_malloc(
+            n_sources * sizeof(uint16_t));
+        applying_sources = (uint16_t *) spin1_malloc(
+            n_sources * sizeof(uint16_t));
+        uint32_t n_words = get_bit_field_size(n_sources);
+        pending_rate_set = (bit_field_t) spin1_malloc(
+            n_words * sizeof(uint32_t));
+        if (schedule == NULL || fast_sources == NULL || pending_rates == NULL
+                || pending_sources == NULL || applying_sources == NULL
+                || pending_rate_set == NULL) {
+            log_error("Failed to allocate the schedule of the sources");
+            return false;
+        }
+        clear_bit_field(pending_rate_set, n_words);
+    }
+    n_pending_rates = 0;
+    return true;
+}
+
+//! \brief callback for a completed read of a block of the rate schedule
+//! \param[in] unused: unused
+//! \param[in] tag: the DMA tag of the read
+void rate_schedule_dma_complete_callback(uint unused, uint tag) {
+    use(unused);
+    use(tag);
+    uint32_t block = rate_change_block_arriving++;
+    rate_change_block_held[block & 1] = block;
+}
+
+//! \brief starts reading a block of the rate schedule into DTCM, if there is
+//!        such a block
+//! \param[in] block: the index of the block to read
+static void _read_rate_change_block(uint32_t block) {
+    uint32_t first = block * RATE_CHANGES_PER_BLOCK;
+    if (first >= rate_schedule->n_changes) {
+        return;
+    }
+    uint32_t n_changes = rate_schedule->n_changes - first;
+    if (n_changes > RATE_CHANGES_PER_BLOCK) {
+        n_changes = RATE_CHANGES_PER_BLOCK;
+    }
+    rate_change_block_held[block & 1] = NO_BLOCK;
+    spin1_dma_transfer(
+        DMA_TAG_READ_RATE_SCHEDULE, &rate_schedule->changes[first],
+        rate_change_blocks[block & 1], DMA_READ,
+        n_changes * sizeof(rate_change_t));
+}
+
+//! \brief sets up the reading of the rate schedule, copying the first block
+//!        into DTCM and starting to read the second
+//! \param[in] address: the address of the rate schedule region
+static void initialise_rate_schedule(address_t address) {
+    rate_schedule = (rate_schedule_t *) address;
+    next_rate_change = 0;
+    log_info("Rate schedule has %u changes", rate_schedule->n_changes);
+    if (rate_schedule->n_changes == 0) {
+        return;
+    }
+
+    uint32_t n_changes = rate_schedule->n_changes;
+    if (n_changes > RATE_CHANGES_PER_BLOCK) {
+        n_changes = RATE_CHANGES_PER_BLOCK;
+    }
+    spin1_memcpy(rate_change_blocks[0], rate_schedule->changes,
+        n_changes * sizeof(rate_change_t));
+    rate_change_block_held[0] = 0;
+
+    simulation_dma_transfer_done_callback_on(
+        DMA_TAG_READ_RATE_SCHEDULE, rate_schedule_dma_complete_callback);
+    rate_change_block_arriving = 1;
+    _read_rate_change_block(1);
+}
+
 //! \brief Initialises the recording parts of the model
 //! \return True if recording initialisation is successful, false otherwise
 static bool initialise_recording(){
@@ -394,6 +783,16 @@ static bool initialize() {
         }
     }
 
+    // Schedule the sources from the first tick
+    if (!initialise_schedule()) {
+        return false;
+    }
+    _schedule_sources(0);
+
+    // Start streaming the scheduled rate changes
+    initialise_rate_schedule(
+        data_specification_get_region(RATE_SCHEDULE_REGION, ds_regions));
+
     // print spike sources for debug purposes
     // print_spike_sources();
 
@@ -436,6 +835,9 @@ void resume_callback() {
         }
     }
 
+    // Reschedule from the tick that will be run next
+    _schedule_sources(time + 1);
+
     log_info("Successfully resumed Poisson spike source at time: %u", time);
 
     // print spike sources for debug purposes
@@ -548,6 +950,221 @@ static inline void _record_spikes(uint32_t time) {
     }
 }
 
+//! \brief records and sends the spikes of a source
+//! \param[in] s: the index of the source
+//! \param[in] n_spikes: the number of spikes to send
+//! \param[in] timer_count: the timer count of the current tick
+static inline void _spike(uint32_t s, uint32_t n_spikes, uint timer_count) {
+
+    // Write spikes to out spikes
+    _mark_spike(s, n_spikes);
+
+    // If no key has been given, do not send spikes to fabric
+    if (global_parameters.has_key) {
+
+        // Send spikes
+        const uint32_t spike_key = global_parameters.key | s;
+        for (uint32_t index = 0; index < n_spikes; index++) {
+            _send_spike(spike_key, timer_count);
+        }
+    }
+}
+
+//! \brief sends the spikes of a fast source for this tick
+//! \param[in] s: the index of the source
+//! \param[in] timer_count: the timer count of the current tick
+static inline void _process_fast_source(uint32_t s, uint timer_count) {
+    spike_source_t *spike_source = &poisson_parameters[s];
+
+    // Get number of spikes to send this tick
+    uint32_t num_spikes = 0;
+    // If sqrt_lambda has been set then use the Gaussian algorithm for faster sources
+    if (REAL_COMPARE(spike_source->sqrt_lambda, >, REAL_CONST(0.0))) {
+        profiler_write_entry_disable_irq_fiq(PROFILER_ENTER | PROFILER_PROB_FUNC);
+        num_spikes = faster_spike_source_get_num_spikes(
+                spike_source->sqrt_lambda);
+        profiler_write_entry_disable_irq_fiq(PROFILER_EXIT | PROFILER_PROB_FUNC);
+    } else {
+        // Call the fast source Poisson algorithm
+        profiler_write_entry_disable_irq_fiq(PROFILER_ENTER | PROFILER_PROB_FUNC);
+        num_spikes = fast_spike_source_get_num_spikes(
+                spike_source->exp_minus_lambda);
+        profiler_write_entry_disable_irq_fiq(PROFILER_EXIT | PROFILER_PROB_FUNC);
+    }
+
+    log_debug("Generating %d spikes", num_spikes);
+
+    // If there are any
+    if (num_spikes > 0) {
+        _spike(s, num_spikes, timer_count);
+    }
+}
+
+//! \brief sends the spikes of a slow source that is due this tick, and
+//!        schedules its next spike
+//! \param[in] s: the index of the source
+//! \param[in] timer_count: the timer count of the current tick
+static inline void _process_slow_source(uint32_t s, uint timer_count) {
+    spike_source_t *spike_source = &poisson_parameters[s];
+
+    // Mark a spike while the "timer" is below the scale factor value
+    while (spike_source->time_to_spike_ticks < ISI_SCALE_FACTOR) {
+        _spike(s, 1, timer_count);
+
+        // Update time to spike (note, this might not get us back above
+        // the scale factor, particularly if the mean_isi is smaller)
+        profiler_write_entry_disable_irq_fiq(PROFILER_ENTER | PROFILER_PROB_FUNC);
+        spike_source->time_to_spike_ticks +=
+            slow_spike_source_get_time_to_spike(
+                spike_source->mean_isi_ticks);
+        profiler_write_entry_disable_irq_fiq(PROFILER_EXIT | PROFILER_PROB_FUNC);
+    }
+
+    // Now we have finished for this tick, subtract the scale factor and
+    // work out when the next spike is due
+    spike_source->time_to_spike_ticks -= ISI_SCALE_FACTOR;
+    _schedule_slow_source(s, time + 1);
+}
+
+//! \brief processes the sources in the slot of the timing wheel for this tick
+//! \param[in] timer_count: the timer count of the current tick
+static inline void _process_wheel(uint timer_count) {
+
+    // Take the whole slot, so that sources due on a later turn of the wheel
+    // can be put straight back in without being seen again
+    uint32_t slot = time & WHEEL_SLOT_MASK;
+    uint32_t s = wheel[slot];
+    wheel[slot] = NO_SOURCE;
+    while (s != NO_SOURCE) {
+        uint32_t next = schedule[s].next;
+        if (schedule[s].due_tick != time) {
+            _wheel_insert(s, schedule[s].due_tick);
+        } else if (poisson_parameters[s].is_fast_source) {
+            _fast_source_add(s);
+        } else {
+            _process_slow_source(s, timer_count);
+        }
+        s = next;
+    }
+}
+
+//! \brief sets the parameters of a source from a rate
+//! \param[in] sub_id: the index of the source on this core
+//! \param[in] rate: the REAL-valued rate in Hz, to be multiplied
+//!            to get per_tick values
+static void _set_spike_source_rate(uint32_t sub_id, REAL rate) {
+    REAL rate_per_tick = rate * global_parameters.seconds_per_tick;
+    log_debug("Setting rate of %u to %kHz (%k per tick)",
+            sub_id, rate, rate_per_tick);
+    if (rate_per_tick >= global_parameters.slow_rate_per_tick_cutoff) {
+        poisson_parameters[sub_id].is_fast_source = true;
+        if (rate_per_tick >= global_parameters.fast_rate_per_tick_cutoff) {
+            poisson_parameters[sub_id].sqrt_lambda =
+                    SQRT(rate_per_tick); // warning: sqrtk is untested...
+        } else {
+            poisson_parameters[sub_id].exp_minus_lambda =
+                    (UFRACT) EXP(-rate_per_tick);
+            poisson_parameters[sub_id].sqrt_lambda = REAL_CONST(0.0);
+        }
+    } else {
+        poisson_parameters[sub_id].is_fast_source = false;
+        poisson_parameters[sub_id].mean_isi_ticks =
+                (uint32_t) (REAL_CONST(1.0) / rate_per_tick);
+        poisson_parameters[sub_id].time_to_spike_ticks =
+                slow_spike_source_get_time_to_spike(
+                    poisson_parameters[sub_id].mean_isi_ticks);
+    }
+}
+
+//! \brief sets the parameters of a source from a scheduled rate change, in
+//!        the same way as the host writes them
+//! \param[in] change: the rate change
+static void _set_spike_source_parameters(const rate_change_t *change) {
+    spike_source_t *spike_source = &poisson_parameters[change->source];
+    spike_source->exp_minus_lambda = UFRACT_CONST(0.0);
+    spike_source->sqrt_lambda = REAL_CONST(0.0);
+    spike_source->mean_isi_ticks = 0;
+    switch (change->kind) {
+    case FASTER_RATE:
+        spike_source->is_fast_source = true;
+        spike_source->sqrt_lambda = kbits(change->value);
+        break;
+    case FAST_RATE:
+        spike_source->is_fast_source = true;
+        spike_source->exp_minus_lambda = ulrbits(change->value);
+        break;
+    default:
+        spike_source->is_fast_source = false;
+        spike_source->mean_isi_ticks = change->value;
+        spike_source->time_to_spike_ticks =
+            slow_spike_source_get_time_to_spike(change->value);
+        break;
+    }
+}
+
+//! \brief gets a change from the rate schedule, from DTCM if its block has
+//!        been read, or from SDRAM otherwise
+//! \param[in] index: the index of the change in the schedule
+//! \return the change
+static inline const rate_change_t *_rate_change(uint32_t index) {
+    uint32_t block = index / RATE_CHANGES_PER_BLOCK;
+    if (rate_change_block_held[block & 1] == block) {
+        return &rate_change_blocks[block & 1][index & RATE_CHANGE_BLOCK_MASK];
+    }
+    return &rate_schedule->changes[index];
+}
+
+//! \brief applies the scheduled rate changes which are due by this tick,
+//!        rescheduling the sources concerned from this tick
+static inline void _apply_rate_schedule() {
+    while (next_rate_change < rate_schedule->n_changes) {
+        const rate_change_t *change = _rate_change(next_rate_change);
+        if (change->tick > time) {
+            return;
+        }
+        if (change->source < global_parameters.n_spike_sources) {
+            _unschedule_source(change->source);
+            _set_spike_source_parameters(change);
+            _schedule_source(change->source, time);
+        }
+
+        // Once a block is used up, its buffer can take the block after next
+        next_rate_change++;
+        if ((next_rate_change & RATE_CHANGE_BLOCK_MASK) == 0) {
+            _read_rate_change_block(
+                (next_rate_change / RATE_CHANGES_PER_BLOCK) + 1);
+        }
+    }
+}
+
+//! \brief applies the rates received since the last tick, rescheduling the
+//!        sources concerned from this tick.  The rates are only taken with
+//!        interrupts disabled; they are converted with interrupts enabled, so
+//!        that many rates do not hold up the receipt of packets.
+static inline void _apply_pending_rates() {
+    uint cpsr = spin1_int_disable();
+    uint16_t *sources = pending_sources;
+    uint32_t n_sources = n_pending_rates;
+    pending_sources = applying_sources;
+    applying_sources = sources;
+    n_pending_rates = 0;
+    spin1_mode_restore(cpsr);
+
+    for (uint32_t i = 0; i < n_sources; i++) {
+        uint32_t s = sources[i];
+
+        // A rate that arrives after this goes in the new list
+        cpsr = spin1_int_disable();
+        REAL rate = pending_rates[s];
+        bit_field_clear(pending_rate_set, s);
+        spin1_mode_restore(cpsr);
+
+        _unschedule_source(s);
+        _set_spike_source_rate(s, rate);
+        _schedule_source(s, time);
+    }
+}
+
 //! \brief Timer interrupt callback
 //! \param[in] timer_count the number of times this call back has been
 //!            executed since start of simulation
@@ -564,6 +1181,13 @@ void timer_callback(uint timer_count, uint unused) {
 
     log_debug("Timer tick %u", time);
 
+    // Apply the scheduled rate changes, and then any rates that have been
+    // received since the last tick, so that received rates take precedence
+    _apply_rate_schedule();
+    if (n_pending_rates > 0) {
+        _apply_pending_rates();
+    }
+
     // If a fixed number of simulation ticks are specified and these have passed
     if (infinite_run != TRUE && time >= simulation_ticks) {
 
@@ -571,6 +1195,7 @@ void timer_callback(uint timer_count, uint unused) {
         simulation_handle_pause_resume(resume_callback);
 
         // rewrite poisson params to SDRAM for reading out if needed
+        _unschedule_sources(time);
         if (!store_poisson_parameters()){
             log_error("Failed to write poisson parameters to SDRAM");
             rt_error(RTE_SWERR);
@@ -596,83 +1221,19 @@ void timer_callback(uint timer_count, uint unused) {
     // Set the next expected time to wait for between spike sending
     expected_time = sv->cpu_clk * timer_period;
 
-    // Loop through spike sources
-    for (index_t s = 0; s < global_parameters.n_spike_sources; s++) {
-
-        // If this spike source is active this tick
-        spike_source_t *spike_source = &poisson_parameters[s];
+    // Handle the slow sources due this tick, and the fast sources starting
+    _process_wheel(timer_count);
 
-        // Choose between fast or slow spike sources
-        if (spike_source->is_fast_source) {
-            if (time >= spike_source->start_ticks
-                    && time < spike_source->end_ticks) {
-
-                // Get number of spikes to send this tick
-                uint32_t num_spikes = 0;
-                // If sqrt_lambda has been set then use the Gaussian algorithm for faster sources
-                if (REAL_COMPARE(spike_source->sqrt_lambda, >, REAL_CONST(0.0))) {
-                    profiler_write_entry_disable_irq_fiq(PROFILER_ENTER | PROFILER_PROB_FUNC);
-                    num_spikes = faster_spike_source_get_num_spikes(
-                            spike_source->sqrt_lambda);
-                    profiler_write_entry_disable_irq_fiq(PROFILER_EXIT | PROFILER_PROB_FUNC);
-                } else {
-                    // Call the fast source Poisson algorithm
-                    profiler_write_entry_disable_irq_fiq(PROFILER_ENTER | PROFILER_PROB_FUNC);
-                    num_spikes = fast_spike_source_get_num_spikes(
-                            spike_source->exp_minus_lambda);
-                    profiler_write_entry_disable_irq_fiq(PROFILER_EXIT | PROFILER_PROB_FUNC);
-                }
-
-                log_debug("Generating %d spikes", num_spikes);
-
-                // If there are any
-                if (num_spikes > 0) {
-
-                    // Write spikes to out spikes
-                    _mark_spike(s, num_spikes);
-
-                    // If no key has been given, do not send spikes to fabric
-                    if (global_parameters.has_key) {
-
-                        // Send spikes
-                        const uint32_t spike_key = global_parameters.key | s;
-                        for (uint32_t index = 0; index < num_spikes; index++) {
-                            _send_spike(spike_key, timer_count);
-                        }
-                    }
-                }
-            }
+    // Handle the active fast sources, dropping any that have ended; the last
+    // source is moved into the place of a dropped one, so don't move on then
+    uint32_t i = 0;
+    while (i < n_fast_sources) {
+        uint32_t s = fast_sources[i];
+        if (time >= poisson_parameters[s].end_ticks) {
+            _fast_source_remove(s);
         } else {
-            // Handle slow sources
-            if ((time >= spike_source->start_ticks)
-                    && (time < spike_source->end_ticks)
-                    && (spike_source->mean_isi_ticks != 0)) {
-
-                // Mark a spike while the "timer" is below the scale factor value
-                while (spike_source->time_to_spike_ticks < ISI_SCALE_FACTOR) {
-
-                    // Write spike to out_spikes
-                    _mark_spike(s, 1);
-
-                    // if no key has been given, do not send spike to fabric.
-                    if (global_parameters.has_key) {
-
-                        // Send package
-                        _send_spike(global_parameters.key | s, timer_count);
-                    }
-
-                    // Update time to spike (note, this might not get us back above
-                    // the scale factor, particularly if the mean_isi is smaller)
-                    profiler_write_entry_disable_irq_fiq(PROFILER_ENTER | PROFILER_PROB_FUNC);
-                    spike_source->time_to_spike_ticks +=
-                        slow_spike_source_get_time_to_spike(
-                            spike_source->mean_isi_ticks);
-                    profiler_write_entry_disable_irq_fiq(PROFILER_EXIT | PROFILER_PROB_FUNC);
-                }
-
-                // Now we have finished for this tick, subtract the scale factor
-                spike_source->time_to_spike_ticks -= ISI_SCALE_FACTOR;
-            }
+            _process_fast_source(s, timer_count);
+            i++;
         }
     }
 
@@ -687,54 +1248,68 @@ void timer_callback(uint timer_count, uint unused) {
         recording_do_timestep_update(time);
     }
 
+    // Draw the variates for the next tick while there is time to spare
+    random_buffer_fill(&random_buffer);
 }
 
-//! \brief set the spike source rate as required
+//! \brief queues a rate to be set at the start of the next tick; this must
+//!        be called with interrupts disabled
 //! \param[in] id, the ID of the source to be updated
-//! \param[in] rate, the REAL-valued rate in Hz, to be multiplied
-//!            to get per_tick values
-void set_spike_source_rate(uint32_t id, REAL rate) {
+//! \param[in] rate, the REAL-valued rate in Hz
+static inline void _queue_spike_source_rate(uint32_t id, REAL rate) {
     if ((id >= global_parameters.first_source_id) &&
             ((id - global_parameters.first_source_id) <
              global_parameters.n_spike_sources)) {
         uint32_t sub_id = id - global_parameters.first_source_id;
-        REAL rate_per_tick = rate * global_parameters.seconds_per_tick;
-        log_debug("Setting rate of %u (%u) to %kHz (%k per tick)",
-                id, sub_id, rate, rate_per_tick);
-        if (rate_per_tick >= global_parameters.slow_rate_per_tick_cutoff) {
-            poisson_parameters[sub_id].is_fast_source = true;
-            if (rate_per_tick >= global_parameters.fast_rate_per_tick_cutoff) {
-                poisson_parameters[sub_id].sqrt_lambda =
-                        SQRT(rate_per_tick); // warning: sqrtk is untested...
-            } else {
-                poisson_parameters[sub_id].exp_minus_lambda =
-                        (UFRACT) EXP(-rate_per_tick);
-                poisson_parameters[sub_id].sqrt_lambda = REAL_CONST(0.0);
-            }
-        } else {
-            poisson_parameters[sub_id].is_fast_source = false;
-            poisson_parameters[sub_id].mean_isi_ticks =
-                    (uint32_t) (REAL_CONST(1.0) / rate_per_tick);
-            poisson_parameters[sub_id].time_to_spike_ticks =
-                    slow_spike_source_get_time_to_spike(
-                        poisson_parameters[sub_id].mean_isi_ticks);
+        pending_rates[sub_id] = rate;
+        if (!bit_field_test(pending_rate_set, sub_id)) {
+            bit_field_set(pending_rate_set, sub_id);
+            pending_sources[n_pending_rates++] = sub_id;
         }
     }
 }
 
-// Is this function actually used any more?
+//! \brief set the spike source rate as required; the change is made at the
+//!        start of the next tick
+//! \param[in] id, the ID of the source to be updated
+//! \param[in] rate, the REAL-valued rate in Hz, to be multiplied
+//!            to get per_tick values
+void set_spike_source_rate(uint32_t id, REAL rate) {
+    uint cpsr = spin1_int_disable();
+    _queue_spike_source_rate(id, rate);
+    spin1_mode_restore(cpsr);
+}
+
+//! \brief SDP callback used to set many rates in one message (see
+//!        rate_command)
 void sdp_packet_callback(uint mailbox, uint port) {
     use(port);
     sdp_msg_t *msg = (sdp_msg_t *) mailbox;
     uint32_t *data = (uint32_t *) &(msg->cmd_rc);
-
-    uint32_t n_items = data[0];
-    data = &(data[1]);
-    for (uint32_t item = 0; item < n_items; item++) {
-        uint32_t id = data[(item * 2)];
-        REAL rate = kbits(data[(item * 2) + 1]);
-        set_spike_source_rate(id, rate);
+    uint32_t n_words = (msg->length - SDP_HEADER_BYTES) >> 2;
+
+    uint cpsr = spin1_int_disable();
+    if ((n_words >= 2) && (data[0] == RATES_LIST)
+            && (data[1] <= ((n_words - 2) >> 1))) {
+        uint32_t n_items = data[1];
+        uint32_t *items = &(data[2]);
+        for (uint32_t item = 0; item < n_items; item++) {
+            uint32_t id = items[(item * 2)];
+            REAL rate = kbits(items[(item * 2) + 1]);
+            _queue_spike_source_rate(id, rate);
+        }
+    } else if ((n_words >= 3) && (data[0] == RATES_RANGE)
+            && (data[2] <= (n_words - 3))) {
+        uint32_t first_id = data[1];
+        uint32_t n_items = data[2];
+        uint32_t *rates = &(data[3]);
+        for (uint32_t item = 0; item < n_items; item++) {
+            _queue_spike_source_rate(first_id + item, kbits(rates[item]));
+        }
+    } else {
+        log_error("Ignoring malformed rate message of %u words", n_words);
     }
+    spin1_mode_restore(cpsr);
     spin1_msg_free(msg);
 }
 
@@ -765,6 +1340,7 @@ void c_main(void) {
     spin1_callback_on(TIMER_TICK, timer_callback, TIMER);
     spin1_callback_on(
         MCPL_PACKET_RECEIVED, multicast_packet_callback, MULTICAST);
+    simulation_sdp_callback_on(POISSON_RATE_SDP_PORT, sdp_packet_callback);
 
     simulation_run();
 }
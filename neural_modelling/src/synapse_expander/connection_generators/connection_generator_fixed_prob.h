@@ -67,6 +67,13 @@ void connection_generator_fixed_prob_free(void *data) {
     sark_free(data);
 }
 
+void connection_generator_fixed_prob_restart(
+        void *data, uint32_t pre_neuron_index) {
+    struct fixed_prob *params =
+            (struct fixed_prob *) data;
+    rng_restart(params->rng, pre_neuron_index);
+}
+
 uint32_t connection_generator_fixed_prob_generate(
         void *data,  uint32_t pre_slice_start, uint32_t pre_slice_count,
         uint32_t pre_neuron_index, uint32_t post_slice_start,
@@ -67,6 +67,13 @@ void param_generator_exponential_free(void *data) {
     sark_free(data);
 }
 
+void param_generator_exponential_restart(
+        void *data, uint32_t pre_neuron_index) {
+    struct param_generator_exponential *params =
+            (struct param_generator_exponential *) data;
+    rng_restart(params->rng, pre_neuron_index);
+}
+
 void param_generator_exponential_generate(
         void *data, uint32_t n_synapses, uint32_t pre_neuron_index,
         uint16_t *indices, accum *values) {
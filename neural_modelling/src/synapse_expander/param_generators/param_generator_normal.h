@@ -69,6 +69,13 @@ void param_generator_normal_free(void *data) {
     sark_free(data);
 }
 
+void param_generator_normal_restart(
+        void *data, uint32_t pre_neuron_index) {
+    struct param_generator_normal *params =
+            (struct param_generator_normal *) data;
+    rng_restart(params->rng, pre_neuron_index);
+}
+
 void param_generator_normal_generate(
         void *data, uint32_t n_synapses, uint32_t pre_neuron_index,
         uint16_t *indices, accum *values) {
@@ -75,6 +75,13 @@ void param_generator_normal_clipped_free(void *data) {
     sark_free(data);
 }
 
+void param_generator_normal_clipped_restart(
+        void *data, uint32_t pre_neuron_index) {
+    struct param_generator_normal_clipped *params =
+            (struct param_generator_normal_clipped *) data;
+    rng_restart(params->rng, pre_neuron_index);
+}
+
 void param_generator_normal_clipped_generate(
         void *data, uint32_t n_synapses, uint32_t pre_neuron_index,
         uint16_t *indices, accum *values) {
@@ -29,15 +29,36 @@
  */
 struct rng {
     mars_kiss64_seed_t seed;
+    mars_kiss64_seed_t base_seed;
 };
 
+/**
+ *! \brief A multiplier that spreads consecutive stream numbers over the
+ *!        range of a word (the golden ratio in 0.32 fixed point)
+ */
+#define STREAM_SPREAD 0x9E3779B9
+
 rng_t rng_init(address_t *region) {
     struct rng *rng = (struct rng *) spin1_malloc(sizeof(struct rng));
     spin1_memcpy(rng->seed, *region, sizeof(mars_kiss64_seed_t));
+    spin1_memcpy(rng->base_seed, *region, sizeof(mars_kiss64_seed_t));
     *region += sizeof(mars_kiss64_seed_t) >> 2;
     return rng;
 }
 
+void rng_restart(rng_t rng, uint32_t stream) {
+    uint32_t spread = (stream + 1) * STREAM_SPREAD;
+    rng->seed[0] = rng->base_seed[0] + spread;
+    rng->seed[1] = rng->base_seed[1] ^ spread;
+    rng->seed[2] = rng->base_seed[2] ^ stream;
+    rng->seed[3] = rng->base_seed[3];
+    validate_mars_kiss64_seed(rng->seed);
+
+    // Nearby streams start from similar seeds, so move them apart
+    mars_kiss64_seed(rng->seed);
+    mars_kiss64_seed(rng->seed);
+}
+
 uint32_t rng_generator(rng_t rng) {
     return mars_kiss64_seed(rng->seed);
 }
@@ -19,7 +19,11 @@
  *! \file
  *! \brief Random number generator interface
  */
+#ifndef __RNG_H__
+#define __RNG_H__
+
 #include <common-typedefs.h>
+#include <stdfix.h>
 
 /**
  *! \brief Random number generator "object"
@@ -35,6 +39,15 @@ typedef struct rng* rng_t;
  */
 rng_t rng_init(address_t *region);
 
+/**
+ *! \brief Restart the random number generator at the start of a repeatable
+ *!        stream of numbers; the same stream always gives the same numbers,
+ *!        and different streams give different numbers
+ *! \param[in] rng The random number generator instance to restart
+ *! \param[in] stream The number of the stream to start
+ */
+void rng_restart(rng_t rng, uint32_t stream);
+
 /**
  *! \brief Generate a random number
  *! \param[in] rng The random number generator instance to generate from
@@ -61,3 +74,5 @@ accum rng_normal(rng_t rng);
  *! \param[in] generator The generator to free
  */
 void rng_free(rng_t rng);
+
+#endif // __RNG_H__
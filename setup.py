@@ -14,7 +14,7 @@
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 import os
-from setuptools import setup
+from setuptools import setup, Extension
 try:
     from collections.abc import defaultdict
 except ImportError:
@@ -61,6 +61,12 @@ for dirname, dirnames, filenames in os.walk(main_package_dir):
                 main_package, dirname[start:].replace(os.sep, '.'))
             package_data[package].append(filename)
 
+# The packing of synaptic rows is done with numpy if this can't be built
+row_packing = Extension(
+    "spynnaker.pyNN.models.neuron.synapse_io._row_packing",
+    sources=["spynnaker/pyNN/models/neuron/synapse_io/_row_packing.c"],
+    optional=True)
+
 setup(
     name="sPyNNaker",
     version=__version__,
@@ -68,6 +74,7 @@ setup(
     url="https://github.com/SpiNNakerManchester/SpyNNaker",
     packages=packages,
     package_data=package_data,
+    ext_modules=[row_packing],
     install_requires=install_requires,
     maintainer="SpiNNakerTeam",
     maintainer_email="spinnakerusers@googlegroups.com"
@@ -13,22 +13,53 @@
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+import struct
 from spinn_utilities.overrides import overrides
 from spinnman.messages.eieio import EIEIOType
 from spinnman.messages.eieio.data_messages import EIEIODataMessage
+from spinnman.messages.sdp import SDPFlag, SDPHeader, SDPMessage
 from data_specification.enums import DataType
 from spinn_front_end_common.utilities.connections import LiveEventConnection
 from spinn_front_end_common.utilities.exceptions import ConfigurationException
 from spinn_front_end_common.utilities.constants import NOTIFY_PORT
 from spinnman.constants import SCP_SCAMP_PORT
+from spynnaker.pyNN.utilities.constants import POISSON_RATE_SDP_PORT
 from decimal import Decimal
 
 _MAX_RATES_PER_PACKET = 32
 
+# The command of an SDP message of the rates of consecutive neurons, which
+# is followed by the first neuron ID, the number of rates and the rates
+_RATES_RANGE = 1
+_RATES_RANGE_HEADER = struct.Struct("<III")
+
+# The words of data that fit in an SDP message after the SDP header
+_SDP_DATA_WORDS = 68
+_MAX_RATES_PER_RANGE_MESSAGE = _SDP_DATA_WORDS - 3
+
+# The SDP source of messages sent from the host
+_SDP_HOST_TAG = 0xFF
+_SDP_HOST_PORT = 7
+_SDP_HOST_CPU = 31
+
+# The placements of the cores of an application vertex and their atoms
+_PLACEMENTS_AND_ATOMS_QUERY = (
+    "SELECT lo_atom, hi_atom, chip_x, chip_y, chip_p"
+    " FROM Application_vertices"
+    " JOIN graph_mapper_vertex"
+    " ON graph_mapper_vertex.application_vertex_id ="
+    " Application_vertices.vertex_id"
+    " JOIN Placements"
+    " ON Placements.vertex_id = graph_mapper_vertex.machine_vertex_id"
+    " WHERE Application_vertices.vertex_label = ?"
+    " ORDER BY lo_atom")
+
 
 class SpynnakerPoissonControlConnection(LiveEventConnection):
     __slots__ = [
-        "__control_label_extension"]
+        "__control_label_extension",
+        "__poisson_cores",
+        "__poisson_labels"]
 
     def __init__(
             self, poisson_labels=None, local_host=None, local_port=NOTIFY_PORT,
@@ -61,10 +92,33 @@ class SpynnakerPoissonControlConnection(LiveEventConnection):
             local_host=local_host, local_port=local_port)
 
         self.__control_label_extension = control_label_extension
+        self.__poisson_labels = list()
+        if poisson_labels is not None:
+            self.__poisson_labels.extend(poisson_labels)
+        self.__poisson_cores = dict()
+        self.add_database_callback(self.__read_poisson_cores)
 
     def add_poisson_label(self, label):
+        self.__poisson_labels.append(label)
         self.add_send_label(self._control_label(label))
 
+    def __read_poisson_cores(self, db_reader):
+        """ Read where the cores of each Poisson source are, and the atoms\
+            each of them has, so that rates can be sent to them directly
+        """
+        cursor = db_reader.cursor
+        self.__poisson_cores = dict()
+        for label in self.__poisson_labels:
+            cursor.execute(_PLACEMENTS_AND_ATOMS_QUERY, (label, ))
+            self.__poisson_cores[label] = [
+                (lo_atom, hi_atom, x, y, p, db_reader.get_ip_address(x, y))
+                for lo_atom, hi_atom, x, y, p in cursor.fetchall()]
+
+    def _poisson_label(self, label):
+        if label.endswith(self.__control_label_extension):
+            return label[:-len(self.__control_label_extension)]
+        return label
+
     def _control_label(self, label):
         return "{}{}".format(label, self.__control_label_extension)
 
@@ -124,6 +178,59 @@ class SpynnakerPoissonControlConnection(LiveEventConnection):
                 self._get_sdp_data(message, x, y, p),
                 (ip_address, SCP_SCAMP_PORT))
 
+    def set_rate_range(self, label, first_neuron_id, rates):
+        """ Set the rates of consecutive Poisson neurons within a Poisson\
+            source.  The rates are sent directly to the cores of the source\
+            in as few messages as possible, rather than as one packet per\
+            rate, and the cores apply them at the start of their next\
+            timestep.
+
+        :param label: The label of the Population to set the rates of
+        :param first_neuron_id: The ID of the neuron of the first rate
+        :param rates: The rates to set in Hz
+        :type rates: iterable of float
+        """
+        poisson_label = self._poisson_label(label)
+        if poisson_label not in self.__poisson_cores:
+            raise ConfigurationException(
+                "The cores of {} are not known; has the simulation been"
+                " started?".format(poisson_label))
+        scale = DataType.S1615.scale  # @UndefinedVariable
+        fixed_rates = [
+            int(round(Decimal(str(rate)) * scale)) & 0xFFFFFFFF
+            for rate in rates]
+        last_neuron_id = first_neuron_id + len(fixed_rates) - 1
+        for lo_atom, hi_atom, x, y, p, ip_address in \
+                self.__poisson_cores[poisson_label]:
+            start = max(lo_atom, first_neuron_id)
+            end = min(hi_atom, last_neuron_id) + 1
+            if start >= end:
+                continue
+            for message in self._assemble_range_messages(
+                    x, y, p, start, fixed_rates[
+                        start - first_neuron_id:end - first_neuron_id]):
+                self._sender_connection.send_to(
+                    b"\0\0" + message.bytestring,
+                    (ip_address, SCP_SCAMP_PORT))
+
+    @staticmethod
+    def _assemble_range_messages(x, y, p, first_neuron_id, fixed_rates):
+        messages = list()
+        for pos in range(
+                0, len(fixed_rates), _MAX_RATES_PER_RANGE_MESSAGE):
+            chunk = fixed_rates[pos:pos + _MAX_RATES_PER_RANGE_MESSAGE]
+            data = _RATES_RANGE_HEADER.pack(
+                _RATES_RANGE, first_neuron_id + pos, len(chunk))
+            data += struct.pack("<{}I".format(len(chunk)), *chunk)
+            messages.append(SDPMessage(SDPHeader(
+                flags=SDPFlag.REPLY_NOT_EXPECTED, tag=_SDP_HOST_TAG,
+                destination_port=POISSON_RATE_SDP_PORT,
+                destination_cpu=p, destination_chip_x=x,
+                destination_chip_y=y, source_port=_SDP_HOST_PORT,
+                source_cpu=_SDP_HOST_CPU, source_chip_x=0, source_chip_y=0),
+                data=data))
+        return messages
+
     @staticmethod
     def _assemble_message(id_to_key_map, neuron_id_rates, pos):
         scale = DataType.S1615.scale  # @UndefinedVariable
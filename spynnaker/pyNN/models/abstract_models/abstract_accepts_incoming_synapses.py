@@ -61,6 +61,20 @@ class AbstractAcceptsIncomingSynapses(object):
         """ Get the connections from the machine post-run.
         """
 
+    @abstractmethod
+    def update_weights_on_machine(
+            self, transceiver, placement, edge, graph_mapper, routing_infos,
+            synapse_information):
+        # pylint: disable=too-many-arguments
+        """ Write the weights now in the synapse information into the\
+            synapses of an edge that are on the machine post-run.
+
+        :return: True if the weights were written, or False if the\
+            synapses will instead be generated and loaded again before the\
+            next run
+        :rtype: bool
+        """
+
     @abstractmethod
     def clear_connection_cache(self):
         """ Clear the connection data stored in the vertex so far.
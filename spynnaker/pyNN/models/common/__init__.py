@@ -22,9 +22,12 @@ from .recording_utils import (
     get_buffer_sizes, get_data, get_recording_region_size_in_bytes,
     needs_buffering, pull_off_cached_lists)
 from .simple_population_settable import SimplePopulationSettable
+from .timestep_telemetry_recorder import (
+    TimestepTelemetryRecorder, TELEMETRY_DTYPE)
 
 __all__ = ["AbstractNeuronRecordable", "AbstractSpikeRecordable",
            "EIEIOSpikeRecorder", "NeuronRecorder", "MultiSpikeRecorder",
-           "SimplePopulationSettable", "get_buffer_sizes", "get_data",
+           "SimplePopulationSettable", "TELEMETRY_DTYPE",
+           "TimestepTelemetryRecorder", "get_buffer_sizes", "get_data",
            "needs_buffering", "get_recording_region_size_in_bytes",
            "pull_off_cached_lists", ]
@@ -0,0 +1,121 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import logging
+import numpy
+from spinn_utilities.progress_bar import ProgressBar
+from pacman.model.resources.variable_sdram import VariableSDRAM
+
+logger = logging.getLogger(__name__)
+
+#: The fields of each timestep recorded on the machine, in order
+TELEMETRY_FIELDS = (
+    "time", "timer_callback_cycles", "n_spikes_received", "n_rows_fetched",
+    "dma_wait_cycles", "max_input_queue_depth")
+
+#: The type of the array returned, with the location of each core added
+TELEMETRY_DTYPE = numpy.dtype(
+    [("x", "<u4"), ("y", "<u4"), ("p", "<u4"), ("lo_atom", "<u4")] +
+    [(field, "<u4") for field in TELEMETRY_FIELDS])
+
+
+class TimestepTelemetryRecorder(object):
+    """ Records the timing and load of every timestep on each core of a\
+        population, to show how close each timestep is to its deadline.
+    """
+    __slots__ = ["__recording"]
+
+    N_BYTES_PER_RECORD = 4 * len(TELEMETRY_FIELDS)
+    SARK_BLOCK_SIZE = 8  # Seen in sark.c
+
+    def __init__(self):
+        self.__recording = False
+
+    @property
+    def is_recording(self):
+        return self.__recording
+
+    def set_recording(self, new_state):
+        self.__recording = new_state
+
+    def get_buffered_sdram_per_timestep(self):
+        if not self.__recording:
+            return 0
+        return self.N_BYTES_PER_RECORD
+
+    def get_buffered_sdram(self, n_machine_time_steps):
+        return self.get_buffered_sdram_per_timestep() * n_machine_time_steps
+
+    def get_variable_sdram_usage(self):
+        if not self.__recording:
+            return VariableSDRAM(0, 0)
+        return VariableSDRAM(self.SARK_BLOCK_SIZE, self.N_BYTES_PER_RECORD)
+
+    def get_dtcm_usage_in_bytes(self):
+        # channel, flag, and the record itself
+        return 8 + self.N_BYTES_PER_RECORD
+
+    def get_telemetry(
+            self, label, buffer_manager, region, placements, graph_mapper,
+            application_vertex):
+        """ Read the telemetry of each core of a population.
+
+        :param label: vertex label
+        :param buffer_manager: the manager for buffered data
+        :param region: the DSG region ID used for this data
+        :param placements: the placements object
+        :param graph_mapper: \
+            the mapping between application and machine vertices
+        :param application_vertex:
+        :return: \
+            an array with a row per core per recorded timestep, with the\
+            fields in TELEMETRY_DTYPE, ordered by core then by time
+        :rtype: numpy.ndarray
+        """
+        vertices = graph_mapper.get_machine_vertices(application_vertex)
+        progress = ProgressBar(
+            vertices, "Getting timestep telemetry for {}".format(label))
+        missing_str = ""
+        data = list()
+        for vertex in progress.over(vertices):
+            placement = placements.get_placement_of_vertex(vertex)
+            vertex_slice = graph_mapper.get_slice(vertex)
+
+            # for buffering output info is taken form the buffer manager
+            record_raw, missing_data = buffer_manager.get_data_by_placement(
+                placement, region)
+            if missing_data:
+                missing_str += "({}, {}, {}); ".format(
+                    placement.x, placement.y, placement.p)
+            record = numpy.asarray(record_raw, dtype="uint8").view(
+                dtype="<u4").reshape((-1, len(TELEMETRY_FIELDS)))
+
+            fragment = numpy.zeros(len(record), dtype=TELEMETRY_DTYPE)
+            fragment["x"] = placement.x
+            fragment["y"] = placement.y
+            fragment["p"] = placement.p
+            fragment["lo_atom"] = vertex_slice.lo_atom
+            for i, field in enumerate(TELEMETRY_FIELDS):
+                fragment[field] = record[:, i]
+            data.append(fragment)
+
+        if len(missing_str) > 0:
+            logger.warning(
+                "Population {} is missing timestep telemetry in region {} "
+                "from the following cores: {}".format(
+                    label, region, missing_str))
+        if not data:
+            return numpy.zeros(0, dtype=TELEMETRY_DTYPE)
+        return numpy.concatenate(data)
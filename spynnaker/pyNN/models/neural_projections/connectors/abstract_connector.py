@@ -56,7 +56,21 @@ class AbstractConnector(with_metaclass(AbstractBase, object)):
         "__space",
         "__verbose",
         "_weights",
-        "__param_seeds"]
+        "__param_seeds",
+        "__slice_seeds"]
+
+    #: The slots that do not describe the connections made, such as caches
+    #: keyed by the ids of objects, and so are not part of the key of a
+    #: cached synaptic block
+    _BLOCK_KEY_EXCLUDED = (
+        "__pre_population", "__post_population", "__n_clipped_delays",
+        "_rng", "__safe", "__space", "__verbose", "__param_seeds",
+        "__slice_seeds")
+
+    #: Whether the connections made are drawn from the random number
+    #: generator of the connector, so that they are only the same in each
+    #: run if it is seeded
+    _DRAWS_RANDOM_NUMBERS = False
 
     def __init__(self, safe=True, verbose=False, rng=None):
         self.__safe = safe
@@ -72,6 +86,7 @@ class AbstractConnector(with_metaclass(AbstractBase, object)):
         self.__n_clipped_delays = 0
         self.__min_delay = 0
         self.__param_seeds = dict()
+        self.__slice_seeds = dict()
 
     def set_space(self, space):
         """ Set the space object (allowed after instantiation).
@@ -257,13 +272,31 @@ class AbstractConnector(with_metaclass(AbstractBase, object)):
         regexpr = re.compile(r'.*d\[\d*\].*')
         return regexpr.match(d_expression)
 
-    def _generate_random_values(
-            self, values, n_connections, pre_vertex_slice, post_vertex_slice):
+    def __get_param_seed(self, values, pre_vertex_slice, post_vertex_slice):
         key = (id(pre_vertex_slice), id(post_vertex_slice), id(values))
         seed = self.__param_seeds.get(key, None)
         if seed is None:
             seed = int(values.rng.next() * 0x7FFFFFFF)
             self.__param_seeds[key] = seed
+        return seed
+
+    def _get_slice_rng(self, pre_vertex_slice, post_vertex_slice):
+        """ Get the random number generator of the connections between a\
+            pair of slices; this gives the same numbers each time it is\
+            got, however many other blocks have been made since.  Connectors\
+            that use this must get it in prepare_synaptic_block.
+        """
+        key = (id(pre_vertex_slice), id(post_vertex_slice))
+        seed = self.__slice_seeds.get(key, None)
+        if seed is None:
+            seed = int(self._rng.next() * 0x7FFFFFFF)
+            self.__slice_seeds[key] = seed
+        return get_simulator().get_pynn_NumpyRNG()(seed)
+
+    def _generate_random_values(
+            self, values, n_connections, pre_vertex_slice, post_vertex_slice):
+        seed = self.__get_param_seed(
+            values, pre_vertex_slice, post_vertex_slice)
         new_rng = get_simulator().get_pynn_NumpyRNG()(seed)
         copy_rd = get_simulator().get_random_distribution()(
             values.name, parameters_pos=None, rng=new_rng,
@@ -321,6 +354,21 @@ class AbstractConnector(with_metaclass(AbstractBase, object)):
                         self.__post_population.label))
         return numpy.abs(weights)
 
+    def generate_replacement_weights(
+            self, weights, n_connections, pre_vertex_slice, post_vertex_slice):
+        """ Generate new weights for connections that have already been\
+            made between a pair of slices, when only the weights of a\
+            projection change
+
+        :return: The weights, or None if the weights depend on the\
+            connections themselves, so the connections must be made again
+        """
+        if not (numpy.isscalar(weights) or
+                get_simulator().is_a_pynn_random(weights)):
+            return None
+        return self._generate_weights(
+            weights, n_connections, None, pre_vertex_slice, post_vertex_slice)
+
     def _clip_delays(self, delays):
         """ Clip delay values, keeping track of how many have been clipped.
         """
@@ -347,6 +395,36 @@ class AbstractConnector(with_metaclass(AbstractBase, object)):
 
         return self._clip_delays(delays)
 
+    def prepare_synaptic_block(
+            self, weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice):
+        """ Draw the random seeds of a synaptic block and fill anything\
+            cached by the connector that the block needs.  Once this has\
+            been done for each block in turn, the blocks can be created in\
+            any order, or at the same time, with the same results.
+        """
+        # pylint: disable=too-many-arguments, unused-argument
+        for values in (weights, delays):
+            if get_simulator().is_a_pynn_random(values):
+                self.__get_param_seed(
+                    values, pre_vertex_slice, post_vertex_slice)
+
+    def get_block_seeds(
+            self, weights, delays, pre_vertex_slice, post_vertex_slice):
+        """ Get the seeds drawn by prepare_synaptic_block for a pair of\
+            slices
+
+        :return: the seeds of the connector, the weights and the delays,\
+            each None if there is none
+        """
+        return (
+            self.__slice_seeds.get(
+                (id(pre_vertex_slice), id(post_vertex_slice))),
+            self.__param_seeds.get(
+                (id(pre_vertex_slice), id(post_vertex_slice), id(weights))),
+            self.__param_seeds.get(
+                (id(pre_vertex_slice), id(post_vertex_slice), id(delays))))
+
     @abstractmethod
     def create_synaptic_block(
             self, weights, delays, pre_slices, pre_slice_index, post_slices,
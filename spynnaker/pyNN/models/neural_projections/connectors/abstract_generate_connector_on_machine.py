@@ -75,6 +75,8 @@ class AbstractGenerateConnectorOnMachine(with_metaclass(
         "__connector_seed"
     ]
 
+    _BLOCK_KEY_EXCLUDED = ("__delay_seed", "__weight_seed", "__connector_seed")
+
     def __init__(self, safe=True, verbose=False):
         AbstractConnector.__init__(self, safe=safe, verbose=verbose)
         self.__delay_seed = dict()
@@ -182,6 +184,17 @@ class AbstractGenerateConnectorOnMachine(with_metaclass(
                 self._generate_lists_on_machine(weights) and
                 self._generate_lists_on_machine(delays))
 
+    def generate_procedurally(self, weights, delays):
+        """ Determine if the rows of this instance can be generated on the\
+            machine each time a spike arrives instead of being stored.
+
+        Default implementation returns False
+
+        :rtype: bool
+        """
+        # pylint: disable=unused-argument
+        return False
+
     def gen_weights_id(self, weights):
         """ Get the id of the weight generator on the machine
 
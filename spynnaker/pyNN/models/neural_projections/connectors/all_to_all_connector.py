@@ -29,9 +29,11 @@ class AllToAllConnector(AbstractGenerateConnectorOnMachine):
     """
 
     __slots__ = [
-        "__allow_self_connections"]
+        "__allow_self_connections",
+        "__procedural"]
 
-    def __init__(self, allow_self_connections=True, safe=True, verbose=None):
+    def __init__(self, allow_self_connections=True, safe=True, verbose=None,
+                 procedural=False):
         """
         :param allow_self_connections:
             if the connector is used to connect a\
@@ -39,9 +41,15 @@ class AllToAllConnector(AbstractGenerateConnectorOnMachine):
             allowed to connect to itself, or only to other neurons in the\
             Population.
         :type allow_self_connections: bool
+        :param procedural:
+            if True, the rows of the connections are generated on the\
+            machine each time a spike arrives rather than stored in SDRAM,\
+            where the weights, delays and synapse dynamics allow this
+        :type procedural: bool
         """
         super(AllToAllConnector, self).__init__(safe, verbose)
         self.__allow_self_connections = allow_self_connections
+        self.__procedural = procedural
 
     def _connection_slices(self, pre_vertex_slice, post_vertex_slice):
         """ Get a slice of the overall set of connections.
@@ -158,3 +166,17 @@ class AllToAllConnector(AbstractGenerateConnectorOnMachine):
                gen_connector_params_size_in_bytes)
     def gen_connector_params_size_in_bytes(self):
         return 4
+
+    @overrides(AbstractGenerateConnectorOnMachine.generate_procedurally)
+    def generate_procedurally(self, weights, delays):
+        return (self.__procedural and
+                self.generate_on_machine(weights, delays))
+
+    @property
+    def procedural(self):
+        """ Whether the rows of the connections are to be generated each time\
+            a spike arrives
+
+        :rtype: bool
+        """
+        return self.__procedural
@@ -42,6 +42,8 @@ class DistanceDependentProbabilityConnector(AbstractConnector):
         "__d_expression",
         "__probs"]
 
+    _DRAWS_RANDOM_NUMBERS = True
+
     def __init__(
             self, d_expression, allow_self_connections=True, safe=True,
             verbose=False, n_connections=None, rng=None):
@@ -147,6 +149,15 @@ class DistanceDependentProbabilityConnector(AbstractConnector):
                 self._n_pre_neurons * self._n_post_neurons,
                 numpy.amax(self.__probs)))
 
+    @overrides(AbstractConnector.prepare_synaptic_block)
+    def prepare_synaptic_block(
+            self, weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice):
+        AbstractConnector.prepare_synaptic_block(
+            self, weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice)
+        self._get_slice_rng(pre_vertex_slice, post_vertex_slice)
+
     @overrides(AbstractConnector.create_synaptic_block)
     def create_synaptic_block(
             self, weights, delays, pre_slices, pre_slice_index, post_slices,
@@ -156,7 +167,8 @@ class DistanceDependentProbabilityConnector(AbstractConnector):
         probs = self.__probs[
             pre_vertex_slice.as_slice, post_vertex_slice.as_slice].reshape(-1)
         n_items = pre_vertex_slice.n_atoms * post_vertex_slice.n_atoms
-        items = self._rng.next(n_items)
+        items = self._get_slice_rng(
+            pre_vertex_slice, post_vertex_slice).next(n_items)
 
         # If self connections are not allowed, remove the possibility of
         # self connections by setting them to a value of infinity
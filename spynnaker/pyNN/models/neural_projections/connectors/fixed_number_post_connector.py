@@ -40,6 +40,10 @@ class FixedNumberPostConnector(AbstractGenerateConnectorOnMachine):
         "__with_replacement",
         "__post_connector_seed"]
 
+    _BLOCK_KEY_EXCLUDED = ("__post_connector_seed", )
+
+    _DRAWS_RANDOM_NUMBERS = True
+
     def __init__(
             self, n, allow_self_connections=True, with_replacement=False,
             safe=True, verbose=False, rng=None):
@@ -184,6 +188,15 @@ class FixedNumberPostConnector(AbstractGenerateConnectorOnMachine):
         n_connections = self._n_pre_neurons * self.__n_post
         return self._get_weight_maximum(weights, n_connections)
 
+    @overrides(AbstractConnector.prepare_synaptic_block)
+    def prepare_synaptic_block(
+            self, weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice):
+        super(FixedNumberPostConnector, self).prepare_synaptic_block(
+            weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice)
+        self._get_post_neurons()
+
     @overrides(AbstractConnector.create_synaptic_block)
     def create_synaptic_block(
             self, weights, delays, pre_slices, pre_slice_index, post_slices,
@@ -39,6 +39,10 @@ class FixedNumberPreConnector(AbstractGenerateConnectorOnMachine):
         "__with_replacement",
         "__pre_connector_seed"]
 
+    _BLOCK_KEY_EXCLUDED = ("__pre_connector_seed", )
+
+    _DRAWS_RANDOM_NUMBERS = True
+
     def __init__(
             self, n, allow_self_connections=True, with_replacement=False,
             safe=True, verbose=False, rng=None):
@@ -189,6 +193,15 @@ class FixedNumberPreConnector(AbstractGenerateConnectorOnMachine):
         return self._get_weight_maximum(
             weights, self.__n_pre * self._n_post_neurons)
 
+    @overrides(AbstractConnector.prepare_synaptic_block)
+    def prepare_synaptic_block(
+            self, weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice):
+        super(FixedNumberPreConnector, self).prepare_synaptic_block(
+            weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice)
+        self._get_pre_neurons()
+
     @overrides(AbstractConnector.create_synaptic_block)
     def create_synaptic_block(
             self, weights, delays, pre_slices, pre_slice_index, post_slices,
@@ -31,11 +31,14 @@ class FixedProbabilityConnector(AbstractGenerateConnectorOnMachine):
 
     __slots__ = [
         "__allow_self_connections",
+        "__procedural",
         "_p_connect"]
 
+    _DRAWS_RANDOM_NUMBERS = True
+
     def __init__(
             self, p_connect, allow_self_connections=True, safe=True,
-            verbose=False, rng=None):
+            verbose=False, rng=None, procedural=False):
         """
         :param p_connect:
             a float between zero and one. Each potential connection is created\
@@ -49,10 +52,16 @@ class FixedProbabilityConnector(AbstractGenerateConnectorOnMachine):
         :param `pyNN.Space` space:
             a Space object, needed if you wish to specify distance-dependent\
             weights or delays - not implemented
+        :param procedural:
+            if True, the rows of the connections are generated on the\
+            machine each time a spike arrives rather than stored in SDRAM,\
+            where the weights, delays and synapse dynamics allow this
+        :type procedural: bool
         """
         super(FixedProbabilityConnector, self).__init__(safe, verbose)
         self._p_connect = p_connect
         self.__allow_self_connections = allow_self_connections
+        self.__procedural = procedural
         self._rng = rng
         if not 0 <= self._p_connect <= 1:
             raise ConfigurationException(
@@ -96,6 +105,15 @@ class FixedProbabilityConnector(AbstractGenerateConnectorOnMachine):
             self._n_pre_neurons * self._n_post_neurons, self._p_connect)
         return self._get_weight_maximum(weights, n_connections)
 
+    @overrides(AbstractConnector.prepare_synaptic_block)
+    def prepare_synaptic_block(
+            self, weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice):
+        super(FixedProbabilityConnector, self).prepare_synaptic_block(
+            weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice)
+        self._get_slice_rng(pre_vertex_slice, post_vertex_slice)
+
     @overrides(AbstractConnector.create_synaptic_block)
     def create_synaptic_block(
             self, weights, delays, pre_slices, pre_slice_index, post_slices,
@@ -103,7 +121,8 @@ class FixedProbabilityConnector(AbstractGenerateConnectorOnMachine):
             synapse_type):
         # pylint: disable=too-many-arguments
         n_items = pre_vertex_slice.n_atoms * post_vertex_slice.n_atoms
-        items = self._rng.next(n_items)
+        items = self._get_slice_rng(
+            pre_vertex_slice, post_vertex_slice).next(n_items)
 
         # If self connections are not allowed, remove possibility the self
         # connections by setting them to a value of infinity
@@ -159,3 +178,17 @@ class FixedProbabilityConnector(AbstractGenerateConnectorOnMachine):
                gen_connector_params_size_in_bytes)
     def gen_connector_params_size_in_bytes(self):
         return 8 + 16
+
+    @overrides(AbstractGenerateConnectorOnMachine.generate_procedurally)
+    def generate_procedurally(self, weights, delays):
+        return (self.__procedural and
+                self.generate_on_machine(weights, delays))
+
+    @property
+    def procedural(self):
+        """ Whether the rows of the connections are to be generated each time\
+            a spike arrives
+
+        :rtype: bool
+        """
+        return self.__procedural
@@ -44,6 +44,9 @@ class FromListConnector(AbstractConnector):
         "__split_pre_slices",
         "__split_post_slices"]
 
+    _BLOCK_KEY_EXCLUDED = (
+        "__split_conn_list", "__split_pre_slices", "__split_post_slices")
+
     def __init__(self, conn_list, safe=True, verbose=False, column_names=None):
         """
         :param: conn_list:
@@ -205,6 +208,24 @@ class FromListConnector(AbstractConnector):
         else:
             return numpy.var(numpy.abs(self.__weights))
 
+    @overrides(AbstractConnector.generate_replacement_weights)
+    def generate_replacement_weights(
+            self, weights, n_connections, pre_vertex_slice, post_vertex_slice):
+        # Listed weights are taken over any given to the projection
+        if self.__weights is not None:
+            return None
+        return super(FromListConnector, self).generate_replacement_weights(
+            weights, n_connections, pre_vertex_slice, post_vertex_slice)
+
+    @overrides(AbstractConnector.prepare_synaptic_block)
+    def prepare_synaptic_block(
+            self, weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice):
+        super(FromListConnector, self).prepare_synaptic_block(
+            weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice)
+        self._split_connections(pre_slices, post_slices)
+
     @overrides(AbstractConnector.create_synaptic_block)
     def create_synaptic_block(
             self, weights, delays, pre_slices, pre_slice_index, post_slices,
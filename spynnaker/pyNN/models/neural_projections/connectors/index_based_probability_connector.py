@@ -43,6 +43,8 @@ class IndexBasedProbabilityConnector(AbstractConnector):
         "__index_expression",
         "__probs"]
 
+    _DRAWS_RANDOM_NUMBERS = True
+
     def __init__(
             self, index_expression, allow_self_connections=True, rng=None,
             safe=True, callback=None, verbose=False):
@@ -112,6 +114,16 @@ class IndexBasedProbabilityConnector(AbstractConnector):
             numpy.amax(self.__probs))
         return self._get_weight_maximum(weights, n_connections)
 
+    @overrides(AbstractConnector.prepare_synaptic_block)
+    def prepare_synaptic_block(
+            self, weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice):
+        AbstractConnector.prepare_synaptic_block(
+            self, weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice)
+        self._update_probs_from_index_expression()
+        self._get_slice_rng(pre_vertex_slice, post_vertex_slice)
+
     @overrides(AbstractConnector.create_synaptic_block)
     def create_synaptic_block(
             self, weights, delays, pre_slices, pre_slice_index, post_slices,
@@ -125,7 +137,8 @@ class IndexBasedProbabilityConnector(AbstractConnector):
             pre_vertex_slice.as_slice, post_vertex_slice.as_slice].reshape(-1)
 
         n_items = pre_vertex_slice.n_atoms * post_vertex_slice.n_atoms
-        items = self._rng.next(n_items)
+        items = self._get_slice_rng(
+            pre_vertex_slice, post_vertex_slice).next(n_items)
 
         # If self connections are not allowed, remove the possibility of self
         # connections by setting the probability to a value of infinity
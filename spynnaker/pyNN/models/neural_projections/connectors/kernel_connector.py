@@ -25,6 +25,14 @@ from .abstract_generate_connector_on_machine \
 HEIGHT, WIDTH = 0, 1
 N_KERNEL_PARAMS = 8
 
+# pre_slice_start, pre_w, post_w, first_post_row, n_post_rows, kernel_w,
+# kernel_h, synapse_type
+N_CONVOLUTION_PARAMS = 8
+
+# The position of a post-neuron outside of the common coordinates; this is
+# never within the kernel
+_OUTSIDE_COMMON = -0x8000
+
 
 class ConvolutionKernel(numpy.ndarray):
     pass
@@ -35,6 +43,22 @@ def shape2word(sw, sh):
             (numpy.uint32(sw) & 0xFFFF))
 
 
+def half_words(values, dtype="uint16"):
+    """ Pack an array of 16-bit values into 32-bit words, padding with a\
+        zero if there are an odd number
+    """
+    values = numpy.asarray(values).astype(dtype).flatten()
+    if len(values) % 2:
+        values = numpy.concatenate((values, numpy.zeros(1, dtype=dtype)))
+    return values.view("uint32")
+
+
+def n_half_words(n_values):
+    """ The number of 32-bit words that hold a number of 16-bit values
+    """
+    return (n_values + 1) // 2
+
+
 class KernelConnector(AbstractGenerateConnectorOnMachine):
     """
     Where the pre- and post-synaptic populations are considered as a 2D array.
@@ -47,7 +71,8 @@ class KernelConnector(AbstractGenerateConnectorOnMachine):
     def __init__(
             self, shape_pre, shape_post, shape_kernel, weight_kernel,
             delay_kernel, shape_common, pre_sample_steps, pre_start_coords,
-            post_sample_steps, post_start_coords, safe, space, verbose):
+            post_sample_steps, post_start_coords, safe, space, verbose,
+            convolution=False):
         """
         :param shape_pre:\
             2D shape of the pre population (rows/height, cols/width, usually \
@@ -69,6 +94,11 @@ class KernelConnector(AbstractGenerateConnectorOnMachine):
         :param pre/post_start_coords (optional):\
             Starting row/col for pre/post sampling <=> (_startX_, endX, stepX)
             None or 2-item array
+        :param convolution (optional):\
+            If True, the kernel is kept on the post-synaptic cores and the\
+            weights of each spike are added from it directly, instead of\
+            the connections being stored in synaptic rows, where the delays\
+            and synapse dynamics allow this
         """
         super(KernelConnector, self).__init__(safe=safe, verbose=verbose)
 
@@ -126,6 +156,8 @@ class KernelConnector(AbstractGenerateConnectorOnMachine):
         self._shape_pre = shape_pre
         self._shape_post = shape_post
 
+        self._convolution = convolution
+
         # Create storage for later
         self._post_as_pre = {}
 
@@ -284,6 +316,12 @@ class KernelConnector(AbstractGenerateConnectorOnMachine):
 
         return self._get_weight_maximum(weights, n_conns)
 
+    @overrides(AbstractConnector.generate_replacement_weights)
+    def generate_replacement_weights(
+            self, weights, n_connections, pre_vertex_slice, post_vertex_slice):
+        # The weights depend on where each connection is in the kernel
+        return None
+
     def __repr__(self):
         return "KernelConnector(shape_kernel[{},{}])".format(
             self._kernel_w, self._kernel_h)
@@ -384,6 +422,82 @@ class KernelConnector(AbstractGenerateConnectorOnMachine):
         return super(KernelConnector, self).gen_weights_params(
             weights, pre_vertex_slice, post_vertex_slice)
 
+    @property
+    def convolution(self):
+        """ Whether the weights of spikes are to be added from the kernel\
+            on the post-synaptic cores rather than from stored rows
+
+        :rtype: bool
+        """
+        return self._convolution
+
+    def _post_rows(self, post_vertex_slice):
+        """ Get the first row and number of rows that the post-neurons of a\
+            slice are in
+        """
+        first_row = post_vertex_slice.lo_atom // self._post_w
+        last_row = post_vertex_slice.hi_atom // self._post_w
+        return first_row, (last_row - first_row) + 1
+
+    @staticmethod
+    def _post_as_pre_line(post, start, step, common, pre_start, pre_step):
+        """ Get the pre-coordinate of each of a line of post-coordinates in\
+            one dimension, as in :py:meth:`compute_statistics`
+        """
+        coord = start + post * step
+        pre = ((coord - pre_start - 1) // pre_step) + 1
+        return numpy.where(
+            (coord < 0) | (coord >= common), _OUTSIDE_COMMON, pre)
+
+    def gen_convolution_params_size_in_bytes(self, post_vertex_slice):
+        """ Get the size of the convolution parameters for a slice of the\
+            post-population, without the key and mask
+        """
+        _, n_post_rows = self._post_rows(post_vertex_slice)
+        n_kernel = self._kernel_w * self._kernel_h
+        return (N_CONVOLUTION_PARAMS + n_half_words(n_post_rows) +
+                n_half_words(self._post_w) + (2 * n_half_words(n_kernel))) * 4
+
+    def gen_convolution_params(
+            self, weights, delays, pre_vertex_slice, post_vertex_slice,
+            synapse_type, weight_scale, machine_time_step):
+        """ Get the parameters of the kernel for a slice of the\
+            post-population, without the key and mask
+
+        :param weight_scale: The scale of the weights of the synapse type
+        :rtype: numpy array of uint32
+        """
+        # As in compute_statistics, the kernels are only made once
+        if self._krn_weights is None:
+            self._krn_weights = self.get_kernel_vals(weights)
+        if self._krn_delays is None:
+            self._krn_delays = self.get_kernel_vals(delays)
+
+        first_post_row, n_post_rows = self._post_rows(post_vertex_slice)
+        post_rows = numpy.arange(first_post_row, first_post_row + n_post_rows)
+        post_row_as_pre = self._post_as_pre_line(
+            post_rows, self._post_start_h, self._post_step_h, self._common_h,
+            self._pre_start_h, self._pre_step_h)
+        post_col_as_pre = self._post_as_pre_line(
+            numpy.arange(self._post_w), self._post_start_w,
+            self._post_step_w, self._common_w, self._pre_start_w,
+            self._pre_step_w)
+
+        # The weights and delays as they would be in a synaptic row
+        krn_weights = numpy.clip(numpy.rint(
+            numpy.abs(self._krn_weights) * weight_scale), 0, 0xFFFF)
+        krn_delays = numpy.rint(
+            self._krn_delays * (1000.0 / machine_time_step))
+
+        return numpy.concatenate((
+            numpy.array([
+                pre_vertex_slice.lo_atom, self._pre_w, self._post_w,
+                first_post_row, n_post_rows, self._kernel_w, self._kernel_h,
+                synapse_type], dtype="uint32"),
+            half_words(post_row_as_pre, "int16"),
+            half_words(post_col_as_pre, "int16"),
+            half_words(krn_weights), half_words(krn_delays)))
+
     @property
     @overrides(AbstractGenerateConnectorOnMachine.gen_connector_id)
     def gen_connector_id(self):
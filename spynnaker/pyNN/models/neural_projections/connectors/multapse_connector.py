@@ -43,6 +43,11 @@ class MultapseConnector(AbstractGenerateConnectorOnMachine):
         "__synapses_per_edge",
         "__with_replacement"]
 
+    # The slices are in the key of each block anyway
+    _BLOCK_KEY_EXCLUDED = ("__pre_slices", "__post_slices")
+
+    _DRAWS_RANDOM_NUMBERS = True
+
     def __init__(self, num_synapses, allow_self_connections=True,
                  with_replacement=True, safe=True, verbose=False,
                  rng=None):
@@ -139,6 +144,16 @@ class MultapseConnector(AbstractGenerateConnectorOnMachine):
     def get_weight_maximum(self, weights):
         return self._get_weight_maximum(weights, self.__num_synapses)
 
+    @overrides(AbstractConnector.prepare_synaptic_block)
+    def prepare_synaptic_block(
+            self, weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice):
+        super(MultapseConnector, self).prepare_synaptic_block(
+            weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice)
+        self._update_synapses_per_post_vertex(pre_slices, post_slices)
+        self._get_slice_rng(pre_vertex_slice, post_vertex_slice)
+
     @overrides(AbstractConnector.create_synaptic_block)
     def create_synaptic_block(
             self, weights, delays, pre_slices, pre_slice_index, post_slices,
@@ -171,9 +186,10 @@ class MultapseConnector(AbstractGenerateConnectorOnMachine):
 
         # Now do the actual random choice from the available connections
         try:
-            chosen = numpy.random.choice(
-                pairs.shape[0], size=n_connections,
-                replace=self.__with_replacement)
+            chosen = self._get_slice_rng(
+                pre_vertex_slice, post_vertex_slice).choice(
+                    pairs.shape[0], size=n_connections,
+                    replace=self.__with_replacement)
         except Exception as e:
             raise_from(SpynnakerException(
                 "MultapseConnector: The number of connections is too large "
@@ -26,6 +26,8 @@ class SmallWorldConnector(AbstractConnector):
         "__n_connections",
         "__rewiring"]
 
+    _DRAWS_RANDOM_NUMBERS = True
+
     def __init__(
             self, degree, rewiring, allow_self_connections=True, safe=True,
             verbose=False, n_connections=None):
@@ -99,6 +101,15 @@ class SmallWorldConnector(AbstractConnector):
         # pylint: disable=too-many-arguments
         return self._get_weight_maximum(weights, self.__n_connections)
 
+    @overrides(AbstractConnector.prepare_synaptic_block)
+    def prepare_synaptic_block(
+            self, weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice):
+        super(SmallWorldConnector, self).prepare_synaptic_block(
+            weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice)
+        self._get_slice_rng(pre_vertex_slice, post_vertex_slice)
+
     @overrides(AbstractConnector.create_synaptic_block)
     def create_synaptic_block(
             self, weights, delays, pre_slices, pre_slice_index, post_slices,
@@ -121,10 +132,10 @@ class SmallWorldConnector(AbstractConnector):
         block["synapse_type"] = synapse_type
 
         # Re-wire some connections
-        rewired = numpy.where(
-            self._rng.next(n_connections) < self.__rewiring)[0]
+        rng = self._get_slice_rng(pre_vertex_slice, post_vertex_slice)
+        rewired = numpy.where(rng.next(n_connections) < self.__rewiring)[0]
         block["target"][rewired] = (
-            (self._rng.next(rewired.size) * (post_vertex_slice.n_atoms - 1)) +
+            (rng.next(rewired.size) * (post_vertex_slice.n_atoms - 1)) +
             post_vertex_slice.lo_atom)
 
         return block
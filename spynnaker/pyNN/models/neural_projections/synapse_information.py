@@ -49,6 +49,10 @@ class SynapseInformation(object):
     def weight(self):
         return self.__weight
 
+    @weight.setter
+    def weight(self, weight):
+        self.__weight = weight
+
     @property
     def delay(self):
         return self.__delay
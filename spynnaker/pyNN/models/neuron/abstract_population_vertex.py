@@ -38,7 +38,8 @@ from spinn_front_end_common.interface.buffer_management import (
     recording_utilities)
 from spinn_front_end_common.interface.profiling import profile_utils
 from spynnaker.pyNN.models.common import (
-    AbstractSpikeRecordable, AbstractNeuronRecordable, NeuronRecorder)
+    AbstractSpikeRecordable, AbstractNeuronRecordable, NeuronRecorder,
+    TimestepTelemetryRecorder)
 from spynnaker.pyNN.utilities import constants
 from spynnaker.pyNN.models.abstract_models import (
     AbstractPopulationInitializable, AbstractAcceptsIncomingSynapses,
@@ -93,6 +94,7 @@ class AbstractPopulationVertex(
         "__pynn_model",
         "_state_variables",  # See AbstractPyNNModel
         "__synapse_manager",
+        "__telemetry_recorder",
         "__time_between_requests",
         "__units",
         "__n_subvertices",
@@ -152,6 +154,7 @@ class AbstractPopulationVertex(
         recordables = ["spikes"]
         recordables.extend(self.__neuron_impl.get_recordable_variables())
         self.__neuron_recorder = NeuronRecorder(recordables, n_neurons)
+        self.__telemetry_recorder = TimestepTelemetryRecorder()
 
         # Set up synapse handling
         self.__synapse_manager = SynapticManager(
@@ -177,6 +180,15 @@ class AbstractPopulationVertex(
     def _neuron_recorder(self):  # for testing only
         return self.__neuron_recorder
 
+    @property
+    def _n_recording_regions(self):
+        # spikes, then each variable, then the timestep telemetry
+        return len(self.__neuron_impl.get_recordable_variables()) + 2
+
+    @property
+    def _telemetry_recording_region(self):
+        return self._n_recording_regions - 1
+
     @inject_items({
         "graph": "MemoryApplicationGraph",
         "machine_time_step": "MachineTimeStep"
@@ -191,8 +203,9 @@ class AbstractPopulationVertex(
             self, vertex_slice, graph, machine_time_step):
         # pylint: disable=arguments-differ
 
-        variableSDRAM = self.__neuron_recorder.get_variable_sdram_usage(
-            vertex_slice)
+        variableSDRAM = (
+            self.__neuron_recorder.get_variable_sdram_usage(vertex_slice) +
+            self.__telemetry_recorder.get_variable_sdram_usage())
         constantSDRAM = ConstantSDRAM(
                 self._get_sdram_usage_for_atoms(
                     vertex_slice, graph, machine_time_step))
@@ -200,7 +213,8 @@ class AbstractPopulationVertex(
         # set resources required from this object
         container = ResourceContainer(
             sdram=variableSDRAM + constantSDRAM,
-            dtcm=DTCMResource(self.get_dtcm_usage_for_atoms(vertex_slice)),
+            dtcm=DTCMResource(self.get_dtcm_usage_for_atoms(
+                vertex_slice, graph, machine_time_step)),
             cpu_cycles=CPUCyclesPerTickResource(
                 self.get_cpu_usage_for_atoms(vertex_slice)))
 
@@ -230,6 +244,8 @@ class AbstractPopulationVertex(
             values.append(
                 self.__neuron_recorder.get_buffered_sdram_per_timestep(
                     variable, vertex_slice))
+        values.append(
+            self.__telemetry_recorder.get_buffered_sdram_per_timestep())
         return values
 
     def _get_buffered_sdram(self, vertex_slice, n_machine_time_steps):
@@ -239,6 +255,8 @@ class AbstractPopulationVertex(
             values.append(
                 self.__neuron_recorder.get_buffered_sdram(
                     variable, vertex_slice, n_machine_time_steps))
+        values.append(
+            self.__telemetry_recorder.get_buffered_sdram(n_machine_time_steps))
         return values
 
     @overrides(ApplicationVertex.create_machine_vertex)
@@ -247,9 +265,11 @@ class AbstractPopulationVertex(
             constraints=None):
 
         self.__n_subvertices += 1
+        recorded_region_ids = list(self.__neuron_recorder.recorded_region_ids)
+        if self.__telemetry_recorder.is_recording:
+            recorded_region_ids.append(self._telemetry_recording_region)
         return PopulationMachineVertex(
-            resources_required, self.__neuron_recorder.recorded_region_ids,
-            label, constraints)
+            resources_required, recorded_region_ids, label, constraints)
 
     def get_cpu_usage_for_atoms(self, vertex_slice):
         return (
@@ -259,12 +279,15 @@ class AbstractPopulationVertex(
             self.__neuron_impl.get_n_cpu_cycles(vertex_slice.n_atoms) +
             self.__synapse_manager.get_n_cpu_cycles())
 
-    def get_dtcm_usage_for_atoms(self, vertex_slice):
+    def get_dtcm_usage_for_atoms(self, vertex_slice, graph, machine_time_step):
         return (
             _NEURON_BASE_DTCM_USAGE_IN_BYTES +
             self.__neuron_impl.get_dtcm_usage_in_bytes(vertex_slice.n_atoms) +
             self.__neuron_recorder.get_dtcm_usage_in_bytes(vertex_slice) +
-            self.__synapse_manager.get_dtcm_usage_in_bytes())
+            self.__telemetry_recorder.get_dtcm_usage_in_bytes() +
+            self.__synapse_manager.get_dtcm_usage_in_bytes(
+                vertex_slice, graph.get_edges_ending_at_vertex(self),
+                machine_time_step))
 
     def _get_sdram_usage_for_neuron_params(self, vertex_slice):
         """ Calculate the SDRAM usage for just the neuron parameters region.
@@ -279,7 +302,7 @@ class AbstractPopulationVertex(
 
     def _get_sdram_usage_for_atoms(
             self, vertex_slice, graph, machine_time_step):
-        n_record = len(self.__neuron_impl.get_recordable_variables()) + 1
+        n_record = self._n_recording_regions
         sdram_requirement = (
             common_constants.SYSTEM_BYTES_REQUIREMENT +
             self._get_sdram_usage_for_neuron_params(vertex_slice) +
@@ -310,7 +333,7 @@ class AbstractPopulationVertex(
         spec.reserve_memory_region(
             region=constants.POPULATION_BASED_REGIONS.RECORDING.value,
             size=recording_utilities.get_recording_header_size(
-                len(self.__neuron_impl.get_recordable_variables()) + 1))
+                self._n_recording_regions))
 
         profile_utils.reserve_profile_region(
             spec, constants.POPULATION_BASED_REGIONS.PROFILING.value,
@@ -524,11 +547,18 @@ class AbstractPopulationVertex(
         # Get the weight_scale value from the appropriate location
         weight_scale = self.__neuron_impl.get_global_weight_scale()
 
+        # The DTCM used other than by the synaptic buffers, including the
+        # incoming spike buffer
+        dtcm_used = (
+            self.get_dtcm_usage_for_atoms(
+                vertex_slice, application_graph, machine_time_step) +
+            (self.__incoming_spike_buffer_size * 4))
+
         # allow the synaptic matrix to write its data spec-able data
         self.__synapse_manager.write_data_spec(
             spec, self, vertex_slice, vertex, placement, machine_graph,
             application_graph, routing_info, graph_mapper,
-            weight_scale, machine_time_step)
+            weight_scale, machine_time_step, dtcm_used)
 
         # End the writing of this specification:
         spec.end_specification()
@@ -592,6 +622,39 @@ class AbstractPopulationVertex(
             self.label, buffer_manager, index, placements, graph_mapper,
             self, variable, n_machine_time_steps)
 
+    def is_recording_timestep_telemetry(self):
+        """ Determine if the timing and load of each timestep is recorded
+        """
+        return self.__telemetry_recorder.is_recording
+
+    def set_recording_timestep_telemetry(self, new_state=True):
+        """ Set whether the timing and load of each timestep is recorded
+
+        :param new_state: True if the telemetry is to be recorded
+        """
+        self.__change_requires_mapping = (
+            new_state != self.__telemetry_recorder.is_recording)
+        self.__telemetry_recorder.set_recording(new_state)
+
+    def get_timestep_telemetry(
+            self, placements, graph_mapper, buffer_manager):
+        """ Get the timing and load of each timestep on each core
+
+        :return: an array with a row per core per timestep
+        :rtype: numpy.ndarray
+        """
+        return self.__telemetry_recorder.get_telemetry(
+            self.label, buffer_manager, self._telemetry_recording_region,
+            placements, graph_mapper, self)
+
+    def clear_timestep_telemetry(
+            self, buffer_manager, placements, graph_mapper):
+        """ Clear the timing and load recorded so far on each core
+        """
+        self._clear_recording_region(
+            buffer_manager, placements, graph_mapper,
+            self._telemetry_recording_region)
+
     @overrides(AbstractNeuronRecordable.get_neuron_sampling_interval)
     def get_neuron_sampling_interval(self, variable):
         return self.__neuron_recorder.get_neuron_sampling_interval(variable)
@@ -768,6 +831,20 @@ class AbstractPopulationVertex(
             placements, monitor_api, monitor_placement, monitor_cores,
             handle_time_out_configuration, fixed_routes)
 
+    @overrides(AbstractAcceptsIncomingSynapses.update_weights_on_machine)
+    def update_weights_on_machine(
+            self, transceiver, placement, edge, graph_mapper, routing_infos,
+            synapse_information):
+        # pylint: disable=too-many-arguments
+        if self.__synapse_manager.update_weights_on_machine(
+                transceiver, placement, edge, graph_mapper, routing_infos,
+                synapse_information):
+            return True
+
+        # The synapses must be generated again with the new weights
+        self.__change_requires_data_generation = True
+        return False
+
     def clear_connection_cache(self):
         self.__synapse_manager.clear_connection_cache()
 
@@ -22,7 +22,8 @@ class AbstractPyNNNeuronModelStandard(AbstractPyNNNeuronModel):
 
     def __init__(
             self, model_name, binary, neuron_model, input_type,
-            synapse_type, threshold_type, additional_input_type=None):
+            synapse_type, threshold_type, additional_input_type=None,
+            field_major=False):
         AbstractPyNNNeuronModel.__init__(self, NeuronImplStandard(
             model_name, binary, neuron_model, input_type, synapse_type,
-            threshold_type, additional_input_type))
+            threshold_type, additional_input_type, field_major))
@@ -51,23 +51,31 @@ class AbstractStandardNeuronComponent(with_metaclass(AbstractBase, object)):
         :rtype: int
         """
 
-    def get_dtcm_usage_in_bytes(self, n_neurons):
+    def get_dtcm_usage_in_bytes(self, n_neurons, field_major=False):
         """ Get the DTCM memory usage required
 
         :param n_neurons: The number of neurons to get the usage for
         :type n_neurons: int
+        :param field_major:\
+            True if the data is stored as an array for each field
+        :type field_major: bool
         :rtype: int
         """
-        return self.struct.get_size_in_whole_words(n_neurons) * 4
+        return self.struct.get_size_in_whole_words(
+            n_neurons, field_major) * 4
 
-    def get_sdram_usage_in_bytes(self, n_neurons):
+    def get_sdram_usage_in_bytes(self, n_neurons, field_major=False):
         """ Get the SDRAM memory usage required
 
         :param n_neurons: The number of neurons to get the usage for
         :type n_neurons: int
+        :param field_major:\
+            True if the data is stored as an array for each field
+        :type field_major: bool
         :rtype: int
         """
-        return self.struct.get_size_in_whole_words(n_neurons) * 4
+        return self.struct.get_size_in_whole_words(
+            n_neurons, field_major) * 4
 
     @abstractmethod
     def add_parameters(self, parameters):
@@ -103,7 +111,9 @@ class AbstractStandardNeuronComponent(with_metaclass(AbstractBase, object)):
         :rtype: A list of (single value or list of values or RangedList)
         """
 
-    def get_data(self, parameters, state_variables, vertex_slice):
+    def get_data(
+            self, parameters, state_variables, vertex_slice,
+            field_major=False):
         """ Get the data to be written to the machine for this model
 
         :param parameters: The holder of the parameters
@@ -113,11 +123,15 @@ class AbstractStandardNeuronComponent(with_metaclass(AbstractBase, object)):
         :type state_variables:\
             :py:class:`spinn_utilities.ranged.range_dictionary.RangeDictionary`
         :param vertex_slice: The slice of the vertex to generate parameters for
+        :param field_major:\
+            True to write an array for each field rather than an array of\
+            structs
+        :type field_major: bool
         :rtype: numpy array of uint32
         """
         values = self.get_values(parameters, state_variables, vertex_slice)
         return self.struct.get_data(
-            values, vertex_slice.lo_atom, vertex_slice.n_atoms)
+            values, vertex_slice.lo_atom, vertex_slice.n_atoms, field_major)
 
     @abstractmethod
     def update_values(self, values, parameters, state_variables):
@@ -132,7 +146,8 @@ class AbstractStandardNeuronComponent(with_metaclass(AbstractBase, object)):
         """
 
     def read_data(
-            self, data, offset, vertex_slice, parameters, state_variables):
+            self, data, offset, vertex_slice, parameters, state_variables,
+            field_major=False):
         """ Read the parameters and state variables of the model from the\
             given data
 
@@ -145,11 +160,15 @@ class AbstractStandardNeuronComponent(with_metaclass(AbstractBase, object)):
         :param state_variables: The holder of the state variables to update
         :type state_variables:\
             :py:class:`spinn_utilities.ranged.range_dictionary.RangeDictionary`
+        :param field_major:\
+            True if the data was written as an array for each field
+        :type field_major: bool
         :return: The offset after reading the data
         """
-        values = self.struct.read_data(data, offset, vertex_slice.n_atoms)
+        values = self.struct.read_data(
+            data, offset, vertex_slice.n_atoms, field_major)
         new_offset = offset + (self.struct.get_size_in_whole_words(
-            vertex_slice.n_atoms) * 4)
+            vertex_slice.n_atoms, field_major) * 4)
         params = RangedDictVertexSlice(parameters, vertex_slice)
         variables = RangedDictVertexSlice(state_variables, vertex_slice)
         self.update_values(values, params, variables)
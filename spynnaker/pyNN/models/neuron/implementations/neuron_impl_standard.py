@@ -31,7 +31,8 @@ class NeuronImplStandard(AbstractNeuronImpl):
         "__synapse_type",
         "__threshold_type",
         "__additional_input_type",
-        "__components"
+        "__components",
+        "__field_major"
     ]
 
     _RECORDABLES = ["v", "gsyn_exc", "gsyn_inh"]
@@ -44,7 +45,15 @@ class NeuronImplStandard(AbstractNeuronImpl):
 
     def __init__(
             self, model_name, binary, neuron_model, input_type,
-            synapse_type, threshold_type, additional_input_type=None):
+            synapse_type, threshold_type, additional_input_type=None,
+            field_major=False):
+        """
+        :param field_major:\
+            True if the binary stores each parameter and state variable of\
+            the components as an array over the neurons, rather than each\
+            component as an array of structs
+        :type field_major: bool
+        """
         self.__model_name = model_name
         self.__binary = binary
         self.__neuron_model = neuron_model
@@ -52,6 +61,7 @@ class NeuronImplStandard(AbstractNeuronImpl):
         self.__synapse_type = synapse_type
         self.__threshold_type = threshold_type
         self.__additional_input_type = additional_input_type
+        self.__field_major = field_major
 
         self.__components = [
             self.__neuron_model, self.__input_type, self.__threshold_type,
@@ -81,25 +91,15 @@ class NeuronImplStandard(AbstractNeuronImpl):
 
     @overrides(AbstractNeuronImpl.get_dtcm_usage_in_bytes)
     def get_dtcm_usage_in_bytes(self, n_neurons):
-        total = self.__neuron_model.get_dtcm_usage_in_bytes(n_neurons)
-        total += self.__synapse_type.get_dtcm_usage_in_bytes(n_neurons)
-        total += self.__input_type.get_dtcm_usage_in_bytes(n_neurons)
-        total += self.__threshold_type.get_dtcm_usage_in_bytes(n_neurons)
-        if self.__additional_input_type is not None:
-            total += self.__additional_input_type.get_dtcm_usage_in_bytes(
-                n_neurons)
-        return total
+        return sum(
+            component.get_dtcm_usage_in_bytes(n_neurons, self.__field_major)
+            for component in self.__components)
 
     @overrides(AbstractNeuronImpl.get_sdram_usage_in_bytes)
     def get_sdram_usage_in_bytes(self, n_neurons):
-        total = self.__neuron_model.get_sdram_usage_in_bytes(n_neurons)
-        total += self.__synapse_type.get_sdram_usage_in_bytes(n_neurons)
-        total += self.__input_type.get_sdram_usage_in_bytes(n_neurons)
-        total += self.__threshold_type.get_sdram_usage_in_bytes(n_neurons)
-        if self.__additional_input_type is not None:
-            total += self.__additional_input_type.get_sdram_usage_in_bytes(
-                n_neurons)
-        return total
+        return sum(
+            component.get_sdram_usage_in_bytes(n_neurons, self.__field_major)
+            for component in self.__components)
 
     @overrides(AbstractNeuronImpl.get_global_weight_scale)
     def get_global_weight_scale(self):
@@ -146,7 +146,8 @@ class NeuronImplStandard(AbstractNeuronImpl):
     @overrides(AbstractNeuronImpl.get_data)
     def get_data(self, parameters, state_variables, vertex_slice):
         return numpy.concatenate([
-            component.get_data(parameters, state_variables, vertex_slice)
+            component.get_data(
+                parameters, state_variables, vertex_slice, self.__field_major)
             for component in self.__components
         ])
 
@@ -155,7 +156,8 @@ class NeuronImplStandard(AbstractNeuronImpl):
             self, data, offset, vertex_slice, parameters, state_variables):
         for component in self.__components:
             offset = component.read_data(
-                data, offset, vertex_slice, parameters, state_variables)
+                data, offset, vertex_slice, parameters, state_variables,
+                self.__field_major)
         return offset
 
     @overrides(AbstractNeuronImpl.get_units)
@@ -54,18 +54,31 @@ class Struct(object):
              for i, data_type in enumerate(self.field_types)],
             align=True)
 
-    def get_size_in_whole_words(self, array_size=1):
+    def get_size_in_whole_words(self, array_size=1, field_major=False):
         """ Get the size of the struct in whole words in an array of given\
             size (default 1 item)
 
         :param array_size: The number of elements in an array of structs
+        :param field_major:\
+            True if the array is written as an array for each field rather\
+            than as an array of structs (see get_data)
         :rtype: int
         """
+        if field_major:
+            return sum(
+                self.__get_field_size_in_whole_words(data_type, array_size)
+                for data_type in self.field_types)
         datatype = self.numpy_dtype
         size_in_bytes = array_size * datatype.itemsize
         return (size_in_bytes + 3) // 4
 
-    def get_data(self, values, offset=0, array_size=1):
+    @staticmethod
+    def __get_field_size_in_whole_words(data_type, array_size):
+        size_in_bytes = array_size * numpy.dtype(
+            data_type.struct_encoding).itemsize
+        return (size_in_bytes + 3) // 4
+
+    def get_data(self, values, offset=0, array_size=1, field_major=False):
         """ Get a numpy array of uint32 of data for the given values
 
         :param values:\
@@ -75,6 +88,10 @@ class Struct(object):
             list of (single value or list of values or RangedList of values)
         :param offset: The offset into each of the values where to start
         :param array_size: The number of structs to generate
+        :param field_major:\
+            True to write all the values of the first field, then all the\
+            values of the second field and so on, each padded to a whole\
+            number of words, rather than an array of structs
         :rtype: numpy.array(dtype="uint32")
         """
         # Create an array to store values in
@@ -103,6 +120,13 @@ class Struct(object):
                     data["f" + str(i)][
                         start - offset:end - offset] = data_value
 
+        if field_major:
+            return numpy.concatenate([
+                self.__pad_to_words(numpy.ascontiguousarray(
+                    data["f" + str(i)]))
+                for i in range(len(self.field_types))] +
+                [numpy.zeros(0, dtype="uint32")])
+
         # Pad to whole number of uint32s
         overflow = (array_size * self.numpy_dtype.itemsize) % 4
         if overflow != 0:
@@ -110,12 +134,23 @@ class Struct(object):
 
         return data.view("uint32")
 
-    def read_data(self, data, offset=0, array_size=1):
+    @staticmethod
+    def __pad_to_words(data):
+        overflow = data.nbytes % 4
+        data = data.view("uint8")
+        if overflow != 0:
+            data = numpy.pad(data, (0, 4 - overflow), "constant")
+        return data.view("uint32")
+
+    def read_data(self, data, offset=0, array_size=1, field_major=False):
         """ Read a bytearray of data and convert to struct values
 
         :param data: The data to be read
         :param offset: Index of the byte at the start of the valid data
         :param array_size: The number of struct elements to read
+        :param field_major:\
+            True if the data was written as an array for each field rather\
+            than as an array of structs (see get_data)
         :return:\
             a list of lists of data values, one list for each struct element
         """
@@ -131,6 +166,17 @@ class Struct(object):
         if len(self.numpy_dtype) == 0:
             return items_to_return
         else:
+            if field_major:
+                for data_type in self.field_types:
+                    values = numpy.frombuffer(
+                        data, offset=offset,
+                        dtype=numpy.dtype(data_type.struct_encoding),
+                        count=array_size)
+                    items_to_return.append(values / float(data_type.scale))
+                    offset += self.__get_field_size_in_whole_words(
+                        data_type, array_size) * 4
+                return items_to_return
+
             # Read in the data values
             numpy_data = numpy.frombuffer(
                 data, offset=offset, dtype=self.numpy_dtype, count=array_size)
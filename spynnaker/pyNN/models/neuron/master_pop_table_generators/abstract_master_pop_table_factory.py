@@ -48,7 +48,7 @@ class AbstractMasterPopTableFactory(object):
     @abstractmethod
     def update_master_population_table(
             self, spec, block_start_addr, row_length, key_and_mask,
-            master_pop_table_region, is_single=False):
+            master_pop_table_region, is_single=False, rows_present=None):
         """ Update a data specification with a master pop entry in some form
 
         :param spec: the data specification to write the master pop entry to
@@ -63,6 +63,10 @@ class AbstractMasterPopTableFactory(object):
         :param master_pop_table_region: \
             The region to which the master pop table is being stored
         :param is_single: True if this is a single synapse, False otherwise
+        :param rows_present: \
+            for each row of the block, True if the row contains any synapses;\
+            None if this is not known
+        :type rows_present: numpy.ndarray(bool) or None
         """
 
     @abstractmethod
@@ -26,6 +26,7 @@ from .abstract_master_pop_table_factory import AbstractMasterPopTableFactory
 
 logger = logging.getLogger(__name__)
 _TWO_WORDS = struct.Struct("<II")
+_BYTES_PER_WORD = 4
 
 
 class _MasterPopEntry(object):
@@ -34,7 +35,8 @@ class _MasterPopEntry(object):
     __slots__ = [
         "__addresses_and_row_lengths",
         "__mask",
-        "__routing_key"]
+        "__routing_key",
+        "__rows_present"]
 
     MASTER_POP_ENTRY_SIZE_BYTES = 12
     MASTER_POP_ENTRY_SIZE_WORDS = 3
@@ -45,11 +47,22 @@ class _MasterPopEntry(object):
         self.__routing_key = routing_key
         self.__mask = mask
         self.__addresses_and_row_lengths = list()
+        self.__rows_present = numpy.zeros(0, dtype="bool")
 
-    def append(self, address, row_length, is_single):
+    def append(self, address, row_length, is_single, rows_present):
         index = len(self.__addresses_and_row_lengths)
         self.__addresses_and_row_lengths.append(
             (address, row_length, is_single))
+
+        # Once any block of rows is unknown, the entry can't be filtered
+        if rows_present is None or self.__rows_present is None:
+            self.__rows_present = None
+        else:
+            n_rows = max(len(rows_present), len(self.__rows_present))
+            merged = numpy.zeros(n_rows, dtype="bool")
+            merged[:len(self.__rows_present)] = self.__rows_present
+            merged[:len(rows_present)] |= rows_present
+            self.__rows_present = merged
         return index
 
     @property
@@ -74,6 +87,14 @@ class _MasterPopEntry(object):
         """
         return self.__addresses_and_row_lengths
 
+    @property
+    def rows_present(self):
+        """
+        :return: for each row index, True if any block of this entry has\
+            a synapse in the row, or None if this is not known
+        """
+        return self.__rows_present
+
 
 class MasterPopTableAsBinarySearch(AbstractMasterPopTableFactory):
     """ Master population table, implemented as binary search master.
@@ -97,6 +118,9 @@ class MasterPopTableAsBinarySearch(AbstractMasterPopTableFactory):
     ADDRESS_SCALE = 16
     ADDRESS_SCALED_SHIFT = 8 - 4
 
+    # The number of rows in each word of a connectivity bit field
+    BITS_PER_WORD = 32
+
     def __init__(self):
         self.__entries = None
         self.__n_addresses = 0
@@ -114,6 +138,7 @@ class MasterPopTableAsBinarySearch(AbstractMasterPopTableFactory):
         # assume multiple entries for each edge
         n_vertices = 0
         n_entries = 0
+        n_bit_field_words = 0
         for in_edge in in_edges:
 
             if isinstance(in_edge, ProjectionApplicationEdge):
@@ -131,12 +156,17 @@ class MasterPopTableAsBinarySearch(AbstractMasterPopTableFactory):
                 n_vertices += n_edge_vertices
                 n_entries += (
                     n_edge_vertices * len(in_edge.synapse_information))
+                n_bit_field_words += n_edge_vertices * (
+                    self._get_bit_field_words(max_atoms) +
+                    self._get_bit_field_words(
+                        max_atoms * in_edge.n_delay_stages))
 
         # Multiply by 2 to get an upper bound
         return (
             (n_vertices * 2 * _MasterPopEntry.MASTER_POP_ENTRY_SIZE_BYTES) +
             (n_entries * 2 * _MasterPopEntry.ADDRESS_LIST_ENTRY_SIZE_BYTES) +
-            8)
+            (n_vertices * 2 * _BYTES_PER_WORD) +
+            (n_bit_field_words * _BYTES_PER_WORD) + 8)
 
     def get_exact_master_population_table_size(
             self, vertex, machine_graph, graph_mapper):
@@ -147,16 +177,29 @@ class MasterPopTableAsBinarySearch(AbstractMasterPopTableFactory):
 
         n_vertices = len(in_edges)
         n_entries = 0
+        n_bit_field_words = 0
         for in_edge in in_edges:
             if isinstance(in_edge, ProjectionMachineEdge):
                 edge = graph_mapper.get_application_edge(in_edge)
                 n_entries += len(edge.synapse_information)
+                n_atoms = graph_mapper.get_slice(in_edge.pre_vertex).n_atoms
+                n_bit_field_words += (
+                    self._get_bit_field_words(n_atoms) +
+                    self._get_bit_field_words(n_atoms * edge.n_delay_stages))
 
         # Multiply by 2 to get an upper bound
         return (
             (n_vertices * 2 * _MasterPopEntry.MASTER_POP_ENTRY_SIZE_BYTES) +
             (n_entries * 2 * _MasterPopEntry.ADDRESS_LIST_ENTRY_SIZE_BYTES) +
-            8)
+            (n_vertices * 2 * _BYTES_PER_WORD) +
+            (n_bit_field_words * _BYTES_PER_WORD) + 8)
+
+    def _get_bit_field_words(self, n_rows):
+        """
+        :param n_rows: the number of rows in a block
+        :return: the number of words in the connectivity bit field of a block
+        """
+        return int(math.ceil(float(n_rows) / float(self.BITS_PER_WORD)))
 
     def get_allowed_row_length(self, row_length):
         """
@@ -198,7 +241,7 @@ class MasterPopTableAsBinarySearch(AbstractMasterPopTableFactory):
                extend_doc=False)
     def update_master_population_table(
             self, spec, block_start_addr, row_length, key_and_mask,
-            master_pop_table_region, is_single=False):
+            master_pop_table_region, is_single=False, rows_present=None):
         """ Add an entry in the binary search to deal with the synaptic matrix
 
         :param spec: the writer for DSG
@@ -208,6 +251,10 @@ class MasterPopTableAsBinarySearch(AbstractMasterPopTableFactory):
         :param master_pop_table_region: the region ID for the master pop
         :param is_single: \
             Flag that states if the entry is a direct entry for a single row.
+        :param rows_present: \
+            for each row of the block, True if the row has any synapses, or\
+            None if this is not known (in which case no spikes for the\
+            entry are filtered)
         :return: The index of the entry, to be used to retrieve it
         :rtype: int
         """
@@ -221,7 +268,7 @@ class MasterPopTableAsBinarySearch(AbstractMasterPopTableFactory):
         if not is_single:
             start_addr = block_start_addr // self.ADDRESS_SCALE
         index = self.__entries[key_and_mask.key].append(
-            start_addr, row_length, is_single)
+            start_addr, row_length, is_single, rows_present)
         self.__n_addresses += 1
         return index
 
@@ -252,6 +299,13 @@ class MasterPopTableAsBinarySearch(AbstractMasterPopTableFactory):
         spec.write_array(pop_table.view("<u4"))
         spec.write_array(address_list)
 
+        # Write the connectivity bit field of each entry, in the same order
+        for entry in entries:
+            bit_field = self._make_bit_field(entry.rows_present)
+            spec.write_value(len(bit_field))
+            if len(bit_field):
+                spec.write_array(bit_field)
+
         self.__entries.clear()
         del self.__entries
         self.__entries = None
@@ -272,6 +326,21 @@ class MasterPopTableAsBinarySearch(AbstractMasterPopTableFactory):
                 (row_length & self.ROW_LENGTH_MASK))
         return count
 
+    def _make_bit_field(self, rows_present):
+        """ Pack the rows present into words, with row 0 in bit 0 of the\
+            first word.  An entry that can't be filtered has no words, and\
+            an entry that can has at least one.
+        """
+        if rows_present is None:
+            return numpy.zeros(0, dtype="uint32")
+        n_words = max(1, self._get_bit_field_words(len(rows_present)))
+        bits = numpy.zeros(n_words * self.BITS_PER_WORD, dtype="uint32")
+        bits[:len(rows_present)] = rows_present
+        shifts = numpy.arange(self.BITS_PER_WORD, dtype="uint32")
+        return numpy.sum(
+            bits.reshape(n_words, self.BITS_PER_WORD) << shifts, axis=1,
+            dtype="uint32")
+
     @overrides(
         AbstractMasterPopTableFactory.extract_synaptic_matrix_data_location)
     def extract_synaptic_matrix_data_location(
@@ -46,15 +46,15 @@ class AbstractNeuronModel(AbstractStandardNeuronComponent):
         return self.__global_struct
 
     @overrides(AbstractStandardNeuronComponent.get_dtcm_usage_in_bytes)
-    def get_dtcm_usage_in_bytes(self, n_neurons):
+    def get_dtcm_usage_in_bytes(self, n_neurons, field_major=False):
         usage = super(AbstractNeuronModel, self).get_dtcm_usage_in_bytes(
-            n_neurons)
+            n_neurons, field_major)
         return usage + (self.__global_struct.get_size_in_whole_words() * 4)
 
     @overrides(AbstractStandardNeuronComponent.get_sdram_usage_in_bytes)
-    def get_sdram_usage_in_bytes(self, n_neurons):
+    def get_sdram_usage_in_bytes(self, n_neurons, field_major=False):
         usage = super(AbstractNeuronModel, self).get_sdram_usage_in_bytes(
-            n_neurons)
+            n_neurons, field_major)
         return usage + (self.__global_struct.get_size_in_whole_words() * 4)
 
     def get_global_values(self):
@@ -66,18 +66,22 @@ class AbstractNeuronModel(AbstractStandardNeuronComponent):
         return numpy.zeros(0, dtype="uint32")
 
     @overrides(AbstractStandardNeuronComponent.get_data)
-    def get_data(self, parameters, state_variables, vertex_slice):
+    def get_data(
+            self, parameters, state_variables, vertex_slice,
+            field_major=False):
         super_data = super(AbstractNeuronModel, self).get_data(
-            parameters, state_variables, vertex_slice)
+            parameters, state_variables, vertex_slice, field_major)
         values = self.get_global_values()
         global_data = self.__global_struct.get_data(values)
         return numpy.concatenate([global_data, super_data])
 
     @overrides(AbstractStandardNeuronComponent.read_data)
     def read_data(
-            self, data, offset, vertex_slice, parameters, state_variables):
+            self, data, offset, vertex_slice, parameters, state_variables,
+            field_major=False):
 
         # Assume that the global data doesn't change
         offset += (self.__global_struct.get_size_in_whole_words() * 4)
         return super(AbstractNeuronModel, self).read_data(
-            data, offset, vertex_slice, parameters, state_variables)
+            data, offset, vertex_slice, parameters, state_variables,
+            field_major)
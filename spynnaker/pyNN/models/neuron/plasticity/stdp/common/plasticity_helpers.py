@@ -27,8 +27,68 @@ def float_to_fixed(value, fixed_point_one):
     return int(round(float(value) * float(fixed_point_one)))
 
 
+# The bits of the word before each exponential lookup table
+LUT_SIZE_MASK = 0xFFFF
+LUT_SHIFT_SHIFT = 16
+LUT_MAX_SHIFT = 16
+LUT_INTERPOLATE_BIT = 24
+LUT_SHARED_BIT = 25
+
+
+def check_exp_lut_parameters(size, shift):
+    """ Check that an exponential lookup table can have the given size and\
+        time shift.
+
+    :param size: the number of entries in the table
+    :param shift: the time is shifted right by this to index the table
+    :raises ValueError: if the table cannot be made
+    """
+    if not (1 <= size <= LUT_SIZE_MASK):
+        raise ValueError(
+            "The lookup table size must be in the interval [1, {}]".format(
+                LUT_SIZE_MASK))
+    if not (0 <= shift <= LUT_MAX_SHIFT):
+        raise ValueError(
+            "The lookup table time shift must be in the interval [0, {}]"
+            .format(LUT_MAX_SHIFT))
+
+
+def get_exp_lut_sdram_usage_in_bytes(size, shared=False):
+    """ Get the size of an exponential lookup table written by\
+        write_exp_lut
+
+    :param size: the number of entries in the table
+    :param shared: whether the table shares the entries of the one before
+    """
+    if shared:
+        return 4
+    return 4 + (4 * ((size + 1) // 2))
+
+
 def write_exp_lut(spec, time_constant, size, shift,
-                  fixed_point_one=STDP_FIXED_POINT_ONE):
+                  fixed_point_one=STDP_FIXED_POINT_ONE, interpolate=False,
+                  shared=False):
+    """ Write an exponential decay lookup table.
+
+    :param time_constant: the time constant of the decay
+    :param size: the number of entries in the table
+    :param shift: the time is shifted right by this to index the table
+    :param fixed_point_one: the fixed-point value of 1.0
+    :param interpolate: \
+        whether the machine should interpolate between the entries
+    :param shared: \
+        whether the table is the same as the one written before it, so\
+        only its header is written and the machine uses the entries of\
+        the one before
+    :return: the last entry of the table as a float (should be 0 if the\
+        table is long enough)
+    """
+    # pylint: disable=too-many-arguments
+    spec.write_value(
+        size | (shift << LUT_SHIFT_SHIFT) |
+        (int(bool(interpolate)) << LUT_INTERPOLATE_BIT) |
+        (int(bool(shared)) << LUT_SHARED_BIT))
+
     # Calculate time constant reciprocal
     time_constant_reciprocal = 1.0 / float(time_constant)
 
@@ -45,7 +105,12 @@ def write_exp_lut(spec, time_constant, size, shift,
 
         # Convert to fixed-point and write to spec
         last_value = float_to_fixed(exp_float, fixed_point_one)
-        spec.write_value(data=last_value, data_type=DataType.INT16)
+        if not shared:
+            spec.write_value(data=last_value, data_type=DataType.INT16)
+
+    # Pad to a whole number of words
+    if not shared and size % 2 != 0:
+        spec.write_value(data=0, data_type=DataType.INT16)
 
     # return last value reverted to float (should be 0 if correct)
     return float(last_value) / float(fixed_point_one)
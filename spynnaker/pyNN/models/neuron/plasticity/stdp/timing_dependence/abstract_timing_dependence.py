@@ -38,6 +38,13 @@ class AbstractTimingDependence(object):
         """ The number of bytes used by the pre-trace of the rule per neuron
         """
 
+    @property
+    def post_trace_n_bytes(self):
+        """ The number of bytes used by the post-trace of the rule per\
+            neuron; the traces of the rules are the same size
+        """
+        return self.pre_trace_n_bytes
+
     @abstractmethod
     def get_parameters_sdram_usage_in_bytes(self):
         """ Get the amount of SDRAM used by the parameters of this rule
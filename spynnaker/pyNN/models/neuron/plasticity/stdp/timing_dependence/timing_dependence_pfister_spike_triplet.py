@@ -26,18 +26,18 @@ from spynnaker.pyNN.models.neuron.plasticity.stdp.synapse_structure\
 
 logger = logging.getLogger(__name__)
 
-LOOKUP_TAU_PLUS_SIZE = 256
-LOOKUP_TAU_PLUS_SHIFT = 0
-LOOKUP_TAU_MINUS_SIZE = 256
-LOOKUP_TAU_MINUS_SHIFT = 0
-LOOKUP_TAU_X_SIZE = 256
-LOOKUP_TAU_X_SHIFT = 2
-LOOKUP_TAU_Y_SIZE = 256
-LOOKUP_TAU_Y_SHIFT = 2
+# Default decay lookup table parameters; the tau x and tau y tables are
+# indexed with a further shift of LOOKUP_TABLE_XY_EXTRA_SHIFT
+LOOKUP_TABLE_SIZE = 256
+LOOKUP_TABLE_SHIFT = 0
+LOOKUP_TABLE_XY_EXTRA_SHIFT = 2
 
 
 class TimingDependencePfisterSpikeTriplet(AbstractTimingDependence):
     __slots__ = [
+        "__lookup_table_interpolation",
+        "__lookup_table_shift",
+        "__lookup_table_size",
         "__synapse_structure",
         "__tau_minus",
         "__tau_minus_last_entry",
@@ -49,12 +49,23 @@ class TimingDependencePfisterSpikeTriplet(AbstractTimingDependence):
         "__tau_y_last_entry"]
 
     # noinspection PyPep8Naming
-    def __init__(self, tau_plus, tau_minus, tau_x, tau_y):
+    def __init__(self, tau_plus, tau_minus, tau_x, tau_y,
+                 lookup_table_size=LOOKUP_TABLE_SIZE,
+                 lookup_table_shift=LOOKUP_TABLE_SHIFT,
+                 lookup_table_interpolation=False):
+        # pylint: disable=too-many-arguments
         self.__tau_plus = tau_plus
         self.__tau_minus = tau_minus
         self.__tau_x = tau_x
         self.__tau_y = tau_y
 
+        plasticity_helpers.check_exp_lut_parameters(
+            lookup_table_size,
+            lookup_table_shift + LOOKUP_TABLE_XY_EXTRA_SHIFT)
+        self.__lookup_table_size = lookup_table_size
+        self.__lookup_table_shift = lookup_table_shift
+        self.__lookup_table_interpolation = lookup_table_interpolation
+
         self.__synapse_structure = SynapseStructureWeightOnly()
 
         # provenance data
@@ -79,6 +90,26 @@ class TimingDependencePfisterSpikeTriplet(AbstractTimingDependence):
     def tau_y(self):
         return self.__tau_y
 
+    @property
+    def lookup_table_size(self):
+        """ The number of entries in each decay lookup table
+        """
+        return self.__lookup_table_size
+
+    @property
+    def lookup_table_shift(self):
+        """ The time is shifted right by this to index the lookup tables, so\
+            each entry covers 2 ** shift timesteps; the tau x and tau y\
+            tables are shifted by LOOKUP_TABLE_XY_EXTRA_SHIFT more
+        """
+        return self.__lookup_table_shift
+
+    @property
+    def lookup_table_interpolation(self):
+        """ Whether the machine interpolates between lookup table entries
+        """
+        return self.__lookup_table_interpolation
+
     @overrides(AbstractTimingDependence.is_same_as)
     def is_same_as(self, timing_dependence):
         if not isinstance(
@@ -88,7 +119,13 @@ class TimingDependencePfisterSpikeTriplet(AbstractTimingDependence):
             (self.__tau_plus == timing_dependence.tau_plus) and
             (self.__tau_minus == timing_dependence.tau_minus) and
             (self.__tau_x == timing_dependence.tau_x) and
-            (self.__tau_y == timing_dependence.tau_y))
+            (self.__tau_y == timing_dependence.tau_y) and
+            (self.__lookup_table_size ==
+             timing_dependence.lookup_table_size) and
+            (self.__lookup_table_shift ==
+             timing_dependence.lookup_table_shift) and
+            (self.__lookup_table_interpolation ==
+             timing_dependence.lookup_table_interpolation))
 
     @property
     def vertex_executable_suffix(self):
@@ -102,8 +139,14 @@ class TimingDependencePfisterSpikeTriplet(AbstractTimingDependence):
 
     @overrides(AbstractTimingDependence.get_parameters_sdram_usage_in_bytes)
     def get_parameters_sdram_usage_in_bytes(self):
-        return (2 * (LOOKUP_TAU_PLUS_SIZE + LOOKUP_TAU_MINUS_SIZE +
-                     LOOKUP_TAU_X_SIZE + LOOKUP_TAU_Y_SIZE))
+        size = self.__lookup_table_size
+        return (
+            plasticity_helpers.get_exp_lut_sdram_usage_in_bytes(size) +
+            plasticity_helpers.get_exp_lut_sdram_usage_in_bytes(
+                size, shared=self.__tau_minus == self.__tau_plus) +
+            plasticity_helpers.get_exp_lut_sdram_usage_in_bytes(size) +
+            plasticity_helpers.get_exp_lut_sdram_usage_in_bytes(
+                size, shared=self.__tau_y == self.__tau_x))
 
     @property
     def n_weight_terms(self):
@@ -118,16 +161,22 @@ class TimingDependencePfisterSpikeTriplet(AbstractTimingDependence):
                 "STDP LUT generation currently only supports 1ms timesteps")
 
         # Write lookup tables
+        # **NOTE** the tau minus and tau y tables share the entries of the
+        # tau plus and tau x tables if they are the same
+        size = self.__lookup_table_size
+        shift = self.__lookup_table_shift
+        xy_shift = shift + LOOKUP_TABLE_XY_EXTRA_SHIFT
+        interpolate = self.__lookup_table_interpolation
         self.__tau_plus_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self.__tau_plus, LOOKUP_TAU_PLUS_SIZE,
-            LOOKUP_TAU_PLUS_SHIFT)
+            spec, self.__tau_plus, size, shift, interpolate=interpolate)
         self.__tau_minus_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self.__tau_minus, LOOKUP_TAU_MINUS_SIZE,
-            LOOKUP_TAU_MINUS_SHIFT)
+            spec, self.__tau_minus, size, shift, interpolate=interpolate,
+            shared=self.__tau_minus == self.__tau_plus)
         self.__tau_x_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self.__tau_x, LOOKUP_TAU_X_SIZE, LOOKUP_TAU_X_SHIFT)
+            spec, self.__tau_x, size, xy_shift, interpolate=interpolate)
         self.__tau_y_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self.__tau_y, LOOKUP_TAU_Y_SIZE, LOOKUP_TAU_Y_SHIFT)
+            spec, self.__tau_y, size, xy_shift, interpolate=interpolate,
+            shared=self.__tau_y == self.__tau_x)
 
     @property
     def synaptic_structure(self):
@@ -23,14 +23,16 @@ from .abstract_timing_dependence import AbstractTimingDependence
 
 logger = logging.getLogger(__name__)
 
-LOOKUP_TAU_PLUS_SIZE = 256
-LOOKUP_TAU_PLUS_SHIFT = 0
-LOOKUP_TAU_MINUS_SIZE = 256
-LOOKUP_TAU_MINUS_SHIFT = 0
+# Default decay lookup table parameters
+LOOKUP_TABLE_SIZE = 256
+LOOKUP_TABLE_SHIFT = 0
 
 
 class TimingDependenceSpikeNearestPair(AbstractTimingDependence):
     __slots__ = [
+        "__lookup_table_interpolation",
+        "__lookup_table_shift",
+        "__lookup_table_size",
         "__synapse_structure",
         "__tau_minus",
         "__tau_minus_last_entry",
@@ -40,10 +42,19 @@ class TimingDependenceSpikeNearestPair(AbstractTimingDependence):
     default_parameters = {'tau_plus': 20.0, 'tau_minus': 20.0}
 
     def __init__(self, tau_plus=default_parameters['tau_plus'],
-                 tau_minus=default_parameters['tau_minus']):
+                 tau_minus=default_parameters['tau_minus'],
+                 lookup_table_size=LOOKUP_TABLE_SIZE,
+                 lookup_table_shift=LOOKUP_TABLE_SHIFT,
+                 lookup_table_interpolation=False):
         self.__tau_plus = tau_plus
         self.__tau_minus = tau_minus
 
+        plasticity_helpers.check_exp_lut_parameters(
+            lookup_table_size, lookup_table_shift)
+        self.__lookup_table_size = lookup_table_size
+        self.__lookup_table_shift = lookup_table_shift
+        self.__lookup_table_interpolation = lookup_table_interpolation
+
         self.__synapse_structure = SynapseStructureWeightOnly()
 
         # provenance data
@@ -58,13 +69,38 @@ class TimingDependenceSpikeNearestPair(AbstractTimingDependence):
     def tau_minus(self):
         return self.__tau_minus
 
+    @property
+    def lookup_table_size(self):
+        """ The number of entries in each decay lookup table
+        """
+        return self.__lookup_table_size
+
+    @property
+    def lookup_table_shift(self):
+        """ The time is shifted right by this to index the lookup tables, so\
+            each entry covers 2 ** shift timesteps
+        """
+        return self.__lookup_table_shift
+
+    @property
+    def lookup_table_interpolation(self):
+        """ Whether the machine interpolates between lookup table entries
+        """
+        return self.__lookup_table_interpolation
+
     @overrides(AbstractTimingDependence.is_same_as)
     def is_same_as(self, timing_dependence):
         # pylint: disable=protected-access
         if not isinstance(timing_dependence, TimingDependenceSpikeNearestPair):
             return False
         return (self.__tau_plus == timing_dependence.tau_plus and
-                self.__tau_minus == timing_dependence.tau_minus)
+                self.__tau_minus == timing_dependence.tau_minus and
+                self.__lookup_table_size ==
+                timing_dependence.lookup_table_size and
+                self.__lookup_table_shift ==
+                timing_dependence.lookup_table_shift and
+                self.__lookup_table_interpolation ==
+                timing_dependence.lookup_table_interpolation)
 
     @property
     def vertex_executable_suffix(self):
@@ -79,7 +115,12 @@ class TimingDependenceSpikeNearestPair(AbstractTimingDependence):
 
     @overrides(AbstractTimingDependence.get_parameters_sdram_usage_in_bytes)
     def get_parameters_sdram_usage_in_bytes(self):
-        return 2 * (LOOKUP_TAU_PLUS_SIZE + LOOKUP_TAU_MINUS_SIZE)
+        return (
+            plasticity_helpers.get_exp_lut_sdram_usage_in_bytes(
+                self.__lookup_table_size) +
+            plasticity_helpers.get_exp_lut_sdram_usage_in_bytes(
+                self.__lookup_table_size,
+                shared=self.__tau_minus == self.__tau_plus))
 
     @property
     def n_weight_terms(self):
@@ -94,12 +135,17 @@ class TimingDependenceSpikeNearestPair(AbstractTimingDependence):
                 "STDP LUT generation currently only supports 1ms timesteps")
 
         # Write lookup tables
+        # **NOTE** the tau minus table shares the entries of the tau plus
+        # table if they are the same
         self.__tau_plus_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self.__tau_plus, LOOKUP_TAU_PLUS_SIZE,
-            LOOKUP_TAU_PLUS_SHIFT)
+            spec, self.__tau_plus, self.__lookup_table_size,
+            self.__lookup_table_shift,
+            interpolate=self.__lookup_table_interpolation)
         self.__tau_minus_last_entry = plasticity_helpers.write_exp_lut(
-            spec, self.__tau_minus, LOOKUP_TAU_MINUS_SIZE,
-            LOOKUP_TAU_MINUS_SHIFT)
+            spec, self.__tau_minus, self.__lookup_table_size,
+            self.__lookup_table_shift,
+            interpolate=self.__lookup_table_interpolation,
+            shared=self.__tau_minus == self.__tau_plus)
 
     @property
     def synaptic_structure(self):
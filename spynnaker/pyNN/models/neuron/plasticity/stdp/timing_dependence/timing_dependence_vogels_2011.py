@@ -25,23 +25,35 @@ from spynnaker.pyNN.models.neuron.plasticity.stdp.common import (
 
 logger = logging.getLogger(__name__)
 
-# Constants
-LOOKUP_TAU_SIZE = 256
-LOOKUP_TAU_SHIFT = 0
+# Default decay lookup table parameters
+LOOKUP_TABLE_SIZE = 256
+LOOKUP_TABLE_SHIFT = 0
 
 
 class TimingDependenceVogels2011(AbstractTimingDependence):
     __slots__ = [
         "__alpha",
+        "__lookup_table_interpolation",
+        "__lookup_table_shift",
+        "__lookup_table_size",
         "__synapse_structure",
         "__tau"]
 
     default_parameters = {'tau': 20.0}
 
-    def __init__(self, alpha, tau=default_parameters['tau']):
+    def __init__(self, alpha, tau=default_parameters['tau'],
+                 lookup_table_size=LOOKUP_TABLE_SIZE,
+                 lookup_table_shift=LOOKUP_TABLE_SHIFT,
+                 lookup_table_interpolation=False):
         self.__alpha = alpha
         self.__tau = tau
 
+        plasticity_helpers.check_exp_lut_parameters(
+            lookup_table_size, lookup_table_shift)
+        self.__lookup_table_size = lookup_table_size
+        self.__lookup_table_shift = lookup_table_shift
+        self.__lookup_table_interpolation = lookup_table_interpolation
+
         self.__synapse_structure = SynapseStructureWeightOnly()
 
     @property
@@ -52,6 +64,25 @@ class TimingDependenceVogels2011(AbstractTimingDependence):
     def tau(self):
         return self.__tau
 
+    @property
+    def lookup_table_size(self):
+        """ The number of entries in the decay lookup table
+        """
+        return self.__lookup_table_size
+
+    @property
+    def lookup_table_shift(self):
+        """ The time is shifted right by this to index the lookup table, so\
+            each entry covers 2 ** shift timesteps
+        """
+        return self.__lookup_table_shift
+
+    @property
+    def lookup_table_interpolation(self):
+        """ Whether the machine interpolates between lookup table entries
+        """
+        return self.__lookup_table_interpolation
+
     @overrides(AbstractTimingDependence.is_same_as)
     def is_same_as(self, timing_dependence):
         # pylint: disable=protected-access
@@ -59,7 +90,13 @@ class TimingDependenceVogels2011(AbstractTimingDependence):
                 timing_dependence, TimingDependenceVogels2011):
             return False
         return (self.__tau == timing_dependence.tau and
-                self.__alpha == timing_dependence.alpha)
+                self.__alpha == timing_dependence.alpha and
+                self.__lookup_table_size ==
+                timing_dependence.lookup_table_size and
+                self.__lookup_table_shift ==
+                timing_dependence.lookup_table_shift and
+                self.__lookup_table_interpolation ==
+                timing_dependence.lookup_table_interpolation)
 
     @property
     def vertex_executable_suffix(self):
@@ -73,7 +110,8 @@ class TimingDependenceVogels2011(AbstractTimingDependence):
 
     @overrides(AbstractTimingDependence.get_parameters_sdram_usage_in_bytes)
     def get_parameters_sdram_usage_in_bytes(self):
-        return 4 + (2 * LOOKUP_TAU_SIZE)
+        return 4 + plasticity_helpers.get_exp_lut_sdram_usage_in_bytes(
+            self.__lookup_table_size)
 
     @property
     def n_weight_terms(self):
@@ -94,7 +132,9 @@ class TimingDependenceVogels2011(AbstractTimingDependence):
 
         # Write lookup table
         plasticity_helpers.write_exp_lut(
-            spec, self.__tau, LOOKUP_TAU_SIZE, LOOKUP_TAU_SHIFT)
+            spec, self.__tau, self.__lookup_table_size,
+            self.__lookup_table_shift,
+            interpolate=self.__lookup_table_interpolation)
 
     @property
     def synaptic_structure(self):
@@ -45,14 +45,20 @@ class PopulationMachineVertex(
                ("SATURATION_COUNT", 1),
                ("BUFFER_OVERFLOW_COUNT", 2),
                ("CURRENT_TIMER_TIC", 3),
-               ("PLASTIC_SYNAPTIC_WEIGHT_SATURATION_COUNT", 4)])
+               ("PLASTIC_SYNAPTIC_WEIGHT_SATURATION_COUNT", 4),
+               ("BIT_FIELD_FILTERED_COUNT", 5),
+               ("PLASTIC_WRITE_BACKS_SKIPPED_COUNT", 6),
+               ("PLASTIC_WRITE_BACKS_SHORTENED_COUNT", 7),
+               ("PROCEDURAL_ROWS_GENERATED_COUNT", 8),
+               ("CONVOLUTION_SPIKES_PROCESSED_COUNT", 9)])
 
     PROFILE_TAG_LABELS = {
         0: "TIMER",
         1: "DMA_READ",
         2: "INCOMING_SPIKE",
         3: "PROCESS_FIXED_SYNAPSES",
-        4: "PROCESS_PLASTIC_SYNAPSES"}
+        4: "PROCESS_PLASTIC_SYNAPSES",
+        5: "POP_TABLE_LOOKUP"}
 
     N_ADDITIONAL_PROVENANCE_DATA_ITEMS = len(EXTRA_PROVENANCE_DATA_ENTRIES)
 
@@ -109,6 +115,20 @@ class PopulationMachineVertex(
         n_plastic_saturations = provenance_data[
             self.EXTRA_PROVENANCE_DATA_ENTRIES.
             PLASTIC_SYNAPTIC_WEIGHT_SATURATION_COUNT.value]
+        n_bit_field_filtered = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.BIT_FIELD_FILTERED_COUNT.value]
+        n_write_backs_skipped = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.
+            PLASTIC_WRITE_BACKS_SKIPPED_COUNT.value]
+        n_write_backs_shortened = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.
+            PLASTIC_WRITE_BACKS_SHORTENED_COUNT.value]
+        n_procedural_rows = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.
+            PROCEDURAL_ROWS_GENERATED_COUNT.value]
+        n_convolution_spikes = provenance_data[
+            self.EXTRA_PROVENANCE_DATA_ENTRIES.
+            CONVOLUTION_SPIKES_PROCESSED_COUNT.value]
 
         label, x, y, p, names = self._get_placement_details(placement)
 
@@ -151,6 +171,21 @@ class PopulationMachineVertex(
                 "spikes_per_second and / or ring_buffer_sigma values located "
                 "within the .spynnaker.cfg file.".format(
                     label, x, y, p, n_plastic_saturations))))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Spikes_dropped_with_no_synapses"),
+            n_bit_field_filtered))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Plastic_write_backs_skipped"),
+            n_write_backs_skipped))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Plastic_write_backs_shortened"),
+            n_write_backs_shortened))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Procedural_rows_generated"),
+            n_procedural_rows))
+        provenance_items.append(ProvenanceDataItem(
+            self._add_name(names, "Convolution_spikes_processed"),
+            n_convolution_spikes))
 
         return provenance_items
 
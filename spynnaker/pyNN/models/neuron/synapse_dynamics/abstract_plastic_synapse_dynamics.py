@@ -72,3 +72,19 @@ class AbstractPlasticSynapseDynamics(AbstractSynapseDynamics):
         """ Read the connections indicated in the connection indices from the\
             data in pp_data and fp_data
         """
+
+    def write_plastic_weights(
+            self, post_vertex_slice, n_synapse_types, pp_size, pp_data,
+            fp_size, fp_data, weights):
+        """ Replace the weights of the synapses in pp_data and fp_data,\
+            which are rows read from the machine, leaving the rest of each\
+            row as it is
+
+        :param weights: The new scaled weight of each synapse, in the order\
+            that read_plastic_synaptic_data gives the connections
+        :return: True if the weights were written, or False if they cannot\
+            be written in the format of the rows
+        :rtype: bool
+        """
+        # pylint: disable=unused-argument
+        return False
@@ -63,3 +63,18 @@ class AbstractStaticSynapseDynamics(AbstractSynapseDynamics):
             self, post_vertex_slice, n_synapse_types, ff_size, ff_data):
         """ Read the connections from the words of data in ff_data
         """
+
+    def write_static_weights(
+            self, post_vertex_slice, n_synapse_types, ff_size, ff_data,
+            weights):
+        """ Replace the weights of the synapses in ff_data, which are rows\
+            read from the machine, leaving the rest of each synapse as it is
+
+        :param weights: The new scaled weight of each synapse, in the order\
+            that read_static_synaptic_data gives the connections
+        :return: True if the weights were written, or False if they cannot\
+            be written in the format of the rows
+        :rtype: bool
+        """
+        # pylint: disable=unused-argument
+        return False
@@ -77,6 +77,16 @@ class AbstractSynapseDynamics(object):
         :rtype: bool
         """
 
+    def get_dtcm_usage_in_bytes(self, n_neurons, n_synapse_types):
+        """ Get the DTCM used by the synapse dynamics of a core in bytes
+
+        :param n_neurons: The number of neurons on the core
+        :param n_synapse_types: The number of synapse types
+        :rtype: int
+        """
+        # pylint: disable=unused-argument
+        return 0
+
     def get_provenance_data(self, pre_population_label, post_population_label):
         """ Get the provenance data from this synapse dynamics object
         """
@@ -111,6 +121,22 @@ class AbstractSynapseDynamics(object):
         # pylint: disable=too-many-arguments
         return connector.get_weight_variance(weights)
 
+    def get_synaptic_row_items(
+            self, connections, post_vertex_slice, n_synapse_types):
+        """ Get the data of each connection in each region of a synaptic\
+            row, for dynamics whose rows can be built in a single pass over\
+            the connections
+
+        :return: \
+            the number of bytes of the header of the plastic-plastic region,\
+            and the bytes of each connection in the plastic-plastic,\
+            fixed-fixed and fixed-plastic regions as arrays of uint8 of shape\
+            (n_connections, n_bytes), or None for a region that is not used;\
+            or None if the rows cannot be built in this way
+        """
+        # pylint: disable=unused-argument
+        return None
+
     def convert_per_connection_data_to_rows(
             self, connection_row_indices, n_rows, data):
         """ Converts per-connection data generated from connections into\
@@ -32,16 +32,51 @@ class SynapseDynamicsStatic(
         # ??????????
         "__change_requires_mapping",
         # padding to add to a synaptic row for synaptic rewiring
-        "__pad_to_length"]
+        "__pad_to_length",
+        # whether rows may be written in a compact format
+        "__compact_rows"]
 
-    def __init__(self, pad_to_length=None):
+    # The encodings of the synapses of a row (see synapse_row.h)
+    ROW_FORMAT_FULL = 0
+    ROW_FORMAT_SHARED_WEIGHT = 1
+    ROW_FORMAT_SHARED_DELAY = 2
+
+    # The format is in the top bits of the row synapse count
+    _ROW_FORMAT_SHIFT = 30
+    _ROW_COUNT_MASK = (1 << _ROW_FORMAT_SHIFT) - 1
+
+    # The bits of a compact synapse
+    _COMPACT_SYNAPSE_BITS = 16
+
+    def __init__(self, pad_to_length=None, compact_rows=False):
+        """
+        :param pad_to_length: the number of synapses to pad each row to
+        :param compact_rows: \
+            if True, a row whose synapses all have the same weight, or all\
+            have the same delay, is written with a half-word per synapse\
+            where this is smaller.  Such rows are generated on the host.
+        """
         self.__change_requires_mapping = True
         self.__pad_to_length = pad_to_length
+        self.__compact_rows = (
+            compact_rows and pad_to_length is None)
 
     @overrides(AbstractSynapseDynamics.is_same_as)
     def is_same_as(self, synapse_dynamics):
         return isinstance(synapse_dynamics, SynapseDynamicsStatic)
 
+    @property
+    def compact_rows(self):
+        """ True if rows may be written in a compact format
+        """
+        return self.__compact_rows
+
+    @overrides(AbstractGenerateOnMachine.generate_on_machine)
+    def generate_on_machine(self):
+
+        # The synapse expander only writes the full format
+        return not self.__compact_rows
+
     @overrides(AbstractSynapseDynamics.are_weights_signed)
     def are_weights_signed(self):
         return False
@@ -73,10 +108,46 @@ class SynapseDynamicsStatic(
             post_vertex_slice, n_synapse_types):
         # pylint: disable=too-many-arguments
         n_neuron_id_bits = get_n_bits(post_vertex_slice.n_atoms)
+        n_synapse_type_bits = get_n_bits(n_synapse_types)
+        fixed_fixed = self.__get_fixed_fixed_words(
+            connections, post_vertex_slice, n_synapse_types)
+        fixed_fixed_rows = self.convert_per_connection_data_to_rows(
+            connection_row_indices, n_rows,
+            fixed_fixed.view(dtype="uint8").reshape((-1, 4)))
+        ff_size = self.get_n_items(fixed_fixed_rows, 4)
+        if self.__pad_to_length is not None:
+            # Pad the data
+            fixed_fixed_rows = self._pad_row(fixed_fixed_rows, 4)
+        ff_data = [fixed_row.view("uint32") for fixed_row in fixed_fixed_rows]
+
+        if self.__compact_rows:
+            n_type_index_bits = n_neuron_id_bits + n_synapse_type_bits
+            for i, row in enumerate(ff_data):
+                ff_data[i], ff_size[i] = self.__compact_row(
+                    row, n_type_index_bits)
+
+        return ff_data, ff_size
+
+    @overrides(AbstractSynapseDynamics.get_synaptic_row_items)
+    def get_synaptic_row_items(
+            self, connections, post_vertex_slice, n_synapse_types):
+        # Padded and compact rows depend on the other synapses of the row
+        if self.__pad_to_length is not None or self.__compact_rows:
+            return None
+        fixed_fixed = self.__get_fixed_fixed_words(
+            connections, post_vertex_slice, n_synapse_types)
+        return 0, None, fixed_fixed.view(dtype="uint8").reshape((-1, 4)), None
+
+    @staticmethod
+    def __get_fixed_fixed_words(
+            connections, post_vertex_slice, n_synapse_types):
+        """ Get the word of each connection in a fixed-fixed region
+        """
+        n_neuron_id_bits = get_n_bits(post_vertex_slice.n_atoms)
         neuron_id_mask = (1 << n_neuron_id_bits) - 1
         n_synapse_type_bits = get_n_bits(n_synapse_types)
 
-        fixed_fixed = (
+        return (
             ((numpy.rint(numpy.abs(connections["weight"])).astype("uint32") &
               0xFFFF) << 16) |
             ((connections["delay"].astype("uint32") & 0xF) <<
@@ -85,16 +156,48 @@ class SynapseDynamicsStatic(
                 "uint32") << n_neuron_id_bits) |
             ((connections["target"] - post_vertex_slice.lo_atom) &
              neuron_id_mask))
-        fixed_fixed_rows = self.convert_per_connection_data_to_rows(
-            connection_row_indices, n_rows,
-            fixed_fixed.view(dtype="uint8").reshape((-1, 4)))
-        ff_size = self.get_n_items(fixed_fixed_rows, 4)
-        if self.__pad_to_length is not None:
-            # Pad the data
-            fixed_fixed_rows = self._pad_row(fixed_fixed_rows, 4)
-        ff_data = [fixed_row.view("uint32") for fixed_row in fixed_fixed_rows]
 
-        return ff_data, ff_size
+    def __compact_row(self, row, n_type_index_bits):
+        """ Convert a row of full synaptic words to the smallest format that\
+            represents it exactly
+
+        :return: the words of the row, and its synapse count and format
+        """
+        n_synapses = row.size
+        full = row, numpy.array([n_synapses], dtype="uint32")
+        if self.__n_compact_words(n_synapses) >= n_synapses:
+            return full
+
+        weights = row >> 16
+        delays = (row >> n_type_index_bits) & 0xF
+        type_index = row & ((1 << n_type_index_bits) - 1)
+        n_weight_bits = self._COMPACT_SYNAPSE_BITS - n_type_index_bits
+        if (numpy.all(weights == weights[0]) and
+                n_type_index_bits + 4 <= self._COMPACT_SYNAPSE_BITS):
+            row_format = self.ROW_FORMAT_SHARED_WEIGHT
+            shared = weights[0]
+            synapses = row & 0xFFFF
+        elif (n_weight_bits > 0 and numpy.all(delays == delays[0]) and
+                numpy.max(weights) < (1 << n_weight_bits)):
+            row_format = self.ROW_FORMAT_SHARED_DELAY
+            shared = delays[0]
+            synapses = (weights << n_type_index_bits) | type_index
+        else:
+            return full
+
+        # Two synapses per word, padded to a whole number of words
+        half_words = numpy.zeros(n_synapses + (n_synapses & 1), dtype="<u2")
+        half_words[:n_synapses] = synapses
+        words = numpy.concatenate((
+            numpy.array([shared], dtype="uint32"), half_words.view("<u4")))
+        size = numpy.array(
+            [(row_format << self._ROW_FORMAT_SHIFT) | n_synapses],
+            dtype="uint32")
+        return words, size
+
+    @staticmethod
+    def __n_compact_words(n_synapses):
+        return 1 + ((n_synapses + 1) // 2)
 
     def _pad_row(self, rows, no_bytes_per_connection):
         padded_rows = []
@@ -111,14 +214,18 @@ class SynapseDynamicsStatic(
     @overrides(AbstractStaticSynapseDynamics.get_n_static_words_per_row)
     def get_n_static_words_per_row(self, ff_size):
 
-        # The sizes are in words, so just return them
-        return ff_size
+        # Full rows have a word per synapse; compact rows have the shared
+        # value then a half-word per synapse
+        n_synapses = ff_size & self._ROW_COUNT_MASK
+        return numpy.where(
+            (ff_size >> self._ROW_FORMAT_SHIFT) == self.ROW_FORMAT_FULL,
+            n_synapses, self.__n_compact_words(n_synapses))
 
     @overrides(AbstractStaticSynapseDynamics.get_n_synapses_in_rows)
     def get_n_synapses_in_rows(self, ff_size):
 
-        # Each word is a synapse and sizes are in words, so just return them
-        return ff_size
+        # The count is below the format
+        return ff_size & self._ROW_COUNT_MASK
 
     @overrides(AbstractStaticSynapseDynamics.read_static_synaptic_data)
     def read_static_synaptic_data(
@@ -128,10 +235,15 @@ class SynapseDynamicsStatic(
         n_neuron_id_bits = get_n_bits(post_vertex_slice.n_atoms)
         neuron_id_mask = (1 << n_neuron_id_bits) - 1
 
-        data = numpy.concatenate(ff_data)
+        n_synapses = self.get_n_synapses_in_rows(ff_size)
+        data = numpy.concatenate([
+            self.__expand_row(
+                ff_size[i] >> self._ROW_FORMAT_SHIFT, n_synapses[i], row,
+                n_neuron_id_bits + n_synapse_type_bits)
+            for i, row in enumerate(ff_data)])
         connections = numpy.zeros(data.size, dtype=self.NUMPY_CONNECTORS_DTYPE)
         connections["source"] = numpy.concatenate(
-            [numpy.repeat(i, ff_size[i]) for i in range(len(ff_size))])
+            [numpy.repeat(i, n_synapses[i]) for i in range(len(ff_size))])
         connections["target"] = (
             (data & neuron_id_mask) + post_vertex_slice.lo_atom)
         connections["weight"] = (data >> 16) & 0xFFFF
@@ -141,6 +253,55 @@ class SynapseDynamicsStatic(
 
         return connections
 
+    def __expand_row(self, row_format, n_synapses, row, n_type_index_bits):
+        """ Convert a row in any format to full synaptic words
+        """
+        if row_format == self.ROW_FORMAT_FULL:
+            return row[:n_synapses]
+        shared = numpy.uint32(row[0])
+        synapses = row[1:].view("<u2")[:n_synapses].astype("uint32")
+        if row_format == self.ROW_FORMAT_SHARED_WEIGHT:
+            return (shared << 16) | synapses
+        type_index_mask = (1 << n_type_index_bits) - 1
+        return (
+            ((synapses >> n_type_index_bits) << 16) |
+            (shared << n_type_index_bits) | (synapses & type_index_mask))
+
+    @overrides(AbstractStaticSynapseDynamics.write_static_weights)
+    def write_static_weights(
+            self, post_vertex_slice, n_synapse_types, ff_size, ff_data,
+            weights):
+        # pylint: disable=too-many-arguments
+        n_type_index_bits = (
+            get_n_bits(post_vertex_slice.n_atoms) +
+            get_n_bits(n_synapse_types))
+        type_index_mask = (1 << n_type_index_bits) - 1
+        n_weight_bits = self._COMPACT_SYNAPSE_BITS - n_type_index_bits
+        weights = numpy.asarray(weights, dtype="uint32")
+        n_synapses = self.get_n_synapses_in_rows(ff_size)
+        ends = numpy.cumsum(n_synapses)
+        for i, row in enumerate(ff_data):
+            n = n_synapses[i]
+            if not n:
+                continue
+            row_weights = weights[ends[i] - n:ends[i]]
+            row_format = ff_size[i] >> self._ROW_FORMAT_SHIFT
+            if row_format == self.ROW_FORMAT_FULL:
+                row[:n] = (row[:n] & 0xFFFF) | (row_weights << 16)
+            elif row_format == self.ROW_FORMAT_SHARED_WEIGHT:
+                # The row can only stay compact if the weights still match
+                if numpy.any(row_weights != row_weights[0]):
+                    return False
+                row[0] = row_weights[0]
+            else:
+                if numpy.max(row_weights) >= (1 << n_weight_bits):
+                    return False
+                synapses = row[1:].view("<u2")[:n]
+                synapses[:] = (
+                    (row_weights << n_type_index_bits) |
+                    (synapses & type_index_mask))
+        return True
+
     @overrides(AbstractChangableAfterRun.requires_mapping)
     def requires_mapping(self):
         """ True if changes that have been made require that mapping be\
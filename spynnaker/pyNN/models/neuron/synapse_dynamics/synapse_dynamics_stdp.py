@@ -26,8 +26,18 @@ from spynnaker.pyNN.utilities.utility_calls import get_n_bits
 
 # How large are the time-stamps stored with each event
 TIME_STAMP_BYTES = 4
+# The pointers to the times and traces and the count and capacity of the
+# post-synaptic event history of a neuron (see post_events.h)
+POST_EVENT_HISTORY_BYTES = 4 + 4 + 2 + 2
 # When not using the MAD scheme, how many pre-synaptic events are buffered
 NUM_PRE_SYNAPTIC_EVENTS = 4
+# How many post-synaptic events are remembered per neuron by default
+DEFAULT_POST_EVENT_HISTORY_SIZE = 16
+# The most pre-synaptic events whose updates can be deferred in a row
+MAX_DEFERRED_PRE_SPIKES = 64
+# The most rows of a core that can have updates deferred in a run; this must
+# match MAX_ROWS_WITH_DEFERRED_SPIKES in synapse_dynamics_stdp_mad_impl.c
+MAX_ROWS_WITH_DEFERRED_SPIKES = 1024
 
 
 class SynapseDynamicsSTDP(
@@ -44,22 +54,46 @@ class SynapseDynamicsSTDP(
         # weight dependence to use for the STDP rule
         "__weight_dependence",
         # padding to add to a synaptic row for synaptic rewiring
-        "__pad_to_length"]
+        "__pad_to_length",
+        # number of post-synaptic events remembered per neuron
+        "__post_event_history_size",
+        # number of pre-synaptic spikes whose updates can be deferred per row
+        "__max_deferred_pre_spikes",
+        # Flag: whether deferred spikes deliver the stored weights rather
+        # than the weights that their update would give
+        "__approximate_deferred_weights"]
 
     def __init__(
             self, timing_dependence=None, weight_dependence=None,
             voltage_dependence=None, dendritic_delay_fraction=1.0,
-            pad_to_length=None):
+            pad_to_length=None,
+            post_event_history_size=DEFAULT_POST_EVENT_HISTORY_SIZE,
+            max_deferred_pre_spikes=0, approximate_deferred_weights=False):
         self.__timing_dependence = timing_dependence
         self.__weight_dependence = weight_dependence
         self.__dendritic_delay_fraction = float(dendritic_delay_fraction)
         self.__change_requires_mapping = True
         self.__pad_to_length = pad_to_length
+        self.__post_event_history_size = int(post_event_history_size)
+        self.__max_deferred_pre_spikes = int(max_deferred_pre_spikes)
+        self.__approximate_deferred_weights = bool(
+            approximate_deferred_weights)
 
         if not (0.5 <= self.__dendritic_delay_fraction <= 1.0):
             raise NotImplementedError(
                 "dendritic_delay_fraction must be in the interval [0.5, 1.0]")
 
+        # The history must hold a new event and the one before it
+        if not (2 <= self.__post_event_history_size <= 0xFFFF):
+            raise NotImplementedError(
+                "post_event_history_size must be in the interval [2, 65535]")
+
+        if not (0 <= self.__max_deferred_pre_spikes <=
+                MAX_DEFERRED_PRE_SPIKES):
+            raise NotImplementedError(
+                "max_deferred_pre_spikes must be in the interval [0, {}]"
+                .format(MAX_DEFERRED_PRE_SPIKES))
+
         if timing_dependence is None or weight_dependence is None:
             raise NotImplementedError(
                 "Both timing_dependence and weight_dependence must be"
@@ -126,6 +160,35 @@ class SynapseDynamicsSTDP(
     def dendritic_delay_fraction(self, new_value):
         self.__dendritic_delay_fraction = new_value
 
+    @property
+    def post_event_history_size(self):
+        """ The number of post-synaptic events remembered for each neuron,\
+            including the oldest, which is only used as the event before the\
+            others
+        """
+        return self.__post_event_history_size
+
+    @property
+    def max_deferred_pre_spikes(self):
+        """ The most pre-synaptic spikes whose weight updates can wait in\
+            each row until a post-synaptic neuron of the row might have\
+            spiked; 0 if every spike updates the weights.  Deferred spikes\
+            are delivered with the weights that their update gives, but only\
+            the row header is written back, and any still waiting at the end\
+            of a run are applied then.
+        """
+        return self.__max_deferred_pre_spikes
+
+    @property
+    def approximate_deferred_weights(self):
+        """ Whether deferred spikes are delivered with the weights stored in\
+            the row, without the updates of the spikes deferred before them.\
+            This saves working out the updates of the deferred spikes again\
+            for each spike, but changes the dynamics of the network, so it\
+            is off by default.
+        """
+        return self.__approximate_deferred_weights
+
     def is_same_as(self, synapse_dynamics):
         # pylint: disable=protected-access
         if not isinstance(synapse_dynamics, SynapseDynamicsSTDP):
@@ -136,7 +199,13 @@ class SynapseDynamicsSTDP(
             self.__weight_dependence.is_same_as(
                 synapse_dynamics.weight_dependence) and
             (self.__dendritic_delay_fraction ==
-             synapse_dynamics.dendritic_delay_fraction))
+             synapse_dynamics.dendritic_delay_fraction) and
+            (self.__post_event_history_size ==
+             synapse_dynamics.post_event_history_size) and
+            (self.__max_deferred_pre_spikes ==
+             synapse_dynamics.max_deferred_pre_spikes) and
+            (self.__approximate_deferred_weights ==
+             synapse_dynamics.approximate_deferred_weights))
 
     def are_weights_signed(self):
         return False
@@ -148,17 +217,49 @@ class SynapseDynamicsSTDP(
         return name
 
     def get_parameters_sdram_usage_in_bytes(self, n_neurons, n_synapse_types):
-        size = self.__timing_dependence.get_parameters_sdram_usage_in_bytes()
+        # The size of the post-synaptic event history, the number of
+        # pre-synaptic spikes that can be deferred, and how they are delivered
+        size = 3 * 4
+        size += self.__timing_dependence.get_parameters_sdram_usage_in_bytes()
         size += self.__weight_dependence.get_parameters_sdram_usage_in_bytes(
             n_synapse_types, self.__timing_dependence.n_weight_terms)
         return size
 
+    @overrides(AbstractPlasticSynapseDynamics.get_dtcm_usage_in_bytes)
+    def get_dtcm_usage_in_bytes(self, n_neurons, n_synapse_types):
+        # The post-synaptic event history of each neuron: the history
+        # structure and the times and traces of the events
+        size = n_neurons * (
+            POST_EVENT_HISTORY_BYTES + self.__post_event_history_size * (
+                TIME_STAMP_BYTES +
+                self.__timing_dependence.post_trace_n_bytes))
+
+        # The times and traces of the spikes applied to a row at once, and
+        # the list of the rows with deferred spikes
+        size += (self.__max_deferred_pre_spikes + 1) * (
+            TIME_STAMP_BYTES + self.__timing_dependence.pre_trace_n_bytes)
+        if self.__max_deferred_pre_spikes > 0:
+            size += MAX_ROWS_WITH_DEFERRED_SPIKES * 4
+
+        # The parameters, including any look-up tables, are copied to DTCM
+        size += self.get_parameters_sdram_usage_in_bytes(
+            n_neurons, n_synapse_types)
+        return size
+
     def write_parameters(self, spec, region, machine_time_step, weight_scales):
         spec.comment("Writing Plastic Parameters")
 
         # Switch focus to the region:
         spec.switch_write_focus(region)
 
+        # Write the size of the post-synaptic event history
+        spec.write_value(self.__post_event_history_size)
+
+        # Write the number of pre-synaptic spikes that can be deferred, and
+        # whether they are delivered with the stored weights
+        spec.write_value(self.__max_deferred_pre_spikes)
+        spec.write_value(int(self.__approximate_deferred_weights))
+
         # Write timing dependence parameters to region
         self.__timing_dependence.write_parameters(
             spec, machine_time_step, weight_scales)
@@ -176,7 +277,13 @@ class SynapseDynamicsSTDP(
 
         # The actual number of bytes is in a word-aligned struct, so work out
         # the number of bytes as a number of words
-        return int(math.ceil(float(n_bytes) / 4.0)) * 4
+        n_bytes = int(math.ceil(float(n_bytes) / 4.0)) * 4
+
+        # Deferred spikes need the buckets of the post-synaptic neurons, a
+        # count and a listed flag, and a timestamp each
+        if self.__max_deferred_pre_spikes > 0:
+            n_bytes += 8 + TIME_STAMP_BYTES * self.__max_deferred_pre_spikes
+        return n_bytes
 
     def get_n_words_for_plastic_connections(self, n_connections):
         synapse_structure = self.__timing_dependence.synaptic_structure
@@ -200,25 +307,9 @@ class SynapseDynamicsSTDP(
             self, connections, connection_row_indices, n_rows,
             post_vertex_slice, n_synapse_types):
         # pylint: disable=too-many-arguments
-        n_synapse_type_bits = get_n_bits(n_synapse_types)
-        n_neuron_id_bits = get_n_bits(post_vertex_slice.n_atoms)
-        neuron_id_mask = (1 << n_neuron_id_bits) - 1
-
-        dendritic_delays = (
-            connections["delay"] * self.__dendritic_delay_fraction)
-        axonal_delays = (
-            connections["delay"] * (1.0 - self.__dendritic_delay_fraction))
-
         # Get the fixed data
-        fixed_plastic = (
-            ((dendritic_delays.astype("uint16") & 0xF) <<
-             (n_neuron_id_bits + n_synapse_type_bits)) |
-            ((axonal_delays.astype("uint16") & 0xF) <<
-             (4 + n_neuron_id_bits + n_synapse_type_bits)) |
-            (connections["synapse_type"].astype("uint16")
-             << n_neuron_id_bits) |
-            ((connections["target"].astype("uint16") -
-              post_vertex_slice.lo_atom) & neuron_id_mask))
+        fixed_plastic = self.__get_fixed_plastic_half_words(
+            connections, post_vertex_slice, n_synapse_types)
         fixed_plastic_rows = self.convert_per_connection_data_to_rows(
             connection_row_indices, n_rows,
             fixed_plastic.view(dtype="uint8").reshape((-1, 2)))
@@ -228,20 +319,11 @@ class SynapseDynamicsSTDP(
             fixed_plastic_rows = self._pad_row(fixed_plastic_rows, 2)
         fp_data = self.get_words(fixed_plastic_rows)
 
-        # Get the plastic data by inserting the weight into the half-word
-        # specified by the synapse structure
-        synapse_structure = self.__timing_dependence.synaptic_structure
-        n_half_words = synapse_structure.get_n_half_words_per_connection()
-        half_word = synapse_structure.get_weight_half_word()
-        plastic_plastic = numpy.zeros(
-            len(connections) * n_half_words, dtype="uint16")
-        plastic_plastic[half_word::n_half_words] = \
-            numpy.rint(numpy.abs(connections["weight"])).astype("uint16")
-
-        # Convert the plastic data into groups of bytes per connection and
-        # then into rows
-        plastic_plastic = plastic_plastic.view(dtype="uint8").reshape(
-            (-1, n_half_words * 2))
+        # Get the plastic data as groups of bytes per connection and then
+        # convert it into rows
+        n_half_words = self.__timing_dependence.synaptic_structure.\
+            get_n_half_words_per_connection()
+        plastic_plastic = self.__get_plastic_plastic_bytes(connections)
         plastic_plastic_row_data = self.convert_per_connection_data_to_rows(
             connection_row_indices, n_rows, plastic_plastic)
 
@@ -261,6 +343,57 @@ class SynapseDynamicsSTDP(
 
         return fp_data, pp_data, fp_size, pp_size
 
+    @overrides(AbstractPlasticSynapseDynamics.get_synaptic_row_items)
+    def get_synaptic_row_items(
+            self, connections, post_vertex_slice, n_synapse_types):
+        # Padded rows depend on the other synapses of the row
+        if self.__pad_to_length is not None:
+            return None
+        fixed_plastic = self.__get_fixed_plastic_half_words(
+            connections, post_vertex_slice, n_synapse_types)
+        return (
+            self._n_header_bytes,
+            self.__get_plastic_plastic_bytes(connections), None,
+            fixed_plastic.view(dtype="uint8").reshape((-1, 2)))
+
+    def __get_fixed_plastic_half_words(
+            self, connections, post_vertex_slice, n_synapse_types):
+        """ Get the half-word of each connection in a fixed-plastic region
+        """
+        n_synapse_type_bits = get_n_bits(n_synapse_types)
+        n_neuron_id_bits = get_n_bits(post_vertex_slice.n_atoms)
+        neuron_id_mask = (1 << n_neuron_id_bits) - 1
+
+        dendritic_delays = (
+            connections["delay"] * self.__dendritic_delay_fraction)
+        axonal_delays = (
+            connections["delay"] * (1.0 - self.__dendritic_delay_fraction))
+
+        return (
+            ((dendritic_delays.astype("uint16") & 0xF) <<
+             (n_neuron_id_bits + n_synapse_type_bits)) |
+            ((axonal_delays.astype("uint16") & 0xF) <<
+             (4 + n_neuron_id_bits + n_synapse_type_bits)) |
+            (connections["synapse_type"].astype("uint16")
+             << n_neuron_id_bits) |
+            ((connections["target"].astype("uint16") -
+              post_vertex_slice.lo_atom) & neuron_id_mask))
+
+    def __get_plastic_plastic_bytes(self, connections):
+        """ Get the bytes of each connection in a plastic-plastic region, by\
+            inserting the weight into the half-word specified by the synapse\
+            structure
+        """
+        synapse_structure = self.__timing_dependence.synaptic_structure
+        n_half_words = synapse_structure.get_n_half_words_per_connection()
+        half_word = synapse_structure.get_weight_half_word()
+        plastic_plastic = numpy.zeros(
+            len(connections) * n_half_words, dtype="uint16")
+        plastic_plastic[half_word::n_half_words] = \
+            numpy.rint(numpy.abs(connections["weight"])).astype("uint16")
+        return plastic_plastic.view(dtype="uint8").reshape(
+            (-1, n_half_words * 2))
+
     def _pad_row(self, rows, no_bytes_per_connection):
         # Row elements are (individual) bytes
         return [
@@ -327,6 +460,23 @@ class SynapseDynamicsSTDP(
         connections["delay"][connections["delay"] == 0] = 16
         return connections
 
+    @overrides(AbstractPlasticSynapseDynamics.write_plastic_weights)
+    def write_plastic_weights(
+            self, post_vertex_slice, n_synapse_types, pp_size, pp_data,
+            fp_size, fp_data, weights):
+        # pylint: disable=too-many-arguments
+        synapse_structure = self.__timing_dependence.synaptic_structure
+        n_half_words = synapse_structure.get_n_half_words_per_connection()
+        half_word = synapse_structure.get_weight_half_word()
+        start = 0
+        for pp, size in zip(pp_data, fp_size):
+            # The pre-synaptic state in the header is left as it is
+            half_words = pp.view(dtype="uint8")[self._n_header_bytes:][
+                :size * n_half_words * 2].view("uint16")
+            half_words[half_word::n_half_words] = weights[start:start + size]
+            start += size
+        return True
+
     def get_weight_mean(self, connector, weights):
         # pylint: disable=too-many-arguments
 
@@ -112,7 +112,13 @@ class SynapseDynamicsStructuralSTDP(AbstractSynapseDynamicsStructural,
                                      stdp_model.weight_dependence,
                                      None,
                                      stdp_model.dendritic_delay_fraction,
-                                     pad_to_length=s_max)
+                                     pad_to_length=s_max,
+                                     post_event_history_size=stdp_model.
+                                     post_event_history_size,
+                                     max_deferred_pre_spikes=stdp_model.
+                                     max_deferred_pre_spikes,
+                                     approximate_deferred_weights=stdp_model.
+                                     approximate_deferred_weights)
         AbstractSynapseDynamicsStructural.__init__(self)
         self.__common_sp = CommonSP(
             stdp_model=self, f_rew=f_rew, weight=weight,
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2017-2019 The University of Manchester
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ *
+ *  \brief Packing of the connections of a synaptic matrix into rows on the
+ *         host, for row_packing.py
+ *
+ *  The connections are counted per row, then copied straight to their
+ *  place in the rows, so there are two passes over the connections and no
+ *  intermediate copies of them.  The buffers are only accessed through the
+ *  buffer protocol, so the extension does not need the numpy headers.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+//! The words of each row before the row data
+#define N_HEADER_WORDS 3
+
+static inline size_t n_words(size_t n_bytes) {
+    return (n_bytes + 3) >> 2;
+}
+
+//! \brief Pack the rows with the GIL released
+//! \return NULL on success, or the message of the error
+static const char *pack(
+        uint8_t *rows, size_t n_rows, size_t row_words,
+        const uint32_t *row_indices, size_t n_connections,
+        size_t pp_header_bytes,
+        const uint8_t *pp_items, size_t pp_bytes,
+        const uint8_t *ff_items, size_t ff_bytes,
+        const uint8_t *fp_items, size_t fp_bytes) {
+    const char *error = NULL;
+    size_t *counts = calloc(n_rows, sizeof(size_t));
+    size_t *ff_starts = malloc(n_rows * sizeof(size_t));
+    size_t *fp_starts = malloc(n_rows * sizeof(size_t));
+    if (n_rows > 0 && (counts == NULL || ff_starts == NULL ||
+            fp_starts == NULL)) {
+        error = "Out of memory";
+        goto done;
+    }
+
+    // Count the connections of each row
+    for (size_t i = 0; i < n_connections; i++) {
+        if (row_indices[i] >= n_rows) {
+            error = "Row index out of range";
+            goto done;
+        }
+        counts[row_indices[i]]++;
+    }
+
+    // Write the sizes of the regions, and find where the regions start
+    size_t row_bytes = row_words * sizeof(uint32_t);
+    for (size_t r = 0; r < n_rows; r++) {
+        uint32_t *row = (uint32_t *) &rows[r * row_bytes];
+        size_t pp_words = n_words(pp_header_bytes + (counts[r] * pp_bytes));
+        size_t ff_words = n_words(counts[r] * ff_bytes);
+        size_t fp_words = n_words(counts[r] * fp_bytes);
+        if (N_HEADER_WORDS + pp_words + ff_words + fp_words > row_words) {
+            error = "The rows are too long to pack";
+            goto done;
+        }
+        row[0] = (uint32_t) pp_words;
+        row[pp_words + 1] = (ff_bytes > 0) ? (uint32_t) counts[r] : 0;
+        row[pp_words + 2] = (fp_bytes > 0) ? (uint32_t) counts[r] : 0;
+        ff_starts[r] = (pp_words + N_HEADER_WORDS) * sizeof(uint32_t);
+        fp_starts[r] = ff_starts[r] + (ff_words * sizeof(uint32_t));
+        counts[r] = 0;
+    }
+
+    // Copy each connection to the next place in its row
+    size_t pp_start = sizeof(uint32_t) + pp_header_bytes;
+    for (size_t i = 0; i < n_connections; i++) {
+        size_t r = row_indices[i];
+        size_t position = counts[r]++;
+        uint8_t *row = &rows[r * row_bytes];
+        memcpy(&row[pp_start + (position * pp_bytes)],
+            &pp_items[i * pp_bytes], pp_bytes);
+        memcpy(&row[ff_starts[r] + (position * ff_bytes)],
+            &ff_items[i * ff_bytes], ff_bytes);
+        memcpy(&row[fp_starts[r] + (position * fp_bytes)],
+            &fp_items[i * fp_bytes], fp_bytes);
+    }
+
+done:
+    free(counts);
+    free(ff_starts);
+    free(fp_starts);
+    return error;
+}
+
+static PyObject *pack_rows(PyObject *self, PyObject *args) {
+    Py_buffer rows, row_indices, pp_items, ff_items, fp_items;
+    Py_ssize_t n_rows, row_words, pp_header_bytes;
+    Py_ssize_t pp_bytes, ff_bytes, fp_bytes;
+    (void) self;
+
+    if (!PyArg_ParseTuple(args, "w*s*nnns*ns*ns*n",
+            &rows, &row_indices, &n_rows, &row_words, &pp_header_bytes,
+            &pp_items, &pp_bytes, &ff_items, &ff_bytes,
+            &fp_items, &fp_bytes)) {
+        return NULL;
+    }
+
+    const char *error = NULL;
+    size_t n_connections = row_indices.len / sizeof(uint32_t);
+    if (n_rows < 0 || row_words < N_HEADER_WORDS || pp_header_bytes < 0 ||
+            pp_bytes < 0 || ff_bytes < 0 || fp_bytes < 0) {
+        error = "Negative size";
+    } else if ((size_t) rows.len <
+            (size_t) n_rows * row_words * sizeof(uint32_t)) {
+        error = "The rows buffer is too small";
+    } else if ((size_t) pp_items.len != n_connections * pp_bytes ||
+            (size_t) ff_items.len != n_connections * ff_bytes ||
+            (size_t) fp_items.len != n_connections * fp_bytes) {
+        error = "The items do not match the number of connections";
+    } else {
+        Py_BEGIN_ALLOW_THREADS
+        error = pack(
+            rows.buf, n_rows, row_words, row_indices.buf, n_connections,
+            pp_header_bytes, pp_items.buf, pp_bytes, ff_items.buf, ff_bytes,
+            fp_items.buf, fp_bytes);
+        Py_END_ALLOW_THREADS
+    }
+
+    PyBuffer_Release(&rows);
+    PyBuffer_Release(&row_indices);
+    PyBuffer_Release(&pp_items);
+    PyBuffer_Release(&ff_items);
+    PyBuffer_Release(&fp_items);
+    if (error != NULL) {
+        PyErr_SetString(PyExc_ValueError, error);
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef row_packing_methods[] = {
+    {"pack_rows", pack_rows, METH_VARARGS,
+        "pack_rows(rows, row_indices, n_rows, row_words, pp_header_bytes, "
+        "pp_items, pp_bytes, ff_items, ff_bytes, fp_items, fp_bytes)\n\n"
+        "Pack the bytes of each connection into zeroed rows"},
+    {NULL, NULL, 0, NULL}
+};
+
+#if PY_MAJOR_VERSION >= 3
+static struct PyModuleDef row_packing_module = {
+    PyModuleDef_HEAD_INIT, "_row_packing", NULL, -1, row_packing_methods,
+    NULL, NULL, NULL, NULL
+};
+
+PyMODINIT_FUNC PyInit__row_packing(void) {
+    return PyModule_Create(&row_packing_module);
+}
+#else
+PyMODINIT_FUNC init_row_packing(void) {
+    Py_InitModule("_row_packing", row_packing_methods);
+}
+#endif
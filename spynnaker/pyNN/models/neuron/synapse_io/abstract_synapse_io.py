@@ -58,6 +58,20 @@ class AbstractSynapseIO(object):
             object out of the given data
         """
 
+    @abstractmethod
+    def write_weights(
+            self, synapse_info, pre_vertex_slice, post_vertex_slice,
+            max_row_length, delayed_max_row_length, n_synapse_types,
+            weight_scales, data, delayed_data):
+        """ Replace the weights of the synapses for a given projection\
+            synapse information object in the given data, read from the\
+            machine, with the weights now in the synapse information
+
+        :return: True if the weights were written, or False if the\
+            synapses must be generated again to change their weights
+        :rtype: bool
+        """
+
     @abstractmethod
     def get_block_n_bytes(self, max_row_length, n_rows):
         """ Get the number of bytes in a block given the max row length and\
@@ -0,0 +1,164 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+""" Building synaptic rows from the data of each connection in a single\
+    pass, rather than splitting the connections into a list per row and\
+    joining the lists.
+
+A row is laid out as::
+
+    | pp size | pp header, pp data | ff size | fp size | ff data | fp data |
+
+followed by padding to the maximum row length; the sizes of the fixed\
+regions are numbers of connections, and the size of the plastic region is\
+a number of words.  The rows are packed by the compiled extension\
+``_row_packing`` where it has been built, and with numpy otherwise.
+"""
+
+import numpy
+try:
+    from ._row_packing import pack_rows as _native_pack_rows
+except ImportError:
+    _native_pack_rows = None
+
+#: The words of each row before the row data
+N_HEADER_WORDS = 3
+
+
+def native_row_packing_available():
+    """ Determine if the compiled row packing extension has been built
+
+    :rtype: bool
+    """
+    return _native_pack_rows is not None
+
+
+def _n_words(n_bytes):
+    return (n_bytes + 3) // 4
+
+
+def _items(items, n_connections):
+    """ Get the bytes of each connection in a region as a contiguous array
+    """
+    if items is None:
+        return numpy.zeros((n_connections, 0), dtype="uint8")
+    items = numpy.ascontiguousarray(items, dtype="uint8")
+    if items.ndim != 2:
+        # The width of each item cannot be found when there are none
+        items = items.reshape((n_connections, -1))
+    return items
+
+
+def get_row_length(n_connections, pp_header_bytes, pp_items, ff_items,
+                   fp_items):
+    """ Get the number of words of row data (without the header words) of a\
+        row with a number of connections
+
+    :param n_connections: The number of connections in the row
+    :param pp_header_bytes: The bytes of the plastic-plastic header
+    :param pp_items: The plastic-plastic bytes of each connection, or None
+    :param ff_items: The fixed-fixed bytes of each connection, or None
+    :param fp_items: The fixed-plastic bytes of each connection, or None
+    :rtype: int
+    """
+    pp_bytes, ff_bytes, fp_bytes = (
+        0 if items is None else items.shape[1]
+        for items in (pp_items, ff_items, fp_items))
+    return (
+        _n_words(pp_header_bytes + (n_connections * pp_bytes)) +
+        _n_words(n_connections * ff_bytes) +
+        _n_words(n_connections * fp_bytes))
+
+
+def pack_rows(row_indices, n_rows, max_row_length, pp_header_bytes,
+              pp_items, ff_items, fp_items, use_native=True):
+    """ Build the rows of a synaptic matrix
+
+    :param row_indices: The row of each connection
+    :param n_rows: The number of rows
+    :param max_row_length: \
+        The number of words of row data to pad each row to; this must be at\
+        least the length of the longest row
+    :param pp_header_bytes: The bytes of the plastic-plastic header
+    :param pp_items: The plastic-plastic bytes of each connection, or None
+    :param ff_items: The fixed-fixed bytes of each connection, or None
+    :param fp_items: The fixed-plastic bytes of each connection, or None
+    :param use_native: False to pack with numpy even if the extension has\
+        been built
+    :return: The rows, one after the other
+    :rtype: numpy array of uint32
+    """
+    n_connections = len(row_indices)
+    row_indices = numpy.ascontiguousarray(row_indices, dtype="uint32")
+    pp_items = _items(pp_items, n_connections)
+    ff_items = _items(ff_items, n_connections)
+    fp_items = _items(fp_items, n_connections)
+    rows = numpy.zeros(
+        (n_rows, max_row_length + N_HEADER_WORDS), dtype="uint32")
+    if use_native and _native_pack_rows is not None:
+        _native_pack_rows(
+            rows, row_indices, n_rows, max_row_length + N_HEADER_WORDS,
+            pp_header_bytes, pp_items, pp_items.shape[1],
+            ff_items, ff_items.shape[1], fp_items, fp_items.shape[1])
+    else:
+        _pack_rows_numpy(
+            rows, row_indices, pp_header_bytes, pp_items, ff_items, fp_items)
+    return rows.reshape(-1)
+
+
+def _pack_rows_numpy(
+        rows, row_indices, pp_header_bytes, pp_items, ff_items, fp_items):
+    """ Build the rows by sorting the connections by row, keeping the\
+        order of the connections within each row
+    """
+    n_rows, row_words = rows.shape
+    counts = numpy.bincount(row_indices, minlength=n_rows)
+    pp_words = _n_words(pp_header_bytes + (counts * pp_items.shape[1]))
+    ff_words = _n_words(counts * ff_items.shape[1])
+    fp_words = _n_words(counts * fp_items.shape[1])
+    if n_rows and numpy.max(pp_words + ff_words + fp_words) > (
+            row_words - N_HEADER_WORDS):
+        raise ValueError("The rows are too long to pack")
+
+    # The sizes of each region
+    row_ids = numpy.arange(n_rows)
+    rows[:, 0] = pp_words
+    if ff_items.shape[1]:
+        rows[row_ids, pp_words + 1] = counts
+    if fp_items.shape[1]:
+        rows[row_ids, pp_words + 2] = counts
+
+    # The position of each connection in its row
+    order = numpy.argsort(row_indices, kind="mergesort")
+    sorted_rows = row_indices[order].astype("int64")
+    row_starts = numpy.cumsum(counts) - counts
+    positions = numpy.arange(len(order)) - row_starts[sorted_rows]
+
+    # The bytes of each region, starting from the start of the row
+    ff_start = (pp_words + N_HEADER_WORDS) * 4
+    region_starts = (
+        (pp_items, numpy.full(n_rows, 4 + pp_header_bytes)),
+        (ff_items, ff_start),
+        (fp_items, ff_start + (ff_words * 4)))
+    row_bytes = rows.view("uint8").reshape(-1)
+    for items, region_start in region_starts:
+        n_bytes = items.shape[1]
+        if not n_bytes:
+            continue
+        starts = (
+            (sorted_rows * (row_words * 4)) +
+            region_start[sorted_rows] + (positions * n_bytes))
+        for byte in range(n_bytes):
+            row_bytes[starts + byte] = items[order, byte]
@@ -22,6 +22,7 @@ from spynnaker.pyNN.models.neural_projections.connectors import (
 from spynnaker.pyNN.exceptions import SynapseRowTooBigException
 from .abstract_synapse_io import AbstractSynapseIO
 from .max_row_info import MaxRowInfo
+from .row_packing import get_row_length, pack_rows
 from spynnaker.pyNN.models.neuron.synapse_dynamics import (
     SynapseDynamicsStructuralStatic, SynapseDynamicsStructuralSTDP,
     AbstractStaticSynapseDynamics, AbstractSynapseDynamicsStructural,
@@ -37,7 +38,16 @@ class SynapseIORowBased(AbstractSynapseIO):
         actually change).  The plastic region structure is determined by the\
         synapse dynamics of the connector.
     """
-    __slots__ = []
+    __slots__ = [
+        # The cache of the blocks of the connectors, or None if not cached
+        "__block_cache"]
+
+    def __init__(self, block_cache=None):
+        """
+        :param block_cache: The cache of the blocks of the connectors, if any
+        :type block_cache: SynapticBlockCache or None
+        """
+        self.__block_cache = block_cache
 
     @overrides(AbstractSynapseIO.get_maximum_delay_supported_in_ms)
     def get_maximum_delay_supported_in_ms(self, machine_time_step):
@@ -129,6 +139,21 @@ class SynapseIORowBased(AbstractSynapseIO):
             n_synapse_types, population_table, synapse_dynamics,
             app_edge, machine_edge):
         # pylint: disable=too-many-arguments, too-many-locals
+        # Build the rows in one pass where the dynamics allow it
+        row_items = None
+        if not isinstance(synapse_dynamics, AbstractSynapseDynamicsStructural):
+            row_items = synapse_dynamics.get_synaptic_row_items(
+                connections, post_vertex_slice, n_synapse_types)
+        if row_items is not None:
+            counts = numpy.bincount(
+                row_indices.astype("uint32"), minlength=n_rows)
+            max_length = get_row_length(int(numpy.max(counts)), *row_items)
+            max_row_length = population_table.get_allowed_row_length(
+                max_length)
+            row_data = pack_rows(
+                row_indices, n_rows, max_row_length, *row_items)
+            return max_row_length, row_data
+
         row_ids = range(n_rows)
         ff_data, ff_size = None, None
         fp_data, pp_data, fp_size, pp_size = None, None, None, None
@@ -206,10 +231,16 @@ class SynapseIORowBased(AbstractSynapseIO):
             max_delay *= (1000.0 / machine_time_step)
 
         # Get the actual connections
-        connections = synapse_info.connector.create_synaptic_block(
-            synapse_info.weight, synapse_info.delay, pre_slices,
-            pre_slice_index, post_slices, post_slice_index, pre_vertex_slice,
-            post_vertex_slice, synapse_info.synapse_type)
+        if self.__block_cache is not None:
+            connections = self.__block_cache.create_synaptic_block(
+                synapse_info, pre_slices, pre_slice_index, post_slices,
+                post_slice_index, pre_vertex_slice, post_vertex_slice)
+        else:
+            connections = synapse_info.connector.create_synaptic_block(
+                synapse_info.weight, synapse_info.delay, pre_slices,
+                pre_slice_index, post_slices, post_slice_index,
+                pre_vertex_slice, post_vertex_slice,
+                synapse_info.synapse_type)
 
         # Convert delays to timesteps
         connections["delay"] = numpy.rint(
@@ -332,6 +363,64 @@ class SynapseIORowBased(AbstractSynapseIO):
         # Return the connections
         return connections
 
+    @overrides(AbstractSynapseIO.write_weights)
+    def write_weights(
+            self, synapse_info, pre_vertex_slice, post_vertex_slice,
+            max_row_length, delayed_max_row_length, n_synapse_types,
+            weight_scales, data, delayed_data):
+        # pylint: disable=too-many-arguments, too-many-locals, arguments-differ
+        dynamics = synapse_info.synapse_dynamics
+        is_static = (
+            isinstance(dynamics, AbstractStaticSynapseDynamics) or
+            isinstance(dynamics, SynapseDynamicsStructuralStatic))
+
+        # Find the synapses of each block; the rows are views of the data
+        blocks = list()
+        for block_data, row_length in (
+                (data, max_row_length),
+                (delayed_data, delayed_max_row_length)):
+            if block_data is None or not len(block_data):
+                continue
+            row_data = numpy.frombuffer(block_data, dtype="<u4").reshape(
+                -1, (row_length + _N_HEADER_WORDS))
+            if is_static:
+                rows = self._parse_static_data(row_data, dynamics)
+                n_synapses = dynamics.get_n_synapses_in_rows(rows[0])
+            else:
+                rows = self._parse_plastic_data(row_data, dynamics)
+                n_synapses = dynamics.get_n_synapses_in_rows(
+                    rows[0], rows[2])
+            blocks.append((int(numpy.sum(n_synapses)), rows))
+
+        # Draw the weights of all the blocks at once, scaled as when written
+        weights = synapse_info.connector.generate_replacement_weights(
+            synapse_info.weight, sum(n for n, _ in blocks),
+            pre_vertex_slice, post_vertex_slice)
+        if weights is None:
+            return False
+        weights = numpy.rint(
+            weights * weight_scales[synapse_info.synapse_type])
+        if weights.size and numpy.max(weights) > 0xFFFF:
+            # The ring buffer shifts must change too
+            return False
+        weights = weights.astype("uint32")
+
+        start = 0
+        for n_synapses, rows in blocks:
+            block_weights = weights[start:start + n_synapses]
+            start += n_synapses
+            if is_static:
+                written = dynamics.write_static_weights(
+                    post_vertex_slice, n_synapse_types, *rows,
+                    weights=block_weights)
+            else:
+                written = dynamics.write_plastic_weights(
+                    post_vertex_slice, n_synapse_types, *rows,
+                    weights=block_weights)
+            if not written:
+                return False
+        return True
+
     @staticmethod
     def _parse_static_data(row_data, dynamics):
         n_rows = row_data.shape[0]
@@ -0,0 +1,341 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import hashlib
+import logging
+import os
+import tempfile
+import threading
+import numpy
+from six import string_types
+from spinn_utilities.log import FormatAdapter
+from spinn_front_end_common.utilities.globals_variables import get_simulator
+
+logger = FormatAdapter(logging.getLogger(__name__))
+
+# Changed when the blocks made by the connectors change, so that blocks
+# made by older versions are not reused
+_CACHE_VERSION = b"synaptic block 1"
+
+_SCALAR_TYPES = (
+    bool, int, float, complex, numpy.number, numpy.bool_) + string_types
+
+
+def _mangle(cls, name):
+    """ Get the name of an attribute as it is stored on an object
+    """
+    if name.startswith("__") and not name.endswith("__"):
+        return "_{}{}".format(cls.__name__.lstrip("_"), name)
+    return name
+
+
+def _update_hash(hasher, value):
+    """ Add a value to a hash
+
+    :return: False if the value is of a type whose contents cannot be hashed
+    :rtype: bool
+    """
+    # pylint: disable=too-many-return-statements
+    if value is None or isinstance(value, _SCALAR_TYPES):
+        hasher.update(repr((type(value).__name__, value)).encode("utf-8"))
+        return True
+    if isinstance(value, type):
+        hasher.update("type {}.{}".format(
+            value.__module__, value.__name__).encode("utf-8"))
+        return True
+    if isinstance(value, numpy.ndarray):
+        if value.dtype.hasobject:
+            return False
+        hasher.update(repr((value.dtype.descr, value.shape)).encode("utf-8"))
+        hasher.update(numpy.ascontiguousarray(value).view("uint8"))
+        return True
+    if isinstance(value, (list, tuple)):
+        hasher.update("sequence {}".format(len(value)).encode("utf-8"))
+        return all(_update_hash(hasher, item) for item in value)
+    if get_simulator().is_a_pynn_random(value):
+        # The seed of the values of each block is added separately
+        hasher.update("random {}".format(value.name).encode("utf-8"))
+        parameters = value.parameters
+        return all(
+            _update_hash(hasher, (name, parameters[name]))
+            for name in sorted(parameters))
+    return False
+
+
+def _is_seeded(rng):
+    """ Determine if a random number generator gives the same numbers in\
+        each run
+    """
+    return rng is not None and getattr(rng, "seed", None) is not None
+
+
+def _connector_state(connector):
+    """ Get the attributes of a connector that describe its connections
+
+    :return: a list of name, value pairs, sorted by name
+    """
+    excluded = set()
+    names = set()
+    for cls in type(connector).__mro__:
+        excluded.update(
+            _mangle(cls, name)
+            for name in cls.__dict__.get("_BLOCK_KEY_EXCLUDED", ()))
+        slots = cls.__dict__.get("__slots__", ())
+        if isinstance(slots, string_types):
+            slots = (slots, )
+        names.update(_mangle(cls, name) for name in slots)
+    names.update(getattr(connector, "__dict__", ()))
+    return [(name, getattr(connector, name, None))
+            for name in sorted(names - excluded)]
+
+
+class SynapticBlockCache(object):
+    """ A cache on disk of the synaptic blocks made by connectors, so that\
+        later runs of the same network can skip making them.
+
+    Each block is stored in a numpy file named by a hash of everything the\
+    block depends on: the type and state of the connector, its seeds for\
+    the pair of slices, the weights and delays, and the slices.  The files\
+    are memory-mapped when they are read.  The blocks of connectors whose\
+    state cannot be hashed are never cached, and neither are the blocks\
+    whose connections, weights or delays are drawn from random numbers that\
+    are not seeded, as these are different in every run anyway.
+
+    If the files come to more than a given size, those least recently used\
+    are removed until they fit again.
+    """
+
+    __slots__ = [
+        # The directory holding the blocks
+        "__directory",
+
+        # The hash of the state of each connector, by id of the connector;
+        # the state is not expected to change once blocks have been made
+        "__connector_hashes",
+
+        # The most bytes the files of the blocks may take up, or None if
+        # there is no limit
+        "__max_bytes",
+
+        # The bytes taken up by the files of the blocks, or None if the
+        # directory has not been scanned yet
+        "__n_bytes",
+
+        # Guards the count of bytes, as blocks may be made on many threads
+        "__lock"]
+
+    def __init__(self, directory, max_bytes=None):
+        """
+        :param directory: The directory to keep the blocks in
+        :type directory: str
+        :param max_bytes: \
+            The most bytes the files of the blocks may take up, or None if\
+            there is no limit
+        :type max_bytes: int or None
+        """
+        self.__directory = directory
+        self.__connector_hashes = dict()
+        self.__max_bytes = max_bytes
+        self.__n_bytes = None
+        self.__lock = threading.Lock()
+
+    @property
+    def directory(self):
+        return self.__directory
+
+    def __connector_hash(self, connector):
+        cached = self.__connector_hashes.get(id(connector))
+        if cached is not None and cached[0] is connector:
+            return cached[1]
+        hasher = hashlib.sha256(_CACHE_VERSION)
+        cls = type(connector)
+        hashable = _update_hash(hasher, "{}.{}".format(
+            cls.__module__, cls.__name__))
+        for name, value in _connector_state(connector):
+            if not hashable:
+                break
+            hashable = _update_hash(hasher, (name, value))
+        digest = hasher.hexdigest() if hashable else None
+
+        # Keep the connector so that its id is not reused
+        self.__connector_hashes[id(connector)] = (connector, digest)
+        return digest
+
+    def get_key(
+            self, synapse_info, pre_slices, pre_slice_index, post_slices,
+            post_slice_index, pre_vertex_slice, post_vertex_slice):
+        """ Get the key of the block of a pair of slices; the connector must\
+            have prepared the block
+
+        :return: the key, or None if the block cannot be cached
+        :rtype: str or None
+        """
+        # pylint: disable=too-many-arguments
+        connector = synapse_info.connector
+        if not self.__is_repeatable(synapse_info):
+            return None
+        connector_hash = self.__connector_hash(connector)
+        if connector_hash is None:
+            return None
+        hasher = hashlib.sha256(connector_hash.encode("utf-8"))
+        if not _update_hash(hasher, (
+                synapse_info.weight, synapse_info.delay,
+                synapse_info.synapse_type,
+                connector.get_block_seeds(
+                    synapse_info.weight, synapse_info.delay,
+                    pre_vertex_slice, post_vertex_slice),
+                [(s.lo_atom, s.hi_atom) for s in pre_slices], pre_slice_index,
+                [(s.lo_atom, s.hi_atom) for s in post_slices],
+                post_slice_index,
+                (pre_vertex_slice.lo_atom, pre_vertex_slice.hi_atom),
+                (post_vertex_slice.lo_atom, post_vertex_slice.hi_atom))):
+            return None
+        return hasher.hexdigest()
+
+    @staticmethod
+    def __is_repeatable(synapse_info):
+        """ Determine if the block of a projection is the same in each run,\
+            as every random number it draws is seeded
+        """
+        connector = synapse_info.connector
+        if (getattr(connector, "_DRAWS_RANDOM_NUMBERS", False) and
+                not _is_seeded(getattr(connector, "_rng", None))):
+            return False
+        return all(
+            _is_seeded(getattr(values, "rng", None))
+            for values in (synapse_info.weight, synapse_info.delay)
+            if get_simulator().is_a_pynn_random(values))
+
+    def __path(self, key):
+        return os.path.join(self.__directory, key[:2], key + ".npy")
+
+    def create_synaptic_block(
+            self, synapse_info, pre_slices, pre_slice_index, post_slices,
+            post_slice_index, pre_vertex_slice, post_vertex_slice):
+        """ Get the block of a pair of slices from the cache, or make it\
+            with the connector and add it to the cache
+
+        :return: The block; this is a copy-on-write memory map of the cached\
+            file if there is one
+        """
+        # pylint: disable=too-many-arguments
+        key = self.get_key(
+            synapse_info, pre_slices, pre_slice_index, post_slices,
+            post_slice_index, pre_vertex_slice, post_vertex_slice)
+        if key is not None:
+            block = self.__load(self.__path(key))
+            if block is not None:
+                return block
+
+        block = synapse_info.connector.create_synaptic_block(
+            synapse_info.weight, synapse_info.delay, pre_slices,
+            pre_slice_index, post_slices, post_slice_index, pre_vertex_slice,
+            post_vertex_slice, synapse_info.synapse_type)
+        if key is not None and self.__save(self.__path(key), block):
+            self.__add_bytes(os.path.getsize(self.__path(key)))
+        return block
+
+    @staticmethod
+    def __load(path):
+        if not os.path.exists(path):
+            return None
+        try:
+            # Mark the file as used, so that it is the last to be removed
+            os.utime(path, None)
+            return numpy.load(path, mmap_mode="c")
+        except ValueError:
+            # Empty blocks cannot be mapped by some versions of numpy
+            try:
+                return numpy.load(path)
+            except (IOError, OSError, ValueError):
+                return None
+        except (IOError, OSError):
+            return None
+
+    def __files(self):
+        """ Get the files of the blocks in the directory
+
+        :return: the time each was last used, its size and its path
+        :rtype: list(tuple(float, int, str))
+        """
+        files = list()
+        for directory, _, names in os.walk(self.__directory):
+            for name in names:
+                if not name.endswith(".npy"):
+                    continue
+                path = os.path.join(directory, name)
+                try:
+                    stat = os.stat(path)
+                except OSError:
+                    # Removed by another process
+                    continue
+                files.append((stat.st_mtime, stat.st_size, path))
+        return files
+
+    def __add_bytes(self, n_bytes):
+        """ Count the bytes of a file added, and remove the files least\
+            recently used if there are too many
+        """
+        if self.__max_bytes is None:
+            return
+        with self.__lock:
+            if self.__n_bytes is None:
+                files = self.__files()
+                self.__n_bytes = sum(size for _, size, _ in files)
+            else:
+                self.__n_bytes += n_bytes
+                if self.__n_bytes <= self.__max_bytes:
+                    return
+
+                # Other processes may have added or removed files too
+                files = self.__files()
+                self.__n_bytes = sum(size for _, size, _ in files)
+            if self.__n_bytes <= self.__max_bytes:
+                return
+            for _, size, path in sorted(files):
+                try:
+                    os.remove(path)
+                except OSError:
+                    # Removed by another process
+                    pass
+                self.__n_bytes -= size
+                if self.__n_bytes <= self.__max_bytes:
+                    return
+
+    @staticmethod
+    def __save(path, block):
+        """ Write a block so that it appears complete or not at all, even\
+            if another process is writing the same block
+
+        :return: whether the block was written
+        :rtype: bool
+        """
+        directory = os.path.dirname(path)
+        try:
+            try:
+                os.makedirs(directory)
+            except OSError:
+                if not os.path.isdir(directory):
+                    raise
+            handle, temp_path = tempfile.mkstemp(
+                dir=directory, suffix=".tmp")
+            with os.fdopen(handle, "wb") as temp_file:
+                numpy.save(temp_file, block)
+            os.rename(temp_path, path)
+            return True
+        except (IOError, OSError) as e:
+            logger.warning("Could not cache a synaptic block in {}: {}",
+                           directory, e)
+            return False
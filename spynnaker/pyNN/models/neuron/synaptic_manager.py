@@ -17,31 +17,37 @@ try:
     from collections.abc import defaultdict
 except ImportError:
     from collections import defaultdict
+from contextlib import contextmanager
+import decimal
 import math
 import struct
+from multiprocessing import cpu_count
+from multiprocessing.pool import ThreadPool
 import numpy
 import scipy.stats  # @UnresolvedImport
 from scipy import special  # @UnresolvedImport
 from spinn_utilities.helpful_functions import get_valid_components
 from data_specification.enums import DataType
 from spinn_front_end_common.utilities.helpful_functions import (
-    locate_memory_region_for_placement)
+    locate_memory_region_for_placement, read_config, read_config_int)
 from spinn_front_end_common.utilities.globals_variables import get_simulator
 from spynnaker.pyNN.models.neuron.generator_data import GeneratorData
 from spynnaker.pyNN.exceptions import SynapticConfigurationException
 from spynnaker.pyNN.models.neural_projections.connectors import (
-    OneToOneConnector, AbstractGenerateConnectorOnMachine)
+    OneToOneConnector, KernelConnector, AbstractGenerateConnectorOnMachine)
 from spynnaker.pyNN.models.neural_projections import ProjectionApplicationEdge
 from spynnaker.pyNN.models.neuron import master_pop_table_generators
 from spynnaker.pyNN.models.neuron.synapse_dynamics import (
     SynapseDynamicsStatic, AbstractSynapseDynamicsStructural,
     AbstractGenerateOnMachine)
-from spynnaker.pyNN.models.neuron.synapse_io import SynapseIORowBased
+from spynnaker.pyNN.models.neuron.synapse_io import (
+    SynapseIORowBased, SynapticBlockCache)
 from spynnaker.pyNN.models.spike_source.spike_source_poisson_vertex import (
     SpikeSourcePoissonVertex)
 from spynnaker.pyNN.models.utility_models.delays import DelayExtensionVertex
 from spynnaker.pyNN.utilities.constants import (
-    POPULATION_BASED_REGIONS, POSSION_SIGMA_SUMMATION_LIMIT)
+    POPULATION_BASED_REGIONS, POSSION_SIGMA_SUMMATION_LIMIT,
+    SYNAPTIC_ROW_HEADER_WORDS, MAX_SUPPORTED_DELAY_TICS)
 from spynnaker.pyNN.utilities.utility_calls import (
     get_maximum_probable_value, get_n_bits)
 from spynnaker.pyNN.utilities.running_stats import RunningStats
@@ -61,9 +67,63 @@ _SYNAPSES_BASE_N_CPU_CYCLES = 8
 # 4 for n_synapse_index_bits
 _SYNAPSES_BASE_GENERATOR_SDRAM_USAGE_IN_BYTES = 4 + 8 + 4 + 4 + 4
 
+# 8 for post_vertex_slice.lo_atom, post_vertex_slice.n_atoms
+# 4 for n_synapse_type_bits
+# 4 for n_synapse_index_bits
+# 4 for n_connectors
+_PROCEDURAL_BASE_SDRAM_USAGE_IN_BYTES = 8 + 4 + 4 + 4
+
+# 8 for key and mask
+# 8 for pre_vertex_slice.lo_atom, pre_vertex_slice.n_atoms
+# 4 for max_row_n_synapses
+# 4 for synapse_type
+# 4 for weight_scale
+# 4 for timestep_per_delay
+# 12 for the connector, weight and delay generator ids
+_PROCEDURAL_CONNECTOR_BASE_SDRAM_USAGE_IN_BYTES = 8 + 8 + 4 + 4 + 4 + 4 + 12
+
+# 8 for post_vertex_slice.lo_atom, post_vertex_slice.n_atoms
+# 4 for n_kernels
+_CONVOLUTION_BASE_SDRAM_USAGE_IN_BYTES = 8 + 4
+
+# 8 for key and mask
+_CONVOLUTION_KERNEL_BASE_SDRAM_USAGE_IN_BYTES = 8
+
+# The pointers to the connector, weight and delay generators of a procedural
+# connector and to their parameters in DTCM
+_PROCEDURAL_CONNECTOR_DTCM_POINTER_BYTES = 6 * 4
+
+# The DTCM used for each synapse of the procedural row being generated: the
+# synaptic word, the post-synaptic index and the generated value
+_PROCEDURAL_SYNAPSE_DTCM_BYTES = 4 + 2 + 4
+
+# The pointers to the coordinates, weights and delays of a convolution kernel
+# in DTCM
+_CONVOLUTION_KERNEL_DTCM_POINTER_BYTES = 4 * 4
+
 # Amount to scale synapse SDRAM estimate by to make sure the synapses fit
 _SYNAPSE_SDRAM_OVERSCALE = 1.1
 
+# The DTCM of a core, and the part of it kept for the stack and for static
+# data not included in the DTCM estimates
+_DTCM_BYTES = 64 * 1024
+_DTCM_RESERVED_BYTES = 8 * 1024
+
+# The DTCM used by each synaptic row DMA buffer; this holds a row of the
+# maximum length allowed by the master population table, plus the buffer
+# details
+_MAX_ROW_LENGTH = 255
+_DMA_BUFFER_BYTES = ((_MAX_ROW_LENGTH + SYNAPTIC_ROW_HEADER_WORDS) * 4) + 16
+
+# The smallest number of DMA buffers; one row can then be written back
+# while the next is read
+_MIN_DMA_BUFFERS = 2
+
+# The largest number of DMA buffers; each can have a read and a write back in
+# the spin1 DMA queue of 16 transfers, leaving space for those of rewiring
+# and recording.  This must match MAX_DMA_BUFFERS in spike_processing.c
+_MAX_DMA_BUFFERS = 6
+
 _ONE_WORD = struct.Struct("<I")
 
 
@@ -75,6 +135,8 @@ class SynapticManager(object):
         "__delay_key_index",
         "__n_synapse_types",
         "__one_to_one_connection_dtcm_max_bytes",
+        "__max_dma_buffers",
+        "__n_generation_threads",
         "__poptable_type",
         "__pre_run_connection_holders",
         "__retrieved_blocks",
@@ -86,6 +148,7 @@ class SynapticManager(object):
         "__ring_buffer_shifts",
         "__gen_on_machine",
         "__max_row_info",
+        "__unstored_keys",
         "__synapse_indices"]
 
     def __init__(self, n_synapse_types, ring_buffer_sigma, spikes_per_second,
@@ -106,7 +169,12 @@ class SynapticManager(object):
         # Get the synapse IO
         self.__synapse_io = synapse_io
         if synapse_io is None:
-            self.__synapse_io = SynapseIORowBased()
+            block_cache_directory = read_config(
+                config, "Simulation", "synaptic_block_cache_directory")
+            self.__synapse_io = SynapseIORowBased(
+                SynapticBlockCache(block_cache_directory, read_config_int(
+                    config, "Simulation", "synaptic_block_cache_max_bytes"))
+                if block_cache_directory else None)
 
         if self.__ring_buffer_sigma is None:
             self.__ring_buffer_sigma = config.getfloat(
@@ -134,6 +202,16 @@ class SynapticManager(object):
         self.__one_to_one_connection_dtcm_max_bytes = config.getint(
             "Simulation", "one_to_one_connection_dtcm_max_bytes")
 
+        # Limit the number of synaptic rows read at once
+        self.__max_dma_buffers = config.getint(
+            "Simulation", "max_synaptic_row_dma_buffers")
+
+        # The number of threads that build synaptic matrices on the host
+        self.__n_generation_threads = config.getint(
+            "Simulation", "n_synapse_generation_threads")
+        if self.__n_generation_threads <= 0:
+            self.__n_generation_threads = cpu_count()
+
         # Whether to generate on machine or not for a given vertex slice
         self.__gen_on_machine = dict()
 
@@ -144,6 +222,10 @@ class SynapticManager(object):
         # A map of synapse information for each machine pre vertex to index
         self.__synapse_indices = dict()
 
+        # The synapse information for each machine pre vertex whose synapses
+        # are generated when spikes arrive, and so cannot be read back
+        self.__unstored_keys = set()
+
     @property
     def synapse_dynamics(self):
         return self.__synapse_dynamics
@@ -201,13 +283,56 @@ class SynapticManager(object):
         # TODO: Calculate this correctly
         return 0
 
-    def get_dtcm_usage_in_bytes(self):
-        # TODO: Calculate this correctly
-        return 0
+    def get_dtcm_usage_in_bytes(
+            self, post_vertex_slice, in_edges, machine_time_step):
+        """ Get the DTCM used by the synapses of a core, other than by the\
+            ring buffers, direct matrix and DMA buffers, which are sized\
+            from what is left (see _get_n_dma_buffers)
+
+        :param post_vertex_slice: The slice of the vertex on the core
+        :param in_edges: The edges arriving at the vertex
+        :param machine_time_step: The time step of the simulation
+        :rtype: int
+        """
+        return (
+            _SYNAPSES_BASE_DTCM_USAGE_IN_BYTES +
+            self.__synapse_dynamics.get_dtcm_usage_in_bytes(
+                post_vertex_slice.n_atoms, self.__n_synapse_types) +
+            self._get_procedural_synapses_dtcm_usage(
+                post_vertex_slice, in_edges, machine_time_step) +
+            self._get_convolution_synapses_dtcm_usage(
+                post_vertex_slice, in_edges, machine_time_step))
 
     def _get_synapse_params_size(self):
+        # 4 for each ring buffer shift and 4 for the number of DMA buffers
         return (_SYNAPSES_BASE_SDRAM_USAGE_IN_BYTES +
-                (4 * self.__n_synapse_types))
+                (4 * self.__n_synapse_types) + 4)
+
+    def _get_n_dma_buffers(self, post_vertex_slice, dtcm_used_in_bytes):
+        """ Get the number of synaptic rows that the core can read from\
+            SDRAM at once; this is as many as fit in the DTCM that is not\
+            used for anything else, up to the configured maximum and the\
+            number that the DMA queue can hold
+
+        :param post_vertex_slice: The slice of the vertex on the core
+        :param dtcm_used_in_bytes: The DTCM used by the core other than by\
+            the ring buffers, direct matrix and DMA buffers
+        :rtype: int
+        """
+        # One 16-bit ring buffer entry for each delay, synapse type and neuron
+        n_ring_buffer_bits = (
+            get_n_bits(post_vertex_slice.n_atoms) +
+            get_n_bits(self.__n_synapse_types) +
+            get_n_bits(MAX_SUPPORTED_DELAY_TICS))
+        ring_buffer_bytes = (1 << n_ring_buffer_bits) * 2
+
+        free_dtcm = (
+            _DTCM_BYTES - _DTCM_RESERVED_BYTES - dtcm_used_in_bytes -
+            ring_buffer_bytes - self.__one_to_one_connection_dtcm_max_bytes)
+        n_dma_buffers = min(
+            self.__max_dma_buffers, _MAX_DMA_BUFFERS,
+            free_dtcm // _DMA_BUFFER_BYTES)
+        return max(_MIN_DMA_BUFFERS, n_dma_buffers)
 
     def _get_static_synaptic_matrix_sdram_requirements(self):
 
@@ -237,6 +362,8 @@ class SynapticManager(object):
         for in_edge in in_edges:
             if isinstance(in_edge, ProjectionApplicationEdge):
                 for synapse_info in in_edge.synapse_information:
+                    if not self.__is_stored(synapse_info, machine_time_step):
+                        continue
                     memory_size = self.__add_synapse_size(
                         memory_size, synapse_info, post_vertex_slice, in_edge,
                         machine_time_step)
@@ -256,7 +383,18 @@ class SynapticManager(object):
             max_row_info.delayed_max_bytes * n_atoms * in_edge.n_delay_stages)
         return memory_size
 
-    def _get_size_of_generator_information(self, in_edges):
+    @staticmethod
+    def __n_likely_pre_vertices(in_edge):
+        """ Get the number of machine vertices the pre-vertex of an edge is\
+            likely to be split into
+        """
+        max_atoms = in_edge.pre_vertex.get_max_atoms_per_core()
+        if in_edge.pre_vertex.n_atoms < max_atoms:
+            max_atoms = in_edge.pre_vertex.n_atoms
+        return int(math.ceil(
+            float(in_edge.pre_vertex.n_atoms) / float(max_atoms)))
+
+    def _get_size_of_generator_information(self, in_edges, machine_time_step):
         """ Get the size of the synaptic expander parameters
         """
         gen_on_machine = False
@@ -264,13 +402,11 @@ class SynapticManager(object):
         for in_edge in in_edges:
             if isinstance(in_edge, ProjectionApplicationEdge):
                 for synapse_info in in_edge.synapse_information:
+                    if not self.__is_stored(synapse_info, machine_time_step):
+                        continue
 
                     # Get the number of likely vertices
-                    max_atoms = in_edge.pre_vertex.get_max_atoms_per_core()
-                    if in_edge.pre_vertex.n_atoms < max_atoms:
-                        max_atoms = in_edge.pre_vertex.n_atoms
-                    n_edge_vertices = int(math.ceil(
-                        float(in_edge.pre_vertex.n_atoms) / float(max_atoms)))
+                    n_edge_vertices = self.__n_likely_pre_vertices(in_edge)
 
                     # Get the size
                     connector = synapse_info.connector
@@ -282,7 +418,8 @@ class SynapticManager(object):
                         connector.generate_on_machine(
                             synapse_info.weight, synapse_info.delay)
                     synapse_gen = isinstance(
-                        dynamics, AbstractGenerateOnMachine)
+                        dynamics, AbstractGenerateOnMachine) and \
+                        dynamics.generate_on_machine()
                     if connector_gen and synapse_gen:
                         gen_on_machine = True
                         gen_size = sum((
@@ -300,6 +437,148 @@ class SynapticManager(object):
             size += self.__n_synapse_types * 4
         return size
 
+    def __can_generate_on_spike(self, synapse_info, machine_time_step):
+        """ Determine if the synapses of a projection could be generated on\
+            the core each time a spike arrives; this is only possible for\
+            static synapses that need no delay extension
+
+        :rtype: bool
+        """
+        dynamics = synapse_info.synapse_dynamics
+        if (not isinstance(dynamics, SynapseDynamicsStatic) or
+                isinstance(dynamics, AbstractSynapseDynamicsStructural)):
+            return False
+        max_delay = synapse_info.connector.get_delay_maximum(
+            synapse_info.delay)
+        return (
+            max_delay is not None and
+            max_delay <= self.get_maximum_delay_supported_in_ms(
+                machine_time_step))
+
+    def __is_procedural(self, synapse_info, machine_time_step):
+        """ Determine if the rows of a projection are to be generated on the\
+            core each time a spike arrives instead of being stored
+
+        :rtype: bool
+        """
+        connector = synapse_info.connector
+        return (
+            isinstance(connector, AbstractGenerateConnectorOnMachine) and
+            connector.generate_procedurally(
+                synapse_info.weight, synapse_info.delay) and
+            self.__can_generate_on_spike(synapse_info, machine_time_step))
+
+    def __is_convolution(self, synapse_info, machine_time_step):
+        """ Determine if the weights of a projection are to be added from a\
+            kernel on the core each time a spike arrives instead of being\
+            stored
+
+        :rtype: bool
+        """
+        connector = synapse_info.connector
+        return (
+            isinstance(connector, KernelConnector) and
+            connector.convolution and
+            self.__can_generate_on_spike(synapse_info, machine_time_step))
+
+    def __is_stored(self, synapse_info, machine_time_step):
+        """ Determine if the synapses of a projection are stored in the\
+            synaptic matrix, whether written by the host or the expander
+
+        :rtype: bool
+        """
+        return not (
+            self.__is_procedural(synapse_info, machine_time_step) or
+            self.__is_convolution(synapse_info, machine_time_step))
+
+    def _get_procedural_synapses_size(self, in_edges, machine_time_step):
+        """ Get the size of the procedural connector parameters
+        """
+        size = _PROCEDURAL_BASE_SDRAM_USAGE_IN_BYTES
+        for in_edge in in_edges:
+            if isinstance(in_edge, ProjectionApplicationEdge):
+                for synapse_info in in_edge.synapse_information:
+                    if not self.__is_procedural(
+                            synapse_info, machine_time_step):
+                        continue
+                    connector = synapse_info.connector
+                    connector_size = sum((
+                        _PROCEDURAL_CONNECTOR_BASE_SDRAM_USAGE_IN_BYTES,
+                        connector.gen_connector_params_size_in_bytes,
+                        connector.gen_weight_params_size_in_bytes(
+                            synapse_info.weight),
+                        connector.gen_delay_params_size_in_bytes(
+                            synapse_info.delay)))
+                    size += (
+                        connector_size * self.__n_likely_pre_vertices(in_edge))
+        return size
+
+    def _get_convolution_synapses_size(
+            self, post_vertex_slice, in_edges, machine_time_step):
+        """ Get the size of the convolution kernel parameters
+        """
+        size = _CONVOLUTION_BASE_SDRAM_USAGE_IN_BYTES
+        for in_edge in in_edges:
+            if isinstance(in_edge, ProjectionApplicationEdge):
+                for synapse_info in in_edge.synapse_information:
+                    if not self.__is_convolution(
+                            synapse_info, machine_time_step):
+                        continue
+                    kernel_size = (
+                        _CONVOLUTION_KERNEL_BASE_SDRAM_USAGE_IN_BYTES +
+                        synapse_info.connector.
+                        gen_convolution_params_size_in_bytes(
+                            post_vertex_slice))
+                    size += kernel_size * self.__n_likely_pre_vertices(in_edge)
+        return size
+
+    def _get_procedural_synapses_dtcm_usage(
+            self, post_vertex_slice, in_edges, machine_time_step):
+        """ Get the DTCM used by the procedural connectors; their parameters\
+            are copied to DTCM, and the longest of their rows is generated\
+            there
+        """
+        n_connectors = 0
+        max_row_n_synapses = 0
+        for in_edge in in_edges:
+            if isinstance(in_edge, ProjectionApplicationEdge):
+                for synapse_info in in_edge.synapse_information:
+                    if not self.__is_procedural(
+                            synapse_info, machine_time_step):
+                        continue
+                    n_connectors += self.__n_likely_pre_vertices(in_edge)
+                    max_row_info = self._get_max_row_info(
+                        synapse_info, post_vertex_slice, in_edge,
+                        machine_time_step)
+                    max_row_n_synapses = max(
+                        max_row_n_synapses,
+                        max_row_info.undelayed_max_n_synapses)
+        if n_connectors == 0:
+            return 0
+        return (
+            self._get_procedural_synapses_size(in_edges, machine_time_step) +
+            (n_connectors * _PROCEDURAL_CONNECTOR_DTCM_POINTER_BYTES) +
+            (SYNAPTIC_ROW_HEADER_WORDS * 4) +
+            (max_row_n_synapses * _PROCEDURAL_SYNAPSE_DTCM_BYTES))
+
+    def _get_convolution_synapses_dtcm_usage(
+            self, post_vertex_slice, in_edges, machine_time_step):
+        """ Get the DTCM used by the convolution kernels, which are copied\
+            to DTCM
+        """
+        n_kernels = 0
+        for in_edge in in_edges:
+            if isinstance(in_edge, ProjectionApplicationEdge):
+                for synapse_info in in_edge.synapse_information:
+                    if self.__is_convolution(synapse_info, machine_time_step):
+                        n_kernels += self.__n_likely_pre_vertices(in_edge)
+        if n_kernels == 0:
+            return 0
+        return (
+            self._get_convolution_synapses_size(
+                post_vertex_slice, in_edges, machine_time_step) +
+            (n_kernels * _CONVOLUTION_KERNEL_DTCM_POINTER_BYTES))
+
     def _get_synapse_dynamics_parameter_size(self, vertex_slice,
                                              in_edges=None):
         """ Get the size of the synapse dynamics region
@@ -325,7 +604,11 @@ class SynapticManager(object):
                 vertex_slice, in_edges, machine_time_step) +
             self.__poptable_type.get_master_population_table_size(
                 vertex_slice, in_edges) +
-            self._get_size_of_generator_information(in_edges))
+            self._get_size_of_generator_information(
+                in_edges, machine_time_step) +
+            self._get_procedural_synapses_size(in_edges, machine_time_step) +
+            self._get_convolution_synapses_size(
+                vertex_slice, in_edges, machine_time_step))
 
     def _reserve_memory_regions(
             self, spec, machine_vertex, vertex_slice,
@@ -543,12 +826,14 @@ class SynapticManager(object):
         return float(math.pow(2, 16 - (ring_buffer_to_input_left_shift + 1)))
 
     def _write_synapse_parameters(
-            self, spec, ring_buffer_shifts, post_vertex_slice, weight_scale):
+            self, spec, ring_buffer_shifts, post_vertex_slice, weight_scale,
+            n_dma_buffers):
         # Get the ring buffer shifts and scaling factors
 
         spec.switch_write_focus(POPULATION_BASED_REGIONS.SYNAPSE_PARAMS.value)
 
         spec.write_array(ring_buffer_shifts)
+        spec.write_value(n_dma_buffers)
 
         weight_scales = numpy.array([
             self._get_weight_scale(r) * weight_scale
@@ -603,53 +888,65 @@ class SynapticManager(object):
         # Store a list of synapse info to be generated on the machine
         generate_on_machine = list()
 
-        # For each machine edge in the vertex, create a synaptic list
-        for machine_edge in in_edges:
-            app_edge = graph_mapper.get_application_edge(machine_edge)
-            if isinstance(app_edge, ProjectionApplicationEdge):
-                spec.comment("\nWriting matrix for m_edge:{}\n".format(
-                    machine_edge.label))
-
-                pre_vertex_slice = graph_mapper.get_slice(
-                    machine_edge.pre_vertex)
-                pre_slices = graph_mapper.get_slices(app_edge.pre_vertex)
-                pre_slice_index = graph_mapper.get_machine_vertex_index(
-                    machine_edge.pre_vertex)
-
-                for synapse_info in app_edge.synapse_information:
-                    rinfo = routing_info.get_routing_info_for_edge(
-                        machine_edge)
-
-                    # If connector is being built on SpiNNaker,
-                    # compute matrix sizes only
-                    connector = synapse_info.connector
-                    dynamics = synapse_info.synapse_dynamics
-                    if (isinstance(
-                            connector, AbstractGenerateConnectorOnMachine) and
-                            connector.generate_on_machine(
-                                synapse_info.weight, synapse_info.delay) and
-                            isinstance(dynamics, AbstractGenerateOnMachine) and
-                            dynamics.generate_on_machine and
-                            not self.__is_direct(
-                                single_addr, connector, pre_vertex_slice,
-                                post_vertex_slice, app_edge)):
-                        generate_on_machine.append((
-                            synapse_info, pre_slices, pre_vertex_slice,
-                            pre_slice_index, app_edge, rinfo))
-                    else:
-                        block_addr, single_addr, index = self.__write_block(
-                            spec, synaptic_matrix_region, synapse_info,
-                            pre_slices, pre_slice_index, post_slices,
-                            post_slice_index, pre_vertex_slice,
-                            post_vertex_slice, app_edge,
-                            self.__n_synapse_types,
-                            single_synapses, master_pop_table_region,
-                            weight_scales, machine_time_step, rinfo,
-                            all_syn_block_sz, block_addr, single_addr,
-                            machine_edge=machine_edge)
-                        key = (synapse_info, pre_vertex_slice.lo_atom,
-                               post_vertex_slice.lo_atom)
-                        self.__synapse_indices[key] = index
+        # Start building the blocks that are built on the host; they are
+        # still written in order below
+        with self.__synaptic_block_pool() as pool:
+            blocks = self.__start_synaptic_blocks(
+                pool, in_edges, post_slices, post_slice_index,
+                post_vertex_slice, weight_scales, graph_mapper,
+                machine_time_step)
+
+            # For each machine edge in the vertex, create a synaptic list
+            for machine_edge in in_edges:
+                app_edge = graph_mapper.get_application_edge(machine_edge)
+                if isinstance(app_edge, ProjectionApplicationEdge):
+                    spec.comment("\nWriting matrix for m_edge:{}\n".format(
+                        machine_edge.label))
+
+                    pre_vertex_slice = graph_mapper.get_slice(
+                        machine_edge.pre_vertex)
+                    pre_slices = graph_mapper.get_slices(app_edge.pre_vertex)
+                    pre_slice_index = graph_mapper.get_machine_vertex_index(
+                        machine_edge.pre_vertex)
+
+                    for synapse_info in app_edge.synapse_information:
+                        rinfo = routing_info.get_routing_info_for_edge(
+                            machine_edge)
+
+                        # Procedural rows and kernels are never stored, so
+                        # need no space or master population table entry
+                        if not self.__is_stored(
+                                synapse_info, machine_time_step):
+                            continue
+
+                        # If connector is being built on SpiNNaker,
+                        # compute matrix sizes only
+                        connector = synapse_info.connector
+                        if (self.__can_generate_on_machine(synapse_info) and
+                                not self.__is_direct(
+                                    single_addr, connector, pre_vertex_slice,
+                                    post_vertex_slice, app_edge)):
+                            generate_on_machine.append((
+                                synapse_info, pre_slices, pre_vertex_slice,
+                                pre_slice_index, app_edge, rinfo))
+                        else:
+                            synapses = self.__get_synaptic_block(
+                                blocks, app_edge, machine_edge, synapse_info,
+                                pre_slices, pre_slice_index, post_slices,
+                                post_slice_index, pre_vertex_slice,
+                                post_vertex_slice, weight_scales,
+                                machine_time_step)
+                            written = self.__write_block(
+                                spec, synaptic_matrix_region, synapse_info,
+                                synapses, pre_vertex_slice, post_vertex_slice,
+                                app_edge, self.__n_synapse_types,
+                                single_synapses, master_pop_table_region,
+                                weight_scales, machine_time_step, rinfo,
+                                all_syn_block_sz, block_addr, single_addr)
+                            block_addr, single_addr, index = written
+                            key = (synapse_info, pre_vertex_slice.lo_atom,
+                                   post_vertex_slice.lo_atom)
+                            self.__synapse_indices[key] = index
 
         # Skip blocks that will be written on the machine, but add them
         # to the master population table
@@ -796,20 +1093,109 @@ class SynapticManager(object):
                             .format(d_index, index))
         return block_addr, index
 
-    def __write_block(
-            self, spec, synaptic_matrix_region, synapse_info, pre_slices,
+    def __can_generate_on_machine(self, synapse_info):
+        """ Determine if the synapses of a projection can be generated by the\
+            synapse expander, if they do not form a direct matrix
+        """
+        connector = synapse_info.connector
+        dynamics = synapse_info.synapse_dynamics
+        return (
+            isinstance(connector, AbstractGenerateConnectorOnMachine) and
+            connector.generate_on_machine(
+                synapse_info.weight, synapse_info.delay) and
+            isinstance(dynamics, AbstractGenerateOnMachine) and
+            dynamics.generate_on_machine())
+
+    @contextmanager
+    def __synaptic_block_pool(self):
+        """ Get a pool of threads to build the blocks on the host, or None if\
+            they are to be built as they are written; the pool is closed on\
+            leaving the context, and any blocks still being built are\
+            abandoned if it is left by an exception
+        """
+        # Structural dynamics record the connections of each edge as the
+        # blocks are built
+        if (self.__n_generation_threads <= 1 or isinstance(
+                self.__synapse_dynamics, AbstractSynapseDynamicsStructural)):
+            yield None
+            return
+        pool = ThreadPool(self.__n_generation_threads)
+        try:
+            yield pool
+            pool.close()
+        except BaseException:
+            pool.terminate()
+            raise
+        finally:
+            pool.join()
+
+    def __start_synaptic_blocks(
+            self, pool, in_edges, post_slices, post_slice_index,
+            post_vertex_slice, weight_scales, graph_mapper, machine_time_step):
+        """ Prepare the blocks of the incoming edges that will be built on\
+            the host, in the order they are written, and start building them\
+            on the pool of threads if there is one
+
+        :return: the blocks being built by edge and synapse information
+        """
+        # Blocks that might be direct are only known to be built on the host
+        # when the blocks before them are written, so are left until then
+        blocks = dict()
+        for machine_edge in in_edges:
+            app_edge = graph_mapper.get_application_edge(machine_edge)
+            if not isinstance(app_edge, ProjectionApplicationEdge):
+                continue
+            pre_vertex_slice = graph_mapper.get_slice(machine_edge.pre_vertex)
+            pre_slices = graph_mapper.get_slices(app_edge.pre_vertex)
+            pre_slice_index = graph_mapper.get_machine_vertex_index(
+                machine_edge.pre_vertex)
+            for synapse_info in app_edge.synapse_information:
+                if (not self.__is_stored(synapse_info, machine_time_step) or
+                        self.__can_generate_on_machine(synapse_info)):
+                    continue
+                synapse_info.connector.prepare_synaptic_block(
+                    synapse_info.weight, synapse_info.delay, pre_slices,
+                    post_slices, pre_vertex_slice, post_vertex_slice)
+                if pool is not None:
+                    blocks[machine_edge, synapse_info] = pool.apply_async(
+                        self.__synapse_io.get_synapses, (
+                            synapse_info, pre_slices, pre_slice_index,
+                            post_slices, post_slice_index, pre_vertex_slice,
+                            post_vertex_slice, app_edge.n_delay_stages,
+                            self.__poptable_type, self.__n_synapse_types,
+                            weight_scales, machine_time_step),
+                        dict(app_edge=app_edge, machine_edge=machine_edge))
+        return blocks
+
+    def __get_synaptic_block(
+            self, blocks, app_edge, machine_edge, synapse_info, pre_slices,
             pre_slice_index, post_slices, post_slice_index, pre_vertex_slice,
-            post_vertex_slice, app_edge, n_synapse_types, single_synapses,
-            master_pop_table_region, weight_scales, machine_time_step,
-            rinfo, all_syn_block_sz, block_addr, single_addr,
-            machine_edge):
+            post_vertex_slice, weight_scales, machine_time_step):
+        """ Get a block built by the pool, or build it now if it was not
+        """
+        block = blocks.pop((machine_edge, synapse_info), None)
+        if block is not None:
+            return block.get()
+
+        # This does nothing if the block has been prepared already
+        synapse_info.connector.prepare_synaptic_block(
+            synapse_info.weight, synapse_info.delay, pre_slices, post_slices,
+            pre_vertex_slice, post_vertex_slice)
+        return self.__synapse_io.get_synapses(
+            synapse_info, pre_slices, pre_slice_index, post_slices,
+            post_slice_index, pre_vertex_slice, post_vertex_slice,
+            app_edge.n_delay_stages, self.__poptable_type,
+            self.__n_synapse_types, weight_scales, machine_time_step,
+            app_edge=app_edge, machine_edge=machine_edge)
+
+    def __write_block(
+            self, spec, synaptic_matrix_region, synapse_info, synapses,
+            pre_vertex_slice, post_vertex_slice, app_edge, n_synapse_types,
+            single_synapses, master_pop_table_region, weight_scales,
+            machine_time_step, rinfo, all_syn_block_sz, block_addr,
+            single_addr):
         (row_data, row_length, delayed_row_data, delayed_row_length,
-         delayed_source_ids, delay_stages) = self.__synapse_io.get_synapses(
-             synapse_info, pre_slices, pre_slice_index, post_slices,
-             post_slice_index, pre_vertex_slice, post_vertex_slice,
-             app_edge.n_delay_stages, self.__poptable_type, n_synapse_types,
-             weight_scales, machine_time_step,
-             app_edge=app_edge, machine_edge=machine_edge)
+         delayed_source_ids, delay_stages) = synapses
 
         if app_edge.delay_edge is not None:
             app_edge.delay_edge.pre_vertex.add_delays(
@@ -838,7 +1224,8 @@ class SynapticManager(object):
                 synaptic_matrix_region, block_addr, single_addr, app_edge)
         elif rinfo is not None:
             index = self.__poptable_type.update_master_population_table(
-                spec, 0, 0, rinfo.first_key_and_mask, master_pop_table_region)
+                spec, 0, 0, rinfo.first_key_and_mask, master_pop_table_region,
+                rows_present=self.__get_rows_present(row_data, row_length))
         del row_data
 
         if block_addr > all_syn_block_sz:
@@ -861,7 +1248,9 @@ class SynapticManager(object):
         elif delay_rinfo is not None:
             d_index = self.__poptable_type.update_master_population_table(
                 spec, 0, 0, delay_rinfo.first_key_and_mask,
-                master_pop_table_region)
+                master_pop_table_region,
+                rows_present=self.__get_rows_present(
+                    delayed_row_data, delayed_row_length))
         del delayed_row_data
 
         if block_addr > all_syn_block_sz:
@@ -909,10 +1298,32 @@ class SynapticManager(object):
             spec.write_array(row_data)
             index = self.__poptable_type.update_master_population_table(
                 spec, block_addr, row_length,
-                rinfo.first_key_and_mask, master_pop_table_region)
+                rinfo.first_key_and_mask, master_pop_table_region,
+                rows_present=self.__get_rows_present(row_data, row_length))
             block_addr += len(row_data) * 4
         return block_addr, single_addr, index
 
+    def __get_rows_present(self, row_data, row_length):
+        """ Determine which rows of a block contain any synapses, so that\
+            spikes for the others can be dropped before the row is read
+
+        :return: a bool per row, or None if rows may gain synapses later
+        """
+        if isinstance(self.__synapse_dynamics,
+                      AbstractSynapseDynamicsStructural):
+            return None
+        if not row_data.size:
+            return numpy.zeros(0, dtype="bool")
+
+        # Each row is the plastic-plastic size and data, followed by the
+        # fixed-fixed and fixed-plastic counts
+        rows = row_data.reshape(-1, row_length + SYNAPTIC_ROW_HEADER_WORDS)
+        row_indices = numpy.arange(len(rows))
+        pp_size = rows[:, 0]
+        n_fixed_fixed = rows[row_indices, pp_size + 1]
+        n_fixed_plastic = rows[row_indices, pp_size + 2]
+        return (n_fixed_fixed + n_fixed_plastic) > 0
+
     def _get_ring_buffer_shifts(
             self, application_vertex, application_graph, machine_timestep,
             weight_scale):
@@ -928,7 +1339,8 @@ class SynapticManager(object):
     def write_data_spec(
             self, spec, application_vertex, post_vertex_slice, machine_vertex,
             placement, machine_graph, application_graph, routing_info,
-            graph_mapper, weight_scale, machine_time_step):
+            graph_mapper, weight_scale, machine_time_step,
+            dtcm_used_in_bytes):
         # Create an index of delay keys into this vertex
         for m_edge in machine_graph.get_edges_ending_at_vertex(machine_vertex):
             app_edge = graph_mapper.get_application_edge(m_edge)
@@ -956,7 +1368,8 @@ class SynapticManager(object):
             application_vertex, application_graph, machine_time_step,
             weight_scale)
         weight_scales = self._write_synapse_parameters(
-            spec, ring_buffer_shifts, post_vertex_slice, weight_scale)
+            spec, ring_buffer_shifts, post_vertex_slice, weight_scale,
+            self._get_n_dma_buffers(post_vertex_slice, dtcm_used_in_bytes))
 
         gen_data = self._write_synaptic_matrix_and_master_population_table(
             spec, post_slices, post_slice_idx, machine_vertex,
@@ -987,6 +1400,12 @@ class SynapticManager(object):
 
         self._write_on_machine_data_spec(
             spec, post_vertex_slice, weight_scales, gen_data)
+        self._write_procedural_synapses_data_spec(
+            spec, post_vertex_slice, machine_vertex, machine_graph,
+            graph_mapper, routing_info, weight_scales, machine_time_step)
+        self._write_convolution_synapses_data_spec(
+            spec, post_vertex_slice, machine_vertex, machine_graph,
+            graph_mapper, routing_info, weight_scales, machine_time_step)
 
     def clear_connection_cache(self):
         self.__retrieved_blocks = dict()
@@ -1018,6 +1437,11 @@ class SynapticManager(object):
         # Get the block for the connections from the pre_vertex
         synapse_key = (synapse_info, pre_vertex_slice.lo_atom,
                        post_vertex_slice.lo_atom)
+        if synapse_key in self.__unstored_keys:
+            raise SynapticConfigurationException(
+                "The connections of {} are generated when spikes arrive and "
+                "are not stored, so cannot be read from the machine".format(
+                    app_edge.label))
         index = self.__synapse_indices[synapse_key]
         master_pop_table, direct_synapses, indirect_synapses = \
             self.__compute_addresses(transceiver, placement)
@@ -1046,6 +1470,114 @@ class SynapticManager(object):
             self.__weight_scales[placement], data, delayed_data,
             app_edge.n_delay_stages, machine_time_step)
 
+    def update_weights_on_machine(
+            self, transceiver, placement, machine_edge, graph_mapper,
+            routing_infos, synapse_info):
+        """ Write the weights now in the synapse information into the rows\
+            of a machine edge that are already on the machine, leaving the\
+            rest of the rows, the master population table and any\
+            generated synapses as they are.
+
+        :return: True if the weights were written, or False if the\
+            synaptic matrix must be generated again to change them
+        :rtype: bool
+        """
+        # pylint: disable=too-many-arguments, too-many-locals
+        app_edge = graph_mapper.get_application_edge(machine_edge)
+        if not isinstance(app_edge, ProjectionApplicationEdge):
+            return True
+        pre_vertex_slice = graph_mapper.get_slice(machine_edge.pre_vertex)
+        post_vertex_slice = graph_mapper.get_slice(machine_edge.post_vertex)
+        synapse_key = (synapse_info, pre_vertex_slice.lo_atom,
+                       post_vertex_slice.lo_atom)
+        if (synapse_key in self.__unstored_keys or
+                synapse_key not in self.__synapse_indices):
+            return False
+        index = self.__synapse_indices[synapse_key]
+        master_pop_table, _, indirect_synapses = self.__compute_addresses(
+            transceiver, placement)
+
+        # Read the undelayed and delayed blocks as they are now; the weights
+        # of a single block are in DTCM, so are not updated from SDRAM
+        keys = [(routing_infos.get_first_key_for_edge(machine_edge),
+                 pre_vertex_slice.n_atoms)]
+        if app_edge.delay_edge is not None:
+            keys.append((self.__delay_key_index[
+                app_edge.pre_vertex, pre_vertex_slice.lo_atom,
+                pre_vertex_slice.hi_atom].first_key,
+                pre_vertex_slice.n_atoms * app_edge.n_delay_stages))
+        blocks = list()
+        for key, n_rows in keys:
+            block = self.__read_block_to_update(
+                transceiver, placement, master_pop_table, indirect_synapses,
+                key, n_rows, index)
+            if block is None:
+                return False
+            blocks.append(block)
+        (data, max_row_length, _) = blocks[0]
+        delayed_data, delayed_max_row_length = None, 0
+        if len(blocks) > 1:
+            (delayed_data, delayed_max_row_length, _) = blocks[1]
+        new_data = bytearray(data) if data is not None else None
+        new_delayed_data = (
+            bytearray(delayed_data) if delayed_data is not None else None)
+
+        if not self.__synapse_io.write_weights(
+                synapse_info, pre_vertex_slice, post_vertex_slice,
+                max_row_length, delayed_max_row_length,
+                self.__n_synapse_types, self.__weight_scales[placement],
+                new_data, new_delayed_data):
+            return False
+
+        # Write back only the words that have changed
+        for (old, _, address), new in zip(
+                blocks, (new_data, new_delayed_data)):
+            if old is not None:
+                self.__write_changed_words(
+                    transceiver, placement, address, old, new)
+        self.__retrieved_blocks = dict()
+        return True
+
+    def __read_block_to_update(
+            self, transceiver, placement, master_pop_table_address,
+            indirect_synapses_address, key, n_rows, index):
+        """ Read a synaptic block from the machine without using the cache\
+            of blocks retrieved
+
+        :return: the block, its maximum row length and its address, where\
+            the block is None if there is none; or None if the block is a\
+            single block, which cannot be updated as the core copies the\
+            direct matrix into DTCM only when it starts
+        """
+        items = self._extract_synaptic_matrix_data_location(
+            key, master_pop_table_address, transceiver, placement)
+        if index >= len(items):
+            return None, 0, None
+        max_row_length, synaptic_block_offset, is_single = items[index]
+        if max_row_length == 0 or synaptic_block_offset is None:
+            return None, 0, None
+        if is_single:
+            return None
+        address = indirect_synapses_address + synaptic_block_offset
+        block = self.__read_multiple_synaptic_blocks(
+            transceiver, None, placement, n_rows, max_row_length,
+            address, False, None, None)
+        return block, max_row_length, address
+
+    @staticmethod
+    def __write_changed_words(transceiver, placement, address, old, new):
+        """ Write the span of a block that holds all of its changed words
+        """
+        old_words = numpy.frombuffer(old, dtype="<u4")
+        new_words = numpy.frombuffer(new, dtype="<u4")
+        changed = numpy.flatnonzero(old_words != new_words)
+        if not changed.size:
+            return
+        first, last = changed[0], changed[-1] + 1
+        transceiver.write_memory(
+            placement.x, placement.y, address + int(first) * 4,
+            numpy.ascontiguousarray(new_words[first:last]).tobytes())
+
     def __compute_addresses(self, transceiver, placement):
         """ Helper for computing the addresses of the master pop table and\
             synaptic-matrix-related bits.
@@ -1204,6 +1736,121 @@ class SynapticManager(object):
         for data in generator_data:
             spec.write_array(data.gen_data)
 
+    def _write_procedural_synapses_data_spec(
+            self, spec, post_vertex_slice, machine_vertex, machine_graph,
+            graph_mapper, routing_info, weight_scales, machine_time_step):
+        """ Write the parameters of the connectors whose rows are generated\
+            on the core each time a spike arrives
+
+        :param spec: The specification to write to
+        :param post_vertex_slice: The slice of the vertex being written
+        :param weight_scales: scaling of weights on each synapse
+        """
+        timestep_per_delay = (
+            decimal.Decimal(str(1000.0 / float(machine_time_step))) *
+            DataType.S1615.scale)
+        connectors = list()
+        for machine_edge in machine_graph.get_edges_ending_at_vertex(
+                machine_vertex):
+            app_edge = graph_mapper.get_application_edge(machine_edge)
+            if not isinstance(app_edge, ProjectionApplicationEdge):
+                continue
+            pre_vertex_slice = graph_mapper.get_slice(machine_edge.pre_vertex)
+            pre_slices = graph_mapper.get_slices(app_edge.pre_vertex)
+            pre_slice_index = graph_mapper.get_machine_vertex_index(
+                machine_edge.pre_vertex)
+            post_slices = graph_mapper.get_slices(app_edge.post_vertex)
+            post_slice_index = graph_mapper.get_machine_vertex_index(
+                machine_vertex)
+            rinfo = routing_info.get_routing_info_for_edge(machine_edge)
+            for synapse_info in app_edge.synapse_information:
+                if not self.__is_procedural(synapse_info, machine_time_step):
+                    continue
+                connector = synapse_info.connector
+                max_row_info = self._get_max_row_info(
+                    synapse_info, post_vertex_slice, app_edge,
+                    machine_time_step)
+                key_and_mask = rinfo.first_key_and_mask
+                connectors.append(numpy.array([
+                    key_and_mask.key, key_and_mask.mask,
+                    pre_vertex_slice.lo_atom, pre_vertex_slice.n_atoms,
+                    max_row_info.undelayed_max_n_synapses,
+                    synapse_info.synapse_type,
+                    int(weight_scales[synapse_info.synapse_type]),
+                    timestep_per_delay,
+                    connector.gen_connector_id,
+                    connector.gen_weights_id(synapse_info.weight),
+                    connector.gen_delays_id(synapse_info.delay)],
+                    dtype="uint32"))
+                connectors.append(connector.gen_connector_params(
+                    pre_slices, pre_slice_index, post_slices,
+                    post_slice_index, pre_vertex_slice, post_vertex_slice,
+                    synapse_info.synapse_type))
+                connectors.append(connector.gen_weights_params(
+                    synapse_info.weight, pre_vertex_slice, post_vertex_slice))
+                connectors.append(connector.gen_delay_params(
+                    synapse_info.delay, pre_vertex_slice, post_vertex_slice))
+                self.__unstored_keys.add(
+                    (synapse_info, pre_vertex_slice.lo_atom,
+                     post_vertex_slice.lo_atom))
+        n_connectors = len(connectors) // 4
+
+        data = numpy.concatenate([numpy.array([
+            post_vertex_slice.lo_atom, post_vertex_slice.n_atoms,
+            get_n_bits(self.__n_synapse_types),
+            get_n_bits(post_vertex_slice.n_atoms), n_connectors],
+            dtype="uint32")] + connectors)
+        spec.reserve_memory_region(
+            region=POPULATION_BASED_REGIONS.PROCEDURAL_SYNAPSES.value,
+            size=len(data) * 4, label="ProceduralSynapses")
+        spec.switch_write_focus(
+            region=POPULATION_BASED_REGIONS.PROCEDURAL_SYNAPSES.value)
+        spec.write_array(data)
+
+    def _write_convolution_synapses_data_spec(
+            self, spec, post_vertex_slice, machine_vertex, machine_graph,
+            graph_mapper, routing_info, weight_scales, machine_time_step):
+        """ Write the kernels whose weights are added on the core each time\
+            a spike arrives
+
+        :param spec: The specification to write to
+        :param post_vertex_slice: The slice of the vertex being written
+        :param weight_scales: scaling of weights on each synapse
+        """
+        kernels = list()
+        for machine_edge in machine_graph.get_edges_ending_at_vertex(
+                machine_vertex):
+            app_edge = graph_mapper.get_application_edge(machine_edge)
+            if not isinstance(app_edge, ProjectionApplicationEdge):
+                continue
+            pre_vertex_slice = graph_mapper.get_slice(machine_edge.pre_vertex)
+            rinfo = routing_info.get_routing_info_for_edge(machine_edge)
+            for synapse_info in app_edge.synapse_information:
+                if not self.__is_convolution(synapse_info, machine_time_step):
+                    continue
+                key_and_mask = rinfo.first_key_and_mask
+                kernels.append(numpy.array(
+                    [key_and_mask.key, key_and_mask.mask], dtype="uint32"))
+                kernels.append(synapse_info.connector.gen_convolution_params(
+                    synapse_info.weight, synapse_info.delay, pre_vertex_slice,
+                    post_vertex_slice, synapse_info.synapse_type,
+                    weight_scales[synapse_info.synapse_type],
+                    machine_time_step))
+                self.__unstored_keys.add(
+                    (synapse_info, pre_vertex_slice.lo_atom,
+                     post_vertex_slice.lo_atom))
+        n_kernels = len(kernels) // 2
+
+        data = numpy.concatenate([numpy.array([
+            post_vertex_slice.lo_atom, post_vertex_slice.n_atoms, n_kernels],
+            dtype="uint32")] + kernels)
+        spec.reserve_memory_region(
+            region=POPULATION_BASED_REGIONS.CONVOLUTION_SYNAPSES.value,
+            size=len(data) * 4, label="ConvolutionSynapses")
+        spec.switch_write_focus(
+            region=POPULATION_BASED_REGIONS.CONVOLUTION_SYNAPSES.value)
+        spec.write_array(data)
+
     def gen_on_machine(self, vertex_slice):
         """ True if the synapses should be generated on the machine
         """
@@ -29,6 +29,7 @@ from spinn_front_end_common.abstract_models import AbstractChangableAfterRun
 from spynnaker.pyNN.models.abstract_models import (
     AbstractReadParametersBeforeSet, AbstractContainsUnits,
     AbstractPopulationInitializable, AbstractPopulationSettable)
+from spynnaker.pyNN.models.common import TELEMETRY_DTYPE
 from .abstract_pynn_model import AbstractPyNNModel
 
 logger = FormatAdapter(logging.getLogger(__file__))
@@ -541,6 +542,48 @@ class PyNNPopulationCommon(object):
         # state that something has changed in the population
         self.__change_requires_mapping = True
 
+    # NON-PYNN API CALL
+    def record_timestep_telemetry(self, new_state=True):
+        """ Record the timing and load of each timestep on each core of\
+            this population, to help choose the number of neurons per core.
+
+        :param new_state: True to record the telemetry, False to stop
+        """
+        globals_variables.get_simulator().verify_not_running()
+        if not hasattr(self.__vertex, "set_recording_timestep_telemetry"):
+            raise ConfigurationException(
+                "This population cannot record timestep telemetry")
+        self.__vertex.set_recording_timestep_telemetry(new_state)
+
+    # NON-PYNN API CALL
+    def get_timestep_telemetry(self, clear=False):
+        """ Get the timing and load of each timestep on each core of this\
+            population; see TimestepTelemetryRecorder.
+
+        :param clear: True to clear the telemetry once it has been read, so\
+            that the next call only gets that of later timesteps
+        :type clear: bool
+        :return: an array with a row per core per timestep
+        :rtype: numpy.ndarray
+        """
+        if not hasattr(self.__vertex, "is_recording_timestep_telemetry") or \
+                not self.__vertex.is_recording_timestep_telemetry():
+            raise ConfigurationException(
+                "This population has not been set to record timestep "
+                "telemetry")
+        sim = globals_variables.get_simulator()
+        if not sim.has_ran or sim.use_virtual_board:
+            logger.warning(
+                "The simulation has not truly ran, therefore the timestep "
+                "telemetry cannot be retrieved, hence it will be empty")
+            return numpy.zeros(0, dtype=TELEMETRY_DTYPE)
+        telemetry = self.__vertex.get_timestep_telemetry(
+            sim.placements, sim.graph_mapper, sim.buffer_manager)
+        if clear:
+            self.__vertex.clear_timestep_telemetry(
+                sim.buffer_manager, sim.placements, sim.graph_mapper)
+        return telemetry
+
     @property
     def size(self):
         """ The number of neurons in the population
@@ -361,6 +361,52 @@ class PyNNProjectionCommon(object):
                 connection_holder.add_connections(connections)
         connection_holder.finish()
 
+    def set(self, **attributes):
+        """ Set the attributes of all the connections of the projection;\
+            only the weights can be set at present.
+
+        :param attributes: The new values of the attributes, by name
+        :raises ConfigurationException: If an attribute cannot be set
+        """
+        unsupported = sorted(set(attributes) - {"weight"})
+        if unsupported:
+            raise ConfigurationException(
+                "Only the weights of a projection can be set, not {}".format(
+                    ", ".join(unsupported)))
+        if "weight" in attributes:
+            self._set_weights(attributes["weight"])
+
+    def _set_weights(self, weights):
+        """ Change the weights of all the connections of the projection.\
+            After a run, the weights are written into the synaptic rows\
+            already on the machine where this can be done, so that the\
+            synaptic matrices and master population tables are not\
+            generated and loaded again before the next run.
+
+        :param weights: The new weights; a single value or a random\
+            distribution can be written in place
+        """
+        self.__synapse_information.weight = weights
+        ctl = self.__spinnaker_control
+        if not ctl.has_ran or self.__virtual_connection_list is not None:
+            return
+
+        post_vertex = self.__projection_edge.post_vertex
+        pre_vertex = self.__projection_edge.pre_vertex
+        edges = ctl.graph_mapper.get_machine_edges(self.__projection_edge)
+        progress = ProgressBar(
+            edges, "Writing weights for projection between {} and {}".format(
+                pre_vertex.label, post_vertex.label))
+        for edge in progress.over(edges, finish_at_end=False):
+            placement = ctl.placements.get_placement_of_vertex(
+                edge.post_vertex)
+            if not post_vertex.update_weights_on_machine(
+                    ctl.transceiver, placement, edge, ctl.graph_mapper,
+                    ctl.routing_infos, self.__synapse_information):
+                # Everything will be generated again anyway
+                break
+        progress.end()
+
     def _clear_cache(self):
         post_vertex = self.__projection_edge.post_vertex
         if isinstance(post_vertex, AbstractAcceptsIncomingSynapses):
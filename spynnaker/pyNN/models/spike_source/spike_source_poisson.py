@@ -26,14 +26,24 @@ DEFAULT_MAX_ATOMS_PER_CORE = 500
 
 
 class SpikeSourcePoisson(AbstractPyNNModel):
-    __slots__ = ["__duration", "__rate", "__start"]
+    __slots__ = ["__duration", "__rate", "__rate_schedule", "__start"]
 
     default_population_parameters = _population_parameters
 
-    def __init__(self, rate=1.0, start=0, duration=None):
+    def __init__(self, rate=1.0, start=0, duration=None, rate_schedule=None):
+        """
+        :param rate: the rate of each source in Hz
+        :param start: the time in ms at which each source starts
+        :param duration: the time in ms for which each source runs
+        :param rate_schedule: \
+            changes of rate made on the machine as the simulation runs; \
+            either a list of (time in ms, rate in Hz) pairs for every \
+            source, or one such list per source
+        """
         self.__start = start
         self.__duration = duration
         self.__rate = rate
+        self.__rate_schedule = rate_schedule
 
     @classmethod
     def set_model_max_atoms_per_core(cls, n_atoms=DEFAULT_MAX_ATOMS_PER_CORE):
@@ -52,4 +62,4 @@ class SpikeSourcePoisson(AbstractPyNNModel):
         max_atoms = self.get_max_atoms_per_core()
         return SpikeSourcePoissonVertex(
             n_neurons, constraints, label, self.__rate, max_rate, self.__start,
-            self.__duration, seed, max_atoms, self)
+            self.__duration, seed, max_atoms, self, self.__rate_schedule)
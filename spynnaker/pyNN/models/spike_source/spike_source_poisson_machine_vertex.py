@@ -50,7 +50,8 @@ class SpikeSourcePoissonMachineVertex(
                ('POISSON_PARAMS_REGION', 1),
                ('SPIKE_HISTORY_REGION', 2),
                ('PROVENANCE_REGION', 3),
-               ('PROFILER_REGION', 4)])
+               ('PROFILER_REGION', 4),
+               ('RATE_SCHEDULE_REGION', 5)])
 
     PROFILE_TAG_LABELS = {
         0: "TIMER",
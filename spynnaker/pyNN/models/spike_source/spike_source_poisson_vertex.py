@@ -64,6 +64,17 @@ PARAMS_BASE_WORDS = 15
 # isi_val, time_to_spike
 PARAMS_WORDS_PER_NEURON = 7
 
+# uint32_t n_changes
+RATE_SCHEDULE_BASE_WORDS = 1
+
+# tick, source | (kind << 16), value
+RATE_SCHEDULE_WORDS_PER_CHANGE = 3
+
+# The kinds of rate change, which say how the value is taken on the machine
+_SLOW_RATE = 0     # value is the inter-spike-interval
+_FAST_RATE = 1     # value is exp^(-spikes_per_tick)
+_FASTER_RATE = 2   # value is sqrt(spikes_per_tick)
+
 START_OF_POISSON_GENERATOR_PARAMETERS = PARAMS_BASE_WORDS * 4
 MICROSECONDS_PER_SECOND = 1000000.0
 MICROSECONDS_PER_MILLISECOND = 1000.0
@@ -104,6 +115,7 @@ class SpikeSourcePoissonVertex(
         "__model_name",
         "__n_atoms",
         "__rate",
+        "__rate_schedule",
         "__rng",
         "__seed",
         "__spike_recorder",
@@ -120,7 +132,7 @@ class SpikeSourcePoissonVertex(
 
     def __init__(
             self, n_neurons, constraints, label, rate, max_rate, start,
-            duration, seed, max_atoms_per_core, model):
+            duration, seed, max_atoms_per_core, model, rate_schedule=None):
         # pylint: disable=too-many-arguments
         super(SpikeSourcePoissonVertex, self).__init__(
             label, constraints, max_atoms_per_core)
@@ -145,6 +157,7 @@ class SpikeSourcePoissonVertex(
         self.__max_rate = max_rate
         self.__rate = self.convert_rate(rate)
         self.__rate_change = numpy.zeros(self.__rate.size)
+        self.__rate_schedule = self.convert_rate_schedule(rate_schedule)
         self.__start = utility_calls.convert_param_to_numpy(start, n_neurons)
         self.__duration = utility_calls.convert_param_to_numpy(
             duration, n_neurons)
@@ -210,6 +223,7 @@ class SpikeSourcePoissonVertex(
             SYSTEM_BYTES_REQUIREMENT +
             SpikeSourcePoissonMachineVertex.get_provenance_data_size(0) +
             poisson_params_sz +
+            self.get_rate_schedule_bytes(vertex_slice) +
             recording_utilities.get_recording_header_size(1) +
             recording_utilities.get_recording_data_constant_size(1) +
             profile_utils.get_profile_region_size(self.__n_profile_samples))
@@ -262,6 +276,54 @@ class SpikeSourcePoissonVertex(
         self.__rate_change = new_rate - self.__rate
         self.__rate = new_rate
 
+    @property
+    def rate_schedule(self):
+        return self.__rate_schedule
+
+    def convert_rate_schedule(self, rate_schedule):
+        """ Convert a rate schedule into an array of (time, rate) rows for\
+            each atom, in order of time
+
+        :param rate_schedule: \
+            None, a list of (time in ms, rate in Hz) pairs for every atom, or\
+            one such list per atom
+        :rtype: list(numpy.ndarray)
+        """
+        if rate_schedule is None:
+            schedules = [[]] * self.__n_atoms
+        else:
+            schedules = list(rate_schedule)
+            if len(schedules) and len(schedules[0]) and \
+                    numpy.ndim(schedules[0]) == 1:
+                schedules = [schedules] * self.__n_atoms
+            if len(schedules) != self.__n_atoms:
+                raise ConfigurationException(
+                    "A rate schedule must be a list of (time, rate) pairs, "
+                    "or one such list for each of the {} sources".format(
+                        self.__n_atoms))
+
+        new_schedules = list()
+        for schedule in schedules:
+            changes = numpy.array(schedule, dtype="float").reshape(-1, 2)
+            if numpy.any(changes < 0):
+                raise ConfigurationException(
+                    "The times and rates of a rate schedule cannot be "
+                    "negative")
+            new_schedules.append(
+                changes[numpy.argsort(changes[:, 0], kind="mergesort")])
+
+        # The recording space must allow for the scheduled rates too
+        for changes in new_schedules:
+            if len(changes) and numpy.max(changes[:, 1]) > self.__max_rate:
+                self.__max_rate = numpy.max(changes[:, 1])
+        return new_schedules
+
+    @rate_schedule.setter
+    def rate_schedule(self, rate_schedule):
+        # The size of the schedule region may change
+        self.__rate_schedule = self.convert_rate_schedule(rate_schedule)
+        self.__change_requires_mapping = True
+
     @property
     def start(self):
         return self.__start
@@ -299,6 +361,17 @@ class SpikeSourcePoissonVertex(
         return (PARAMS_BASE_WORDS +
                 (vertex_slice.n_atoms * PARAMS_WORDS_PER_NEURON)) * 4
 
+    def get_rate_schedule_bytes(self, vertex_slice):
+        """ Gets the size of the rate schedule in bytes
+
+        :param vertex_slice:
+        """
+        n_changes = sum(
+            len(changes)
+            for changes in self.__rate_schedule[vertex_slice.as_slice])
+        return (RATE_SCHEDULE_BASE_WORDS +
+                (n_changes * RATE_SCHEDULE_WORDS_PER_CHANGE)) * 4
+
     def reserve_memory_regions(self, spec, placement, graph_mapper):
         """ Reserve memory regions for poisson source parameters and output\
             buffer.
@@ -327,6 +400,11 @@ class SpikeSourcePoissonVertex(
         profile_utils.reserve_profile_region(
             spec, _REGIONS.PROFILER_REGION.value, self.__n_profile_samples)
 
+        spec.reserve_memory_region(
+            region=_REGIONS.RATE_SCHEDULE_REGION.value,
+            size=self.get_rate_schedule_bytes(graph_mapper.get_slice(
+                placement.vertex)), label='RateSchedule')
+
         placement.vertex.reserve_provenance_data_region(spec)
 
     def _reserve_poisson_params_region(self, placement, graph_mapper, spec):
@@ -395,11 +473,13 @@ class SpikeSourcePoissonVertex(
             self.__n_data_specs)
         self.__n_data_specs += 1
 
-        # Write the number of microseconds between sending spikes
-        total_mean_rate = numpy.sum(self.__rate)
+        # Write the number of microseconds between sending spikes, allowing
+        # for the highest rate that each source is scheduled to reach
+        peak_rate = self._peak_rates()
+        total_mean_rate = numpy.sum(peak_rate)
         if total_mean_rate > 0:
             max_spikes = numpy.sum(scipy.stats.poisson.ppf(
-                1.0 - (1.0 / self.__rate), self.__rate))
+                1.0 - (1.0 / peak_rate), peak_rate))
             spikes_per_timestep = (
                 max_spikes / (MICROSECONDS_PER_SECOND // machine_time_step))
             # avoid a possible division by zero / small number (which may
@@ -469,7 +549,39 @@ class SpikeSourcePoissonVertex(
 
         # Get the rates for the atoms
         rates = self.__rate[vertex_slice.as_slice].astype("float")
+        (is_fast_source, is_faster_source, exp_minus_lambda, sqrt_lambda,
+         isi_val) = self._get_rate_parameters(rates, machine_time_step)
+        elements = numpy.logical_not(is_fast_source) & (rates > 0)
+
+        # Get the time to spike value
+        time_to_spike = self.__time_to_spike[vertex_slice.as_slice].astype(int)
+        changed_rates = (
+            self.__rate_change[vertex_slice.as_slice].astype("bool") &
+            elements)
+        time_to_spike[changed_rates] = 0
+
+        # Merge the arrays as parameters per atom
+        data = numpy.dstack((
+            start_scaled.astype("uint32"),
+            end_scaled.astype("uint32"),
+            is_fast_source.astype("uint32"),
+            (exp_minus_lambda * (2 ** 32)).astype("uint32"),
+            (sqrt_lambda * (2 ** 15)).astype("uint32"),
+            isi_val.astype("uint32"),
+            time_to_spike.astype("uint32")
+        ))[0]
+
+        spec.write_array(data)
 
+    @staticmethod
+    def _get_rate_parameters(rates, machine_time_step):
+        """ Work out the parameters which give sources their rates
+
+        :param rates: the rates of the sources in Hz
+        :param machine_time_step: the time between timer tick updates.
+        :return: is_fast_source, is_faster_source, exp_minus_lambda,\
+            sqrt_lambda and isi_val for each source
+        """
         # Compute the spikes per tick for each atom
         spikes_per_tick = (
             rates * (float(machine_time_step) / MICROSECONDS_PER_SECOND))
@@ -498,24 +610,63 @@ class SpikeSourcePoissonVertex(
         elements = numpy.logical_not(is_fast_source) & (spikes_per_tick > 0)
         isi_val[elements] = (1.0 / spikes_per_tick[elements]).astype(int)
 
-        # Get the time to spike value
-        time_to_spike = self.__time_to_spike[vertex_slice.as_slice].astype(int)
-        changed_rates = (
-            self.__rate_change[vertex_slice.as_slice].astype("bool") &
-            elements)
-        time_to_spike[changed_rates] = 0
+        return (is_fast_source, is_faster_source, exp_minus_lambda,
+                sqrt_lambda, isi_val)
+
+    def _peak_rates(self):
+        """ Get the highest rate of each atom, including scheduled rates
+        """
+        peak_rate = numpy.array(self.__rate, dtype="float")
+        for atom, changes in enumerate(self.__rate_schedule):
+            if len(changes):
+                peak_rate[atom] = max(
+                    peak_rate[atom], numpy.max(changes[:, 1]))
+        return peak_rate
+
+    def _write_rate_schedule(self, spec, vertex_slice, machine_time_step):
+        """ Write the scheduled rate changes of the atoms of a slice, in\
+            order of time, with the parameters for each rate worked out
+
+        :param spec: the data specification writer
+        :param vertex_slice: the slice of atoms a machine vertex holds
+        :param machine_time_step: the time between timer tick updates.
+        :return: None
+        """
+        spec.switch_write_focus(_REGIONS.RATE_SCHEDULE_REGION.value)
+
+        # Gather the changes of each source; a stable sort by tick keeps the
+        # changes of each source in order, so the last one of a tick wins
+        schedules = self.__rate_schedule[vertex_slice.as_slice]
+        ticks = numpy.concatenate([
+            self._convert_ms_to_n_timesteps(changes[:, 0], machine_time_step)
+            for changes in schedules])
+        sources = numpy.concatenate([
+            numpy.full(len(changes), source, dtype="uint32")
+            for source, changes in enumerate(schedules)])
+        rates = numpy.concatenate([changes[:, 1] for changes in schedules])
+        order = numpy.argsort(ticks, kind="mergesort")
+        ticks, sources, rates = ticks[order], sources[order], rates[order]
+
+        spec.write_value(data=len(ticks))
+        if not len(ticks):
+            return
+
+        (is_fast_source, is_faster_source, exp_minus_lambda, sqrt_lambda,
+         isi_val) = self._get_rate_parameters(rates, machine_time_step)
+        kinds = numpy.full(len(ticks), _SLOW_RATE, dtype="uint32")
+        kinds[is_fast_source] = _FAST_RATE
+        kinds[is_faster_source] = _FASTER_RATE
+        values = isi_val.astype("uint32")
+        values[is_fast_source] = (
+            exp_minus_lambda[is_fast_source] * (2 ** 32)).astype("uint32")
+        values[is_faster_source] = (
+            sqrt_lambda[is_faster_source] * (2 ** 15)).astype("uint32")
 
-        # Merge the arrays as parameters per atom
         data = numpy.dstack((
-            start_scaled.astype("uint32"),
-            end_scaled.astype("uint32"),
-            is_fast_source.astype("uint32"),
-            (exp_minus_lambda * (2 ** 32)).astype("uint32"),
-            (sqrt_lambda * (2 ** 15)).astype("uint32"),
-            isi_val.astype("uint32"),
-            time_to_spike.astype("uint32")
+            ticks.astype("uint32"),
+            sources | (kinds << 16),
+            values
         ))[0]
-
         spec.write_array(data)
 
     @staticmethod
@@ -707,6 +858,9 @@ class SpikeSourcePoissonVertex(
             spec, _REGIONS.PROFILER_REGION.value,
             self.__n_profile_samples)
 
+        # write the scheduled rate changes
+        self._write_rate_schedule(spec, vertex_slice, machine_time_step)
+
         # End-of-Spec:
         spec.end_specification()
 
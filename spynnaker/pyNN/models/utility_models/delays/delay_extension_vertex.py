@@ -344,7 +344,8 @@ class DelayExtensionVertex(
             connector.generate_on_machine(
                 synapse_info.weight, synapse_info.delay)
         synapse_gen = isinstance(
-            dynamics, AbstractGenerateOnMachine)
+            dynamics, AbstractGenerateOnMachine) and \
+            dynamics.generate_on_machine()
         if connector_gen and synapse_gen:
             return sum((
                 DelayGeneratorData.BASE_SIZE,
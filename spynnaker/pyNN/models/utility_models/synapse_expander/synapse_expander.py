@@ -169,7 +169,8 @@ def _fill_in_connection_data(
                 connector.generate_on_machine(
                     synapse_info.weight, synapse_info.delay)
             synapse_gen = isinstance(
-                dynamics, AbstractGenerateOnMachine)
+                dynamics, AbstractGenerateOnMachine) and \
+                dynamics.generate_on_machine()
             if connector_gen and synapse_gen:
                 machine_edges = graph_mapper.get_machine_edges(app_edge)
                 for machine_edge in machine_edges:
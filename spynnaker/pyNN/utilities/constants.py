@@ -72,7 +72,9 @@ POPULATION_BASED_REGIONS = Enum(
            ('PROVENANCE_DATA', 7),
            ('PROFILING', 8),
            ('CONNECTOR_BUILDER', 9),
-           ('DIRECT_MATRIX', 10)])
+           ('DIRECT_MATRIX', 10),
+           ('PROCEDURAL_SYNAPSES', 11),
+           ('CONVOLUTION_SYNAPSES', 12)])
 
 # The partition ID used for spike data
 SPIKE_PARTITION_ID = "SPIKE"
@@ -85,3 +87,7 @@ GSYN_INHIB = "gsyn_inh"
 
 # The partition ID used for Poisson live control data
 LIVE_POISSON_CONTROL_PARTITION_ID = "CONTROL"
+
+# The SDP port on which Poisson sources receive messages of many rates; this
+# must match POISSON_RATE_SDP_PORT in spike_source_poisson.c
+POISSON_RATE_SDP_PORT = 6
@@ -0,0 +1,159 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import struct
+import unittest
+from spinnman.messages.sdp import SDPFlag
+from spynnaker.pyNN.connections import SpynnakerPoissonControlConnection
+from spynnaker.pyNN.utilities.constants import POISSON_RATE_SDP_PORT
+
+# The command of a message of the rates of consecutive neurons
+_RATES_RANGE = 1
+
+# The most rates in one message
+_MAX_RATES = 65
+
+_IP_ADDRESS = "10.11.12.13"
+
+
+class MockCursor(object):
+
+    def __init__(self, cores):
+        self._cores = cores
+        self._label = None
+
+    def execute(self, query, args):
+        self._label = args[0]
+
+    def fetchall(self):
+        return self._cores[self._label]
+
+
+class MockDatabaseReader(object):
+
+    def __init__(self, cores):
+        self.cursor = MockCursor(cores)
+
+    def get_ip_address(self, x, y):
+        return _IP_ADDRESS
+
+
+class MockSenderConnection(object):
+
+    def __init__(self):
+        self.sent = list()
+
+    def send_to(self, data, address):
+        self.sent.append((data, address))
+
+
+def _range_data(data):
+    """ Decode the data of a message of the rates of consecutive neurons
+    """
+    command, first_neuron_id, n_rates = struct.unpack_from("<III", data)
+    rates = struct.unpack_from("<{}I".format(n_rates), data, 12)
+    if len(data) != 12 + 4 * n_rates:
+        raise AssertionError("{} bytes for {} rates".format(
+            len(data), n_rates))
+    return command, first_neuron_id, list(rates)
+
+
+def _connection(cores):
+    """ Make a connection that has read where the cores of the source\
+        "poisson" are, without connecting to anything
+    """
+    # pylint: disable=protected-access
+    connection = SpynnakerPoissonControlConnection.__new__(
+        SpynnakerPoissonControlConnection)
+    connection._SpynnakerPoissonControlConnection__control_label_extension = \
+        "_control"
+    connection._SpynnakerPoissonControlConnection__poisson_labels = [
+        "poisson"]
+    connection._SpynnakerPoissonControlConnection__read_poisson_cores(
+        MockDatabaseReader({"poisson": cores}))
+    connection._sender_connection = MockSenderConnection()
+    return connection
+
+
+class TestSpynnakerPoissonControlConnection(unittest.TestCase):
+
+    def test_assemble_range_messages(self):
+        # pylint: disable=protected-access
+        fixed_rates = list(range(1000, 1000 + 2 * _MAX_RATES + 20))
+        messages = SpynnakerPoissonControlConnection._assemble_range_messages(
+            3, 4, 5, 10, fixed_rates)
+        self.assertEqual(len(messages), 3)
+
+        rates = list()
+        for i, message in enumerate(messages):
+            header = message.sdp_header
+            self.assertEqual(header.flags, SDPFlag.REPLY_NOT_EXPECTED)
+            self.assertEqual(header.destination_port, POISSON_RATE_SDP_PORT)
+            self.assertEqual(header.destination_chip_x, 3)
+            self.assertEqual(header.destination_chip_y, 4)
+            self.assertEqual(header.destination_cpu, 5)
+            command, first_neuron_id, message_rates = _range_data(
+                message.data)
+            self.assertEqual(command, _RATES_RANGE)
+            self.assertEqual(first_neuron_id, 10 + i * _MAX_RATES)
+            rates.extend(message_rates)
+        self.assertEqual(rates, fixed_rates)
+
+    def test_assemble_range_messages_of_no_rates(self):
+        # pylint: disable=protected-access
+        self.assertEqual(
+            SpynnakerPoissonControlConnection._assemble_range_messages(
+                0, 0, 1, 0, []), [])
+
+    def test_set_rate_range(self):
+        connection = _connection([
+            (0, 9, 0, 0, 1), (10, 19, 0, 0, 2), (20, 29, 1, 0, 1)])
+        connection.set_rate_range("poisson_control", 5, [
+            0.5 * i for i in range(10)])
+
+        # Only the first two cores have neurons of the range
+        sent = connection._sender_connection.sent
+        self.assertEqual(len(sent), 2)
+        first_neuron_ids = list()
+        cores = list()
+        for data, address in sent:
+            self.assertEqual(address[0], _IP_ADDRESS)
+            self.assertEqual(data[:2], b"\0\0")
+            cores.append(struct.unpack_from("<B", data, 4)[0] & 0x1F)
+            command, first_neuron_id, rates = _range_data(data[10:])
+            self.assertEqual(command, _RATES_RANGE)
+            first_neuron_ids.append(first_neuron_id)
+            self.assertEqual(rates, [
+                (first_neuron_id - 5 + i) * 16384 for i in range(5)])
+        self.assertEqual(first_neuron_ids, [5, 10])
+        self.assertEqual(cores, [1, 2])
+
+    def test_set_rate_range_before_first_core(self):
+        connection = _connection([(0, 9, 0, 0, 1), (10, 19, 0, 0, 2)])
+        connection.set_rate_range("poisson", 12, [-1.5, 2.0, 0.5, 1.0, 3.0])
+
+        # No message is sent to the core whose neurons are all before the
+        # range, and negative rates are sent as two's complement
+        sent = connection._sender_connection.sent
+        self.assertEqual(len(sent), 1)
+        self.assertEqual(struct.unpack_from("<B", sent[0][0], 4)[0] & 0x1F, 2)
+        command, first_neuron_id, rates = _range_data(sent[0][0][10:])
+        self.assertEqual((command, first_neuron_id), (_RATES_RANGE, 12))
+        self.assertEqual(rates, [
+            (-3 * 16384) & 0xFFFFFFFF, 2 * 32768, 16384, 32768, 3 * 32768])
+
+
+if __name__ == '__main__':
+    unittest.main()
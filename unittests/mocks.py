@@ -15,6 +15,7 @@
 
 import configparser
 import numpy
+from pacman.model.routing_info import BaseKeyAndMask
 from spinn_front_end_common.utilities import globals_variables
 from spynnaker.pyNN.utilities.spynnaker_failed_state import (
     SpynnakerFailedState)
@@ -40,10 +41,11 @@ class MockPopulation(object):
 
 class MockRNG(object):
 
-    def __init__(self):
-        self._rng = numpy.random.RandomState()
+    def __init__(self, seed=None):
+        self.seed = seed
+        self._rng = numpy.random.RandomState(seed)
 
-    def next(self, n):
+    def next(self, n=None):
         return self._rng.uniform(size=n)
 
     def __getattr__(self, name):
@@ -61,6 +63,70 @@ class MockRandomDistribution(object):
         return self._rng.next(n)
 
 
+class MockMachineEdge(object):
+
+    def __init__(self, pre_vertex, post_vertex, label):
+        self.pre_vertex = pre_vertex
+        self.post_vertex = post_vertex
+        self.label = label
+
+
+class MockRoutingInfo(object):
+
+    def __init__(self, key_and_mask):
+        self.first_key_and_mask = key_and_mask
+
+
+class MockGraphs(object):
+    """ The machine graph, graph mapper and routing information of the\
+        machine edges of an application edge, one from each slice of its\
+        pre-vertex to a single machine vertex of its post-vertex.  The\
+        machine vertices are the index of the pre-vertex slice and "post",\
+        and the keys are one block of 0x10000 for each slice unless given.
+    """
+
+    def __init__(self, app_edge, pre_vertex_slices, post_vertex_slice,
+                 keys_and_masks=None):
+        self._app_edge = app_edge
+        self._pre_vertex_slices = pre_vertex_slices
+        self._post_vertex_slice = post_vertex_slice
+        if keys_and_masks is None:
+            keys_and_masks = [
+                BaseKeyAndMask((index + 1) << 16, 0xFFFF0000)
+                for index in range(len(pre_vertex_slices))]
+        self._keys_and_masks = keys_and_masks
+        self.machine_edges = [
+            MockMachineEdge(index, "post", "machine edge {}".format(index))
+            for index in range(len(pre_vertex_slices))]
+
+    def get_edges_ending_at_vertex(self, vertex):
+        return self.machine_edges
+
+    def get_application_edge(self, machine_edge):
+        return self._app_edge
+
+    def get_slice(self, vertex):
+        if vertex == "post":
+            return self._post_vertex_slice
+        return self._pre_vertex_slices[vertex]
+
+    def get_slices(self, vertex):
+        if vertex is self._app_edge.post_vertex:
+            return [self._post_vertex_slice]
+        return self._pre_vertex_slices
+
+    def get_machine_vertex_index(self, vertex):
+        if vertex == "post":
+            return 0
+        return vertex
+
+    def get_routing_info_for_edge(self, machine_edge):
+        return MockRoutingInfo(self._keys_and_masks[machine_edge.pre_vertex])
+
+    def get_first_key_for_edge(self, machine_edge):
+        return self._keys_and_masks[machine_edge.pre_vertex].key
+
+
 class MockSimulator(object):
 
     def __init__(self):
@@ -69,7 +135,11 @@ class MockSimulator(object):
             {"spikes_per_second": "30",
              "incoming_spike_buffer_size": "256",
              "ring_buffer_sigma": "5",
-             "one_to_one_connection_dtcm_max_bytes": "0"}
+             "one_to_one_connection_dtcm_max_bytes": "0",
+             "max_synaptic_row_dma_buffers": "4",
+             "n_synapse_generation_threads": "1",
+             "synaptic_block_cache_directory": "None",
+             "synaptic_block_cache_max_bytes": "None"}
         self.config["Buffers"] = {"time_between_requests": "10",
                                   "minimum_buffer_sdram": "10",
                                   "use_auto_pause_and_resume": "True",
@@ -0,0 +1,102 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+""" Compare the times taken to build the synaptic rows of a projection of\
+    a million synapses a list per row at a time, with numpy in one pass,\
+    and with the compiled extension.
+
+    python row_packing_benchmark.py [n_synapses] [n_pre_neurons]
+"""
+
+from __future__ import print_function
+import sys
+import time
+import numpy
+from pacman.model.graphs.common import Slice
+from spynnaker.pyNN.models.neural_projections.connectors import (
+    AbstractConnector)
+from spynnaker.pyNN.models.neuron.synapse_dynamics import (
+    SynapseDynamicsStatic, SynapseDynamicsSTDP)
+from spynnaker.pyNN.models.neuron.master_pop_table_generators import (
+    MasterPopTableAsBinarySearch)
+from spynnaker.pyNN.models.neuron.synapse_io import SynapseIORowBased
+from spynnaker.pyNN.models.neuron.synapse_io import row_packing
+from spynnaker.pyNN.models.neuron.plasticity.stdp.weight_dependence import (
+    WeightDependenceAdditive)
+from spynnaker.pyNN.models.neuron.plasticity.stdp.timing_dependence import (
+    TimingDependenceSpikePair)
+
+N_POST_NEURONS = 255
+N_SYNAPSE_TYPES = 2
+
+
+class _LegacyStatic(SynapseDynamicsStatic):
+    def get_synaptic_row_items(self, *args):
+        return None
+
+
+class _LegacySTDP(SynapseDynamicsSTDP):
+    def get_synaptic_row_items(self, *args):
+        return None
+
+
+def _connections(n_synapses, n_pre):
+    rng = numpy.random.RandomState(0)
+    connections = numpy.zeros(
+        n_synapses, dtype=AbstractConnector.NUMPY_SYNAPSES_DTYPE)
+    connections["source"] = rng.randint(0, n_pre, n_synapses)
+    connections["target"] = rng.randint(0, N_POST_NEURONS, n_synapses)
+    connections["weight"] = rng.randint(0, 0x10000, n_synapses)
+    connections["delay"] = rng.randint(1, 16, n_synapses)
+    connections["synapse_type"] = rng.randint(
+        0, N_SYNAPSE_TYPES, n_synapses)
+    return connections
+
+
+def _time(dynamics, connections, n_pre):
+    start = time.time()
+    _, data = SynapseIORowBased._get_max_row_length_and_row_data(
+        connections, connections["source"], n_pre,
+        Slice(0, N_POST_NEURONS - 1), N_SYNAPSE_TYPES,
+        MasterPopTableAsBinarySearch(), dynamics, None, None)
+    return time.time() - start, data
+
+
+def run(n_synapses, n_pre):
+    connections = _connections(n_synapses, n_pre)
+    stdp_args = (TimingDependenceSpikePair(), WeightDependenceAdditive())
+    native = row_packing._native_pack_rows
+    for name, dynamics, legacy in (
+            ("static", SynapseDynamicsStatic(), _LegacyStatic()),
+            ("STDP", SynapseDynamicsSTDP(*stdp_args),
+             _LegacySTDP(*stdp_args))):
+        legacy_time, legacy_data = _time(legacy, connections, n_pre)
+        row_packing._native_pack_rows = None
+        numpy_time, numpy_data = _time(dynamics, connections, n_pre)
+        row_packing._native_pack_rows = native
+        assert numpy.array_equal(numpy_data, legacy_data)
+        print("{}: {} synapses in {} rows: per row {:.3f}s, numpy {:.3f}s"
+              .format(name, n_synapses, n_pre, legacy_time, numpy_time),
+              end="")
+        if native is not None:
+            native_time, native_data = _time(dynamics, connections, n_pre)
+            assert numpy.array_equal(native_data, legacy_data)
+            print(", compiled {:.3f}s".format(native_time), end="")
+        print()
+
+
+if __name__ == "__main__":
+    run(int(sys.argv[1]) if len(sys.argv) > 1 else 1000000,
+        int(sys.argv[2]) if len(sys.argv) > 2 else 8192)
@@ -0,0 +1,69 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import numpy
+from pacman.model.routing_info import BaseKeyAndMask
+from spynnaker.pyNN.models.neuron.master_pop_table_generators import (
+    MasterPopTableAsBinarySearch)
+
+
+class _MockSpec(object):
+    """ Records the words written by the master population table
+    """
+
+    def __init__(self):
+        self.words = list()
+
+    def switch_write_focus(self, region):
+        pass
+
+    def write_value(self, value):
+        self.words.append(int(value))
+
+    def write_array(self, array):
+        self.words.extend(int(value) for value in array)
+
+
+def test_connectivity_bit_fields():
+    table = MasterPopTableAsBinarySearch()
+    spec = _MockSpec()
+    table.initialise_table(spec, 0)
+
+    # Two blocks for one key are merged; rows 0, 3 and 33 have synapses
+    rows_a = numpy.zeros(40, dtype="bool")
+    rows_a[[0, 33]] = True
+    rows_b = numpy.zeros(8, dtype="bool")
+    rows_b[3] = True
+    key_a = BaseKeyAndMask(0x100, 0xFFFFFF00)
+    table.update_master_population_table(
+        spec, 0, 10, key_a, 0, rows_present=rows_a)
+    table.update_master_population_table(
+        spec, 0x100, 10, key_a, 0, rows_present=rows_b)
+
+    # An empty block is filtered completely
+    table.update_master_population_table(
+        spec, 0, 0, BaseKeyAndMask(0x200, 0xFFFFFF00), 0,
+        rows_present=numpy.zeros(0, dtype="bool"))
+
+    # A block with unknown rows is not filtered
+    table.update_master_population_table(
+        spec, 0x200, 10, BaseKeyAndMask(0x300, 0xFFFFFF00), 0)
+    table.finish_master_pop_table(spec, 0)
+
+    n_entries, n_addresses = spec.words[0:2]
+    assert n_entries == 3
+    assert n_addresses == 4
+    bit_fields = spec.words[2 + (n_entries * 3) + n_addresses:]
+    assert bit_fields == [2, 0x9, 0x2, 1, 0, 0]
@@ -0,0 +1,81 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import pytest
+from data_specification.enums import DataType
+from spynnaker.pyNN.models.neuron.plasticity.stdp.common import (
+    plasticity_helpers)
+from spynnaker.pyNN.models.neuron.plasticity.stdp.timing_dependence import (
+    TimingDependenceSpikePair)
+
+
+class _MockSpec(object):
+    """ Records the values written, and how many bytes they take
+    """
+    def __init__(self):
+        self.values = list()
+        self.n_bytes = 0
+
+    def write_value(self, data, data_type=DataType.UINT32):
+        self.values.append(data)
+        self.n_bytes += data_type.size
+
+
+@pytest.mark.parametrize("size,shift,interpolate", [
+    (256, 0, False), (33, 3, True)])
+def test_write_exp_lut(size, shift, interpolate):
+    spec = _MockSpec()
+    last_entry = plasticity_helpers.write_exp_lut(
+        spec, 20.0, size, shift, interpolate=interpolate)
+    header = spec.values[0]
+    assert header & plasticity_helpers.LUT_SIZE_MASK == size
+    assert (header >> plasticity_helpers.LUT_SHIFT_SHIFT) & 0xFF == shift
+    assert bool(header & (1 << plasticity_helpers.LUT_INTERPOLATE_BIT)) == \
+        interpolate
+    assert not header & (1 << plasticity_helpers.LUT_SHARED_BIT)
+
+    # The first entry is one and the last is the one returned
+    assert spec.values[1] == plasticity_helpers.STDP_FIXED_POINT_ONE
+    assert spec.values[size] == round(
+        last_entry * plasticity_helpers.STDP_FIXED_POINT_ONE)
+    assert spec.n_bytes == \
+        plasticity_helpers.get_exp_lut_sdram_usage_in_bytes(size)
+
+
+def test_write_shared_exp_lut():
+    spec = _MockSpec()
+    plasticity_helpers.write_exp_lut(spec, 20.0, 256, 0, shared=True)
+    assert len(spec.values) == 1
+    assert spec.values[0] & (1 << plasticity_helpers.LUT_SHARED_BIT)
+    assert spec.n_bytes == \
+        plasticity_helpers.get_exp_lut_sdram_usage_in_bytes(256, shared=True)
+
+
+def test_pair_shares_equal_taus():
+    shared = TimingDependenceSpikePair(tau_plus=20.0, tau_minus=20.0)
+    separate = TimingDependenceSpikePair(tau_plus=20.0, tau_minus=30.0)
+    for timing in (shared, separate):
+        spec = _MockSpec()
+        timing.write_parameters(spec, 1000, None)
+        assert spec.n_bytes == timing.get_parameters_sdram_usage_in_bytes()
+    assert (shared.get_parameters_sdram_usage_in_bytes() <
+            separate.get_parameters_sdram_usage_in_bytes())
+
+
+@pytest.mark.parametrize("size,shift", [(0, 0), (0x10000, 0), (256, 17)])
+def test_bad_lut_parameters(size, shift):
+    with pytest.raises(ValueError):
+        TimingDependenceSpikePair(
+            lookup_table_size=size, lookup_table_shift=shift)
@@ -0,0 +1,107 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import numpy
+import pytest
+from pacman.model.graphs.common import Slice
+from spynnaker.pyNN.models.neural_projections.connectors import (
+    AbstractConnector)
+from spynnaker.pyNN.models.neuron.synapse_dynamics import (
+    SynapseDynamicsStatic, SynapseDynamicsSTDP)
+from spynnaker.pyNN.models.neuron.master_pop_table_generators import (
+    MasterPopTableAsBinarySearch)
+from spynnaker.pyNN.models.neuron.synapse_io import SynapseIORowBased
+from spynnaker.pyNN.models.neuron.synapse_io.row_packing import (
+    native_row_packing_available, pack_rows)
+from spynnaker.pyNN.models.neuron.plasticity.stdp.weight_dependence import (
+    WeightDependenceAdditive)
+from spynnaker.pyNN.models.neuron.plasticity.stdp.timing_dependence import (
+    TimingDependenceSpikePair)
+
+
+def _connections(n_pre, n_post, n_connections, seed):
+    rng = numpy.random.RandomState(seed)
+    connections = numpy.zeros(
+        n_connections, dtype=AbstractConnector.NUMPY_SYNAPSES_DTYPE)
+    connections["source"] = rng.randint(0, n_pre, n_connections)
+    connections["target"] = rng.randint(0, n_post, n_connections)
+    connections["weight"] = rng.randint(0, 0x10000, n_connections)
+    connections["delay"] = rng.randint(1, 16, n_connections)
+    connections["synapse_type"] = rng.randint(0, 2, n_connections)
+    return connections
+
+
+class _LegacyStatic(SynapseDynamicsStatic):
+    """ Static dynamics whose rows are built a list per row at a time, as\
+        is still done for dynamics that cannot give the data of each\
+        connection
+    """
+    def get_synaptic_row_items(self, *args):
+        return None
+
+
+class _LegacySTDP(SynapseDynamicsSTDP):
+    """ STDP dynamics whose rows are built a list per row at a time
+    """
+    def get_synaptic_row_items(self, *args):
+        return None
+
+
+def _rows(dynamics, connections, n_pre, post_slice):
+    return SynapseIORowBased._get_max_row_length_and_row_data(
+        connections, connections["source"], n_pre, post_slice, 2,
+        MasterPopTableAsBinarySearch(), dynamics, None, None)
+
+
+@pytest.mark.parametrize("dynamics_class", [
+    (SynapseDynamicsStatic, _LegacyStatic),
+    (SynapseDynamicsSTDP, _LegacySTDP)])
+@pytest.mark.parametrize("n_connections", [0, 1, 500])
+def test_rows_match_legacy(dynamics_class, n_connections):
+    if dynamics_class[0] is SynapseDynamicsStatic:
+        dynamics, legacy = (cls() for cls in dynamics_class)
+    else:
+        dynamics, legacy = (
+            cls(TimingDependenceSpikePair(), WeightDependenceAdditive())
+            for cls in dynamics_class)
+    n_pre = 37
+    post_slice = Slice(0, 99)
+    connections = _connections(n_pre, 100, n_connections, n_connections)
+    legacy_length, legacy_data = _rows(
+        legacy, connections, n_pre, post_slice)
+    length, data = _rows(dynamics, connections, n_pre, post_slice)
+    assert length == legacy_length
+    assert numpy.array_equal(data, legacy_data)
+
+
+def test_native_matches_numpy():
+    if not native_row_packing_available():
+        pytest.skip("The row packing extension has not been built")
+    rng = numpy.random.RandomState(1)
+    row_indices = rng.randint(0, 50, 1000)
+    pp_items = rng.randint(0, 256, (1000, 2)).astype("uint8")
+    fp_items = rng.randint(0, 256, (1000, 2)).astype("uint8")
+    native = pack_rows(row_indices, 50, 60, 2, pp_items, None, fp_items)
+    numpy_rows = pack_rows(
+        row_indices, 50, 60, 2, pp_items, None, fp_items, use_native=False)
+    assert numpy.array_equal(native, numpy_rows)
+
+
+@pytest.mark.parametrize("use_native", [True, False])
+def test_row_too_long(use_native):
+    ff_items = numpy.zeros((5, 4), dtype="uint8")
+    with pytest.raises(ValueError):
+        pack_rows(numpy.zeros(5, dtype="uint32"), 1, 4, 0, None, ff_items,
+                  None, use_native=use_native)
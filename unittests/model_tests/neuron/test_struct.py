@@ -0,0 +1,41 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import numpy
+import pytest
+from data_specification.enums import DataType
+from spynnaker.pyNN.models.neuron.implementations import Struct
+
+
+@pytest.mark.parametrize("field_major", [False, True])
+def test_struct_round_trip(field_major):
+    struct = Struct([DataType.S1615, DataType.UINT8, DataType.INT32])
+    values = [numpy.arange(5) * 1.5, numpy.arange(5) + 10, -7]
+    data = struct.get_data(values, 0, 5, field_major)
+    assert len(data) == struct.get_size_in_whole_words(5, field_major)
+
+    read = struct.read_data(data.tobytes(), 0, 5, field_major)
+    assert all(read[0] == values[0])
+    assert all(read[1] == values[1])
+    assert all(read[2] == -7)
+
+
+def test_struct_field_major_layout():
+    struct = Struct([DataType.INT32, DataType.UINT8, DataType.INT32])
+    data = struct.get_data([[1, 2, 3], [4, 5, 6], [7, 8, 9]], 0, 3, True)
+
+    # Each field is contiguous and padded to a whole number of words
+    assert list(data) == [1, 2, 3, 0x060504, 7, 8, 9]
+    assert struct.get_size_in_whole_words(3, True) == 7
@@ -0,0 +1,62 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import numpy
+import pytest
+from pacman.model.graphs.common import Slice
+from spynnaker.pyNN.models.neural_projections.connectors import (
+    AbstractConnector)
+from spynnaker.pyNN.models.neuron.synapse_dynamics import (
+    SynapseDynamicsStatic)
+
+
+def _connections(n_rows, n_per_row, weight, delay):
+    connections = numpy.zeros(
+        n_rows * n_per_row, dtype=AbstractConnector.NUMPY_SYNAPSES_DTYPE)
+    connections["source"] = numpy.repeat(numpy.arange(n_rows), n_per_row)
+    connections["target"] = numpy.tile(numpy.arange(n_per_row), n_rows) + 10
+    connections["weight"] = weight
+    connections["delay"] = delay
+    connections["synapse_type"] = connections["target"] & 1
+    return connections
+
+
+@pytest.mark.parametrize(
+    "weight,delay,row_format",
+    [(numpy.arange(64) * 100, numpy.arange(64) % 16 + 1,
+      SynapseDynamicsStatic.ROW_FORMAT_FULL),
+     (500, numpy.arange(64) % 16 + 1,
+      SynapseDynamicsStatic.ROW_FORMAT_SHARED_WEIGHT),
+     (numpy.arange(64), 3,
+      SynapseDynamicsStatic.ROW_FORMAT_SHARED_DELAY)])
+def test_compact_rows(weight, delay, row_format):
+    n_rows = 4
+    connections = _connections(n_rows, 16, weight, delay)
+    post_slice = Slice(10, 41)
+    dynamics = SynapseDynamicsStatic(compact_rows=True)
+    ff_data, ff_size = dynamics.get_static_synaptic_data(
+        connections, connections["source"], n_rows, post_slice, 2)
+    ff_size = numpy.concatenate(ff_size)
+
+    # All the rows are written in the expected format
+    assert all((ff_size >> 30) == row_format)
+    assert all(dynamics.get_n_synapses_in_rows(ff_size) == 16)
+    n_words = dynamics.get_n_static_words_per_row(ff_size)
+    assert [len(row) for row in ff_data] == list(n_words)
+
+    # The connections read back are those written
+    read = dynamics.read_static_synaptic_data(post_slice, 2, ff_size, ff_data)
+    for name in ["source", "target", "weight", "delay"]:
+        assert all(read[name] == connections[name])
@@ -0,0 +1,102 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import pytest
+from spynnaker.pyNN.models.neuron.synapse_dynamics import SynapseDynamicsSTDP
+from spynnaker.pyNN.models.neuron.plasticity.stdp.timing_dependence import (
+    TimingDependenceSpikePair)
+from spynnaker.pyNN.models.neuron.plasticity.stdp.weight_dependence import (
+    WeightDependenceAdditive)
+
+
+def _dynamics(**kwargs):
+    return SynapseDynamicsSTDP(
+        TimingDependenceSpikePair(), WeightDependenceAdditive(), **kwargs)
+
+
+def test_post_event_history_size():
+    default = _dynamics()
+    bigger = _dynamics(post_event_history_size=64)
+    assert default.post_event_history_size == 16
+    assert bigger.post_event_history_size == 64
+
+    # The size is one word in the parameters, whatever its value
+    assert (default.get_parameters_sdram_usage_in_bytes(10, 2) ==
+            bigger.get_parameters_sdram_usage_in_bytes(10, 2))
+
+    # Different sizes need different parameters
+    assert default.is_same_as(_dynamics())
+    assert not default.is_same_as(bigger)
+
+
+@pytest.mark.parametrize("size", [0, 1, 0x10000])
+def test_bad_post_event_history_size(size):
+    with pytest.raises(NotImplementedError):
+        _dynamics(post_event_history_size=size)
+
+
+def test_deferred_pre_spikes():
+    default = _dynamics()
+    deferred = _dynamics(max_deferred_pre_spikes=8)
+    assert default.max_deferred_pre_spikes == 0
+    assert not default.is_same_as(deferred)
+
+    # The deferred spikes need the buckets of the post-synaptic neurons, a
+    # count and a time each in the row header, so fewer synapses fit in a row
+    n_words = default.get_n_words_for_plastic_connections(10)
+    assert deferred.get_n_words_for_plastic_connections(10) == n_words + 10
+    assert (deferred.get_max_synapses(n_words + 10) ==
+            default.get_max_synapses(n_words))
+
+
+def test_approximate_deferred_weights():
+    exact = _dynamics(max_deferred_pre_spikes=8)
+    approximate = _dynamics(
+        max_deferred_pre_spikes=8, approximate_deferred_weights=True)
+    assert not exact.approximate_deferred_weights
+    assert approximate.approximate_deferred_weights
+    assert not exact.is_same_as(approximate)
+
+    # The flag is a word of the parameters, and the rows are the same size
+    assert (exact.get_parameters_sdram_usage_in_bytes(10, 2) ==
+            approximate.get_parameters_sdram_usage_in_bytes(10, 2))
+    assert (exact.get_n_words_for_plastic_connections(10) ==
+            approximate.get_n_words_for_plastic_connections(10))
+
+
+@pytest.mark.parametrize("n_spikes", [-1, 65])
+def test_bad_deferred_pre_spikes(n_spikes):
+    with pytest.raises(NotImplementedError):
+        _dynamics(max_deferred_pre_spikes=n_spikes)
+
+
+def test_dtcm_usage():
+    default = _dynamics()
+    bigger = _dynamics(post_event_history_size=32)
+    deferred = _dynamics(max_deferred_pre_spikes=8)
+    params = default.get_parameters_sdram_usage_in_bytes(100, 2)
+
+    # Each neuron has a history structure, and a time and trace per event;
+    # one spike is applied at a time, and the parameters are copied
+    assert default.get_dtcm_usage_in_bytes(100, 2) == (
+        100 * (12 + (16 * (4 + 2))) + (4 + 2) + params)
+    assert (bigger.get_dtcm_usage_in_bytes(100, 2) ==
+            default.get_dtcm_usage_in_bytes(100, 2) + (100 * 16 * (4 + 2)))
+
+    # The deferred spikes are applied together, and the rows with deferred
+    # spikes are listed
+    assert (deferred.get_dtcm_usage_in_bytes(100, 2) ==
+            default.get_dtcm_usage_in_bytes(100, 2) + (8 * (4 + 2)) +
+            (1024 * 4))
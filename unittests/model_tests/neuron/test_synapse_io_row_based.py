@@ -13,10 +13,14 @@
 # You should have received a copy of the GNU General Public License
 # along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+import numpy
 import pytest
+from pacman.model.graphs.common import Slice
 from spynnaker.pyNN.exceptions import SynapseRowTooBigException
 from spynnaker.pyNN.models.neural_projections import (
     ProjectionApplicationEdge, SynapseInformation)
+from spynnaker.pyNN.models.neural_projections.connectors import (
+    AbstractConnector, AllToAllConnector)
 from spynnaker.pyNN.models.neuron.synapse_dynamics import (
     SynapseDynamicsStatic, SynapseDynamicsSTDP)
 from spynnaker.pyNN.models.neuron.master_pop_table_generators import (
@@ -26,6 +30,7 @@ from spynnaker.pyNN.models.neuron.plasticity.stdp.weight_dependence import (
     WeightDependenceAdditive)
 from spynnaker.pyNN.models.neuron.plasticity.stdp.timing_dependence import (
     TimingDependenceSpikePair)
+from unittests.mocks import MockSimulator
 
 
 @pytest.mark.parametrize(
@@ -61,3 +66,70 @@ def test_get_max_row_length(dynamics, size, exception, max_size):
         actual_size = io._get_max_row_length(
             size, dynamics, population_table, in_edge, size)
         assert actual_size == max_size
+
+
+def _rows(dynamics, same_weight, same_delay):
+    # 20 synapses from each of 10 neurons to a slice of 100
+    connections = numpy.zeros(
+        200, dtype=AbstractConnector.NUMPY_SYNAPSES_DTYPE)
+    connections["source"] = numpy.repeat(numpy.arange(10), 20)
+    connections["target"] = numpy.tile(numpy.arange(0, 100, 5), 10)
+    connections["weight"] = 20 if same_weight else (
+        numpy.arange(200) % 7 + 10)
+    connections["delay"] = 3 if same_delay else numpy.arange(200) % 15 + 1
+    max_row_length, row_data = \
+        SynapseIORowBased._get_max_row_length_and_row_data(
+            connections, connections["source"], 10, Slice(0, 99), 2,
+            MasterPopTableAsBinarySearch(), dynamics, None, None)
+    return max_row_length, bytearray(row_data.tobytes())
+
+
+def _read(io, synapse_info, max_row_length, data):
+    return io.read_synapses(
+        synapse_info, Slice(0, 9), Slice(0, 99), max_row_length, 0, 2,
+        [10.0, 10.0], data, None, 0, 1000)
+
+
+@pytest.mark.parametrize("dynamics,same_weight,same_delay", [
+    (SynapseDynamicsStatic(), False, False),
+    # Rows whose synapses share a weight
+    (SynapseDynamicsStatic(compact_rows=True), True, False),
+    # Rows whose synapses share a delay
+    (SynapseDynamicsStatic(compact_rows=True), False, True),
+    (SynapseDynamicsSTDP(
+        TimingDependenceSpikePair(), WeightDependenceAdditive()),
+     False, False)])
+def test_write_weights(dynamics, same_weight, same_delay):
+    MockSimulator.setup()
+    io = SynapseIORowBased()
+    max_row_length, data = _rows(dynamics, same_weight, same_delay)
+    synapse_info = SynapseInformation(
+        AllToAllConnector(), dynamics, 0, weight=2.0)
+    before = _read(io, synapse_info, max_row_length, data)
+    new_data = bytearray(data)
+    assert io.write_weights(
+        synapse_info, Slice(0, 9), Slice(0, 99), max_row_length, 0, 2,
+        [10.0, 10.0], new_data, None)
+
+    # Only the weights have changed
+    assert len(new_data) == len(data)
+    after = _read(io, synapse_info, max_row_length, new_data)
+    assert numpy.all(after["weight"] == 2.0)
+    for field in ("source", "target", "delay"):
+        assert numpy.array_equal(before[field], after[field])
+
+
+@pytest.mark.parametrize("dynamics,weight", [
+    # Too big for the ring buffer shifts
+    (SynapseDynamicsStatic(), 10000.0),
+    # Too big for rows whose synapses share a delay
+    (SynapseDynamicsStatic(compact_rows=True), 100.0)])
+def test_write_weights_not_possible(dynamics, weight):
+    MockSimulator.setup()
+    io = SynapseIORowBased()
+    max_row_length, data = _rows(dynamics, False, True)
+    synapse_info = SynapseInformation(
+        AllToAllConnector(), dynamics, 0, weight=weight)
+    assert not io.write_weights(
+        synapse_info, Slice(0, 9), Slice(0, 99), max_row_length, 0, 2,
+        [10.0, 10.0], data, None)
@@ -0,0 +1,180 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import os
+import numpy
+from pacman.model.graphs.common import Slice
+from spynnaker.pyNN.models.neural_projections import SynapseInformation
+from spynnaker.pyNN.models.neural_projections.connectors import (
+    AllToAllConnector, FixedProbabilityConnector)
+from spynnaker.pyNN.models.neuron.synapse_dynamics import (
+    SynapseDynamicsStatic)
+from spynnaker.pyNN.models.neuron.synapse_io import SynapticBlockCache
+from unittests.mocks import MockSimulator, MockPopulation, MockRNG
+
+PRE_SLICES = [Slice(0, 9), Slice(10, 19)]
+POST_SLICES = [Slice(0, 9)]
+
+
+class _CountingConnector(FixedProbabilityConnector):
+    """ Counts the blocks it makes
+    """
+    __slots__ = ["n_created"]
+    _BLOCK_KEY_EXCLUDED = ("n_created", )
+
+    def __init__(self, *args, **kwargs):
+        super(_CountingConnector, self).__init__(*args, **kwargs)
+        self.n_created = 0
+
+    def create_synaptic_block(self, *args, **kwargs):
+        self.n_created += 1
+        return super(_CountingConnector, self).create_synaptic_block(
+            *args, **kwargs)
+
+
+def _random_values(seed):
+    """ Random values drawn from a generator with the given seed
+    """
+    values = MockRNG()
+    values.name = "uniform"
+    values.parameters = {"low": 0.0, "high": 1.0}
+    values.rng = MockRNG(seed)
+    return values
+
+
+def _synapse_info(p_connect=0.5, seed=1, weight=2.0, connector=None):
+    if connector is None:
+        connector = _CountingConnector(p_connect)
+    connector.set_projection_information(
+        pre_population=MockPopulation(20, "Pre"),
+        post_population=MockPopulation(10, "Post"),
+        rng=MockRNG(seed), machine_time_step=1000)
+    return SynapseInformation(
+        connector, SynapseDynamicsStatic(), 0, weight, 1.0)
+
+
+def _block(cache, synapse_info, pre_index=1):
+    synapse_info.connector.prepare_synaptic_block(
+        synapse_info.weight, synapse_info.delay, PRE_SLICES, POST_SLICES,
+        PRE_SLICES[pre_index], POST_SLICES[0])
+    return cache.create_synaptic_block(
+        synapse_info, PRE_SLICES, pre_index, POST_SLICES, 0,
+        PRE_SLICES[pre_index], POST_SLICES[0])
+
+
+def _key(cache, synapse_info, pre_index=1):
+    synapse_info.connector.prepare_synaptic_block(
+        synapse_info.weight, synapse_info.delay, PRE_SLICES, POST_SLICES,
+        PRE_SLICES[pre_index], POST_SLICES[0])
+    return cache.get_key(
+        synapse_info, PRE_SLICES, pre_index, POST_SLICES, 0,
+        PRE_SLICES[pre_index], POST_SLICES[0])
+
+
+def test_reused_in_later_runs(tmpdir):
+    MockSimulator.setup()
+    first = _synapse_info()
+    block = _block(SynapticBlockCache(str(tmpdir)), first)
+    assert first.connector.n_created == 1
+
+    # A new run of the same network loads the block instead
+    second = _synapse_info()
+    cached = _block(SynapticBlockCache(str(tmpdir)), second)
+    assert second.connector.n_created == 0
+    assert isinstance(cached, numpy.memmap)
+    assert numpy.array_equal(block, cached)
+
+    # Changing the block as it is written does not change the file
+    cached["weight"] *= 2
+    third = _synapse_info()
+    assert numpy.array_equal(
+        block, _block(SynapticBlockCache(str(tmpdir)), third))
+
+
+def test_keys_differ(tmpdir):
+    MockSimulator.setup()
+    cache = SynapticBlockCache(str(tmpdir))
+    key = _key(cache, _synapse_info())
+    assert key is not None
+    assert key == _key(cache, _synapse_info())
+    assert key != _key(cache, _synapse_info(), pre_index=0)
+    assert key != _key(cache, _synapse_info(p_connect=0.25))
+    assert key != _key(cache, _synapse_info(seed=2))
+    assert key != _key(cache, _synapse_info(weight=3.0))
+
+
+def test_not_cached(tmpdir):
+    MockSimulator.setup()
+    cache = SynapticBlockCache(str(tmpdir))
+
+    # The numbers of unseeded connectors differ in every run anyway
+    assert _key(cache, _synapse_info(seed=None)) is None
+
+    # Values that cannot be hashed stop the block being cached
+    synapse_info = _synapse_info()
+    synapse_info.connector._p_connect = object()
+    assert _key(cache, synapse_info) is None
+
+
+def test_seed_only_needed_for_random_numbers(tmpdir):
+    MockSimulator.setup()
+    cache = SynapticBlockCache(str(tmpdir))
+
+    # Connections not drawn from random numbers are the same in every run
+    assert _key(cache, _synapse_info(
+        seed=None, connector=AllToAllConnector())) is not None
+
+    # ... unless the weights are drawn from unseeded random numbers
+    assert _key(cache, _synapse_info(
+        seed=None, connector=AllToAllConnector(),
+        weight=_random_values(None))) is None
+    assert _key(cache, _synapse_info(
+        seed=None, connector=AllToAllConnector(),
+        weight=_random_values(3))) is not None
+    assert _key(cache, _synapse_info(weight=_random_values(None))) is None
+
+
+def _files(tmpdir):
+    return sorted(
+        os.path.join(directory, name)
+        for directory, _, names in os.walk(str(tmpdir))
+        for name in names if name.endswith(".npy"))
+
+
+def test_least_recently_used_removed(tmpdir):
+    MockSimulator.setup()
+
+    # Find the size of a block
+    _block(SynapticBlockCache(str(tmpdir)), _synapse_info(p_connect=1.0))
+    first_path, = _files(tmpdir)
+    n_bytes = os.path.getsize(first_path)
+
+    # Room for two blocks the size of the first, which is used again so
+    # that the second is the least recently used
+    cache = SynapticBlockCache(str(tmpdir), max_bytes=2 * n_bytes)
+    _block(cache, _synapse_info(p_connect=1.0), pre_index=0)
+    second_path, = set(_files(tmpdir)) - {first_path}
+    os.utime(second_path, (0, 0))
+    first = _synapse_info(p_connect=1.0)
+    _block(cache, first)
+    assert first.connector.n_created == 0
+
+    # Adding a third removes the second
+    _block(cache, _synapse_info(p_connect=1.0, weight=3.0))
+    files = _files(tmpdir)
+    assert len(files) == 2
+    assert first_path in files
+    assert second_path not in files
+    assert sum(os.path.getsize(path) for path in files) <= 2 * n_bytes
@@ -16,7 +16,9 @@
 import os
 import struct
 import tempfile
+import time
 import unittest
+import numpy
 import spinn_utilities.conf_loader as conf_loader
 from spinn_utilities.overrides import overrides
 from spinn_machine import SDRAM
@@ -30,7 +32,15 @@ from pacman.model.graphs.application import ApplicationVertex
 from spinn_storage_handlers import FileDataWriter, FileDataReader
 from data_specification import (
     DataSpecificationGenerator, DataSpecificationExecutor)
+from data_specification.enums import DataType
 from spynnaker.pyNN.models.neuron import SynapticManager
+import spynnaker.pyNN.models.neuron.synaptic_manager as synaptic_manager_module
+from spynnaker.pyNN.models.neuron.synaptic_manager import (
+    _SYNAPSE_SDRAM_OVERSCALE)
+from spynnaker.pyNN.models.neuron.synapse_io import SynapseIORowBased
+from spynnaker.pyNN.models.neuron.master_pop_table_generators import (
+    MasterPopTableAsBinarySearch)
+from spynnaker.pyNN.utilities.constants import POPULATION_BASED_REGIONS
 import spynnaker.pyNN.models.neural_projections.connectors.\
     abstract_generate_connector_on_machine as \
     abstract_generate_connector_on_machine
@@ -39,10 +49,14 @@ import spynnaker.pyNN.abstract_spinnaker_common as abstract_spinnaker_common
 from spynnaker.pyNN.models.neural_projections import (
     ProjectionApplicationEdge, ProjectionMachineEdge, SynapseInformation)
 from spynnaker.pyNN.models.neural_projections.connectors import (
-    OneToOneConnector, AllToAllConnector)
+    AbstractConnector, OneToOneConnector, AllToAllConnector)
 from spynnaker.pyNN.models.neuron.synapse_dynamics import (
-    SynapseDynamicsStatic)
-from unittests.mocks import MockSimulator
+    SynapseDynamicsStatic, SynapseDynamicsSTDP)
+from spynnaker.pyNN.models.neuron.plasticity.stdp.timing_dependence import (
+    TimingDependenceSpikePair)
+from spynnaker.pyNN.models.neuron.plasticity.stdp.weight_dependence import (
+    WeightDependenceAdditive)
+from unittests.mocks import MockGraphs, MockSimulator
 
 
 class MockSynapseIO(object):
@@ -70,6 +84,137 @@ class MockTransceiverRawData(object):
         return self._data_to_read[base_address:base_address + length]
 
 
+class MockTransceiverMemory(object):
+    """ Memory that can be read and written, recording the writes
+    """
+
+    def __init__(self, n_bytes):
+        self.memory = bytearray(n_bytes)
+        self.writes = list()
+
+    def read_memory(self, x, y, base_address, length):
+        return bytearray(self.memory[base_address:base_address + length])
+
+    def write_memory(self, x, y, base_address, data):
+        self.writes.append((base_address, bytes(data)))
+        self.memory[base_address:base_address + len(data)] = data
+
+
+class MockDataSpec(object):
+    """ Records the regions reserved and the arrays written to each
+    """
+
+    def __init__(self):
+        self.region_sizes = dict()
+        self.region_data = dict()
+        self._region = None
+
+    def comment(self, comment):
+        pass
+
+    def reserve_memory_region(self, region, size, label=None, empty=False):
+        self.region_sizes[region] = size
+
+    def switch_write_focus(self, region):
+        self._region = region
+
+    def write_value(self, data, data_type=None):
+        self.region_data.setdefault(self._region, list()).append(data)
+
+    def write_array(self, array_values, data_type=None):
+        self.region_data.setdefault(self._region, list()).extend(
+            array_values)
+
+
+class MockPopulationTable(object):
+    """ Records the entries added to the master population table
+    """
+
+    def __init__(self):
+        self.entries = list()
+
+    def initialise_table(self, spec, master_population_table_region):
+        pass
+
+    def update_master_population_table(self, spec, block_start_addr,
+                                       row_length, key_and_mask,
+                                       master_pop_table_region,
+                                       is_single=False, rows_present=None):
+        self.entries.append(key_and_mask)
+
+    def finish_master_pop_table(self, spec, master_pop_table_region):
+        pass
+
+    def get_next_allowed_address(self, next_address):
+        return next_address
+
+
+class MockPopulationVertex(object):
+
+    def __init__(self, n_atoms):
+        self.n_atoms = n_atoms
+        self.size = n_atoms
+
+    def get_max_atoms_per_core(self):
+        return 256
+
+
+class MockProjectionApplicationEdge(ProjectionApplicationEdge):
+
+    def __init__(self, pre_vertex, post_vertex, synapse_information):
+        super(MockProjectionApplicationEdge, self).__init__(
+            pre_vertex, post_vertex, synapse_information)
+        self._pre_vertex = pre_vertex
+        self._post_vertex = post_vertex
+
+    @property
+    def pre_vertex(self):
+        return self._pre_vertex
+
+    @property
+    def post_vertex(self):
+        return self._post_vertex
+
+    @property
+    def label(self):
+        return "edge"
+
+
+class MockConnector(object):
+    """ A connector whose blocks are only built on the host
+    """
+
+    def prepare_synaptic_block(
+            self, weights, delays, pre_slices, post_slices, pre_vertex_slice,
+            post_vertex_slice):
+        pass
+
+
+class MockBlockSynapseIO(object):
+    """ Builds blocks of rows that depend only on the pre-vertex slice,\
+        taking longer for the earlier slices so that blocks built on threads\
+        finish out of order
+    """
+
+    ROW_LENGTH = 4
+
+    def get_synapses(
+            self, synapse_info, pre_slices, pre_slice_index, post_slices,
+            post_slice_index, pre_vertex_slice, post_vertex_slice,
+            n_delay_stages, population_table, n_synapse_types, weight_scales,
+            machine_time_step, app_edge, machine_edge):
+        time.sleep(0.01 * (len(pre_slices) - pre_slice_index))
+        rng = numpy.random.RandomState(pre_vertex_slice.lo_atom)
+        n_words = self.ROW_LENGTH + 3
+        rows = numpy.zeros((pre_vertex_slice.n_atoms, n_words), "uint32")
+        rows[:, 1] = rng.randint(
+            0, self.ROW_LENGTH + 1, pre_vertex_slice.n_atoms)
+        rows[:, 3:] = rng.randint(0, 0xFFFFFFFF, (
+            pre_vertex_slice.n_atoms, self.ROW_LENGTH), dtype="uint32")
+        empty = numpy.zeros(0, "uint32")
+        return (rows.flatten(), self.ROW_LENGTH, empty, 0, empty, empty)
+
+
 class SimpleApplicationVertex(ApplicationVertex):
 
     def __init__(self, n_atoms):
@@ -379,6 +524,356 @@ class TestSynapticManager(unittest.TestCase):
         assert all([conn["weight"] == 4.5 for conn in connections_3])
         assert all([conn["delay"] == 4.0 for conn in connections_3])
 
+    def test_n_dma_buffers(self):
+        default_config_paths = os.path.join(
+            os.path.dirname(abstract_spinnaker_common.__file__),
+            AbstractSpiNNakerCommon.CONFIG_FILE_NAME)
+        config = conf_loader.load_config(
+            AbstractSpiNNakerCommon.CONFIG_FILE_NAME, default_config_paths)
+        max_buffers = config.getint(
+            "Simulation", "max_synaptic_row_dma_buffers")
+        synaptic_manager = SynapticManager(
+            n_synapse_types=2, ring_buffer_sigma=5.0,
+            spikes_per_second=100.0, config=config)
+        post_vertex_slice = Slice(0, 9)
+
+        # With plenty of DTCM, the configured maximum is used
+        assert synaptic_manager._get_n_dma_buffers(
+            post_vertex_slice, 0) == max_buffers
+
+        # Without any DTCM, the minimum is still used
+        assert synaptic_manager._get_n_dma_buffers(
+            post_vertex_slice, 64 * 1024) == 2
+
+        # No more are used than fit in the DMA queue
+        config.set("Simulation", "max_synaptic_row_dma_buffers", "100")
+        synaptic_manager = SynapticManager(
+            n_synapse_types=2, ring_buffer_sigma=5.0,
+            spikes_per_second=100.0, config=config)
+        assert synaptic_manager._get_n_dma_buffers(
+            Slice(0, 0), 0) == 6
+
+    def test_dtcm_usage(self):
+        default_config_paths = os.path.join(
+            os.path.dirname(abstract_spinnaker_common.__file__),
+            AbstractSpiNNakerCommon.CONFIG_FILE_NAME)
+        config = conf_loader.load_config(
+            AbstractSpiNNakerCommon.CONFIG_FILE_NAME, default_config_paths)
+        config.set("Simulation", "max_synaptic_row_dma_buffers", "6")
+        synaptic_manager = SynapticManager(
+            n_synapse_types=2, ring_buffer_sigma=5.0,
+            spikes_per_second=100.0, config=config)
+        post_vertex_slice = Slice(0, 255)
+        static_dtcm = synaptic_manager.get_dtcm_usage_in_bytes(
+            post_vertex_slice, [], 1000)
+        assert static_dtcm > 0
+
+        # The post-synaptic event history of STDP is counted, and leaves
+        # less DTCM for the DMA buffers
+        dynamics = SynapseDynamicsSTDP(
+            TimingDependenceSpikePair(), WeightDependenceAdditive(),
+            post_event_history_size=32)
+        synaptic_manager.synapse_dynamics = dynamics
+        stdp_dtcm = synaptic_manager.get_dtcm_usage_in_bytes(
+            post_vertex_slice, [], 1000)
+        assert stdp_dtcm == static_dtcm + dynamics.get_dtcm_usage_in_bytes(
+            post_vertex_slice.n_atoms, 2)
+        assert stdp_dtcm - static_dtcm > 256 * 32 * 4
+        assert (synaptic_manager._get_n_dma_buffers(
+                    post_vertex_slice, stdp_dtcm) <
+                synaptic_manager._get_n_dma_buffers(
+                    post_vertex_slice, static_dtcm))
+
+    def _procedural_projection(self, machine_time_step):
+        pre_vertex = MockPopulationVertex(100)
+        post_vertex = MockPopulationVertex(100)
+        connector = AllToAllConnector(procedural=True)
+        connector.set_projection_information(
+            pre_vertex, post_vertex, None, machine_time_step)
+        synapse_info = SynapseInformation(
+            connector, SynapseDynamicsStatic(), 1, 1.5, 1.0)
+        app_edge = MockProjectionApplicationEdge(
+            pre_vertex, post_vertex, synapse_info)
+        graphs = MockGraphs(
+            app_edge, [Slice(0, 99)], Slice(0, 99),
+            [BaseKeyAndMask(0x10000, 0xFFFFFF00)])
+        return synapse_info, app_edge, graphs
+
+    def _procedural_synaptic_manager(self):
+        default_config_paths = os.path.join(
+            os.path.dirname(abstract_spinnaker_common.__file__),
+            AbstractSpiNNakerCommon.CONFIG_FILE_NAME)
+        config = conf_loader.load_config(
+            AbstractSpiNNakerCommon.CONFIG_FILE_NAME, default_config_paths)
+        return SynapticManager(
+            n_synapse_types=2, ring_buffer_sigma=5.0,
+            spikes_per_second=100.0, config=config)
+
+    def test_write_procedural_synapses_data_spec(self):
+        MockSimulator.setup()
+        machine_time_step = 1000.0
+        is_pynn_8 = abstract_generate_connector_on_machine.IS_PYNN_8
+        abstract_generate_connector_on_machine.IS_PYNN_8 = True
+        try:
+            synaptic_manager = self._procedural_synaptic_manager()
+            synapse_info, app_edge, graphs = self._procedural_projection(
+                machine_time_step)
+            post_vertex_slice = Slice(0, 99)
+            spec = MockDataSpec()
+            synaptic_manager._write_procedural_synapses_data_spec(
+                spec, post_vertex_slice, "post", graphs, graphs, graphs,
+                [4096.0, 4096.0], machine_time_step)
+            size = synaptic_manager._get_procedural_synapses_size(
+                [app_edge], machine_time_step)
+        finally:
+            abstract_generate_connector_on_machine.IS_PYNN_8 = is_pynn_8
+
+        region = POPULATION_BASED_REGIONS.PROCEDURAL_SYNAPSES.value
+        data = spec.region_data[region]
+
+        # The size estimated is what is written, and all is written
+        assert spec.region_sizes[region] == len(data) * 4
+        assert size == len(data) * 4
+
+        # The slice, the bits of the synapse type and neuron index, and one
+        # connector of the whole pre-vertex, with rows of every neuron
+        assert list(data[:5]) == [0, 100, 1, 7, 1]
+        connector = synapse_info.connector
+        assert list(data[5:16]) == [
+            0x10000, 0xFFFFFF00, 0, 100, 100, 1, 4096,
+            DataType.S1615.encode_as_int(1.0), connector.gen_connector_id,
+            connector.gen_weights_id(1.5), connector.gen_delays_id(1.0)]
+
+        # The parameters of the connector, then the constant weight and delay
+        assert list(data[16:]) == [
+            1, DataType.S1615.encode_as_int(1.5),
+            DataType.S1615.encode_as_int(1.0)]
+
+    def test_procedural_synapses_not_stored(self):
+        MockSimulator.setup()
+        machine_time_step = 1000.0
+        is_pynn_8 = abstract_generate_connector_on_machine.IS_PYNN_8
+        abstract_generate_connector_on_machine.IS_PYNN_8 = True
+        try:
+            synaptic_manager = self._procedural_synaptic_manager()
+            population_table = MockPopulationTable()
+            synaptic_manager._SynapticManager__poptable_type = \
+                population_table
+            _, app_edge, graphs = self._procedural_projection(
+                machine_time_step)
+            post_vertex_slice = Slice(0, 99)
+            synaptic_manager.\
+                _write_synaptic_matrix_and_master_population_table(
+                    MockDataSpec(), [post_vertex_slice], 0, "post",
+                    post_vertex_slice, 1000, [4096.0, 4096.0], 0, 1, 2,
+                    graphs, graphs, graphs, machine_time_step)
+            blocks_size = synaptic_manager._get_synaptic_blocks_size(
+                post_vertex_slice, [app_edge], machine_time_step)
+        finally:
+            abstract_generate_connector_on_machine.IS_PYNN_8 = is_pynn_8
+
+        # Neither the master population table nor the matrix has the rows
+        assert population_table.entries == []
+        assert blocks_size == int(
+            synaptic_manager._get_static_synaptic_matrix_sdram_requirements()
+            * _SYNAPSE_SDRAM_OVERSCALE)
+
+    def _write_blocks_with_threads(self, n_threads):
+        default_config_paths = os.path.join(
+            os.path.dirname(abstract_spinnaker_common.__file__),
+            AbstractSpiNNakerCommon.CONFIG_FILE_NAME)
+        config = conf_loader.load_config(
+            AbstractSpiNNakerCommon.CONFIG_FILE_NAME, default_config_paths)
+        config.set(
+            "Simulation", "n_synapse_generation_threads", str(n_threads))
+        population_table = MockPopulationTable()
+        synaptic_manager = SynapticManager(
+            n_synapse_types=2, ring_buffer_sigma=5.0,
+            spikes_per_second=100.0, config=config,
+            population_table_type=population_table,
+            synapse_io=MockBlockSynapseIO())
+        pre_vertex = MockPopulationVertex(100)
+        post_vertex = MockPopulationVertex(100)
+        synapse_info = SynapseInformation(
+            MockConnector(), SynapseDynamicsStatic(), 0, 1.5, 1.0)
+        app_edge = MockProjectionApplicationEdge(
+            pre_vertex, post_vertex, synapse_info)
+        post_vertex_slice = Slice(0, 99)
+        graphs = MockGraphs(
+            app_edge, [Slice(lo_atom, lo_atom + 24)
+                       for lo_atom in range(0, 100, 25)], post_vertex_slice)
+        spec = MockDataSpec()
+        synaptic_manager._write_synaptic_matrix_and_master_population_table(
+            spec, [post_vertex_slice], 0, "post", post_vertex_slice,
+            1024 * 1024, [4096.0, 4096.0], 0, 1, 2, graphs, graphs, graphs,
+            1000.0)
+        keys = [key_and_mask.key for key_and_mask in population_table.entries]
+        return spec.region_data, keys
+
+    def test_write_synaptic_blocks_with_threads(self):
+        MockSimulator.setup()
+        serial_data, serial_keys = self._write_blocks_with_threads(1)
+        threaded_data, threaded_keys = self._write_blocks_with_threads(2)
+
+        # Every block is written, in the order of the edges
+        assert serial_keys == [0x10000, 0x20000, 0x30000, 0x40000]
+        assert threaded_keys == serial_keys
+
+        # The regions are byte-identical
+        assert sorted(threaded_data) == sorted(serial_data)
+        for region, data in serial_data.items():
+            assert (numpy.array(threaded_data[region], "uint32").tobytes() ==
+                    numpy.array(data, "uint32").tobytes())
+
+    @staticmethod
+    def _update_weights_on_machine(
+            synaptic_manager, transceiver, placement, graphs, synapse_info,
+            matrix_address):
+        def locate_region(placement, region, transceiver):
+            if region == POPULATION_BASED_REGIONS.SYNAPTIC_MATRIX.value:
+                return matrix_address
+            return 0
+
+        locate = synaptic_manager_module.locate_memory_region_for_placement
+        synaptic_manager_module.locate_memory_region_for_placement = \
+            locate_region
+        try:
+            return synaptic_manager.update_weights_on_machine(
+                transceiver, placement, graphs.machine_edges[0], graphs,
+                graphs, synapse_info)
+        finally:
+            synaptic_manager_module.locate_memory_region_for_placement = \
+                locate
+
+    def test_update_weights_on_machine(self):
+        MockSimulator.setup()
+        default_config_paths = os.path.join(
+            os.path.dirname(abstract_spinnaker_common.__file__),
+            AbstractSpiNNakerCommon.CONFIG_FILE_NAME)
+        config = conf_loader.load_config(
+            AbstractSpiNNakerCommon.CONFIG_FILE_NAME, default_config_paths)
+        pre_vertex_slice = Slice(0, 9)
+        post_vertex_slice = Slice(0, 99)
+        dynamics = SynapseDynamicsStatic()
+
+        # 20 synapses from each of 10 neurons, where only those of the
+        # last 5 neurons have a weight other than the new one
+        connections = numpy.zeros(
+            200, dtype=AbstractConnector.NUMPY_SYNAPSES_DTYPE)
+        connections["source"] = numpy.repeat(numpy.arange(10), 20)
+        connections["target"] = numpy.tile(numpy.arange(0, 100, 5), 10)
+        connections["weight"] = numpy.where(
+            connections["source"] < 5, 20, 30)
+        connections["delay"] = 3
+        max_row_length, row_data = \
+            SynapseIORowBased._get_max_row_length_and_row_data(
+                connections, connections["source"], 10, post_vertex_slice, 2,
+                MasterPopTableAsBinarySearch(), dynamics, None, None)
+        block = row_data.tobytes()
+
+        # The block is found in the synaptic matrix region from the key
+        key = 0x10000
+        matrix_address = 0x100
+        block_offset = 0x40
+        synapse_io = SynapseIORowBased()
+        synaptic_manager = SynapticManager(
+            n_synapse_types=2, ring_buffer_sigma=5.0,
+            spikes_per_second=100.0, config=config,
+            population_table_type=MockMasterPopulationTable(
+                {key: [(max_row_length, block_offset, False)]}),
+            synapse_io=synapse_io)
+        transceiver = MockTransceiverMemory(
+            matrix_address + block_offset + len(block) + 0x40)
+        block_address = matrix_address + block_offset
+        transceiver.memory[
+            block_address:block_address + len(block)] = block
+        original_memory = bytes(transceiver.memory)
+
+        synapse_info = SynapseInformation(
+            AllToAllConnector(), dynamics, 0, weight=2.0)
+        app_edge = MockProjectionApplicationEdge(
+            MockPopulationVertex(10), MockPopulationVertex(100),
+            synapse_info)
+        graphs = MockGraphs(app_edge, [pre_vertex_slice], post_vertex_slice)
+        placement = Placement(None, 0, 0, 1)
+        synaptic_manager._SynapticManager__synapse_indices[
+            synapse_info, 0, 0] = 0
+        synaptic_manager._SynapticManager__weight_scales[placement] = [
+            10.0, 10.0]
+
+        def update_weights():
+            return self._update_weights_on_machine(
+                synaptic_manager, transceiver, placement, graphs,
+                synapse_info, matrix_address)
+
+        assert update_weights()
+
+        # Every weight is now the new one, and nothing else has changed
+        new_block = transceiver.memory[
+            block_address:block_address + len(block)]
+        synapses = synapse_io.read_synapses(
+            synapse_info, pre_vertex_slice, post_vertex_slice,
+            max_row_length, 0, 2, [10.0, 10.0], new_block, None, 0, 1000)
+        assert numpy.all(synapses["weight"] == 2.0)
+        assert numpy.array_equal(
+            numpy.sort(synapses["source"]), connections["source"])
+        assert numpy.all(synapses["delay"] == 3)
+        assert (transceiver.memory[:block_address] ==
+                original_memory[:block_address])
+        assert (transceiver.memory[block_address + len(block):] ==
+                original_memory[block_address + len(block):])
+
+        # Only the span of the rows of the last 5 neurons is written, from
+        # their first changed word to their last
+        old_words = numpy.frombuffer(block, dtype="<u4")
+        new_words = numpy.frombuffer(bytes(new_block), dtype="<u4")
+        changed = numpy.flatnonzero(old_words != new_words)
+        row_words = max_row_length + 3
+        assert changed[0] >= 5 * row_words
+        assert transceiver.writes == [(
+            block_address + int(changed[0]) * 4,
+            new_words[changed[0]:changed[-1] + 1].tobytes())]
+
+        # Writing the same weights again writes nothing
+        transceiver.writes = list()
+        assert update_weights()
+        assert transceiver.writes == []
+
+    def test_update_weights_of_direct_block(self):
+        MockSimulator.setup()
+        default_config_paths = os.path.join(
+            os.path.dirname(abstract_spinnaker_common.__file__),
+            AbstractSpiNNakerCommon.CONFIG_FILE_NAME)
+        config = conf_loader.load_config(
+            AbstractSpiNNakerCommon.CONFIG_FILE_NAME, default_config_paths)
+
+        # A one-to-one block in the direct matrix, which the core copies into
+        # DTCM only when it starts, so it can't be updated in SDRAM
+        key = 0x10000
+        synaptic_manager = SynapticManager(
+            n_synapse_types=2, ring_buffer_sigma=5.0,
+            spikes_per_second=100.0, config=config,
+            population_table_type=MockMasterPopulationTable(
+                {key: [(1, 0x40, True)]}),
+            synapse_io=SynapseIORowBased())
+        transceiver = MockTransceiverMemory(0x200)
+        synapse_info = SynapseInformation(
+            OneToOneConnector(None), SynapseDynamicsStatic(), 0, weight=2.0)
+        app_edge = MockProjectionApplicationEdge(
+            MockPopulationVertex(10), MockPopulationVertex(10), synapse_info)
+        graphs = MockGraphs(app_edge, [Slice(0, 9)], Slice(0, 9))
+        placement = Placement(None, 0, 0, 1)
+        synaptic_manager._SynapticManager__synapse_indices[
+            synapse_info, 0, 0] = 0
+        synaptic_manager._SynapticManager__weight_scales[placement] = [
+            10.0, 10.0]
+
+        # The matrix must be generated again, and nothing is written
+        assert not self._update_weights_on_machine(
+            synaptic_manager, transceiver, placement, graphs, synapse_info,
+            0x100)
+        assert transceiver.writes == []
+
 
 if __name__ == "__main__":
     unittest.main()
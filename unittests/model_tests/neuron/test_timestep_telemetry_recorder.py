@@ -0,0 +1,129 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+from collections import OrderedDict
+import numpy
+from spinn_front_end_common.utilities import globals_variables
+from pacman.model.graphs.common import Slice
+from pacman.model.placements import Placement
+from spynnaker.pyNN.models.common import (
+    TimestepTelemetryRecorder, TELEMETRY_DTYPE)
+from spynnaker.pyNN.models.pynn_population_common import PyNNPopulationCommon
+from unittests.mocks import MockSimulator
+
+
+class _MockGraphMapper(object):
+    def __init__(self, slices):
+        self._slices = slices
+
+    def get_machine_vertices(self, application_vertex):
+        return list(self._slices.keys())
+
+    def get_slice(self, vertex):
+        return self._slices[vertex]
+
+
+class _MockPlacements(object):
+    def __init__(self, placements):
+        self._placements = placements
+
+    def get_placement_of_vertex(self, vertex):
+        return self._placements[vertex]
+
+
+class _MockBufferManager(object):
+    def __init__(self, data):
+        self._data = data
+
+    def get_data_by_placement(self, placement, region):
+        return self._data[placement.p], False
+
+
+class _MockRanSimulator(MockSimulator):
+    """ A simulator that has run on a machine
+    """
+    has_ran = True
+    use_virtual_board = False
+    placements = None
+    graph_mapper = None
+    buffer_manager = None
+
+
+class _MockTelemetryVertex(object):
+    """ Records the telemetry read and cleared, as the population asks\
+        for them
+    """
+    def __init__(self):
+        self.calls = list()
+
+    def is_recording_timestep_telemetry(self):
+        return True
+
+    def get_timestep_telemetry(
+            self, placements, graph_mapper, buffer_manager):
+        self.calls.append("get")
+        return numpy.zeros(3, dtype=TELEMETRY_DTYPE)
+
+    def clear_timestep_telemetry(
+            self, buffer_manager, placements, graph_mapper):
+        self.calls.append("clear")
+
+
+def test_sdram():
+    recorder = TimestepTelemetryRecorder()
+    assert not recorder.is_recording
+    assert recorder.get_buffered_sdram(100) == 0
+    recorder.set_recording(True)
+    assert recorder.is_recording
+    assert recorder.get_buffered_sdram_per_timestep() == 24
+    assert recorder.get_buffered_sdram(100) == 2400
+    sdram = recorder.get_variable_sdram_usage()
+    assert sdram.per_timestep == 24
+
+
+def test_get_telemetry():
+    recorder = TimestepTelemetryRecorder()
+    recorder.set_recording(True)
+    records = {
+        1: bytearray(numpy.arange(12, dtype="<u4").tobytes()),
+        2: bytearray(numpy.arange(100, 106, dtype="<u4").tobytes())}
+    graph_mapper = _MockGraphMapper(
+        OrderedDict([("a", Slice(0, 9)), ("b", Slice(10, 19))]))
+    placements = _MockPlacements({
+        "a": Placement("a", 0, 0, 1), "b": Placement("b", 0, 0, 2)})
+    telemetry = recorder.get_telemetry(
+        "test", _MockBufferManager(records), 5, placements, graph_mapper,
+        None)
+    assert len(telemetry) == 3
+    assert list(telemetry["p"]) == [1, 1, 2]
+    assert list(telemetry["lo_atom"]) == [0, 0, 10]
+    assert list(telemetry["time"]) == [0, 6, 100]
+    assert list(telemetry["max_input_queue_depth"]) == [5, 11, 105]
+
+
+def test_get_and_clear_telemetry():
+    # pylint: disable=protected-access
+    MockSimulator.setup()
+    globals_variables.set_simulator(_MockRanSimulator())
+    population = PyNNPopulationCommon.__new__(PyNNPopulationCommon)
+    vertex = _MockTelemetryVertex()
+    population._PyNNPopulationCommon__vertex = vertex
+
+    # The telemetry is kept unless asked to be cleared, and cleared only
+    # once it has been read
+    assert len(population.get_timestep_telemetry()) == 3
+    assert vertex.calls == ["get"]
+    assert len(population.get_timestep_telemetry(clear=True)) == 3
+    assert vertex.calls == ["get", "get", "clear"]
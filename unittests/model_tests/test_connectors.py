@@ -19,9 +19,9 @@ import numpy
 import pytest
 from pacman.model.graphs.common import Slice
 from spynnaker.pyNN.models.neural_projections.connectors import (
-    FixedNumberPreConnector, FixedNumberPostConnector,
+    AllToAllConnector, FixedNumberPreConnector, FixedNumberPostConnector,
     FixedProbabilityConnector, IndexBasedProbabilityConnector)
-from unittests.mocks import MockSimulator, MockPopulation
+from unittests.mocks import MockSimulator, MockPopulation, MockRNG
 from unittest import SkipTest
 
 
@@ -179,3 +179,51 @@ def test_connectors(
                 "https://github.com/SpiNNakerManchester/sPyNNaker/issues/587")
     print(connector, n_pre, n_post, n_in_slice, max_row_length,
           max_source, max_col_length, max_target)
+
+
+def test_blocks_in_any_order(create_connector):
+    MockSimulator.setup()
+    pre_slices = [Slice(i, i + 9) for i in range(0, 30, 10)]
+    post_slices = [Slice(i, i + 9) for i in range(0, 20, 10)]
+    pairs = [(pre_index, post_index)
+             for pre_index in range(len(pre_slices))
+             for post_index in range(len(post_slices))]
+
+    def create_blocks(order):
+        connector = create_connector()
+        connector.set_projection_information(
+            pre_population=MockPopulation(30, "Pre"),
+            post_population=MockPopulation(20, "Post"),
+            rng=MockRNG(1), machine_time_step=1000)
+
+        # Once prepared in order, blocks can be made in any order
+        for pre_index, post_index in pairs:
+            connector.prepare_synaptic_block(
+                5, 5, pre_slices, post_slices, pre_slices[pre_index],
+                post_slices[post_index])
+        return {
+            (pre_index, post_index): connector.create_synaptic_block(
+                5, 5, pre_slices, pre_index, post_slices, post_index,
+                pre_slices[pre_index], post_slices[post_index], 0)
+            for pre_index, post_index in order}
+
+    blocks = create_blocks(pairs)
+    reversed_blocks = create_blocks(reversed(pairs))
+    for pair in pairs:
+        assert numpy.array_equal(blocks[pair], reversed_blocks[pair])
+
+
+@pytest.mark.parametrize("create_connector", [
+    AllToAllConnector, functools.partial(FixedProbabilityConnector, 0.5)])
+def test_generate_procedurally(create_connector):
+    MockSimulator.setup()
+
+    # Only generated procedurally when asked for
+    assert not create_connector().generate_procedurally(1.0, 1.0)
+
+    # ... and when it could be generated on the machine anyway
+    connector = create_connector(procedural=True)
+    assert connector.procedural
+    assert (connector.generate_procedurally(1.0, 1.0) ==
+            connector.generate_on_machine(1.0, 1.0))
+    assert not connector.generate_procedurally(numpy.ones(10), 1.0)
@@ -0,0 +1,87 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import numpy
+import pytest
+from pacman.model.graphs.common import Slice
+from spynnaker.pyNN.models.neural_projections.connectors import (
+    KernelConnector)
+from unittests.mocks import MockSimulator
+
+
+def _convolve(params, pre_index, post_vertex_slice):
+    """ Find the synapses of a pre-neuron as the neuron core does from the\
+        convolution parameters
+    """
+    (pre_slice_start, pre_w, post_w, first_post_row, n_post_rows, kernel_w,
+     kernel_h, _synapse_type) = params[:8]
+    n_kernel = kernel_w * kernel_h
+    halves = params[8:].view("uint16")
+    offset = n_post_rows + (n_post_rows % 2)
+    post_row_as_pre = halves[:n_post_rows].view("int16")
+    post_col_as_pre = halves[offset:offset + post_w].view("int16")
+    offset += post_w + (post_w % 2)
+    weights = halves[offset:offset + n_kernel]
+
+    pre_index += pre_slice_start
+    pre_r, pre_c = pre_index // pre_w, pre_index % pre_w
+    synapses = set()
+    for i in range(n_post_rows):
+        k_r = (kernel_h // 2) + pre_r - int(post_row_as_pre[i])
+        if not 0 <= k_r < kernel_h:
+            continue
+        for c in range(post_w):
+            post = (first_post_row + i) * post_w + c
+            if not (post_vertex_slice.lo_atom <= post <=
+                    post_vertex_slice.hi_atom):
+                continue
+            k_c = (kernel_w // 2) + pre_c - int(post_col_as_pre[c])
+            if 0 <= k_c < kernel_w and weights[k_r * kernel_w + k_c]:
+                synapses.add((
+                    pre_index, post, int(weights[k_r * kernel_w + k_c])))
+    return synapses
+
+
+@pytest.mark.parametrize("post_steps", [None, (2, 2)])
+def test_convolution_matches_synaptic_block(post_steps):
+    MockSimulator.setup()
+    weights = numpy.arange(1.0, 10.0).reshape(3, 3)
+    connector = KernelConnector(
+        shape_pre=(10, 10), shape_post=(5, 5) if post_steps else (10, 10),
+        shape_kernel=(3, 3), weight_kernel=weights,
+        delay_kernel=numpy.ones((3, 3)), shape_common=None,
+        pre_sample_steps=None, pre_start_coords=None,
+        post_sample_steps=post_steps, post_start_coords=None, safe=True,
+        space=None, verbose=False, convolution=True)
+    assert connector.convolution
+
+    n_post = 25 if post_steps else 100
+    pre_vertex_slice = Slice(0, 99)
+    for post_vertex_slice in [Slice(0, 12), Slice(13, n_post - 1)]:
+        params = connector.gen_convolution_params(
+            None, None, pre_vertex_slice, post_vertex_slice, 0, 1.0, 1000)
+        assert len(params) * 4 == (
+            connector.gen_convolution_params_size_in_bytes(post_vertex_slice))
+
+        block = connector.create_synaptic_block(
+            None, None, [pre_vertex_slice], 0, [post_vertex_slice], 0,
+            pre_vertex_slice, post_vertex_slice, 0)
+        expected = set(
+            (int(s), int(t), int(w)) for s, t, w in zip(
+                block["source"], block["target"], block["weight"]))
+        convolved = set()
+        for pre_index in range(pre_vertex_slice.n_atoms):
+            convolved |= _convolve(params, pre_index, post_vertex_slice)
+        assert convolved == expected
@@ -0,0 +1,144 @@
+# Copyright (c) 2017-2019 The University of Manchester
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+import math
+import numpy
+import pytest
+from pacman.model.graphs.common import Slice
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+# The neuron models must be imported before the Poisson vertex, which the
+# synaptic manager imports in turn
+from spynnaker.pyNN.models.neuron import AbstractPopulationVertex  # noqa
+from spynnaker.pyNN.models.spike_source.spike_source_poisson_vertex import (
+    SpikeSourcePoissonVertex)
+from unittests.mocks import MockSimulator
+
+_MACHINE_TIME_STEP = 1000
+
+# The kinds of rate change, as in spike_source_poisson.c
+_SLOW_RATE = 0
+_FAST_RATE = 1
+_FASTER_RATE = 2
+
+
+class _MockSpec(object):
+    """ Records the words written by the vertex
+    """
+
+    def __init__(self):
+        self.words = list()
+
+    def switch_write_focus(self, region):
+        pass
+
+    def write_value(self, data):
+        self.words.append(int(data))
+
+    def write_array(self, array):
+        self.words.extend(int(value) for value in numpy.ravel(array))
+
+
+def _vertex(n_neurons, rate=0.0, rate_schedule=None):
+    MockSimulator.setup()
+    return SpikeSourcePoissonVertex(
+        n_neurons, None, "poisson", rate, None, 0, None, 1, 256, None,
+        rate_schedule=rate_schedule)
+
+
+def test_convert_no_rate_schedule():
+    vertex = _vertex(3)
+    assert len(vertex.rate_schedule) == 3
+    for changes in vertex.rate_schedule:
+        assert changes.shape == (0, 2)
+
+
+def test_convert_shared_rate_schedule():
+    vertex = _vertex(3, rate_schedule=[(20, 5.0), (0, 2.0), (20, 7.0)])
+    for changes in vertex.rate_schedule:
+        # Sorted by time, keeping changes of the same time in order
+        assert changes.tolist() == [[0, 2.0], [20, 5.0], [20, 7.0]]
+
+
+def test_convert_rate_schedule_per_source():
+    vertex = _vertex(3, rate_schedule=[[], [(10, 1.0)], [(5, 3.0), (1, 4)]])
+    assert vertex.rate_schedule[0].shape == (0, 2)
+    assert vertex.rate_schedule[1].tolist() == [[10, 1.0]]
+    assert vertex.rate_schedule[2].tolist() == [[1, 4.0], [5, 3.0]]
+
+    # The schedule can be replaced after creation
+    vertex.rate_schedule = [(3, 6.0)]
+    assert [changes.tolist() for changes in vertex.rate_schedule] == \
+        [[[3, 6.0]]] * 3
+
+
+def test_convert_bad_rate_schedule():
+    with pytest.raises(ConfigurationException):
+        _vertex(3, rate_schedule=[[(0, 1.0)], [(0, 2.0)]])
+    with pytest.raises(ConfigurationException):
+        _vertex(2, rate_schedule=[(0, 1.0), (10, -1.0)])
+    with pytest.raises(ConfigurationException):
+        _vertex(2, rate_schedule=[(-1, 1.0)])
+
+
+def test_peak_rates():
+    # pylint: disable=protected-access
+    vertex = _vertex(4, rate=[1.0, 2.0, 3.0, 4.0], rate_schedule=[
+        [], [(10, 20.0), (20, 0.0)], [(10, 1.0)], [(5, 4.0), (6, 50.0)]])
+    assert vertex._peak_rates().tolist() == [1.0, 20.0, 3.0, 50.0]
+
+    # The time between spikes is sized for the peak rates; a higher peak
+    # makes it shorter than that of the rates alone
+    assert vertex._max_spikes_per_ts(_MACHINE_TIME_STEP) == \
+        _vertex(1, rate=50.0)._max_spikes_per_ts(_MACHINE_TIME_STEP)
+
+
+def test_write_rate_schedule():
+    # pylint: disable=protected-access
+    vertex = _vertex(4, rate_schedule=[
+        [(1, 5.0)],
+        [(2.4, 100.0), (1.0, 20000.0), (2, 0.0)],
+        [(2, 5.0), (0, 100.0)],
+        [(0, 1.0)]])
+    spec = _MockSpec()
+    vertex._write_rate_schedule(spec, Slice(1, 2), _MACHINE_TIME_STEP)
+
+    # The changes of atoms 1 and 2 only, as sources 0 and 1 of the slice,
+    # sorted by tick; changes in the same tick stay in order of time, so
+    # the last rate of a tick is applied last
+    n_changes = spec.words[0]
+    assert n_changes == 5
+    changes = [tuple(spec.words[1 + i * 3:4 + i * 3])
+               for i in range(n_changes)]
+    assert len(spec.words) == 1 + n_changes * 3
+    assert len(spec.words) * 4 == vertex.get_rate_schedule_bytes(
+        Slice(1, 2))
+
+    exp_minus_lambda = int(math.exp(-0.1) * (2 ** 32))
+    sqrt_lambda = int(math.sqrt(20.0) * (2 ** 15))
+    assert changes == [
+        (0, 1 | (_FAST_RATE << 16), exp_minus_lambda),
+        (1, 0 | (_FASTER_RATE << 16), sqrt_lambda),
+        (2, 0 | (_SLOW_RATE << 16), 0),
+        (2, 0 | (_FAST_RATE << 16), exp_minus_lambda),
+        (2, 1 | (_SLOW_RATE << 16), 200)]
+
+
+def test_write_no_rate_schedule():
+    # pylint: disable=protected-access
+    vertex = _vertex(4, rate_schedule=[[(1, 5.0)], [], [], [(2, 1.0)]])
+    spec = _MockSpec()
+    vertex._write_rate_schedule(spec, Slice(1, 2), _MACHINE_TIME_STEP)
+    assert spec.words == [0]
+    assert vertex.get_rate_schedule_bytes(Slice(1, 2)) == 4